@@ -0,0 +1,516 @@
+/**************************************************************************//**
+ * @file     DAP_config.h
+ * @brief    CMSIS-DAP Configuration File for NUC1261
+ * @version  V1.10
+ * @date     20. May 2015
+ *
+ * @note
+ * Copyright (C) 2012-2015 ARM Limited. All rights reserved.
+ *
+ * @par
+ * ARM Limited (ARM) is supplying this software for use with Cortex-M
+ * processor based microcontrollers.
+ *
+ * @par
+ * THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ * OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ * ARM SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *
+ ******************************************************************************/
+
+#ifndef __DAP_CONFIG_H__
+#define __DAP_CONFIG_H__
+
+
+//**************************************************************************************************
+/**
+\defgroup DAP_Config_Debug_gr CMSIS-DAP Debug Unit Information
+\ingroup DAP_ConfigIO_gr
+@{
+Provides definitions about the hardware and configuration of the Debug Unit.
+
+This information includes:
+ - Definition of Cortex-M processor parameters used in CMSIS-DAP Debug Unit.
+ - Debug Unit communication packet size.
+ - Debug Access Port communication mode (JTAG or SWD).
+ - Optional information about a connected Target Device (for Evaluation Boards).
+*/
+
+#include "NUC1261.h"                            // Debug Unit Cortex-M Processor Header File
+
+/// Processor Clock of the Cortex-M MCU used in the Debug Unit.
+/// This value is used to calculate the SWD/JTAG clock speed.
+#define CPU_CLOCK               72000000U       ///< Specifies the CPU Clock in Hz
+
+/// Number of processor cycles for I/O Port write operations.
+/// This value is used to calculate the SWD/JTAG clock speed that is generated with I/O
+/// Port write operations in the Debug Unit by a Cortex-M MCU. Most Cortex-M processors
+/// require 2 processor cycles for a I/O Port Write operation.  If the Debug Unit uses
+/// a Cortex-M0+ processor with high-speed peripheral I/O only 1 processor cycle might be
+/// required.
+#define IO_PORT_WRITE_CYCLES    2U              ///< I/O Cycles: 2=default, 1=Cortex-M0+ fast I/0
+
+/// Indicate that Serial Wire Debug (SWD) communication mode is available at the Debug Access Port.
+/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
+#define DAP_SWD                 1               ///< SWD Mode:  1 = available, 0 = not available
+
+/// Indicate that JTAG communication mode is available at the Debug Port.
+/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
+#define DAP_JTAG                0               ///< JTAG Mode: 1 = available, 0 = not available.
+
+/// Configure maximum number of JTAG devices on the scan chain connected to the Debug Access Port.
+/// This setting impacts the RAM requirements of the Debug Unit. Valid range is 1 .. 255.
+#define DAP_JTAG_DEV_CNT        0U              ///< Maximum number of JTAG devices on scan chain
+
+/// Default communication mode on the Debug Access Port.
+/// Used for the command \ref DAP_Connect when Port Default mode is selected.
+#define DAP_DEFAULT_PORT        1U              ///< Default JTAG/SWJ Port Mode: 1 = SWD, 2 = JTAG.
+
+/// Default communication speed on the Debug Access Port for SWD and JTAG mode.
+/// Used to initialize the default SWD/JTAG clock frequency.
+/// The command \ref DAP_SWJ_Clock can be used to overwrite this default setting.
+#define DAP_DEFAULT_SWJ_CLOCK   1000000U        ///< Default SWD/JTAG clock frequency in Hz.
+
+/// Maximum Package Size for Command and Response data.
+/// This configuration settings is used to optimized the communication performance with the
+/// debugger and depends on the USB peripheral. Change setting to 1024 for High-Speed USB.
+#define DAP_PACKET_SIZE         64U             ///< USB: 64 = Full-Speed, 1024 = High-Speed.
+
+/// Maximum Package Buffers for Command and Response data.
+/// This configuration settings is used to optimized the communication performance with the
+/// debugger and depends on the USB peripheral. For devices with limited RAM or USB buffer the
+/// setting can be reduced (valid range is 1 .. 255). Change setting to 4 for High-Speed USB.
+#define DAP_PACKET_COUNT        4U              ///< Buffers: 64 = Full-Speed, 4 = High-Speed.
+
+/// Indicate that UART Serial Wire Output (SWO) trace is available.
+/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
+#define SWO_UART                1               ///< SWO UART:  1 = available, 0 = not available
+
+/// Maximum SWO UART Baudrate
+/// UART0 is clocked from PLL / 2 = 72 MHz, see UART.c for the PDMA receive driver.
+#define SWO_UART_MAX_BAUDRATE   6000000U        ///< SWO UART Maximum Baudrate in Hz
+
+/// Indicate that Manchester Serial Wire Output (SWO) trace is available.
+/// This information is returned by the command \ref DAP_Info as part of <b>Capabilities</b>.
+#define SWO_MANCHESTER          0               ///< SWO Manchester:  1 = available, 0 = not available
+
+/// SWO Trace Buffer Size.
+#define SWO_BUFFER_SIZE         4096U           ///< SWO Trace Buffer Size in bytes (must be 2^n)
+
+/// Indicate that SWO trace can be streamed to a dedicated USB bulk IN endpoint (Transport 2).
+#define SWO_STREAM              1               ///< SWO Streaming Trace: 1 = available, 0 = not available
+
+
+/// Debug Unit is connected to fixed Target Device.
+/// The Debug Unit may be part of an evaluation board and always connected to a fixed
+/// known device.  In this case a Device Vendor and Device Name string is stored which
+/// may be used by the debugger or IDE to configure device parameters.
+#define TARGET_DEVICE_FIXED     0               ///< Target Device: 1 = known, 0 = unknown;
+
+#if TARGET_DEVICE_FIXED
+#define TARGET_DEVICE_VENDOR    "Nuvoton"       ///< String indicating the Silicon Vendor
+#define TARGET_DEVICE_NAME      "NUC1261"       ///< String indicating the Target Device
+#endif
+
+/// Shift the 32-bit SWD data phase with the SPI1 controller.
+/// Used by \ref SWD_Transfer in fast clock mode. Request, acknowledge, turnaround and parity
+/// bits are still generated by GPIO; only WDATA/RDATA[0:31] are shifted by the SPI controller.
+#define SWD_DATA_HW             1               ///< SWD data phase: 1 = SPI1, 0 = GPIO bit-banging
+
+/// SWCLK frequency of the SPI1 data phase.
+/// SPI1 is clocked from PCLK0 (CPU_CLOCK) and the divider is rounded to the next slower clock.
+#define SWD_DATA_HW_CLOCK       12000000U       ///< SWCLK frequency of the data phase in Hz
+
+///@}
+
+
+// Debug Port I/O Pins
+
+// SWCLK Pin                    PA.7 (SPI1_CLK)
+// SWDIO Pin                    PA.5 (SPI1_MOSI, half-duplex)
+// nRESET Pin                   PA.6
+// SWO Pin                      PA.3 (UART0_RXD)
+// Connected LED                PB.0
+// Target Running LED           PB.1
+
+/// @cond HIDDEN_SYMBOLS
+#define PIN_MODE_Set(port, pin, mode) \
+    ((port)->MODE = ((port)->MODE & ~(0x3UL << ((pin) << 1))) | ((mode) << ((pin) << 1)))
+/// @endcond
+
+
+//**************************************************************************************************
+/**
+\defgroup DAP_Config_PortIO_gr CMSIS-DAP Hardware I/O Pin Access
+\ingroup DAP_ConfigIO_gr
+@{
+
+Standard I/O Pins of the CMSIS-DAP Hardware Debug Port support standard JTAG mode
+and Serial Wire Debug (SWD) mode. In SWD mode only 2 pins are required to implement the debug
+interface of a device. The following I/O Pins are provided:
+
+JTAG I/O Pin                 | SWD I/O Pin          | CMSIS-DAP Hardware pin mode
+---------------------------- | -------------------- | ---------------------------------------------
+TCK: Test Clock              | SWCLK: Clock         | Output Push/Pull
+TMS: Test Mode Select        | SWDIO: Data I/O      | Output Push/Pull; Input (for receiving data)
+TDI: Test Data Input         |                      | Output Push/Pull
+TDO: Test Data Output        |                      | Input
+nTRST: Test Reset (optional) |                      | Output Open Drain with pull-up resistor
+nRESET: Device Reset         | nRESET: Device Reset | Output Open Drain with pull-up resistor
+
+
+DAP Hardware I/O Pin Access Functions
+-------------------------------------
+The various I/O Pins are accessed by functions that implement the Read, Write, Set, or Clear to
+these I/O Pins.
+
+For the SWDIO I/O Pin there are additional functions that are called in SWD I/O mode only.
+This functions are provided to achieve faster I/O that is possible with some advanced GPIO
+peripherals that can independently write/read a single I/O pin without affecting any other pins
+of the same I/O port. The following SWDIO I/O Pin functions are provided:
+ - \ref PIN_SWDIO_OUT_ENABLE to enable the output mode from the DAP hardware.
+ - \ref PIN_SWDIO_OUT_DISABLE to enable the input mode to the DAP hardware.
+ - \ref PIN_SWDIO_IN to read from the SWDIO I/O pin with utmost possible speed.
+ - \ref PIN_SWDIO_OUT to write to the SWDIO I/O pin with utmost possible speed.
+
+When \ref SWD_DATA_HW is enabled the 32-bit data phase is shifted by SPI1 instead:
+ - \ref PIN_SWD_DATA_WRITE to send WDATA[0:31].
+ - \ref PIN_SWD_DATA_READ to receive RDATA[0:31].
+*/
+
+
+// Configure DAP I/O pins ------------------------------
+
+/** Setup JTAG I/O pins: TCK, TMS, TDI, TDO, nTRST, and nRESET.
+Configures the DAP Hardware I/O pins for JTAG mode:
+ - TCK, TMS, TDI, nTRST, nRESET to output mode and set to high level.
+ - TDO to input mode.
+*/
+static __inline void PORT_JTAG_SETUP(void)
+{
+    ;
+}
+
+/** Setup SWD I/O pins: SWCLK, SWDIO, and nRESET.
+Configures the DAP Hardware I/O pins for Serial Wire Debug (SWD) mode:
+ - SWCLK, SWDIO, nRESET to output mode and set to default high level.
+ - TDI, nTRST to HighZ mode (pins are unused in SWD mode).
+*/
+static __inline void PORT_SWD_SETUP(void)
+{
+    PA7 = 1;
+    PA5 = 1;
+    PA6 = 1;
+    PIN_MODE_Set(PA, 7, GPIO_MODE_OUTPUT);
+    PIN_MODE_Set(PA, 5, GPIO_MODE_OUTPUT);
+    PIN_MODE_Set(PA, 6, GPIO_MODE_OPEN_DRAIN);
+}
+
+/** Disable JTAG/SWD I/O Pins.
+Disables the DAP Hardware I/O pins which configures:
+ - TCK/SWCLK, TMS/SWDIO, TDI, TDO, nTRST, nRESET to High-Z mode.
+*/
+static __inline void PORT_OFF(void)
+{
+    SYS->GPA_MFPL &= ~(SYS_GPA_MFPL_PA5MFP_Msk | SYS_GPA_MFPL_PA7MFP_Msk);
+    PIN_MODE_Set(PA, 7, GPIO_MODE_INPUT);
+    PIN_MODE_Set(PA, 5, GPIO_MODE_INPUT);
+    PIN_MODE_Set(PA, 6, GPIO_MODE_INPUT);
+}
+
+
+// SWCLK/TCK I/O pin -------------------------------------
+
+/** SWCLK/TCK I/O pin: Get Input.
+\return Current status of the SWCLK/TCK DAP hardware I/O pin.
+*/
+static __forceinline uint32_t PIN_SWCLK_TCK_IN(void)
+{
+    return (PA7);
+}
+
+/** SWCLK/TCK I/O pin: Set Output to High.
+Set the SWCLK/TCK DAP hardware I/O pin to high level.
+*/
+static __forceinline void     PIN_SWCLK_TCK_SET(void)
+{
+    PA7 = 1;
+}
+
+/** SWCLK/TCK I/O pin: Set Output to Low.
+Set the SWCLK/TCK DAP hardware I/O pin to low level.
+*/
+static __forceinline void     PIN_SWCLK_TCK_CLR(void)
+{
+    PA7 = 0;
+}
+
+
+// SWDIO/TMS Pin I/O --------------------------------------
+
+/** SWDIO/TMS I/O pin: Get Input.
+\return Current status of the SWDIO/TMS DAP hardware I/O pin.
+*/
+static __forceinline uint32_t PIN_SWDIO_TMS_IN(void)
+{
+    return (PA5);
+}
+
+/** SWDIO/TMS I/O pin: Set Output to High.
+Set the SWDIO/TMS DAP hardware I/O pin to high level.
+*/
+static __forceinline void     PIN_SWDIO_TMS_SET(void)
+{
+    PA5 = 1;
+}
+
+/** SWDIO/TMS I/O pin: Set Output to Low.
+Set the SWDIO/TMS DAP hardware I/O pin to low level.
+*/
+static __forceinline void     PIN_SWDIO_TMS_CLR(void)
+{
+    PA5 = 0;
+}
+
+/** SWDIO I/O pin: Get Input (used in SWD mode only).
+\return Current status of the SWDIO DAP hardware I/O pin.
+*/
+static __forceinline uint32_t PIN_SWDIO_IN(void)
+{
+    return (PA5);
+}
+
+/** SWDIO I/O pin: Set Output (used in SWD mode only).
+\param bit Output value for the SWDIO DAP hardware I/O pin.
+*/
+static __forceinline void     PIN_SWDIO_OUT(uint32_t bit)
+{
+    PA5 = bit & 1U;
+}
+
+/** SWDIO I/O pin: Switch to Output mode (used in SWD mode only).
+Configure the SWDIO DAP hardware I/O pin to output mode. This function is
+called prior \ref PIN_SWDIO_OUT function calls.
+*/
+static __forceinline void     PIN_SWDIO_OUT_ENABLE(void)
+{
+    PIN_MODE_Set(PA, 5, GPIO_MODE_OUTPUT);
+}
+
+/** SWDIO I/O pin: Switch to Input mode (used in SWD mode only).
+Configure the SWDIO DAP hardware I/O pin to input mode. This function is
+called prior \ref PIN_SWDIO_IN function calls.
+*/
+static __forceinline void     PIN_SWDIO_OUT_DISABLE(void)
+{
+    PIN_MODE_Set(PA, 5, GPIO_MODE_INPUT);
+}
+
+
+// SWD data phase by SPI1 ----------------------------------
+
+/** SWD data phase: Write WDATA[0:31] (used in SWD fast clock mode only).
+SWCLK and SWDIO are handed to SPI1 for 32 clocks and returned to GPIO afterwards.
+SPI1 idles SWCLK high and drives SWDIO on the falling edge, so the target samples on
+the rising edge exactly as with \ref PIN_SWDIO_OUT.
+\param data 32-bit data word, sent LSB first.
+*/
+static __forceinline void     PIN_SWD_DATA_WRITE(uint32_t data)
+{
+    SPI1->CTL |= SPI_CTL_DATDIR_Msk;
+    SYS->GPA_MFPL |= (SYS_GPA_MFPL_PA5MFP_SPI1_MOSI | SYS_GPA_MFPL_PA7MFP_SPI1_CLK);
+    SPI1->TX = data;
+    while(SPI1->STATUS & SPI_STATUS_BUSY_Msk);
+    SYS->GPA_MFPL &= ~(SYS_GPA_MFPL_PA5MFP_Msk | SYS_GPA_MFPL_PA7MFP_Msk);
+}
+
+/** SWD data phase: Read RDATA[0:31] (used in SWD fast clock mode only).
+SWDIO must be in input mode. SPI1 generates 32 clocks and samples SWDIO on the falling
+edge, after the target has driven the bit on the preceding rising edge.
+\return 32-bit data word, received LSB first.
+*/
+static __forceinline uint32_t PIN_SWD_DATA_READ(void)
+{
+    SPI1->CTL &= ~SPI_CTL_DATDIR_Msk;
+    SPI1->FIFOCTL |= SPI_FIFOCTL_RXRST_Msk;
+    while(SPI1->STATUS & SPI_STATUS_TXRXRST_Msk);
+    SYS->GPA_MFPL |= (SYS_GPA_MFPL_PA5MFP_SPI1_MOSI | SYS_GPA_MFPL_PA7MFP_SPI1_CLK);
+    SPI1->TX = 0U;
+    while(SPI1->STATUS & SPI_STATUS_BUSY_Msk);
+    SYS->GPA_MFPL &= ~(SYS_GPA_MFPL_PA5MFP_Msk | SYS_GPA_MFPL_PA7MFP_Msk);
+    return (SPI1->RX);
+}
+
+
+// TDI Pin I/O ---------------------------------------------
+
+/** TDI I/O pin: Get Input.
+\return Current status of the TDI DAP hardware I/O pin.
+*/
+static __forceinline uint32_t PIN_TDI_IN(void)
+{
+    return (0U);
+}
+
+/** TDI I/O pin: Set Output.
+\param bit Output value for the TDI DAP hardware I/O pin.
+*/
+static __forceinline void     PIN_TDI_OUT(uint32_t bit)
+{
+    ;
+}
+
+
+// TDO Pin I/O ---------------------------------------------
+
+/** TDO I/O pin: Get Input.
+\return Current status of the TDO DAP hardware I/O pin.
+*/
+static __forceinline uint32_t PIN_TDO_IN(void)
+{
+    return (0U);
+}
+
+
+// nTRST Pin I/O -------------------------------------------
+
+/** nTRST I/O pin: Get Input.
+\return Current status of the nTRST DAP hardware I/O pin.
+*/
+static __forceinline uint32_t PIN_nTRST_IN(void)
+{
+    return (0U);
+}
+
+/** nTRST I/O pin: Set Output.
+\param bit JTAG TRST Test Reset pin status:
+           - 0: issue a JTAG TRST Test Reset.
+           - 1: release JTAG TRST Test Reset.
+*/
+static __forceinline void     PIN_nTRST_OUT(uint32_t bit)
+{
+    ;
+}
+
+// nRESET Pin I/O------------------------------------------
+
+/** nRESET I/O pin: Get Input.
+\return Current status of the nRESET DAP hardware I/O pin.
+*/
+static __forceinline uint32_t PIN_nRESET_IN(void)
+{
+    return (PA6);
+}
+
+/** nRESET I/O pin: Set Output.
+\param bit target device hardware reset pin status:
+           - 0: issue a device hardware reset.
+           - 1: release device hardware reset.
+*/
+static __forceinline void     PIN_nRESET_OUT(uint32_t bit)
+{
+    PA6 = bit & 1U;
+}
+
+///@}
+
+
+//**************************************************************************************************
+/**
+\defgroup DAP_Config_LEDs_gr CMSIS-DAP Hardware Status LEDs
+\ingroup DAP_ConfigIO_gr
+@{
+
+CMSIS-DAP Hardware may provide LEDs that indicate the status of the CMSIS-DAP Debug Unit.
+
+It is recommended to provide the following LEDs for status indication:
+ - Connect LED: is active when the DAP hardware is connected to a debugger.
+ - Running LED: is active when the debugger has put the target device into running state.
+*/
+
+/** Debug Unit: Set status of Connected LED.
+\param bit status of the Connect LED.
+           - 1: Connect LED ON: debugger is connected to CMSIS-DAP Debug Unit.
+           - 0: Connect LED OFF: debugger is not connected to CMSIS-DAP Debug Unit.
+*/
+static __inline void LED_CONNECTED_OUT(uint32_t bit)
+{
+    PB0 = ~bit & 1U;
+}
+
+/** Debug Unit: Set status Target Running LED.
+\param bit status of the Target Running LED.
+           - 1: Target Running LED ON: program execution in target started.
+           - 0: Target Running LED OFF: program execution in target stopped.
+*/
+static __inline void LED_RUNNING_OUT(uint32_t bit)
+{
+    PB1 = ~bit & 1U;
+}
+
+///@}
+
+
+//**************************************************************************************************
+/**
+\defgroup DAP_Config_Initialization_gr CMSIS-DAP Initialization
+\ingroup DAP_ConfigIO_gr
+@{
+
+CMSIS-DAP Hardware I/O and LED Pins are initialized with the function \ref DAP_SETUP.
+*/
+
+/** Setup of the Debug Unit I/O pins and LEDs (called when Debug Unit is initialized).
+This function performs the initialization of the CMSIS-DAP Hardware I/O Pins and the
+Status LEDs. In detail the operation of Hardware I/O and LED pins are enabled and set:
+ - I/O clock system enabled.
+ - all I/O pins: input buffer enabled, output pins are set to HighZ mode.
+ - for nTRST, nRESET a weak pull-up (if available) is enabled.
+ - LED output pins are enabled and LEDs are turned off.
+*/
+static __inline void DAP_SETUP(void)
+{
+    /* SWCLK, SWDIO and nRESET are GPIO inputs until a debugger connects */
+    SYS->GPA_MFPL &= ~(SYS_GPA_MFPL_PA5MFP_Msk | SYS_GPA_MFPL_PA6MFP_Msk | SYS_GPA_MFPL_PA7MFP_Msk);
+    PIN_MODE_Set(PA, 7, GPIO_MODE_INPUT);
+    PIN_MODE_Set(PA, 5, GPIO_MODE_INPUT);
+    PIN_MODE_Set(PA, 6, GPIO_MODE_INPUT);
+
+    /* LEDs are active low */
+    SYS->GPB_MFPL &= ~(SYS_GPB_MFPL_PB0MFP_Msk | SYS_GPB_MFPL_PB1MFP_Msk);
+    PB0 = 1;
+    PB1 = 1;
+    PIN_MODE_Set(PB, 0, GPIO_MODE_OUTPUT);
+    PIN_MODE_Set(PB, 1, GPIO_MODE_OUTPUT);
+
+#if (SWD_DATA_HW != 0)
+    /* SPI1 master, 32-bit, LSB first, half-duplex on SPI1_MOSI.
+       SWCLK idles high: data is driven and sampled on the falling edge. */
+    CLK->CLKSEL2 = (CLK->CLKSEL2 & ~CLK_CLKSEL2_SPI1SEL_Msk) | CLK_CLKSEL2_SPI1SEL_PCLK0;
+    CLK->APBCLK0 |= CLK_APBCLK0_SPI1CKEN_Msk;
+    SPI1->CTL = 0U;
+    SPI1->CLKDIV = (CPU_CLOCK + SWD_DATA_HW_CLOCK - 1U) / SWD_DATA_HW_CLOCK - 1U;
+    SPI1->SSCTL = 0U;
+    SPI1->CTL = SPI_CTL_CLKPOL_Msk | SPI_CTL_TXNEG_Msk | SPI_CTL_RXNEG_Msk | SPI_CTL_LSB_Msk |
+                SPI_CTL_HALFDPX_Msk | (0U << SPI_CTL_DWIDTH_Pos) | SPI_CTL_SPIEN_Msk;
+#endif
+}
+
+/** Reset Target Device with custom specific I/O pin or command sequence.
+This function allows the optional implementation of a device specific reset sequence.
+It is called when the command \ref DAP_ResetTarget and is for example required
+when a device needs a time-critical unlock sequence that enables the debug port.
+\return 0 = no device specific reset sequence is implemented.\n
+        1 = a device specific reset sequence is implemented.
+*/
+static __inline uint8_t RESET_TARGET(void)
+{
+    return (0U);             // change to '1' when a device reset sequence is implemented
+}
+
+///@}
+
+
+#endif /* __DAP_CONFIG_H__ */
@@ -0,0 +1,292 @@
+/******************************************************************************
+ * @file     UART.c
+ * @brief    NUC1261 series CMSIS-Driver USART for CMSIS-DAP SWO capture
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "NUC1261.h"
+#include "Driver_USART.h"
+
+/*
+    Driver_USART0 is a receive only driver on UART0 RXD (PA.3) for SWO.c.
+    Receive() moves data from UART0 RX FIFO to the trace buffer by PDMA with one request per byte,
+    so SWO capture does not take an interrupt per byte and GetRxCount() reads the PDMA progress
+    without waiting for RX time-out. Data received while no Receive() is pending is dropped and
+    reported as ARM_USART_EVENT_RX_OVERFLOW.
+    The bulk receive is a PDMA job, so the application must call PDMA_JobOpen() and
+    PDMA_JobIRQHandler() in PDMA_IRQHandler().
+    The callback is RAMFUNC. PDMA_JobIRQHandler and UART_AsyncIRQHandler run from SRAM too when pdma.o
+    and uart.o are placed in the SRAM region of the linker script.
+*/
+
+#define ARM_USART_DRV_VERSION   ARM_DRIVER_VERSION_MAJOR_MINOR(1, 0)
+
+static const ARM_DRIVER_VERSION DriverVersion =
+{
+    ARM_USART_API_VERSION,
+    ARM_USART_DRV_VERSION
+};
+
+static const ARM_USART_CAPABILITIES DriverCapabilities =
+{
+    1   /* supports UART (Asynchronous) mode */
+};
+
+static S_UART_ASYNC_T s_sUsart0;                /* UART0 asynchronous context */
+static uint8_t s_au8RxRing[16];                 /* Catches data received while no Receive() is pending */
+static uint8_t s_au8TxRing[4];                  /* Unused, send is not supported */
+static ARM_USART_SignalEvent_t s_pfnSignalEvent = NULL;
+static uint32_t s_u32RxNum = 0;                 /* Byte count of current Receive() */
+static volatile uint32_t s_u32RxCnt = 0;        /* Byte count of last completed or aborted Receive() */
+static volatile uint8_t s_u8RxBusy = 0;         /* Receive() is in progress */
+static volatile uint8_t s_u8RxOverflow = 0;     /* Overflow since last Receive() */
+static volatile uint8_t s_u8RxLineErr = 0;      /* Frame, parity or break error since last Receive() */
+static uint8_t s_u8Powered = 0;
+
+
+/// @cond HIDDEN_SYMBOLS
+static RAMFUNC void USART0_AsyncCallback(S_UART_ASYNC_T *psAsync, uint32_t u32Event)
+{
+    uint32_t u32Signal = 0;
+
+    if(u32Event & UART_ASYNC_EVT_RX_DONE)
+    {
+        s_u32RxCnt = s_u32RxNum;
+        s_u8RxBusy = 0;
+        u32Signal |= ARM_USART_EVENT_RECEIVE_COMPLETE;
+    }
+
+    if(u32Event & (UART_ASYNC_EVT_RX | UART_ASYNC_EVT_RX_OVERFLOW))
+    {
+        /* No buffer to take the data */
+        psAsync->u32RxTail = psAsync->u32RxHead;
+        s_u8RxOverflow = 1;
+        u32Signal |= ARM_USART_EVENT_RX_OVERFLOW;
+    }
+
+    if(u32Event & UART_ASYNC_EVT_LINE_ERR)
+    {
+        s_u8RxLineErr = 1;
+        u32Signal |= ARM_USART_EVENT_RX_FRAMING_ERROR;
+    }
+
+    if(u32Signal && s_pfnSignalEvent)
+        s_pfnSignalEvent(u32Signal);
+}
+
+static void USART0_AsyncOpen(void)
+{
+    UART_AsyncOpen(&s_sUsart0, UART0, s_au8RxRing, sizeof(s_au8RxRing), s_au8TxRing, sizeof(s_au8TxRing),
+                   USART0_AsyncCallback);
+    UART_AsyncSetPDMA(&s_sUsart0, 0, 1);
+}
+/// @endcond HIDDEN_SYMBOLS
+
+
+static ARM_DRIVER_VERSION USART0_GetVersion(void)
+{
+    return DriverVersion;
+}
+
+static ARM_USART_CAPABILITIES USART0_GetCapabilities(void)
+{
+    return DriverCapabilities;
+}
+
+static int32_t USART0_Initialize(ARM_USART_SignalEvent_t cb_event)
+{
+    s_pfnSignalEvent = cb_event;
+    s_u8RxBusy = 0;
+    s_u32RxCnt = 0;
+    return ARM_DRIVER_OK;
+}
+
+static int32_t USART0_Uninitialize(void)
+{
+    s_pfnSignalEvent = NULL;
+    return ARM_DRIVER_OK;
+}
+
+static int32_t USART0_PowerControl(ARM_POWER_STATE state)
+{
+    switch(state)
+    {
+        case ARM_POWER_FULL:
+            CLK_EnableModuleClock(UART0_MODULE);
+            CLK_EnableModuleClock(PDMA_MODULE);
+
+            /* Set PA.3 multi-function pin for UART0 RXD */
+            SYS->GPA_MFPL = (SYS->GPA_MFPL & ~SYS_GPA_MFPL_PA3MFP_Msk) | SYS_GPA_MFPL_PA3MFP_UART0_RXD;
+
+            /* Receiver is enabled by ARM_USART_CONTROL_RX */
+            UART_Open(UART0, 0);
+            UART0->FIFO |= UART_FIFO_RXOFF_Msk;
+            USART0_AsyncOpen();
+            NVIC_EnableIRQ(UART02_IRQn);
+            s_u8Powered = 1;
+            break;
+
+        case ARM_POWER_OFF:
+            if(!s_u8Powered)
+                break;
+            if(s_u8RxBusy)
+            {
+                UART_AsyncAbortReadPDMA(&s_sUsart0);
+                s_u8RxBusy = 0;
+            }
+            NVIC_DisableIRQ(UART02_IRQn);
+            UART_AsyncClose(&s_sUsart0);
+            SYS->GPA_MFPL &= ~SYS_GPA_MFPL_PA3MFP_Msk;
+            CLK_DisableModuleClock(UART0_MODULE);
+            s_u8Powered = 0;
+            break;
+
+        default:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+    return ARM_DRIVER_OK;
+}
+
+static int32_t USART0_Send(const void *data, uint32_t num)
+{
+    return ARM_DRIVER_ERROR_UNSUPPORTED;
+}
+
+static int32_t USART0_Receive(void *data, uint32_t num)
+{
+    if((data == NULL) || (num == 0) || (num > UART_ASYNC_PDMA_MAX_CNT))
+        return ARM_DRIVER_ERROR_PARAMETER;
+
+    if(!s_u8Powered)
+        return ARM_DRIVER_ERROR;
+
+    if(s_u8RxBusy)
+        return ARM_DRIVER_ERROR_BUSY;
+
+    s_u32RxNum = num;
+    s_u32RxCnt = 0;
+    s_u8RxOverflow = 0;
+    s_u8RxLineErr = 0;
+    s_u8RxBusy = 1;
+    if(UART_AsyncReadPDMA(&s_sUsart0, (uint8_t *)data, num) != 0)
+    {
+        s_u8RxBusy = 0;
+        return ARM_DRIVER_ERROR;
+    }
+    return ARM_DRIVER_OK;
+}
+
+static int32_t USART0_Transfer(const void *data_out, void *data_in, uint32_t num)
+{
+    return ARM_DRIVER_ERROR_UNSUPPORTED;
+}
+
+static uint32_t USART0_GetTxCount(void)
+{
+    return 0;
+}
+
+static uint32_t USART0_GetRxCount(void)
+{
+    uint32_t u32Primask, u32Cnt;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    if(s_u8RxBusy)
+        u32Cnt = UART_AsyncGetReadPDMACount(&s_sUsart0);
+    else
+        u32Cnt = s_u32RxCnt;
+    __set_PRIMASK(u32Primask);
+
+    return u32Cnt;
+}
+
+static int32_t USART0_Control(uint32_t control, uint32_t arg)
+{
+    switch(control & ARM_USART_CONTROL_Msk)
+    {
+        case ARM_USART_MODE_ASYNCHRONOUS:
+            /* 8 data bits, no parity, 1 stop bit and no flow control only */
+            if(control & (ARM_USART_DATA_BITS_Msk | ARM_USART_PARITY_Msk | ARM_USART_STOP_BITS_Msk |
+                          ARM_USART_FLOW_CONTROL_Msk))
+                return ARM_DRIVER_ERROR_UNSUPPORTED;
+            if(!s_u8Powered || s_u8RxBusy || (arg == 0))
+                return ARM_DRIVER_ERROR;
+
+            /* UART_Open() resets FIFO trigger level, open asynchronous transfer again */
+            UART_Open(UART0, arg);
+            USART0_AsyncOpen();
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_CONTROL_RX:
+            if(arg)
+                UART0->FIFO &= ~UART_FIFO_RXOFF_Msk;
+            else
+                UART0->FIFO |= UART_FIFO_RXOFF_Msk;
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_ABORT_RECEIVE:
+            if(s_u8RxBusy)
+            {
+                s_u32RxCnt = UART_AsyncAbortReadPDMA(&s_sUsart0);
+                s_u8RxBusy = 0;
+            }
+            return ARM_DRIVER_OK;
+
+        case ARM_USART_CONTROL_TX:
+        case ARM_USART_ABORT_SEND:
+            return ARM_DRIVER_OK;
+
+        default:
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+}
+
+static ARM_USART_STATUS USART0_GetStatus(void)
+{
+    ARM_USART_STATUS sStatus = {0};
+
+    sStatus.rx_busy = s_u8RxBusy;
+    sStatus.rx_overflow = s_u8RxOverflow;
+    sStatus.rx_framing_error = s_u8RxLineErr;
+
+    return sStatus;
+}
+
+static int32_t USART0_SetModemControl(ARM_USART_MODEM_CONTROL control)
+{
+    return ARM_DRIVER_ERROR_UNSUPPORTED;
+}
+
+static ARM_USART_MODEM_STATUS USART0_GetModemStatus(void)
+{
+    ARM_USART_MODEM_STATUS sStatus = {0};
+
+    return sStatus;
+}
+
+void UART02_IRQHandler(void)
+{
+    UART_AsyncIRQHandler(&s_sUsart0);
+}
+
+ARM_DRIVER_USART Driver_USART0 =
+{
+    USART0_GetVersion,
+    USART0_GetCapabilities,
+    USART0_Initialize,
+    USART0_Uninitialize,
+    USART0_PowerControl,
+    USART0_Send,
+    USART0_Receive,
+    USART0_Transfer,
+    USART0_GetTxCount,
+    USART0_GetRxCount,
+    USART0_Control,
+    USART0_GetStatus,
+    USART0_SetModemControl,
+    USART0_GetModemStatus
+};
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
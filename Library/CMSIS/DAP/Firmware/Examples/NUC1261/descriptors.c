@@ -0,0 +1,211 @@
+/******************************************************************************
+ * @file     descriptors.c
+ * @brief    NUC1261 series USBD CMSIS-DAP descriptor
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+/*!<Includes */
+#include "NUC1261.h"
+#include "DAP_config.h"
+#include "hid_dap.h"
+
+/*!<USB HID Report Descriptor */
+const uint8_t HID_DeviceReportDescriptor[] =
+{
+    0x06, 0x00, 0xFF,   // USAGE_PAGE (Vendor Defined Page 1)
+    0x09, 0x01,         // USAGE (Vendor Usage 1)
+    0xA1, 0x01,         // COLLECTION (Application)
+    0x15, 0x00,         //     LOGICAL_MINIMUM (0)
+    0x26, 0xFF, 0x00,   //     LOGICAL_MAXIMUM (255)
+    0x75, 0x08,         //     REPORT_SIZE (8)
+    0x95, DAP_PACKET_SIZE,  //     REPORT_COUNT (DAP_PACKET_SIZE)
+    0x09, 0x01,         //     USAGE (Vendor Usage 1)
+    0x81, 0x02,         //     INPUT (Data,Var,Abs)
+    0x95, DAP_PACKET_SIZE,  //     REPORT_COUNT (DAP_PACKET_SIZE)
+    0x09, 0x01,         //     USAGE (Vendor Usage 1)
+    0x91, 0x02,         //     OUTPUT (Data,Var,Abs)
+    0xC0                // END_COLLECTION
+};
+
+
+/*----------------------------------------------------------------------------*/
+/*!<USB Device Descriptor */
+const uint8_t gu8DeviceDescriptor[] =
+{
+    LEN_DEVICE,     /* bLength */
+    DESC_DEVICE,    /* bDescriptorType */
+    0x10, 0x01,     /* bcdUSB */
+    0x00,           /* bDeviceClass */
+    0x00,           /* bDeviceSubClass */
+    0x00,           /* bDeviceProtocol */
+    EP0_MAX_PKT_SIZE,   /* bMaxPacketSize0 */
+    /* idVendor */
+    USBD_VID & 0x00FF,
+    (USBD_VID & 0xFF00) >> 8,
+    /* idProduct */
+    USBD_PID & 0x00FF,
+    (USBD_PID & 0xFF00) >> 8,
+    0x00, 0x00,     /* bcdDevice */
+    0x01,           /* iManufacture */
+    0x02,           /* iProduct */
+    0x03,           /* iSerialNumber */
+    0x01            /* bNumConfigurations */
+};
+
+/*!<USB Configure Descriptor */
+const uint8_t gu8ConfigDescriptor[] =
+{
+    LEN_CONFIG,     /* bLength */
+    DESC_CONFIG,    /* bDescriptorType */
+    /* wTotalLength */
+    LEN_CONFIG_AND_SUBORDINATE & 0x00FF,
+    (LEN_CONFIG_AND_SUBORDINATE & 0xFF00) >> 8,
+#if (SWO_STREAM != 0)
+    0x02,           /* bNumInterfaces */
+#else
+    0x01,           /* bNumInterfaces */
+#endif
+    0x01,           /* bConfigurationValue */
+    0x00,           /* iConfiguration */
+    0x80 | (USBD_SELF_POWERED << 6) | (USBD_REMOTE_WAKEUP << 5),/* bmAttributes */
+    USBD_MAX_POWER,         /* MaxPower */
+
+    /* I/F descr: HID */
+    LEN_INTERFACE,  /* bLength */
+    DESC_INTERFACE, /* bDescriptorType */
+    0x00,           /* bInterfaceNumber */
+    0x00,           /* bAlternateSetting */
+    0x02,           /* bNumEndpoints */
+    0x03,           /* bInterfaceClass */
+    0x00,           /* bInterfaceSubClass */
+    0x00,           /* bInterfaceProtocol */
+    0x00,           /* iInterface */
+
+    /* HID Descriptor */
+    LEN_HID,        /* Size of this descriptor in UINT8s. */
+    DESC_HID,       /* HID descriptor type. */
+    0x10, 0x01,     /* HID Class Spec. release number. */
+    0x00,           /* H/W target country. */
+    0x01,           /* Number of HID class descriptors to follow. */
+    DESC_HID_RPT,   /* Descriptor type. */
+    /* Total length of report descriptor. */
+    sizeof(HID_DeviceReportDescriptor) & 0x00FF,
+    (sizeof(HID_DeviceReportDescriptor) & 0xFF00) >> 8,
+
+    /* EP Descriptor: interrupt in. */
+    LEN_ENDPOINT,   /* bLength */
+    DESC_ENDPOINT,  /* bDescriptorType */
+    (INT_IN_EP_NUM | EP_INPUT), /* bEndpointAddress */
+    EP_INT,         /* bmAttributes */
+    /* wMaxPacketSize */
+    EP2_MAX_PKT_SIZE & 0x00FF,
+    (EP2_MAX_PKT_SIZE & 0xFF00) >> 8,
+    HID_DEFAULT_INT_IN_INTERVAL,        /* bInterval */
+
+    /* EP Descriptor: interrupt out. */
+    LEN_ENDPOINT,   /* bLength */
+    DESC_ENDPOINT,  /* bDescriptorType */
+    (INT_OUT_EP_NUM | EP_OUTPUT),   /* bEndpointAddress */
+    EP_INT,         /* bmAttributes */
+    /* wMaxPacketSize */
+    EP3_MAX_PKT_SIZE & 0x00FF,
+    (EP3_MAX_PKT_SIZE & 0xFF00) >> 8,
+    HID_DEFAULT_INT_IN_INTERVAL,    /* bInterval */
+
+#if (SWO_STREAM != 0)
+    /* I/F descr: SWO trace stream */
+    LEN_INTERFACE,  /* bLength */
+    DESC_INTERFACE, /* bDescriptorType */
+    0x01,           /* bInterfaceNumber */
+    0x00,           /* bAlternateSetting */
+    0x01,           /* bNumEndpoints */
+    0xFF,           /* bInterfaceClass */
+    0x00,           /* bInterfaceSubClass */
+    0x00,           /* bInterfaceProtocol */
+    0x00,           /* iInterface */
+
+    /* EP Descriptor: bulk in. */
+    LEN_ENDPOINT,   /* bLength */
+    DESC_ENDPOINT,  /* bDescriptorType */
+    (SWO_IN_EP_NUM | EP_INPUT), /* bEndpointAddress */
+    EP_BULK,        /* bmAttributes */
+    /* wMaxPacketSize */
+    EP4_MAX_PKT_SIZE & 0x00FF,
+    (EP4_MAX_PKT_SIZE & 0xFF00) >> 8,
+    0x00,           /* bInterval */
+#endif
+};
+
+/*!<USB Language String Descriptor */
+const uint8_t gu8StringLang[4] =
+{
+    4,              /* bLength */
+    DESC_STRING,    /* bDescriptorType */
+    0x09, 0x04
+};
+
+/*!<USB Vendor String Descriptor */
+const uint8_t gu8VendorStringDesc[] =
+{
+    16,
+    DESC_STRING,
+    'N', 0, 'u', 0, 'v', 0, 'o', 0, 't', 0, 'o', 0, 'n', 0
+};
+
+/*!<USB Product String Descriptor */
+const uint8_t gu8ProductStringDesc[] =
+{
+    36,             /* bLength          */
+    DESC_STRING,    /* bDescriptorType  */
+    'N', 0, 'u', 0, 'M', 0, 'i', 0, 'c', 0, 'r', 0, 'o', 0, ' ', 0,
+    'C', 0, 'M', 0, 'S', 0, 'I', 0, 'S', 0, '-', 0, 'D', 0, 'A', 0, 'P', 0
+};
+
+
+
+const uint8_t gu8StringSerial[26] =
+{
+    26,             // bLength
+    DESC_STRING,    // bDescriptorType
+    'A', 0, '0', 0, '2', 0, '0', 0, '1', 0, '4', 0, '0', 0, '9', 0, '0', 0, '3', 0, '0', 0, '4', 0
+};
+
+const uint8_t *gpu8UsbString[4] =
+{
+    gu8StringLang,
+    gu8VendorStringDesc,
+    gu8ProductStringDesc,
+    gu8StringSerial
+};
+
+const uint8_t *gpu8UsbHidReport[2] =
+{
+    HID_DeviceReportDescriptor,
+    NULL
+};
+
+const uint32_t gu32UsbHidReportLen[2] =
+{
+    sizeof(HID_DeviceReportDescriptor),
+    0
+};
+
+const uint32_t gu32ConfigHidDescIdx[2] =
+{
+    (LEN_CONFIG + LEN_INTERFACE),
+    0
+};
+
+const S_USBD_INFO_T gsInfo =
+{
+    gu8DeviceDescriptor,
+    gu8ConfigDescriptor,
+    gpu8UsbString,
+    gpu8UsbHidReport,
+    gu32UsbHidReportLen,
+    gu32ConfigHidDescIdx
+};
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
+
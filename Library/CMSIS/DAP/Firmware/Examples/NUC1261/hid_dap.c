@@ -0,0 +1,429 @@
+/******************************************************************************
+ * @file     hid_dap.c
+ * @brief    NUC1261 series USBD HID CMSIS-DAP transport
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+
+/*!<Includes */
+#include <string.h>
+#include "NUC1261.h"
+#include "DAP_config.h"
+#include "DAP.h"
+#include "hid_dap.h"
+
+#if (DAP_PACKET_COUNT & (DAP_PACKET_COUNT - 1U))
+#error "DAP_PACKET_COUNT must be a power of 2"
+#endif
+
+/*
+    DAP requests and responses are kept in two rings of DAP_PACKET_COUNT packets.
+    The USB interrupt fills the request ring from the interrupt OUT endpoint and drains the
+    response ring to the interrupt IN endpoint, so the host can send the next requests and
+    read earlier responses while HID_DAP_Process() executes a command.
+    The interrupt OUT endpoint is left NAKing while the request ring is full.
+    The counters are free running and the ring index is the counter modulo DAP_PACKET_COUNT.
+    The interrupt path is RAMFUNC, so it does not wait for flash while DAP commands run from flash.
+*/
+#define DAP_PACKET_MASK     (DAP_PACKET_COUNT - 1U)
+
+static uint32_t s_au32Request[DAP_PACKET_COUNT][DAP_PACKET_SIZE / 4];   /* Request ring */
+static uint32_t s_au32Response[DAP_PACKET_COUNT][DAP_PACKET_SIZE / 4];  /* Response ring */
+static volatile uint32_t s_u32RequestIn = 0;    /* Number of requests received */
+static volatile uint32_t s_u32RequestOut = 0;   /* Number of requests executed */
+static volatile uint32_t s_u32ResponseIn = 0;   /* Number of responses prepared */
+static volatile uint32_t s_u32ResponseOut = 0;  /* Number of responses sent */
+static volatile uint8_t s_u8InIdle = 1;         /* No response is pending on interrupt IN endpoint */
+static volatile uint8_t s_u8OutHold = 0;        /* Interrupt OUT endpoint is not armed as request ring is full */
+static volatile uint8_t s_u8SwoIdle = 1;        /* No trace data is pending on SWO bulk IN endpoint */
+
+/// @cond HIDDEN_SYMBOLS
+static RAMFUNC void HID_DAP_ArmOut(void)
+{
+    if((s_u32RequestIn - s_u32RequestOut) < DAP_PACKET_COUNT)
+    {
+        s_u8OutHold = 0;
+        USBD_SET_PAYLOAD_LEN(EP3, EP3_MAX_PKT_SIZE);
+    }
+    else
+    {
+        s_u8OutHold = 1;
+    }
+}
+
+static RAMFUNC void HID_DAP_SendResponse(void)
+{
+    if(s_u8InIdle && (s_u32ResponseIn != s_u32ResponseOut))
+    {
+        USBD_MemCopy((uint8_t *)(USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(EP2)),
+                     (uint8_t *)s_au32Response[s_u32ResponseOut & DAP_PACKET_MASK], DAP_PACKET_SIZE);
+        USBD_SET_PAYLOAD_LEN(EP2, DAP_PACKET_SIZE);
+        s_u32ResponseOut++;
+        s_u8InIdle = 0;
+    }
+}
+/// @endcond HIDDEN_SYMBOLS
+
+RAMFUNC void USBD_IRQHandler(void)
+{
+    uint32_t u32IntSts = USBD_GET_INT_FLAG();
+    uint32_t u32State = USBD_GET_BUS_STATE();
+
+//------------------------------------------------------------------
+    if(u32IntSts & USBD_INTSTS_FLDET)
+    {
+        // Floating detect
+        USBD_CLR_INT_FLAG(USBD_INTSTS_FLDET);
+
+        if(USBD_IS_ATTACHED())
+        {
+            /* USB Plug In */
+            USBD_ENABLE_USB();
+        }
+        else
+        {
+            /* USB Un-plug */
+            USBD_DISABLE_USB();
+        }
+    }
+
+//------------------------------------------------------------------
+    if(u32IntSts & USBD_INTSTS_WAKEUP)
+    {
+        /* Clear event flag */
+        USBD_CLR_INT_FLAG(USBD_INTSTS_WAKEUP);
+    }
+
+//------------------------------------------------------------------
+    if(u32IntSts & USBD_INTSTS_BUS)
+    {
+        /* Clear event flag */
+        USBD_CLR_INT_FLAG(USBD_INTSTS_BUS);
+
+        if(u32State & USBD_STATE_USBRST)
+        {
+            /* Bus reset */
+            USBD_ENABLE_USB();
+            USBD_SwReset();
+        }
+        if(u32State & USBD_STATE_SUSPEND)
+        {
+            /* Enable USB but disable PHY */
+            USBD_DISABLE_PHY();
+        }
+        if(u32State & USBD_STATE_RESUME)
+        {
+            /* Enable USB and enable PHY */
+            USBD_ENABLE_USB();
+        }
+    }
+
+//------------------------------------------------------------------
+    if(u32IntSts & USBD_INTSTS_USB)
+    {
+        // USB event
+        if(u32IntSts & USBD_INTSTS_SETUP)
+        {
+            // Setup packet
+            /* Clear event flag */
+            USBD_CLR_INT_FLAG(USBD_INTSTS_SETUP);
+
+            /* Clear the data IN/OUT ready flag of control end-points */
+            USBD_STOP_TRANSACTION(EP0);
+            USBD_STOP_TRANSACTION(EP1);
+
+            USBD_ProcessSetupPacket();
+        }
+
+        // EP events
+        if(u32IntSts & USBD_INTSTS_EP0)
+        {
+            /* Clear event flag */
+            USBD_CLR_INT_FLAG(USBD_INTSTS_EP0);
+            // control IN
+            USBD_CtrlIn();
+        }
+
+        if(u32IntSts & USBD_INTSTS_EP1)
+        {
+            /* Clear event flag */
+            USBD_CLR_INT_FLAG(USBD_INTSTS_EP1);
+
+            // control OUT
+            USBD_CtrlOut();
+        }
+
+        if(u32IntSts & USBD_INTSTS_EP2)
+        {
+            /* Clear event flag */
+            USBD_CLR_INT_FLAG(USBD_INTSTS_EP2);
+            // Interrupt IN
+            EP2_Handler();
+        }
+
+        if(u32IntSts & USBD_INTSTS_EP3)
+        {
+            /* Clear event flag */
+            USBD_CLR_INT_FLAG(USBD_INTSTS_EP3);
+            // Interrupt OUT
+            EP3_Handler();
+        }
+
+        if(u32IntSts & USBD_INTSTS_EP4)
+        {
+            /* Clear event flag */
+            USBD_CLR_INT_FLAG(USBD_INTSTS_EP4);
+            // Bulk IN
+            EP4_Handler();
+        }
+
+        if(u32IntSts & USBD_INTSTS_EP5)
+        {
+            /* Clear event flag */
+            USBD_CLR_INT_FLAG(USBD_INTSTS_EP5);
+        }
+
+        if(u32IntSts & USBD_INTSTS_EP6)
+        {
+            /* Clear event flag */
+            USBD_CLR_INT_FLAG(USBD_INTSTS_EP6);
+        }
+
+        if(u32IntSts & USBD_INTSTS_EP7)
+        {
+            /* Clear event flag */
+            USBD_CLR_INT_FLAG(USBD_INTSTS_EP7);
+        }
+    }
+}
+
+RAMFUNC void EP2_Handler(void)  /* Interrupt IN handler */
+{
+    /* Previous response has been read by host, send the next one if it is ready */
+    s_u8InIdle = 1;
+    HID_DAP_SendResponse();
+}
+
+RAMFUNC void EP3_Handler(void)  /* Interrupt OUT handler */
+{
+    uint8_t *pu8Buf;
+    uint32_t u32Len;
+
+    pu8Buf = (uint8_t *)(USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(EP3));
+    u32Len = USBD_GET_PAYLOAD_LEN(EP3);
+
+    if(u32Len)
+    {
+        if(pu8Buf[0] == ID_DAP_TransferAbort)
+        {
+            /* Abort is not queued. It has to stop the transfer being executed. */
+            DAP_TransferAbort = 1U;
+        }
+        else
+        {
+            USBD_MemCopy((uint8_t *)s_au32Request[s_u32RequestIn & DAP_PACKET_MASK], pu8Buf, u32Len);
+            s_u32RequestIn++;
+        }
+    }
+
+    /* Receive next request if there is still a free slot */
+    HID_DAP_ArmOut();
+}
+
+RAMFUNC void EP4_Handler(void)  /* SWO bulk IN handler */
+{
+    /* Trace data has been read by host, HID_SWO_Process() sends the next packet */
+    s_u8SwoIdle = 1;
+}
+
+
+/*--------------------------------------------------------------------------*/
+/**
+  * @brief  USBD Endpoint Config.
+  * @param  None.
+  * @retval None.
+  */
+void HID_Init(void)
+{
+    /* Init setup packet buffer */
+    /* Buffer range for setup packet -> [0 ~ 0x7] */
+    USBD->STBUFSEG = SETUP_BUF_BASE;
+
+    /*****************************************************/
+    /* EP0 ==> control IN endpoint, address 0 */
+    USBD_CONFIG_EP(EP0, USBD_CFG_CSTALL | USBD_CFG_EPMODE_IN | 0);
+    /* Buffer range for EP0 */
+    USBD_SET_EP_BUF_ADDR(EP0, EP0_BUF_BASE);
+
+    /* EP1 ==> control OUT endpoint, address 0 */
+    USBD_CONFIG_EP(EP1, USBD_CFG_CSTALL | USBD_CFG_EPMODE_OUT | 0);
+    /* Buffer range for EP1 */
+    USBD_SET_EP_BUF_ADDR(EP1, EP1_BUF_BASE);
+
+    /*****************************************************/
+    /* EP2 ==> Interrupt IN endpoint, address 1 */
+    USBD_CONFIG_EP(EP2, USBD_CFG_EPMODE_IN | INT_IN_EP_NUM);
+    /* Buffer range for EP2 */
+    USBD_SET_EP_BUF_ADDR(EP2, EP2_BUF_BASE);
+
+    /* EP3 ==> Interrupt OUT endpoint, address 2 */
+    USBD_CONFIG_EP(EP3, USBD_CFG_EPMODE_OUT | INT_OUT_EP_NUM);
+    /* Buffer range for EP3 */
+    USBD_SET_EP_BUF_ADDR(EP3, EP3_BUF_BASE);
+
+#if (SWO_STREAM != 0)
+    /* EP4 ==> Bulk IN endpoint, address 3 */
+    USBD_CONFIG_EP(EP4, USBD_CFG_EPMODE_IN | SWO_IN_EP_NUM);
+    /* Buffer range for EP4 */
+    USBD_SET_EP_BUF_ADDR(EP4, EP4_BUF_BASE);
+    s_u8SwoIdle = 1;
+#endif
+
+    /* Empty request and response rings */
+    s_u32RequestIn = s_u32RequestOut = 0;
+    s_u32ResponseIn = s_u32ResponseOut = 0;
+    s_u8InIdle = 1;
+
+    /* trigger to receive OUT data */
+    HID_DAP_ArmOut();
+}
+
+void HID_ClassRequest(void)
+{
+    uint8_t buf[8];
+
+    USBD_GetSetupPacket(buf);
+
+    if(buf[0] & 0x80)    /* request data transfer direction */
+    {
+        // Device to host
+        switch(buf[1])
+        {
+            case GET_REPORT:
+            case GET_IDLE:
+            case GET_PROTOCOL:
+            default:
+            {
+                /* Setup error, stall the device */
+                USBD_SetStall(0);
+                break;
+            }
+        }
+    }
+    else
+    {
+        // Host to device
+        switch(buf[1])
+        {
+            case SET_REPORT:
+            {
+                if(buf[3] == 3)
+                {
+                    /* Request Type = Feature */
+                    USBD_SET_DATA1(EP1);
+                    USBD_SET_PAYLOAD_LEN(EP1, 0);
+                }
+                break;
+            }
+            case SET_IDLE:
+            {
+                /* Status stage */
+                USBD_SET_DATA1(EP0);
+                USBD_SET_PAYLOAD_LEN(EP0, 0);
+                break;
+            }
+            case SET_PROTOCOL:
+            default:
+            {
+                /* Setup error, stall the device */
+                USBD_SetStall(0);
+                break;
+            }
+        }
+    }
+}
+
+/**
+  * @brief      Execute received DAP requests
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Called from the main loop. Each request in the request ring is executed into a free
+  *             slot of the response ring and the response is queued for the interrupt IN endpoint.
+  *             A DAP_QueueCommands packet is held until the packet closing the queue has arrived
+  *             or the request ring is full, then the queued packets are executed one by one as
+  *             DAP_ExecuteCommands. Execution stops when the response ring is full.
+  */
+void HID_DAP_Process(void)
+{
+    uint32_t u32In, u32Next, u32Primask;
+    uint8_t *pu8Request;
+
+    while(1)
+    {
+        u32In = s_u32RequestIn;
+        if(u32In == s_u32RequestOut)
+            break;
+
+        /* Wait for host to read responses */
+        if((s_u32ResponseIn - s_u32ResponseOut) == DAP_PACKET_COUNT)
+            break;
+
+        /* Hold queued commands until the rest of the queue is received */
+        for(u32Next = s_u32RequestOut; u32Next != u32In; u32Next++)
+        {
+            if(*(uint8_t *)s_au32Request[u32Next & DAP_PACKET_MASK] != ID_DAP_QueueCommands)
+                break;
+        }
+        if((u32Next == u32In) && ((u32In - s_u32RequestOut) < DAP_PACKET_COUNT))
+            break;
+
+        pu8Request = (uint8_t *)s_au32Request[s_u32RequestOut & DAP_PACKET_MASK];
+        if(*pu8Request == ID_DAP_QueueCommands)
+            *pu8Request = ID_DAP_ExecuteCommands;
+
+        DAP_ExecuteCommand(pu8Request, (uint8_t *)s_au32Response[s_u32ResponseIn & DAP_PACKET_MASK]);
+
+        u32Primask = __get_PRIMASK();
+        __disable_irq();
+        s_u32RequestOut++;
+        s_u32ResponseIn++;
+        if(s_u8OutHold)
+            HID_DAP_ArmOut();
+        HID_DAP_SendResponse();
+        __set_PRIMASK(u32Primask);
+    }
+}
+
+/**
+  * @brief      Send captured SWO trace data
+  *
+  * @param      None
+  *
+  * @return     None
+  *
+  * @details    Called from the main loop. When the SWO bulk IN endpoint is idle, up to one packet of
+  *             trace data is moved from the SWO trace buffer to the endpoint buffer. Nothing is sent
+  *             unless the host has selected SWO Transport 2 (streaming to dedicated endpoint).
+  */
+void HID_SWO_Process(void)
+{
+#if (SWO_STREAM != 0)
+    uint32_t u32Len;
+
+    if(!s_u8SwoIdle)
+        return;
+
+    u32Len = SWO_GetStreamData((uint8_t *)(USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(EP4)), EP4_MAX_PKT_SIZE);
+    if(u32Len)
+    {
+        s_u8SwoIdle = 0;
+        USBD_SET_PAYLOAD_LEN(EP4, u32Len);
+    }
+#endif
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * @file     main.c
+ * @brief
+ *           CMSIS-DAP debug unit on NUC1261 with USB HID transport.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "NUC1261.h"
+#include "DAP_config.h"
+#include "DAP.h"
+#include "hid_dap.h"
+
+
+/* Driver_USART0 receives SWO by PDMA jobs */
+RAMFUNC void PDMA_IRQHandler(void)
+{
+    PDMA_JobIRQHandler();
+}
+
+void SYS_Init(void)
+{
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184 MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Enable external XTAL 12 MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HXTEN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HXTSTB_Msk);
+
+    /* Set core clock as CPU_CLOCK */
+    CLK_SetCoreClock(CPU_CLOCK);
+
+    /* Use PLL as USB clock source */
+    CLK_SetModuleClock(USBD_MODULE, CLK_CLKSEL3_USBDSEL_PLL, CLK_CLKDIV0_USB(3));
+
+    /* Enable module clock */
+    CLK_EnableModuleClock(USBD_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
+
+    /* UART0 for SWO capture runs from PLL / 2 (72 MHz), clock is enabled by Driver_USART0 */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_PLL, CLK_CLKDIV0_UART(2));
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Main Function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int32_t main(void)
+{
+    /* Unlock write-protected registers */
+    SYS_UnlockReg();
+
+    /* Init system clock */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* PDMA channel 0 for the jobs of SWO capture */
+    PDMA_JobOpen(1 << 0);
+
+    /* Init debug port I/O and status LEDs */
+    DAP_Setup();
+
+    /* Open USB controller */
+    USBD_Open(&gsInfo, HID_ClassRequest, NULL);
+
+    /* Init Endpoint configuration for HID */
+    HID_Init();
+
+    /* Start USB device */
+    USBD_Start();
+
+    /* Enable USB device interrupt */
+    NVIC_EnableIRQ(USBD_IRQn);
+
+    /* Requests are received and responses sent by USB interrupt, commands are executed here */
+    while(1)
+    {
+        HID_DAP_Process();
+        HID_SWO_Process();
+    }
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
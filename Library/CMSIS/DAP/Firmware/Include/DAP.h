@@ -230,6 +230,7 @@ extern uint32_t SWO_Baudrate(const uint8_t *request, uint8_t *response);
 extern uint32_t SWO_Control(const uint8_t *request, uint8_t *response);
 extern uint32_t SWO_Status(uint8_t *response);
 extern uint32_t SWO_Data(const uint8_t *request, uint8_t *response);
+extern uint32_t SWO_GetStreamData(uint8_t *data, uint32_t num);
 
 extern uint32_t DAP_ProcessVendorCommand(const uint8_t *request, uint8_t *response);
 extern uint32_t DAP_ProcessCommand(const uint8_t *request, uint8_t *response);
@@ -237,6 +238,11 @@ extern uint32_t DAP_ExecuteCommand(const uint8_t *request, uint8_t *response);
 
 extern void     DAP_Setup(void);
 
+// SWO trace streaming to a dedicated endpoint (Transport 2), data is fetched by SWO_GetStreamData
+#ifndef SWO_STREAM
+#define SWO_STREAM              0
+#endif
+
 // Configurable delay for clock generation
 #ifndef DELAY_SLOW_CYCLES
 #define DELAY_SLOW_CYCLES       3U      // Number of cycles for one iteration
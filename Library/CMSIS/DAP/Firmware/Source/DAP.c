@@ -124,7 +124,8 @@ static uint8_t DAP_Info(uint8_t id, uint8_t *info)
                       ((DAP_JTAG != 0)       ? (1U << 1) : 0U) |
                       ((SWO_UART != 0)       ? (1U << 2) : 0U) |
                       ((SWO_MANCHESTER != 0) ? (1U << 3) : 0U) |
-                      /* Atomic Commands  */ (1U << 4);
+                      /* Atomic Commands  */ (1U << 4) |
+                      ((SWO_STREAM != 0)     ? (1U << 6) : 0U);
             length = 1U;
             break;
         case DAP_ID_SWO_BUFFER_SIZE:
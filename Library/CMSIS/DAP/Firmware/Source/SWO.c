@@ -66,6 +66,8 @@ static uint32_t GetTraceSpace(void);
 static uint32_t GetTraceCount(void);
 static uint8_t  GetTraceStatus(void);
 static void     SetTraceError(uint8_t flag);
+static void     UpdateTrace(void);
+static void     ResumeTrace(void);
 
 
 #if (SWO_UART != 0)
@@ -360,6 +362,60 @@ static void SetTraceError(uint8_t flag)
     TraceError[TraceError_n] |= flag;
 }
 
+// Update count of data captured by active transfer
+static void UpdateTrace(void)
+{
+    if(TraceStatus == DAP_SWO_CAPTURE_ACTIVE)
+    {
+        switch(TraceMode)
+        {
+#if (SWO_UART != 0)
+            case DAP_SWO_UART:
+                UART_SWO_Update();
+                break;
+#endif
+#if (SWO_MANCHESTER != 0)
+            case DAP_SWO_MANCHESTER:
+                Manchester_SWO_Update();
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+}
+
+// Resume paused capture when trace buffer has space again
+static void ResumeTrace(void)
+{
+    uint32_t n;
+
+    if(TraceStatus == (DAP_SWO_CAPTURE_ACTIVE | DAP_SWO_CAPTURE_PAUSED))
+    {
+        n = GetTraceSpace();
+        if(n != 0U)
+        {
+            switch(TraceMode)
+            {
+#if (SWO_UART != 0)
+                case DAP_SWO_UART:
+                    UART_SWO_Capture(&TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], n);
+                    TraceStatus = DAP_SWO_CAPTURE_ACTIVE;
+                    break;
+#endif
+#if (SWO_MANCHESTER != 0)
+                case DAP_SWO_MANCHESTER:
+                    Manchester_SWO_Capture(&TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], n);
+                    TraceStatus = DAP_SWO_CAPTURE_ACTIVE;
+                    break;
+#endif
+                default:
+                    break;
+            }
+        }
+    }
+}
+
 
 // Process SWO Transport command and prepare response
 //   request:  pointer to request data
@@ -378,6 +434,9 @@ uint32_t SWO_Transport(const uint8_t *request, uint8_t *response)
         {
             case 0:
             case 1:
+#if (SWO_STREAM != 0)
+            case 2:
+#endif
                 TraceTransport = transport;
                 result = 1U;
                 break;
@@ -584,24 +643,7 @@ uint32_t SWO_Status(uint8_t *response)
     uint8_t  status;
     uint32_t count;
 
-    if(TraceStatus == DAP_SWO_CAPTURE_ACTIVE)
-    {
-        switch(TraceMode)
-        {
-#if (SWO_UART != 0)
-            case DAP_SWO_UART:
-                UART_SWO_Update();
-                break;
-#endif
-#if (SWO_MANCHESTER != 0)
-            case DAP_SWO_MANCHESTER:
-                Manchester_SWO_Update();
-                break;
-#endif
-            default:
-                break;
-        }
-    }
+    UpdateTrace();
 
     status = GetTraceStatus();
     count  = GetTraceCount();
@@ -627,24 +669,7 @@ uint32_t SWO_Data(const uint8_t *request, uint8_t *response)
     uint32_t count;
     uint32_t n;
 
-    if(TraceStatus == DAP_SWO_CAPTURE_ACTIVE)
-    {
-        switch(TraceMode)
-        {
-#if (SWO_UART != 0)
-            case DAP_SWO_UART:
-                UART_SWO_Update();
-                break;
-#endif
-#if (SWO_MANCHESTER != 0)
-            case DAP_SWO_MANCHESTER:
-                Manchester_SWO_Update();
-                break;
-#endif
-            default:
-                break;
-        }
-    }
+    UpdateTrace();
 
     status = GetTraceStatus();
     count  = GetTraceCount();
@@ -672,33 +697,47 @@ uint32_t SWO_Data(const uint8_t *request, uint8_t *response)
         *response++ = TraceBuf[TraceOut++ & (SWO_BUFFER_SIZE - 1U)];
     }
 
-    if(TraceStatus == (DAP_SWO_CAPTURE_ACTIVE | DAP_SWO_CAPTURE_PAUSED))
+    ResumeTrace();
+
+    return ((2U << 16) | (3U + count));
+}
+
+
+#if (SWO_STREAM != 0)
+
+// Get SWO trace data for streaming transport
+//   data:   pointer to buffer for trace data
+//   num:    maximum number of bytes (endpoint packet size)
+//   return: number of bytes copied to buffer
+uint32_t SWO_GetStreamData(uint8_t *data, uint32_t num)
+{
+    uint32_t count;
+    uint32_t n;
+
+    if(TraceTransport != 2U)
     {
-        n = GetTraceSpace();
-        if(n != 0U)
-        {
-            switch(TraceMode)
-            {
-#if (SWO_UART != 0)
-                case DAP_SWO_UART:
-                    UART_SWO_Capture(&TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], n);
-                    TraceStatus = DAP_SWO_CAPTURE_ACTIVE;
-                    break;
-#endif
-#if (SWO_MANCHESTER != 0)
-                case DAP_SWO_MANCHESTER:
-                    Manchester_SWO_Capture(&TraceBuf[TraceIn & (SWO_BUFFER_SIZE - 1U)], n);
-                    TraceStatus = DAP_SWO_CAPTURE_ACTIVE;
-                    break;
-#endif
-                default:
-                    break;
-            }
-        }
+        return (0U);
     }
 
-    return ((2U << 16) | (3U + count));
+    UpdateTrace();
+
+    count = GetTraceCount();
+    if(count > num)
+    {
+        count = num;
+    }
+
+    for(n = count; n; n--)
+    {
+        *data++ = TraceBuf[TraceOut++ & (SWO_BUFFER_SIZE - 1U)];
+    }
+
+    ResumeTrace();
+
+    return (count);
 }
 
+#endif  /* (SWO_STREAM != 0) */
+
 
 #endif  /* ((SWO_UART != 0) || (SWO_MANCHESTER != 0)) */
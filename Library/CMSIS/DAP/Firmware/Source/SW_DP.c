@@ -51,6 +51,50 @@
 
 #define PIN_DELAY() PIN_DELAY_SLOW(DAP_Data.clock_delay)
 
+#define SW_READ_DATA_IO(val, parity)    \
+  val = 0U;                             \
+  parity = 0U;                          \
+  for (n = 32U; n; n--) {               \
+    SW_READ_BIT(bit);                   \
+    parity += bit;                      \
+    val >>= 1;                          \
+    val  |= bit << 31;                  \
+  }
+
+#define SW_WRITE_DATA_IO(val, parity)   \
+  parity = 0U;                          \
+  for (n = 32U; n; n--) {               \
+    SW_WRITE_BIT(val);                  \
+    parity += val;                      \
+    val >>= 1;                          \
+  }
+
+// Optional data phase shifted by a hardware serializer (see DAP_config.h)
+#ifndef SWD_DATA_HW
+#define SWD_DATA_HW             0
+#endif
+
+#if ((DAP_SWD != 0) && (SWD_DATA_HW != 0))
+// Even parity of a 32-bit word (bit 0 of the result)
+static __forceinline uint32_t SW_PARITY(uint32_t val)
+{
+  val ^= val >> 16;
+  val ^= val >> 8;
+  val ^= val >> 4;
+  val ^= val >> 2;
+  val ^= val >> 1;
+  return (val & 1U);
+}
+
+#define SW_READ_DATA_HW(val, parity)    \
+  val = PIN_SWD_DATA_READ();            \
+  parity = SW_PARITY(val)
+
+#define SW_WRITE_DATA_HW(val, parity)   \
+  PIN_SWD_DATA_WRITE(val);              \
+  parity = SW_PARITY(val)
+#endif
+
 
 // Generate SWJ Sequence
 //   count:  sequence bit count
@@ -140,14 +184,7 @@ uint8_t SWD_Transfer##speed (uint32_t request, uint32_t *data) {
     /* Data transfer */                                                         \
     if (request & DAP_TRANSFER_RnW) {                                           \
       /* Read data */                                                           \
-      val = 0U;                                                                 \
-      parity = 0U;                                                              \
-      for (n = 32U; n; n--) {                                                   \
-        SW_READ_BIT(bit);               /* Read RDATA[0:31] */                  \
-        parity += bit;                                                          \
-        val >>= 1;                                                              \
-        val  |= bit << 31;                                                      \
-      }                                                                         \
+      SW_READ_DATA(val, parity);        /* Read RDATA[0:31] */                  \
       SW_READ_BIT(bit);                 /* Read Parity */                       \
       if ((parity ^ bit) & 1U) {                                                \
         ack = DAP_TRANSFER_ERROR;                                               \
@@ -166,12 +203,7 @@ uint8_t SWD_Transfer##speed (uint32_t request, uint32_t *data) {
       PIN_SWDIO_OUT_ENABLE();                                                   \
       /* Write data */                                                          \
       val = *data;                                                              \
-      parity = 0U;                                                              \
-      for (n = 32U; n; n--) {                                                   \
-        SW_WRITE_BIT(val);              /* Write WDATA[0:31] */                 \
-        parity += val;                                                          \
-        val >>= 1;                                                              \
-      }                                                                         \
+      SW_WRITE_DATA(val, parity);       /* Write WDATA[0:31] */                 \
       SW_WRITE_BIT(parity);             /* Write Parity Bit */                  \
     }                                                                           \
     /* Idle cycles */                                                           \
@@ -220,10 +252,21 @@ uint8_t SWD_Transfer##speed (uint32_t request, uint32_t *data) {
 
 #undef  PIN_DELAY
 #define PIN_DELAY() PIN_DELAY_FAST()
+#if (SWD_DATA_HW != 0)
+#define SW_READ_DATA  SW_READ_DATA_HW
+#define SW_WRITE_DATA SW_WRITE_DATA_HW
+#else
+#define SW_READ_DATA  SW_READ_DATA_IO
+#define SW_WRITE_DATA SW_WRITE_DATA_IO
+#endif
 SWD_TransferFunction(Fast);
 
 #undef  PIN_DELAY
 #define PIN_DELAY() PIN_DELAY_SLOW(DAP_Data.clock_delay)
+#undef  SW_READ_DATA
+#undef  SW_WRITE_DATA
+#define SW_READ_DATA  SW_READ_DATA_IO
+#define SW_WRITE_DATA SW_WRITE_DATA_IO
 SWD_TransferFunction(Slow);
 
 
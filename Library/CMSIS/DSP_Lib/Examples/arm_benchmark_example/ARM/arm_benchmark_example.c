@@ -0,0 +1,1003 @@
+/**************************************************************************//**
+ * @file     arm_benchmark_example.c
+ * @version  V1.00
+ * @brief    Benchmark of CMSIS DSP functions built for ARM_MATH_CM0_FAMILY.
+ *
+ * @details  Runs filtering, transform, matrix, statistics and fast math functions of the
+ *           DSP library in q7, q15, q31 and f32 for block sizes of 16, 64 and 256.
+ *           Every output is compared with a double precision reference computed here and
+ *           the signal to error ratio has to reach the limit given for the data type.
+ *
+ *           On NUC1261 the execution time is measured in HCLK cycles by SysTick and the
+ *           result is printed to UART0 (115200-8n1). arm_benchmark_example.uvprojx builds it
+ *           for NUC1261 with the Cortex-M0 DSP library, and Nu-Link loads and runs it.
+ *
+ *           Defining BENCH_HOST builds a host version with the same kernels, using clock()
+ *           to report nanoseconds per call. It returns non-zero if any output check fails,
+ *           for example:
+ *             gcc -O2 -DBENCH_HOST -DARM_MATH_CM0 -I../../../../Include arm_benchmark_example.c
+ *                 <DSP_Lib sources used here> -lm
+ *
+ *           Code and data size of each function are listed in the linker map file.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <math.h>
+#include "arm_math.h"
+
+#ifdef BENCH_HOST
+#include <time.h>
+#else
+#include "NUC1261.h"
+#endif
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Benchmark configuration                                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+#define BENCH_MAX_BLOCK         256     /* Largest block size, also largest FFT length and matrix elements */
+#define BENCH_TAPS              32      /* FIR taps and length of second convolution input */
+#define BENCH_STAGES            2       /* Biquad stages */
+
+#define BENCH_Q7                0
+#define BENCH_Q15               1
+#define BENCH_Q31               2
+#define BENCH_F32               3
+#define BENCH_TYPE_NUM          4
+
+#define BENCH_TYPE_Q7           (1UL << BENCH_Q7)
+#define BENCH_TYPE_Q15          (1UL << BENCH_Q15)
+#define BENCH_TYPE_Q31          (1UL << BENCH_Q31)
+#define BENCH_TYPE_F32          (1UL << BENCH_F32)
+#define BENCH_TYPE_ALL          (BENCH_TYPE_Q7 | BENCH_TYPE_Q15 | BENCH_TYPE_Q31 | BENCH_TYPE_F32)
+#define BENCH_TYPE_FIXED        (BENCH_TYPE_Q15 | BENCH_TYPE_Q31)
+
+#ifdef BENCH_HOST
+#define BENCH_LOOPS             10000
+#define BENCH_UNIT              "ns/call"
+/* Repeat the call to get a resolution of clock() and report the time of one call in ns */
+#define BENCH_MEASURE(u32Time, call)                                                    \
+    do {                                                                                \
+        uint32_t u32Loop;                                                               \
+        clock_t tStart = clock();                                                       \
+        for(u32Loop = 0; u32Loop < BENCH_LOOPS; u32Loop++) { call; }                    \
+        u32Time = (uint32_t)((double)(clock() - tStart) * 1e9 / CLOCKS_PER_SEC / BENCH_LOOPS); \
+    } while(0)
+#else
+#define BENCH_UNIT              "cycles"
+/* SysTick counts down HCLK cycles from 0xFFFFFF, one measurement must be shorter than 2^24 cycles */
+#define BENCH_MEASURE(u32Time, call)                                                    \
+    do {                                                                                \
+        uint32_t u32Start, u32End;                                                      \
+        u32Start = SysTick->VAL;                                                        \
+        call;                                                                           \
+        u32End = SysTick->VAL;                                                          \
+        u32Time = ((u32Start - u32End) & SysTick_LOAD_RELOAD_Msk) - s_u32Overhead;     \
+    } while(0)
+#endif
+
+typedef struct
+{
+    const char *pcName;                                     /* Function name without data type */
+    uint32_t u32Types;                                      /* Data types to run, BENCH_TYPE_xxx */
+    int32_t ai32MinSnr[BENCH_TYPE_NUM];                     /* Minimum signal to error ratio in dB */
+    uint32_t (*pfnRef)(uint32_t u32Type, uint32_t u32N);    /* Fill s_af32Ref and return output length */
+    void (*pfnInit)(uint32_t u32Type, uint32_t u32N);       /* Prepare inputs and instance */
+    void (*pfnRun)(uint32_t u32Type, uint32_t u32N);        /* Function being measured */
+} S_BENCH_T;
+
+typedef union
+{
+    q7_t      q7[2 * BENCH_MAX_BLOCK];
+    q15_t     q15[2 * BENCH_MAX_BLOCK];
+    q31_t     q31[2 * BENCH_MAX_BLOCK];
+    float32_t f32[2 * BENCH_MAX_BLOCK];
+} U_BENCH_BUF_T;
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static const char *s_apcTypeName[BENCH_TYPE_NUM] = {"q7", "q15", "q31", "f32"};
+static const uint32_t s_au32BlockSize[] = {16, 64, 256};
+
+static float32_t s_af32Src[2 * BENCH_MAX_BLOCK];    /* Input signal in [-0.5, 0.5) */
+static float32_t s_af32Coef[BENCH_TAPS];            /* FIR taps and second convolution input */
+static float32_t s_af32Ref[2 * BENCH_MAX_BLOCK];    /* Reference output */
+static U_BENCH_BUF_T s_uInA, s_uInB, s_uOut;
+static union
+{
+    q7_t      q7[BENCH_TAPS + BENCH_MAX_BLOCK];
+    q15_t     q15[BENCH_TAPS + BENCH_MAX_BLOCK];
+    q31_t     q31[BENCH_TAPS + BENCH_MAX_BLOCK];
+    float32_t f32[BENCH_TAPS + BENCH_MAX_BLOCK];
+} s_uState;
+static union
+{
+    q7_t      q7[BENCH_TAPS];
+    q15_t     q15[BENCH_TAPS];
+    q31_t     q31[BENCH_TAPS];
+    float32_t f32[BENCH_TAPS];
+} s_uCoef;
+
+/* Biquad sections: b0, b1, b2, a1, a2 with the sign convention of arm_biquad_cascade_df1 */
+static const float32_t s_af32Biquad[5] = {0.2f, 0.4f, 0.2f, 0.5f, -0.25f};
+
+static union
+{
+    arm_fir_instance_q7 q7;
+    arm_fir_instance_q15 q15;
+    arm_fir_instance_q31 q31;
+    arm_fir_instance_f32 f32;
+    arm_biquad_casd_df1_inst_q15 biq15;
+    arm_biquad_casd_df1_inst_q31 biq31;
+    arm_biquad_casd_df1_inst_f32 bif32;
+    arm_cfft_radix4_instance_q15 fft15;
+    arm_cfft_radix4_instance_q31 fft31;
+    arm_cfft_radix4_instance_f32 fftf32;
+} s_uInst;
+
+static union
+{
+    arm_matrix_instance_q15 q15;
+    arm_matrix_instance_q31 q31;
+    arm_matrix_instance_f32 f32;
+} s_auMat[3];
+
+static uint32_t s_u32Index;
+#ifndef BENCH_HOST
+static uint32_t s_u32Overhead = 0;                  /* Measured time of an empty call */
+#endif
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Data helpers                                                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+static float32_t Bench_Random(void)
+{
+    static uint32_t s_u32Seed = 1;
+
+    s_u32Seed = s_u32Seed * 1664525UL + 1013904223UL;
+    return (float32_t)(s_u32Seed >> 8) / 16777216.0f - 0.5f;
+}
+
+static q31_t Bench_Saturate(double dValue, double dFull, q31_t i32Max)
+{
+    double d = dValue * dFull;
+
+    if(d >= (double)i32Max)
+        return i32Max;
+    if(d <= -(double)i32Max - 1.0)
+        return -i32Max - 1;
+    return (q31_t)d;
+}
+
+/* Convert float data to the given type, multiplied by f32Scale */
+static void Bench_Convert(uint32_t u32Type, const float32_t *pf32Src, void *pvDst, uint32_t u32Len, float32_t f32Scale)
+{
+    uint32_t i;
+
+    for(i = 0; i < u32Len; i++)
+    {
+        double d = (double)pf32Src[i] * f32Scale;
+
+        switch(u32Type)
+        {
+            case BENCH_Q7:
+                ((q7_t *)pvDst)[i] = (q7_t)Bench_Saturate(d, 128.0, 0x7F);
+                break;
+            case BENCH_Q15:
+                ((q15_t *)pvDst)[i] = (q15_t)Bench_Saturate(d, 32768.0, 0x7FFF);
+                break;
+            case BENCH_Q31:
+                ((q31_t *)pvDst)[i] = Bench_Saturate(d, 2147483648.0, 0x7FFFFFFF);
+                break;
+            default:
+                ((float32_t *)pvDst)[i] = (float32_t)d;
+                break;
+        }
+    }
+}
+
+static double Bench_Value(uint32_t u32Type, const void *pvData, uint32_t u32Idx)
+{
+    switch(u32Type)
+    {
+        case BENCH_Q7:
+            return ((const q7_t *)pvData)[u32Idx] / 128.0;
+        case BENCH_Q15:
+            return ((const q15_t *)pvData)[u32Idx] / 32768.0;
+        case BENCH_Q31:
+            return ((const q31_t *)pvData)[u32Idx] / 2147483648.0;
+        default:
+            return ((const float32_t *)pvData)[u32Idx];
+    }
+}
+
+/* Signal to error ratio of s_uOut against s_af32Ref in dB */
+static int32_t Bench_Snr(uint32_t u32Type, uint32_t u32Len)
+{
+    double dSignal = 0, dError = 0, dDiff;
+    uint32_t i;
+
+    for(i = 0; i < u32Len; i++)
+    {
+        dDiff = s_af32Ref[i] - Bench_Value(u32Type, &s_uOut, i);
+        dSignal += (double)s_af32Ref[i] * s_af32Ref[i];
+        dError += dDiff * dDiff;
+    }
+
+    if(dError <= dSignal * 1e-20)
+        return 200;
+    if(dSignal <= dError)
+        return 0;
+    return (int32_t)(10.0 * log10(dSignal / dError));
+}
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* FIR                                                                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t Fir_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t n, k;
+    double dAcc;
+
+    /* Coefficients are stored in time reversed order */
+    for(n = 0; n < u32N; n++)
+    {
+        dAcc = 0;
+        for(k = 0; (k < BENCH_TAPS) && (k <= n); k++)
+            dAcc += (double)s_af32Coef[BENCH_TAPS - 1 - k] * s_af32Src[n - k];
+        s_af32Ref[n] = (float32_t)dAcc;
+    }
+    return u32N;
+}
+
+static void Fir_Init(uint32_t u32Type, uint32_t u32N)
+{
+    Bench_Convert(u32Type, s_af32Coef, &s_uCoef, BENCH_TAPS, 1.0f);
+    Bench_Convert(u32Type, s_af32Src, &s_uInA, u32N, 1.0f);
+
+    switch(u32Type)
+    {
+        case BENCH_Q7:
+            arm_fir_init_q7(&s_uInst.q7, BENCH_TAPS, s_uCoef.q7, s_uState.q7, u32N);
+            break;
+        case BENCH_Q15:
+            arm_fir_init_q15(&s_uInst.q15, BENCH_TAPS, s_uCoef.q15, s_uState.q15, u32N);
+            break;
+        case BENCH_Q31:
+            arm_fir_init_q31(&s_uInst.q31, BENCH_TAPS, s_uCoef.q31, s_uState.q31, u32N);
+            break;
+        default:
+            arm_fir_init_f32(&s_uInst.f32, BENCH_TAPS, s_uCoef.f32, s_uState.f32, u32N);
+            break;
+    }
+}
+
+static void Fir_Run(uint32_t u32Type, uint32_t u32N)
+{
+    switch(u32Type)
+    {
+        case BENCH_Q7:
+            arm_fir_q7(&s_uInst.q7, s_uInA.q7, s_uOut.q7, u32N);
+            break;
+        case BENCH_Q15:
+            arm_fir_q15(&s_uInst.q15, s_uInA.q15, s_uOut.q15, u32N);
+            break;
+        case BENCH_Q31:
+            arm_fir_q31(&s_uInst.q31, s_uInA.q31, s_uOut.q31, u32N);
+            break;
+        default:
+            arm_fir_f32(&s_uInst.f32, s_uInA.f32, s_uOut.f32, u32N);
+            break;
+    }
+}
+
+static void FirFast_Run(uint32_t u32Type, uint32_t u32N)
+{
+    if(u32Type == BENCH_Q15)
+        arm_fir_fast_q15(&s_uInst.q15, s_uInA.q15, s_uOut.q15, u32N);
+    else
+        arm_fir_fast_q31(&s_uInst.q31, s_uInA.q31, s_uOut.q31, u32N);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Biquad cascade direct form I                                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t Biquad_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    double adState[BENCH_STAGES][4] = {{0}};
+    double dIn, dOut;
+    uint32_t n, s;
+
+    for(n = 0; n < u32N; n++)
+    {
+        dIn = s_af32Src[n];
+        for(s = 0; s < BENCH_STAGES; s++)
+        {
+            /* State is x[n-1], x[n-2], y[n-1], y[n-2] */
+            dOut = s_af32Biquad[0] * dIn + s_af32Biquad[1] * adState[s][0] + s_af32Biquad[2] * adState[s][1] +
+                   s_af32Biquad[3] * adState[s][2] + s_af32Biquad[4] * adState[s][3];
+            adState[s][1] = adState[s][0];
+            adState[s][0] = dIn;
+            adState[s][3] = adState[s][2];
+            adState[s][2] = dOut;
+            dIn = dOut;
+        }
+        s_af32Ref[n] = (float32_t)dIn;
+    }
+    return u32N;
+}
+
+static void Biquad_Init(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t s;
+
+    Bench_Convert(u32Type, s_af32Src, &s_uInA, u32N, 1.0f);
+
+    for(s = 0; s < BENCH_STAGES; s++)
+    {
+        if(u32Type == BENCH_Q15)
+        {
+            /* q15 sections are b0, 0, b1, b2, a1, a2 */
+            Bench_Convert(u32Type, &s_af32Biquad[0], &s_uCoef.q15[s * 6], 1, 1.0f);
+            s_uCoef.q15[s * 6 + 1] = 0;
+            Bench_Convert(u32Type, &s_af32Biquad[1], &s_uCoef.q15[s * 6 + 2], 4, 1.0f);
+        }
+        else if(u32Type == BENCH_Q31)
+        {
+            Bench_Convert(u32Type, s_af32Biquad, &s_uCoef.q31[s * 5], 5, 1.0f);
+        }
+        else
+        {
+            Bench_Convert(u32Type, s_af32Biquad, &s_uCoef.f32[s * 5], 5, 1.0f);
+        }
+    }
+
+    if(u32Type == BENCH_Q15)
+        arm_biquad_cascade_df1_init_q15(&s_uInst.biq15, BENCH_STAGES, s_uCoef.q15, s_uState.q15, 0);
+    else if(u32Type == BENCH_Q31)
+        arm_biquad_cascade_df1_init_q31(&s_uInst.biq31, BENCH_STAGES, s_uCoef.q31, s_uState.q31, 0);
+    else
+        arm_biquad_cascade_df1_init_f32(&s_uInst.bif32, BENCH_STAGES, s_uCoef.f32, s_uState.f32);
+}
+
+static void Biquad_Run(uint32_t u32Type, uint32_t u32N)
+{
+    if(u32Type == BENCH_Q15)
+        arm_biquad_cascade_df1_q15(&s_uInst.biq15, s_uInA.q15, s_uOut.q15, u32N);
+    else if(u32Type == BENCH_Q31)
+        arm_biquad_cascade_df1_q31(&s_uInst.biq31, s_uInA.q31, s_uOut.q31, u32N);
+    else
+        arm_biquad_cascade_df1_f32(&s_uInst.bif32, s_uInA.f32, s_uOut.f32, u32N);
+}
+
+static void BiquadFast_Run(uint32_t u32Type, uint32_t u32N)
+{
+    if(u32Type == BENCH_Q15)
+        arm_biquad_cascade_df1_fast_q15(&s_uInst.biq15, s_uInA.q15, s_uOut.q15, u32N);
+    else
+        arm_biquad_cascade_df1_fast_q31(&s_uInst.biq31, s_uInA.q31, s_uOut.q31, u32N);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Convolution of the input block with BENCH_TAPS samples                                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t Conv_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t n, k;
+    double dAcc;
+
+    for(n = 0; n < u32N + BENCH_TAPS - 1; n++)
+    {
+        dAcc = 0;
+        for(k = 0; k < BENCH_TAPS; k++)
+        {
+            if((n >= k) && (n - k < u32N))
+                dAcc += (double)s_af32Coef[k] * s_af32Src[n - k];
+        }
+        s_af32Ref[n] = (float32_t)dAcc;
+    }
+    return u32N + BENCH_TAPS - 1;
+}
+
+static void Conv_Init(uint32_t u32Type, uint32_t u32N)
+{
+    Bench_Convert(u32Type, s_af32Src, &s_uInA, u32N, 1.0f);
+    Bench_Convert(u32Type, s_af32Coef, &s_uInB, BENCH_TAPS, 1.0f);
+}
+
+static void Conv_Run(uint32_t u32Type, uint32_t u32N)
+{
+    switch(u32Type)
+    {
+        case BENCH_Q7:
+            arm_conv_q7(s_uInA.q7, u32N, s_uInB.q7, BENCH_TAPS, s_uOut.q7);
+            break;
+        case BENCH_Q15:
+            arm_conv_q15(s_uInA.q15, u32N, s_uInB.q15, BENCH_TAPS, s_uOut.q15);
+            break;
+        case BENCH_Q31:
+            arm_conv_q31(s_uInA.q31, u32N, s_uInB.q31, BENCH_TAPS, s_uOut.q31);
+            break;
+        default:
+            arm_conv_f32(s_uInA.f32, u32N, s_uInB.f32, BENCH_TAPS, s_uOut.f32);
+            break;
+    }
+}
+
+static void ConvFast_Run(uint32_t u32Type, uint32_t u32N)
+{
+    if(u32Type == BENCH_Q15)
+        arm_conv_fast_q15(s_uInA.q15, u32N, s_uInB.q15, BENCH_TAPS, s_uOut.q15);
+    else
+        arm_conv_fast_q31(s_uInA.q31, u32N, s_uInB.q31, BENCH_TAPS, s_uOut.q31);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Radix-4 complex FFT, in place on s_uOut                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t Cfft_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    /* s_uOut is overwritten by Cfft_Init(), use it for the twiddle table */
+    float32_t *pf32Cos = s_uOut.f32, *pf32Sin = s_uOut.f32 + u32N;
+    double dRe, dIm, dScale;
+    uint32_t k, n, w;
+
+    for(k = 0; k < u32N; k++)
+    {
+        pf32Cos[k] = (float32_t)cos(2.0 * PI * k / u32N);
+        pf32Sin[k] = (float32_t)sin(2.0 * PI * k / u32N);
+    }
+
+    /* Fixed point transforms scale the output down by the FFT length */
+    dScale = (u32Type == BENCH_F32) ? 1.0 : 1.0 / u32N;
+
+    for(k = 0; k < u32N; k++)
+    {
+        dRe = dIm = 0;
+        for(n = 0; n < u32N; n++)
+        {
+            w = (k * n) % u32N;
+            dRe += (double)s_af32Src[2 * n] * pf32Cos[w] + (double)s_af32Src[2 * n + 1] * pf32Sin[w];
+            dIm += (double)s_af32Src[2 * n + 1] * pf32Cos[w] - (double)s_af32Src[2 * n] * pf32Sin[w];
+        }
+        s_af32Ref[2 * k] = (float32_t)(dRe * dScale);
+        s_af32Ref[2 * k + 1] = (float32_t)(dIm * dScale);
+    }
+    return 2 * u32N;
+}
+
+static void Cfft_Init(uint32_t u32Type, uint32_t u32N)
+{
+    Bench_Convert(u32Type, s_af32Src, &s_uOut, 2 * u32N, 1.0f);
+
+    if(u32Type == BENCH_Q15)
+        arm_cfft_radix4_init_q15(&s_uInst.fft15, u32N, 0, 1);
+    else if(u32Type == BENCH_Q31)
+        arm_cfft_radix4_init_q31(&s_uInst.fft31, u32N, 0, 1);
+    else
+        arm_cfft_radix4_init_f32(&s_uInst.fftf32, u32N, 0, 1);
+}
+
+static void Cfft_Run(uint32_t u32Type, uint32_t u32N)
+{
+    if(u32Type == BENCH_Q15)
+        arm_cfft_radix4_q15(&s_uInst.fft15, s_uOut.q15);
+    else if(u32Type == BENCH_Q31)
+        arm_cfft_radix4_q31(&s_uInst.fft31, s_uOut.q31);
+    else
+        arm_cfft_radix4_f32(&s_uInst.fftf32, s_uOut.f32);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Square matrix multiplication, u32N is the number of elements (4x4, 8x8 and 16x16)                       */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t Mat_Dim(uint32_t u32N)
+{
+    uint32_t u32Dim = 1;
+
+    while(u32Dim * u32Dim < u32N)
+        u32Dim++;
+    return u32Dim;
+}
+
+static uint32_t Mat_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t u32Dim = Mat_Dim(u32N), r, c, k;
+    double dAcc;
+
+    /* B is scaled by 1 / dimension to keep the result in range */
+    for(r = 0; r < u32Dim; r++)
+    {
+        for(c = 0; c < u32Dim; c++)
+        {
+            dAcc = 0;
+            for(k = 0; k < u32Dim; k++)
+                dAcc += (double)s_af32Src[r * u32Dim + k] * s_af32Src[BENCH_MAX_BLOCK + k * u32Dim + c];
+            s_af32Ref[r * u32Dim + c] = (float32_t)(dAcc / u32Dim);
+        }
+    }
+    return u32N;
+}
+
+static void Mat_Init(uint32_t u32Type, uint32_t u32N)
+{
+    uint16_t u16Dim = (uint16_t)Mat_Dim(u32N);
+
+    Bench_Convert(u32Type, s_af32Src, &s_uInA, u32N, 1.0f);
+    Bench_Convert(u32Type, &s_af32Src[BENCH_MAX_BLOCK], &s_uInB, u32N, 1.0f / u16Dim);
+
+    if(u32Type == BENCH_Q15)
+    {
+        arm_mat_init_q15(&s_auMat[0].q15, u16Dim, u16Dim, s_uInA.q15);
+        arm_mat_init_q15(&s_auMat[1].q15, u16Dim, u16Dim, s_uInB.q15);
+        arm_mat_init_q15(&s_auMat[2].q15, u16Dim, u16Dim, s_uOut.q15);
+    }
+    else if(u32Type == BENCH_Q31)
+    {
+        arm_mat_init_q31(&s_auMat[0].q31, u16Dim, u16Dim, s_uInA.q31);
+        arm_mat_init_q31(&s_auMat[1].q31, u16Dim, u16Dim, s_uInB.q31);
+        arm_mat_init_q31(&s_auMat[2].q31, u16Dim, u16Dim, s_uOut.q31);
+    }
+    else
+    {
+        arm_mat_init_f32(&s_auMat[0].f32, u16Dim, u16Dim, s_uInA.f32);
+        arm_mat_init_f32(&s_auMat[1].f32, u16Dim, u16Dim, s_uInB.f32);
+        arm_mat_init_f32(&s_auMat[2].f32, u16Dim, u16Dim, s_uOut.f32);
+    }
+}
+
+static void Mat_Run(uint32_t u32Type, uint32_t u32N)
+{
+    /* Upper half of s_uInB is the scratch buffer of q15 functions */
+    if(u32Type == BENCH_Q15)
+        arm_mat_mult_q15(&s_auMat[0].q15, &s_auMat[1].q15, &s_auMat[2].q15, &s_uInB.q15[BENCH_MAX_BLOCK]);
+    else if(u32Type == BENCH_Q31)
+        arm_mat_mult_q31(&s_auMat[0].q31, &s_auMat[1].q31, &s_auMat[2].q31);
+    else
+        arm_mat_mult_f32(&s_auMat[0].f32, &s_auMat[1].f32, &s_auMat[2].f32);
+}
+
+static void MatFast_Run(uint32_t u32Type, uint32_t u32N)
+{
+    if(u32Type == BENCH_Q15)
+        arm_mat_mult_fast_q15(&s_auMat[0].q15, &s_auMat[1].q15, &s_auMat[2].q15, &s_uInB.q15[BENCH_MAX_BLOCK]);
+    else
+        arm_mat_mult_fast_q31(&s_auMat[0].q31, &s_auMat[1].q31, &s_auMat[2].q31);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Statistics, the result is the first element of s_uOut                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static void Stat_Init(uint32_t u32Type, uint32_t u32N)
+{
+    Bench_Convert(u32Type, s_af32Src, &s_uInA, u32N, 1.0f);
+}
+
+/* Input of mean has a DC offset, so the result is not close to zero */
+static float32_t Mean_Input(uint32_t u32Idx)
+{
+    return s_af32Src[u32Idx] * 0.5f + 0.25f;
+}
+
+static uint32_t Mean_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    double dSum = 0;
+    uint32_t i;
+
+    for(i = 0; i < u32N; i++)
+        dSum += Mean_Input(i);
+    s_af32Ref[0] = (float32_t)(dSum / u32N);
+    return 1;
+}
+
+static void Mean_Init(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t i;
+
+    for(i = 0; i < u32N; i++)
+        s_uOut.f32[i] = Mean_Input(i);
+    Bench_Convert(u32Type, s_uOut.f32, &s_uInA, u32N, 1.0f);
+}
+
+static void Mean_Run(uint32_t u32Type, uint32_t u32N)
+{
+    switch(u32Type)
+    {
+        case BENCH_Q7:
+            arm_mean_q7(s_uInA.q7, u32N, s_uOut.q7);
+            break;
+        case BENCH_Q15:
+            arm_mean_q15(s_uInA.q15, u32N, s_uOut.q15);
+            break;
+        case BENCH_Q31:
+            arm_mean_q31(s_uInA.q31, u32N, s_uOut.q31);
+            break;
+        default:
+            arm_mean_f32(s_uInA.f32, u32N, s_uOut.f32);
+            break;
+    }
+}
+
+static uint32_t Max_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    float32_t f32Max = s_af32Src[0];
+    uint32_t i;
+
+    for(i = 1; i < u32N; i++)
+    {
+        if(s_af32Src[i] > f32Max)
+            f32Max = s_af32Src[i];
+    }
+    s_af32Ref[0] = f32Max;
+    return 1;
+}
+
+static void Max_Run(uint32_t u32Type, uint32_t u32N)
+{
+    switch(u32Type)
+    {
+        case BENCH_Q7:
+            arm_max_q7(s_uInA.q7, u32N, s_uOut.q7, &s_u32Index);
+            break;
+        case BENCH_Q15:
+            arm_max_q15(s_uInA.q15, u32N, s_uOut.q15, &s_u32Index);
+            break;
+        case BENCH_Q31:
+            arm_max_q31(s_uInA.q31, u32N, s_uOut.q31, &s_u32Index);
+            break;
+        default:
+            arm_max_f32(s_uInA.f32, u32N, s_uOut.f32, &s_u32Index);
+            break;
+    }
+}
+
+static uint32_t Rms_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    double dSum = 0;
+    uint32_t i;
+
+    /* Input is scaled down by sqrt(u32N), the q31 accumulator has only one guard bit */
+    for(i = 0; i < u32N; i++)
+        dSum += (double)s_af32Src[i] * s_af32Src[i];
+    s_af32Ref[0] = (float32_t)(sqrt(dSum / u32N) / Mat_Dim(u32N));
+    return 1;
+}
+
+static void Rms_Init(uint32_t u32Type, uint32_t u32N)
+{
+    Bench_Convert(u32Type, s_af32Src, &s_uInA, u32N, 1.0f / Mat_Dim(u32N));
+}
+
+static void Rms_Run(uint32_t u32Type, uint32_t u32N)
+{
+    if(u32Type == BENCH_Q15)
+        arm_rms_q15(s_uInA.q15, u32N, s_uOut.q15);
+    else if(u32Type == BENCH_Q31)
+        arm_rms_q31(s_uInA.q31, u32N, s_uOut.q31);
+    else
+        arm_rms_f32(s_uInA.f32, u32N, s_uOut.f32);
+}
+
+static uint32_t Var_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    double dSum = 0, dSquare = 0;
+    uint32_t i;
+
+    for(i = 0; i < u32N; i++)
+    {
+        dSum += s_af32Src[i];
+        dSquare += (double)s_af32Src[i] * s_af32Src[i];
+    }
+    s_af32Ref[0] = (float32_t)((dSquare - dSum * dSum / u32N) / (u32N - 1));
+    return 1;
+}
+
+static void Var_Run(uint32_t u32Type, uint32_t u32N)
+{
+    if(u32Type == BENCH_Q15)
+        arm_var_q15(s_uInA.q15, u32N, s_uOut.q15);
+    else if(u32Type == BENCH_Q31)
+        arm_var_q31(s_uInA.q31, u32N, s_uOut.q31);
+    else
+        arm_var_f32(s_uInA.f32, u32N, s_uOut.f32);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Fast math, one call per sample                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t Sin_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t i;
+
+    /* Fixed point angle is [0, 1) for [0, 2 pi) */
+    for(i = 0; i < u32N; i++)
+        s_af32Ref[i] = (float32_t)sin(2.0 * PI * (s_af32Src[i] + 0.5f));
+    return u32N;
+}
+
+static uint32_t Cos_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t i;
+
+    for(i = 0; i < u32N; i++)
+        s_af32Ref[i] = (float32_t)cos(2.0 * PI * (s_af32Src[i] + 0.5f));
+    return u32N;
+}
+
+static void Angle_Init(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t i;
+
+    /* Build the angles in s_uOut, then convert them to the input buffer */
+    for(i = 0; i < u32N; i++)
+        s_uOut.f32[i] = s_af32Src[i] + 0.5f;
+    Bench_Convert(u32Type, s_uOut.f32, &s_uInA, u32N, (u32Type == BENCH_F32) ? 2.0f * PI : 1.0f);
+}
+
+static void Sin_Run(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t i;
+
+    if(u32Type == BENCH_Q15)
+    {
+        for(i = 0; i < u32N; i++)
+            s_uOut.q15[i] = arm_sin_q15(s_uInA.q15[i]);
+    }
+    else if(u32Type == BENCH_Q31)
+    {
+        for(i = 0; i < u32N; i++)
+            s_uOut.q31[i] = arm_sin_q31(s_uInA.q31[i]);
+    }
+    else
+    {
+        for(i = 0; i < u32N; i++)
+            s_uOut.f32[i] = arm_sin_f32(s_uInA.f32[i]);
+    }
+}
+
+static void Cos_Run(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t i;
+
+    if(u32Type == BENCH_Q15)
+    {
+        for(i = 0; i < u32N; i++)
+            s_uOut.q15[i] = arm_cos_q15(s_uInA.q15[i]);
+    }
+    else if(u32Type == BENCH_Q31)
+    {
+        for(i = 0; i < u32N; i++)
+            s_uOut.q31[i] = arm_cos_q31(s_uInA.q31[i]);
+    }
+    else
+    {
+        for(i = 0; i < u32N; i++)
+            s_uOut.f32[i] = arm_cos_f32(s_uInA.f32[i]);
+    }
+}
+
+static uint32_t Sqrt_Ref(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t i;
+
+    for(i = 0; i < u32N; i++)
+        s_af32Ref[i] = (float32_t)sqrt(fabs(2.0 * s_af32Src[i]));
+    return u32N;
+}
+
+static void Sqrt_Init(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t i;
+
+    for(i = 0; i < u32N; i++)
+        s_uOut.f32[i] = (float32_t)fabs(2.0 * s_af32Src[i]);
+    Bench_Convert(u32Type, s_uOut.f32, &s_uInA, u32N, 1.0f);
+}
+
+static void Sqrt_Run(uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t i;
+
+    if(u32Type == BENCH_Q15)
+    {
+        for(i = 0; i < u32N; i++)
+            arm_sqrt_q15(s_uInA.q15[i], &s_uOut.q15[i]);
+    }
+    else
+    {
+        for(i = 0; i < u32N; i++)
+            arm_sqrt_q31(s_uInA.q31[i], &s_uOut.q31[i]);
+    }
+}
+
+static void Empty_Run(uint32_t u32Type, uint32_t u32N)
+{
+}
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Benchmark list                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+static const S_BENCH_T s_asBench[] =
+{
+    /* Name                     Types               SNR q7, q15, q31, f32   Reference  Init         Run */
+    {"arm_fir",                 BENCH_TYPE_ALL,     {3, 50, 100, 100},     Fir_Ref,    Fir_Init,    Fir_Run},
+    {"arm_fir_fast",            BENCH_TYPE_FIXED,   {0, 50, 100, 0},        Fir_Ref,    Fir_Init,    FirFast_Run},
+    {"arm_biquad_cascade_df1",  BENCH_TYPE_FIXED | BENCH_TYPE_F32, {0, 60, 120, 100}, Biquad_Ref, Biquad_Init, Biquad_Run},
+    {"arm_biquad_cascade_df1_fast", BENCH_TYPE_FIXED, {0, 60, 100, 0},      Biquad_Ref, Biquad_Init, BiquadFast_Run},
+    {"arm_conv",                BENCH_TYPE_ALL,     {5, 50, 100, 100},     Conv_Ref,   Conv_Init,   Conv_Run},
+    {"arm_conv_fast",           BENCH_TYPE_FIXED,   {0, 50, 100, 0},        Conv_Ref,   Conv_Init,   ConvFast_Run},
+    {"arm_cfft_radix4",         BENCH_TYPE_FIXED | BENCH_TYPE_F32, {0, 45, 100, 100}, Cfft_Ref, Cfft_Init, Cfft_Run},
+    {"arm_mat_mult",            BENCH_TYPE_FIXED | BENCH_TYPE_F32, {0, 50, 120, 100}, Mat_Ref, Mat_Init, Mat_Run},
+    {"arm_mat_mult_fast",       BENCH_TYPE_FIXED,   {0, 50, 100, 0},        Mat_Ref,    Mat_Init,    MatFast_Run},
+    {"arm_mean",                BENCH_TYPE_ALL,     {20, 60, 120, 100},     Mean_Ref,   Mean_Init,   Mean_Run},
+    {"arm_max",                 BENCH_TYPE_ALL,     {30, 60, 120, 100},     Max_Ref,    Stat_Init,   Max_Run},
+    {"arm_rms",                 BENCH_TYPE_FIXED | BENCH_TYPE_F32, {0, 30, 100, 100}, Rms_Ref, Rms_Init, Rms_Run},
+    {"arm_var",                 BENCH_TYPE_FIXED | BENCH_TYPE_F32, {0, 50, 100, 100}, Var_Ref, Stat_Init, Var_Run},
+    {"arm_sin",                 BENCH_TYPE_FIXED | BENCH_TYPE_F32, {0, 60, 80, 80}, Sin_Ref, Angle_Init, Sin_Run},
+    {"arm_cos",                 BENCH_TYPE_FIXED | BENCH_TYPE_F32, {0, 60, 80, 80}, Cos_Ref, Angle_Init, Cos_Run},
+    {"arm_sqrt",                BENCH_TYPE_FIXED,   {0, 70, 100, 0},        Sqrt_Ref,   Sqrt_Init,   Sqrt_Run},
+};
+
+
+/**
+  * @brief      Run one function of a benchmark for one data type and block size
+  * @param[in]  psBench     Benchmark to run
+  * @param[in]  u32Type     Data type, BENCH_Q7, BENCH_Q15, BENCH_Q31 or BENCH_F32
+  * @param[in]  u32N        Block size
+  * @retval     0           Output check passed
+  * @retval     1           Output check failed
+  * @details    The function is run once on fresh state to check the output, then initialized again
+  *             and measured, so the time does not include input preparation.
+  */
+static uint32_t Bench_Run(const S_BENCH_T *psBench, uint32_t u32Type, uint32_t u32N)
+{
+    uint32_t u32Len, u32Time, u32PerSample;
+    int32_t i32Snr;
+
+    u32Len = psBench->pfnRef(u32Type, u32N);
+    psBench->pfnInit(u32Type, u32N);
+    psBench->pfnRun(u32Type, u32N);
+    i32Snr = Bench_Snr(u32Type, u32Len);
+
+    psBench->pfnInit(u32Type, u32N);
+    BENCH_MEASURE(u32Time, psBench->pfnRun(u32Type, u32N));
+    u32PerSample = (uint32_t)(((uint64_t)u32Time * 100 + u32N / 2) / u32N);
+
+    printf("%-28s %-4s %4u %10u %7u.%02u %4d dB %s\n", psBench->pcName, s_apcTypeName[u32Type], (unsigned)u32N,
+           (unsigned)u32Time, (unsigned)(u32PerSample / 100), (unsigned)(u32PerSample % 100), (int)i32Snr,
+           (i32Snr >= psBench->ai32MinSnr[u32Type]) ? "PASS" : "FAIL");
+
+    return (i32Snr >= psBench->ai32MinSnr[u32Type]) ? 0 : 1;
+}
+
+static uint32_t Bench_RunAll(void)
+{
+    uint32_t i, u32Type, u32Size, u32Fail = 0;
+
+    for(i = 0; i < BENCH_MAX_BLOCK * 2; i++)
+        s_af32Src[i] = Bench_Random();
+    for(i = 0; i < BENCH_TAPS; i++)
+        s_af32Coef[i] = Bench_Random() / 16.0f;
+
+#ifndef BENCH_HOST
+    /* Cost of calling an empty function through the measurement */
+    BENCH_MEASURE(s_u32Overhead, Empty_Run(0, 0));
+#else
+    Empty_Run(0, 0);
+#endif
+
+    printf("%-28s %-4s %4s %10s %10s %7s\n", "Function", "Type", "N", BENCH_UNIT, "per sample", "SNR");
+
+    for(i = 0; i < sizeof(s_asBench) / sizeof(s_asBench[0]); i++)
+    {
+        for(u32Type = 0; u32Type < BENCH_TYPE_NUM; u32Type++)
+        {
+            if(!(s_asBench[i].u32Types & (1UL << u32Type)))
+                continue;
+
+            for(u32Size = 0; u32Size < sizeof(s_au32BlockSize) / sizeof(s_au32BlockSize[0]); u32Size++)
+                u32Fail += Bench_Run(&s_asBench[i], u32Type, s_au32BlockSize[u32Size]);
+        }
+    }
+
+    printf("\n%u check(s) failed\n", (unsigned)u32Fail);
+
+    return u32Fail;
+}
+
+
+#ifdef BENCH_HOST
+
+int main(void)
+{
+    return Bench_RunAll() ? 1 : 0;
+}
+
+#else
+
+#define PLL_CLOCK           72000000
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable HIRC clock (Internal RC 22.1184MHz) */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Wait for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Select HCLK clock source as HIRC and and HCLK source divider as 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Enable HXT clock (external XTAL 12MHz) */
+    CLK_EnableXtalRC(CLK_PWRCTL_HXTEN_Msk);
+
+    /* Wait for HXT clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HXTSTB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+
+    /* Select UART module clock source as HXT and UART module clock divider as 1 */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HXT, CLK_CLKDIV0_UART(1));
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set PA multi-function pins for UART0 RXD and TXD */
+    SYS->GPA_MFPL &= ~(SYS_GPA_MFPL_PA3MFP_Msk | SYS_GPA_MFPL_PA2MFP_Msk);
+    SYS->GPA_MFPL |= (SYS_GPA_MFPL_PA3MFP_UART0_RXD | SYS_GPA_MFPL_PA2MFP_UART0_TXD);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  MAIN function                                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+int main(void)
+{
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init System, IP clock and multi-function I/O */
+    SYS_Init();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    /* Init UART0 to 115200-8n1 for print message */
+    UART_Open(UART0, 115200);
+
+    printf("\nCMSIS DSP benchmark, HCLK %d Hz\n\n", SystemCoreClock);
+
+    /* SysTick free runs on HCLK without interrupt */
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    Bench_RunAll();
+
+    while(1);
+}
+
+#endif
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -76,6 +76,7 @@
 /*
 * @brief  Table for bit reversal process
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREV_1024)
 const uint16_t armBitRevTable[1024] =
 {
     0x400, 0x200, 0x600, 0x100, 0x500, 0x300, 0x700, 0x80, 0x480, 0x280,
@@ -182,6 +183,7 @@ const uint16_t armBitRevTable[1024] =
     0x67e, 0x17e, 0x57e, 0x37e, 0x77e, 0xfe, 0x4fe, 0x2fe, 0x6fe, 0x1fe,
     0x5fe, 0x3fe, 0x7fe, 0x1
 };
+#endif
 
 
 /*
@@ -203,6 +205,7 @@ const uint16_t armBitRevTable[1024] =
 * Cos and Sin values are in interleaved fashion
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_16)
 const float32_t twiddleCoef_16[32] =
 {
     1.000000000f,  0.000000000f,
@@ -222,6 +225,7 @@ const float32_t twiddleCoef_16[32] =
     0.707106781f, -0.707106781f,
     0.923879533f, -0.382683432f
 };
+#endif
 
 /**
 * \par
@@ -238,6 +242,7 @@ const float32_t twiddleCoef_16[32] =
 * Cos and Sin values are in interleaved fashion
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_32)
 const float32_t twiddleCoef_32[64] =
 {
     1.000000000f,  0.000000000f,
@@ -273,6 +278,7 @@ const float32_t twiddleCoef_32[64] =
     0.923879533f, -0.382683432f,
     0.980785280f, -0.195090322f
 };
+#endif
 
 /**
 * \par
@@ -289,6 +295,7 @@ const float32_t twiddleCoef_32[64] =
 * Cos and Sin values are in interleaved fashion
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_64)
 const float32_t twiddleCoef_64[128] =
 {
     1.000000000f,  0.000000000f,
@@ -356,6 +363,7 @@ const float32_t twiddleCoef_64[128] =
     0.980785280f, -0.195090322f,
     0.995184727f, -0.098017140f
 };
+#endif
 
 /**
 * \par
@@ -373,6 +381,7 @@ const float32_t twiddleCoef_64[128] =
 *
 */
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_128)
 const float32_t twiddleCoef_128[256] =
 {
     1.000000000f,   0.000000000f,
@@ -504,6 +513,7 @@ const float32_t twiddleCoef_128[256] =
     0.995184727f,   -0.098017140f,
     0.998795456f,   -0.049067674f
 };
+#endif
 
 /**
 * \par
@@ -520,6 +530,7 @@ const float32_t twiddleCoef_128[256] =
 * Cos and Sin values are in interleaved fashion
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_256)
 const float32_t twiddleCoef_256[512] =
 {
     1.000000000f,  0.000000000f,
@@ -779,6 +790,7 @@ const float32_t twiddleCoef_256[512] =
     0.998795456f, -0.049067674f,
     0.999698819f, -0.024541229f
 };
+#endif
 
 /**
 * \par
@@ -795,6 +807,7 @@ const float32_t twiddleCoef_256[512] =
 * Cos and Sin values are in interleaved fashion
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_512)
 const float32_t twiddleCoef_512[1024] =
 {
     1.000000000f,  0.000000000f,
@@ -1310,6 +1323,7 @@ const float32_t twiddleCoef_512[1024] =
     0.999698819f, -0.024541229f,
     0.999924702f, -0.012271538f
 };
+#endif
 /**
 * \par
 * Example code for Floating-point Twiddle factors Generation:
@@ -1325,6 +1339,7 @@ const float32_t twiddleCoef_512[1024] =
 * Cos and Sin values are in interleaved fashion
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_1024)
 const float32_t twiddleCoef_1024[2048] =
 {
     1.000000000f,   0.000000000f,
@@ -2352,6 +2367,7 @@ const float32_t twiddleCoef_1024[2048] =
     0.999924702f,   -0.012271538f,
     0.999981175f,   -0.006135885f
 };
+#endif
 
 /**
 * \par
@@ -2368,6 +2384,7 @@ const float32_t twiddleCoef_1024[2048] =
 * Cos and Sin values are in interleaved fashion
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_2048)
 const float32_t twiddleCoef_2048[4096] =
 {
     1.000000000f,  0.000000000f,
@@ -4419,6 +4436,7 @@ const float32_t twiddleCoef_2048[4096] =
     0.999981175f, -0.006135885f,
     0.999995294f, -0.003067957f
 };
+#endif
 
 /**
 * \par
@@ -4435,6 +4453,7 @@ const float32_t twiddleCoef_2048[4096] =
 * Cos and Sin values are in interleaved fashion
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_4096)
 const float32_t twiddleCoef_4096[8192] =
 {
     1.000000000f,  0.000000000f,
@@ -8534,6 +8553,7 @@ const float32_t twiddleCoef_4096[8192] =
     0.999995294f, -0.003067957f,
     0.999998823f, -0.001533980f
 };
+#endif
 
 /*
 * @brief  Q31 Twiddle factors Table
@@ -8558,6 +8578,7 @@ const float32_t twiddleCoef_4096[8192] =
 *   round(twiddleCoefQ31(i) * pow(2, 31))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_16)
 const q31_t twiddleCoef_16_q31[24] =
 {
     0x7FFFFFFF, 0x00000000,
@@ -8573,6 +8594,7 @@ const q31_t twiddleCoef_16_q31[24] =
     0xA57D8666, 0xA57D8666,
     0xCF043AB2, 0x89BE50C3
 };
+#endif
 
 /**
 * \par
@@ -8592,6 +8614,7 @@ const q31_t twiddleCoef_16_q31[24] =
 *   round(twiddleCoefQ31(i) * pow(2, 31))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_32)
 const q31_t twiddleCoef_32_q31[48] =
 {
     0x7FFFFFFF, 0x00000000,
@@ -8619,6 +8642,7 @@ const q31_t twiddleCoef_32_q31[48] =
     0xCF043AB2, 0x89BE50C3,
     0xE70747C3, 0x8275A0C0
 };
+#endif
 
 /**
 * \par
@@ -8638,6 +8662,7 @@ const q31_t twiddleCoef_32_q31[48] =
 *   round(twiddleCoefQ31(i) * pow(2, 31))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_64)
 const q31_t twiddleCoef_64_q31[96] =
 {
     0x7FFFFFFF, 0x00000000,
@@ -8689,6 +8714,7 @@ const q31_t twiddleCoef_64_q31[96] =
     0xE70747C3, 0x8275A0C0,
     0xF3742CA1, 0x809DC970
 };
+#endif
 
 /**
 * \par
@@ -8708,6 +8734,7 @@ const q31_t twiddleCoef_64_q31[96] =
 *   round(twiddleCoefQ31(i) * pow(2, 31))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_128)
 const q31_t twiddleCoef_128_q31[192] =
 {
     0x7FFFFFFF, 0x00000000,
@@ -8807,6 +8834,7 @@ const q31_t twiddleCoef_128_q31[192] =
     0xF3742CA1, 0x809DC970,
     0xF9B82683, 0x80277872
 };
+#endif
 
 /**
 * \par
@@ -8826,6 +8854,7 @@ const q31_t twiddleCoef_128_q31[192] =
 *   round(twiddleCoefQ31(i) * pow(2, 31))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_256)
 const q31_t twiddleCoef_256_q31[384] =
 {
     0x7FFFFFFF, 0x00000000,
@@ -9021,6 +9050,7 @@ const q31_t twiddleCoef_256_q31[384] =
     0xF9B82683, 0x80277872,
     0xFCDBD541, 0x8009DE7D
 };
+#endif
 
 /**
 * \par
@@ -9040,6 +9070,7 @@ const q31_t twiddleCoef_256_q31[384] =
 *   round(twiddleCoefQ31(i) * pow(2, 31))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_512)
 const q31_t twiddleCoef_512_q31[768] =
 {
     0x7FFFFFFF, 0x00000000,
@@ -9427,6 +9458,7 @@ const q31_t twiddleCoef_512_q31[768] =
     0xFCDBD541, 0x8009DE7D,
     0xFE6DE2E0, 0x800277A5
 };
+#endif
 
 /**
 * \par
@@ -9446,6 +9478,7 @@ const q31_t twiddleCoef_512_q31[768] =
 *   round(twiddleCoefQ31(i) * pow(2, 31))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_1024)
 const q31_t twiddleCoef_1024_q31[1536] =
 {
     0x7FFFFFFF, 0x00000000,
@@ -10217,6 +10250,7 @@ const q31_t twiddleCoef_1024_q31[1536] =
     0xFE6DE2E0, 0x800277A5,
     0xFF36F078, 0x80009DE9
 };
+#endif
 
 /**
 * \par
@@ -10236,6 +10270,7 @@ const q31_t twiddleCoef_1024_q31[1536] =
 *   round(twiddleCoefQ31(i) * pow(2, 31))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_2048)
 const q31_t twiddleCoef_2048_q31[3072] =
 {
     0x7FFFFFFF, 0x00000000,
@@ -11775,6 +11810,7 @@ const q31_t twiddleCoef_2048_q31[3072] =
     0xFF36F078, 0x80009DE9,
     0xFF9B781D, 0x8000277A
 };
+#endif
 
 /**
 * \par
@@ -11794,6 +11830,7 @@ const q31_t twiddleCoef_2048_q31[3072] =
 *   round(twiddleCoefQ31(i) * pow(2, 31))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_4096)
 const q31_t twiddleCoef_4096_q31[6144] =
 {
     0x7FFFFFFF, 0x00000000,
@@ -14869,6 +14906,7 @@ const q31_t twiddleCoef_4096_q31[6144] =
     0xFF9B781D, 0x8000277A,
     0xFFCDBC0A, 0x800009DE
 };
+#endif
 
 
 
@@ -14895,6 +14933,7 @@ const q31_t twiddleCoef_4096_q31[6144] =
 *   round(twiddleCoefq15(i) * pow(2, 15))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q15_16)
 const q15_t twiddleCoef_16_q15[24] =
 {
     0x7FFF, 0x0000,
@@ -14910,6 +14949,7 @@ const q15_t twiddleCoef_16_q15[24] =
     0xA57D, 0xA57D,
     0xCF04, 0x89BE
 };
+#endif
 
 /**
 * \par
@@ -14929,6 +14969,7 @@ const q15_t twiddleCoef_16_q15[24] =
 *   round(twiddleCoefq15(i) * pow(2, 15))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q15_32)
 const q15_t twiddleCoef_32_q15[48] =
 {
     0x7FFF, 0x0000,
@@ -14956,6 +14997,7 @@ const q15_t twiddleCoef_32_q15[48] =
     0xCF04, 0x89BE,
     0xE707, 0x8275
 };
+#endif
 
 /**
 * \par
@@ -14975,6 +15017,7 @@ const q15_t twiddleCoef_32_q15[48] =
 *   round(twiddleCoefq15(i) * pow(2, 15))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q15_64)
 const q15_t twiddleCoef_64_q15[96] =
 {
     0x7FFF, 0x0000,
@@ -15026,6 +15069,7 @@ const q15_t twiddleCoef_64_q15[96] =
     0xE707, 0x8275,
     0xF374, 0x809D
 };
+#endif
 
 /**
 * \par
@@ -15045,6 +15089,7 @@ const q15_t twiddleCoef_64_q15[96] =
 *   round(twiddleCoefq15(i) * pow(2, 15))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q15_128)
 const q15_t twiddleCoef_128_q15[192] =
 {
     0x7FFF, 0x0000,
@@ -15144,6 +15189,7 @@ const q15_t twiddleCoef_128_q15[192] =
     0xF374, 0x809D,
     0xF9B8, 0x8027
 };
+#endif
 
 /**
 * \par
@@ -15163,6 +15209,7 @@ const q15_t twiddleCoef_128_q15[192] =
 *   round(twiddleCoefq15(i) * pow(2, 15))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q15_256)
 const q15_t twiddleCoef_256_q15[384] =
 {
     0x7FFF, 0x0000,
@@ -15358,6 +15405,7 @@ const q15_t twiddleCoef_256_q15[384] =
     0xF9B8, 0x8027,
     0xFCDB, 0x8009
 };
+#endif
 
 /**
 * \par
@@ -15377,6 +15425,7 @@ const q15_t twiddleCoef_256_q15[384] =
 *   round(twiddleCoefq15(i) * pow(2, 15))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q15_512)
 const q15_t twiddleCoef_512_q15[768] =
 {
     0x7FFF, 0x0000,
@@ -15764,6 +15813,7 @@ const q15_t twiddleCoef_512_q15[768] =
     0xFCDB, 0x8009,
     0xFE6D, 0x8002
 };
+#endif
 
 /**
 * \par
@@ -15783,6 +15833,7 @@ const q15_t twiddleCoef_512_q15[768] =
 *   round(twiddleCoefq15(i) * pow(2, 15))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q15_1024)
 const q15_t twiddleCoef_1024_q15[1536] =
 {
     0x7FFF, 0x0000,
@@ -16554,6 +16605,7 @@ const q15_t twiddleCoef_1024_q15[1536] =
     0xFE6D, 0x8002,
     0xFF36, 0x8000
 };
+#endif
 
 /**
 * \par
@@ -16573,6 +16625,7 @@ const q15_t twiddleCoef_1024_q15[1536] =
 *   round(twiddleCoefq15(i) * pow(2, 15))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q15_2048)
 const q15_t twiddleCoef_2048_q15[3072] =
 {
     0x7FFF, 0x0000,
@@ -18112,6 +18165,7 @@ const q15_t twiddleCoef_2048_q15[3072] =
     0xFF36, 0x8000,
     0xFF9B, 0x8000
 };
+#endif
 
 /**
 * \par
@@ -18131,6 +18185,7 @@ const q15_t twiddleCoef_2048_q15[3072] =
 *   round(twiddleCoefq15(i) * pow(2, 15))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q15_4096)
 const q15_t twiddleCoef_4096_q15[6144] =
 {
     0x7FFF, 0x0000,
@@ -21206,6 +21261,7 @@ const q15_t twiddleCoef_4096_q15[6144] =
     0xFF9B, 0x8000,
     0xFFCD, 0x8000
 };
+#endif
 
 
 /**
@@ -21248,12 +21304,15 @@ const q31_t armRecipTableQ31[64] =
     0x41CCDDB6, 0x4146A3C6, 0x40C28923, 0x40408102
 };
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_16)
 const uint16_t armBitRevIndexTable16[ARMBITREVINDEXTABLE__16_TABLE_LENGTH] =
 {
     //8x2, size 20
     8, 64, 24, 72, 16, 64, 40, 80, 32, 64, 56, 88, 48, 72, 88, 104, 72, 96, 104, 112
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_32)
 const uint16_t armBitRevIndexTable32[ARMBITREVINDEXTABLE__32_TABLE_LENGTH] =
 {
     //8x4, size 48
@@ -21261,7 +21320,9 @@ const uint16_t armBitRevIndexTable32[ARMBITREVINDEXTABLE__32_TABLE_LENGTH] =
     80, 144, 96, 192, 104, 208, 112, 152, 120, 216, 136, 192, 144, 160, 168, 208,
     152, 224, 176, 208, 184, 232, 216, 240, 200, 224, 232, 240
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_64)
 const uint16_t armBitRevIndexTable64[ARMBITREVINDEXTABLE__64_TABLE_LENGTH] =
 {
     //radix 8, size 56
@@ -21270,7 +21331,9 @@ const uint16_t armBitRevIndexTable64[ARMBITREVINDEXTABLE__64_TABLE_LENGTH] =
     184, 464, 224, 280, 232, 344, 240, 408, 248, 472, 296, 352, 304, 416, 312, 480,
     368, 424, 376, 488, 440, 496
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_128)
 const uint16_t armBitRevIndexTable128[ARMBITREVINDEXTABLE_128_TABLE_LENGTH] =
 {
     //8x2, size 208
@@ -21288,7 +21351,9 @@ const uint16_t armBitRevIndexTable128[ARMBITREVINDEXTABLE_128_TABLE_LENGTH] =
     792, 864, 808, 904, 816, 864, 824, 920, 840, 864, 856, 880, 872, 944, 888, 1008,
     904, 928, 912, 960, 920, 992, 944, 968, 952, 1000, 968, 992, 984, 1008
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_256)
 const uint16_t armBitRevIndexTable256[ARMBITREVINDEXTABLE_256_TABLE_LENGTH] =
 {
     //8x4, size 440
@@ -21326,7 +21391,9 @@ const uint16_t armBitRevIndexTable256[ARMBITREVINDEXTABLE_256_TABLE_LENGTH] =
     1880, 1904, 1888, 1984, 1896, 2000, 1912, 2032, 1904, 2016, 1976, 2032,
     1960, 1968, 2008, 2032, 1992, 2016, 2024, 2032
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_512)
 const uint16_t armBitRevIndexTable512[ARMBITREVINDEXTABLE_512_TABLE_LENGTH] =
 {
     //radix 8, size 448
@@ -21366,7 +21433,9 @@ const uint16_t armBitRevIndexTable512[ARMBITREVINDEXTABLE_512_TABLE_LENGTH] =
     3064, 4072, 3128, 3632, 3192, 3696, 3256, 3760, 3320, 3824, 3384, 3888,
     3448, 3952, 3512, 4016, 3576, 4080
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_1024)
 const uint16_t armBitRevIndexTable1024[ARMBITREVINDEXTABLE1024_TABLE_LENGTH] =
 {
     //8x2, size 1800
@@ -21518,7 +21587,9 @@ const uint16_t armBitRevIndexTable1024[ARMBITREVINDEXTABLE1024_TABLE_LENGTH] =
     8008, 8032, 8024, 8048, 8056, 8120, 8072, 8096, 8080, 8128, 8088, 8160,
     8112, 8136, 8120, 8168, 8136, 8160, 8152, 8176
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_2048)
 const uint16_t armBitRevIndexTable2048[ARMBITREVINDEXTABLE2048_TABLE_LENGTH] =
 {
     //8x2, size 3808
@@ -21860,7 +21931,9 @@ const uint16_t armBitRevIndexTable2048[ARMBITREVINDEXTABLE2048_TABLE_LENGTH] =
     16248, 16368, 16264, 16288, 16280, 16296, 16296, 16304, 16344, 16368,
     16328, 16352, 16360, 16368
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_F32_4096)
 const uint16_t armBitRevIndexTable4096[ARMBITREVINDEXTABLE4096_TABLE_LENGTH] =
 {
     //radix 8, size 4032
@@ -22231,21 +22304,27 @@ const uint16_t armBitRevIndexTable4096[ARMBITREVINDEXTABLE4096_TABLE_LENGTH] =
     31096, 31544, 31160, 32056, 31224, 32568, 31672, 32120, 31736, 32632,
     32248, 32696
 };
+#endif
 
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_16) || defined(ARM_TABLE_CFFT_Q15_16)
 const uint16_t armBitRevIndexTable_fixed_16[ARMBITREVINDEXTABLE_FIXED___16_TABLE_LENGTH] =
 {
     //radix 4, size 12
     8, 64, 16, 32, 24, 96, 40, 80, 56, 112, 88, 104
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_32) || defined(ARM_TABLE_CFFT_Q15_32)
 const uint16_t armBitRevIndexTable_fixed_32[ARMBITREVINDEXTABLE_FIXED___32_TABLE_LENGTH] =
 {
     //4x2, size 24
     8, 128, 16, 64, 24, 192, 40, 160, 48, 96, 56, 224, 72, 144,
     88, 208, 104, 176, 120, 240, 152, 200, 184, 232
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_64) || defined(ARM_TABLE_CFFT_Q15_64)
 const uint16_t armBitRevIndexTable_fixed_64[ARMBITREVINDEXTABLE_FIXED___64_TABLE_LENGTH] =
 {
     //radix 4, size 56
@@ -22253,7 +22332,9 @@ const uint16_t armBitRevIndexTable_fixed_64[ARMBITREVINDEXTABLE_FIXED___64_TABLE
     112, 224, 120, 480, 136, 272, 152, 400, 168, 336, 176, 208, 184, 464, 200, 304, 216, 432,
     232, 368, 248, 496, 280, 392, 296, 328, 312, 456, 344, 424, 376, 488, 440, 472
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_128) || defined(ARM_TABLE_CFFT_Q15_128)
 const uint16_t armBitRevIndexTable_fixed_128[ARMBITREVINDEXTABLE_FIXED__128_TABLE_LENGTH] =
 {
     //4x2, size 112
@@ -22264,7 +22345,9 @@ const uint16_t armBitRevIndexTable_fixed_128[ARMBITREVINDEXTABLE_FIXED__128_TABL
     472, 880, 488, 752, 504, 1008, 536, 776, 552, 648, 568, 904, 600, 840, 616, 712, 632, 968,
     664, 808, 696, 936, 728, 872, 760, 1000, 824, 920, 888, 984
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_256) || defined(ARM_TABLE_CFFT_Q15_256)
 const uint16_t armBitRevIndexTable_fixed_256[ARMBITREVINDEXTABLE_FIXED__256_TABLE_LENGTH] =
 {
     //radix 4, size 240
@@ -22283,7 +22366,9 @@ const uint16_t armBitRevIndexTable_fixed_256[ARMBITREVINDEXTABLE_FIXED__256_TABL
     1368, 1704, 1384, 1448, 1400, 1960, 1432, 1640, 1464, 1896, 1496, 1768, 1528, 2024, 1592, 1816,
     1624, 1688, 1656, 1944, 1720, 1880, 1784, 2008, 1912, 1976
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_512) || defined(ARM_TABLE_CFFT_Q15_512)
 const uint16_t armBitRevIndexTable_fixed_512[ARMBITREVINDEXTABLE_FIXED__512_TABLE_LENGTH] =
 {
     //4x2, size 480
@@ -22317,7 +22402,9 @@ const uint16_t armBitRevIndexTable_fixed_512[ARMBITREVINDEXTABLE_FIXED__512_TABL
     3128, 3608, 3160, 3352, 3192, 3864, 3256, 3736, 3288, 3480, 3320, 3992, 3384, 3672, 3448, 3928,
     3512, 3800, 3576, 4056, 3704, 3896, 3832, 4024
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_1024) || defined(ARM_TABLE_CFFT_Q15_1024)
 const uint16_t armBitRevIndexTable_fixed_1024[ARMBITREVINDEXTABLE_FIXED_1024_TABLE_LENGTH] =
 {
     //radix 4, size 992
@@ -22391,7 +22478,9 @@ const uint16_t armBitRevIndexTable_fixed_1024[ARMBITREVINDEXTABLE_FIXED_1024_TAB
     6872, 7000, 6904, 8024, 6968, 7384, 7032, 7896, 7096, 7640, 7160, 8152, 7288, 7736,
     7352, 7480, 7416, 7992, 7544, 7864, 7672, 8120, 7928, 8056
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_2048) || defined(ARM_TABLE_CFFT_Q15_2048)
 const uint16_t armBitRevIndexTable_fixed_2048[ARMBITREVINDEXTABLE_FIXED_2048_TABLE_LENGTH] =
 {
     //4x2, size 1984
@@ -22547,7 +22636,9 @@ const uint16_t armBitRevIndexTable_fixed_2048[ARMBITREVINDEXTABLE_FIXED_2048_TAB
     14456, 15416, 14520, 14904, 14584, 15928, 14712, 15672, 14776, 15160, 14840, 16184,
     14968, 15544, 15096, 16056, 15224, 15800, 15352, 16312, 15608, 15992, 15864, 16248
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_CFFT_Q31_4096) || defined(ARM_TABLE_CFFT_Q15_4096)
 const uint16_t armBitRevIndexTable_fixed_4096[ARMBITREVINDEXTABLE_FIXED_4096_TABLE_LENGTH] =
 {
     //radix 4, size 4032
@@ -22885,6 +22976,7 @@ const uint16_t armBitRevIndexTable_fixed_4096[ARMBITREVINDEXTABLE_FIXED_4096_TAB
     30456, 32184, 30584, 31672, 30712, 32696, 30968, 31864, 31096, 31352, 31224, 32376,
     31480, 32120, 31736, 32632, 32248, 32504
 };
+#endif
 
 /**
 * \par
@@ -22894,6 +22986,7 @@ const uint16_t armBitRevIndexTable_fixed_4096[ARMBITREVINDEXTABLE_FIXED_4096_TAB
 * \par
 * Real and Imag values are in interleaved fashion
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_FAST_F32_32)
 const float32_t twiddleCoef_rfft_32[32] =
 {
     0.0f,   1.0f,
@@ -22913,7 +23006,9 @@ const float32_t twiddleCoef_rfft_32[32] =
     0.382683432f,   -0.923879533f,
     0.195090322f,   -0.98078528f
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_FAST_F32_64)
 const float32_t twiddleCoef_rfft_64[64] =
 {
     0.0f,   1.0f,
@@ -22949,7 +23044,9 @@ const float32_t twiddleCoef_rfft_64[64] =
     0.195090322016129f, -0.98078528040323f,
     0.098017140329561f, -0.995184726672197f
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_FAST_F32_128)
 const float32_t twiddleCoef_rfft_128[128] =
 {
     0.000000000f,  1.000000000f,
@@ -23017,7 +23114,9 @@ const float32_t twiddleCoef_rfft_128[128] =
     0.098017140f, -0.995184727f,
     0.049067674f, -0.998795456f
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_FAST_F32_256)
 const float32_t twiddleCoef_rfft_256[256] =
 {
     0.000000000f,  1.000000000f,
@@ -23149,7 +23248,9 @@ const float32_t twiddleCoef_rfft_256[256] =
     0.049067674f, -0.998795456f,
     0.024541229f, -0.999698819f
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_FAST_F32_512)
 const float32_t twiddleCoef_rfft_512[512] =
 {
     0.000000000f,  1.000000000f,
@@ -23409,7 +23510,9 @@ const float32_t twiddleCoef_rfft_512[512] =
     0.024541229f, -0.999698819f,
     0.012271538f, -0.999924702f
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_FAST_F32_1024)
 const float32_t twiddleCoef_rfft_1024[1024] =
 {
     0.000000000f,  1.000000000f,
@@ -23925,7 +24028,9 @@ const float32_t twiddleCoef_rfft_1024[1024] =
     0.012271538f, -0.999924702f,
     0.006135885f, -0.999981175f
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_FAST_F32_2048)
 const float32_t twiddleCoef_rfft_2048[2048] =
 {
     0.000000000f,  1.000000000f,
@@ -24953,7 +25058,9 @@ const float32_t twiddleCoef_rfft_2048[2048] =
     0.006135885f, -0.999981175f,
     0.003067957f, -0.999995294f
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_FAST_F32_4096)
 const float32_t twiddleCoef_rfft_4096[4096] =
 {
     0.000000000f,  1.000000000f,
@@ -27005,6 +27112,7 @@ const float32_t twiddleCoef_rfft_4096[4096] =
     0.003067957f, -0.999995294f,
     0.001533980f, -0.999998823f
 };
+#endif
 
 
 /**
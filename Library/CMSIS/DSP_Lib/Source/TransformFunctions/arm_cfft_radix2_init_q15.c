@@ -85,7 +85,9 @@ arm_status arm_cfft_radix2_init_q15(
     S->fftLen = fftLen;
 
     /*  Initialise the Twiddle coefficient pointer */
+#if defined(ARM_ALL_FFT_TABLES)
     S->pTwiddle = (q15_t *) twiddleCoef_4096_q15;
+#endif
     /*  Initialise the Flag for selection of CFFT or CIFFT */
     S->ifftFlag = ifftFlag;
     /*  Initialise the Flag for calculation Bit reversal or not */
@@ -180,6 +182,17 @@ arm_status arm_cfft_radix2_init_q15(
             break;
     }
 
+#if !defined(ARM_ALL_FFT_TABLES)
+    /*  Only the twiddle table of the selected length is built, it is used with modifier 1 */
+    S->pTwiddle = (q15_t *) arm_cfft_radix_twiddle_q15(fftLen);
+    S->twidCoefModifier = 1u;
+
+    if(S->pTwiddle == NULL)
+    {
+        status = ARM_MATH_ARGUMENT_ERROR;
+    }
+#endif
+
     return (status);
 }
 
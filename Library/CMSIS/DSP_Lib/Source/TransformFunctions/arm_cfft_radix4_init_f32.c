@@ -86,7 +86,9 @@ arm_status arm_cfft_radix4_init_f32(
     S->fftLen = fftLen;
 
     /*  Initialise the Twiddle coefficient pointer */
+#if defined(ARM_ALL_FFT_TABLES)
     S->pTwiddle = (float32_t *) twiddleCoef;
+#endif
 
     /*  Initialise the Flag for selection of CFFT or CIFFT */
     S->ifftFlag = ifftFlag;
@@ -156,6 +158,17 @@ arm_status arm_cfft_radix4_init_f32(
             break;
     }
 
+#if !defined(ARM_ALL_FFT_TABLES)
+    /*  Only the twiddle table of the selected length is built, it is used with modifier 1 */
+    S->pTwiddle = (float32_t *) arm_cfft_radix_twiddle_f32(fftLen);
+    S->twidCoefModifier = 1u;
+
+    if(S->pTwiddle == NULL)
+    {
+        status = ARM_MATH_ARGUMENT_ERROR;
+    }
+#endif
+
     return (status);
 }
 
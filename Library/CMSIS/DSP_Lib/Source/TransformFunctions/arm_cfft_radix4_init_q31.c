@@ -83,7 +83,9 @@ arm_status arm_cfft_radix4_init_q31(
     /*  Initialise the FFT length */
     S->fftLen = fftLen;
     /*  Initialise the Twiddle coefficient pointer */
+#if defined(ARM_ALL_FFT_TABLES)
     S->pTwiddle = (q31_t *) twiddleCoef_4096_q31;
+#endif
     /*  Initialise the Flag for selection of CFFT or CIFFT */
     S->ifftFlag = ifftFlag;
     /*  Initialise the Flag for calculation Bit reversal or not */
@@ -139,6 +141,17 @@ arm_status arm_cfft_radix4_init_q31(
             break;
     }
 
+#if !defined(ARM_ALL_FFT_TABLES)
+    /*  Only the twiddle table of the selected length is built, it is used with modifier 1 */
+    S->pTwiddle = (q31_t *) arm_cfft_radix_twiddle_q31(fftLen);
+    S->twidCoefModifier = 1u;
+
+    if(S->pTwiddle == NULL)
+    {
+        status = ARM_MATH_ARGUMENT_ERROR;
+    }
+#endif
+
     return (status);
 }
 
@@ -39,6 +39,7 @@
 
 
 #include "arm_math.h"
+#include "arm_common_tables.h"
 
 /**
  * @ingroup groupTransforms
@@ -73,6 +74,7 @@
 * array length is <code>2*N</code>.
 */
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_128)
 static const q31_t WeightsQ31_128[256] =
 {
     0x7fffffff, 0x0, 0x7ffd885a, 0xfe6de2e0, 0x7ff62182, 0xfcdbd541, 0x7fe9cbc0,
@@ -140,7 +142,9 @@ static const q31_t WeightsQ31_128[256] =
     0x647d97c, 0x80277872, 0x4b6195d, 0x80163440, 0x3242abf, 0x8009de7e,
     0x1921d20, 0x800277a6,
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_512)
 static const q31_t WeightsQ31_512[1024] =
 {
     0x7fffffff, 0x0, 0x7fffd886, 0xff9b781d, 0x7fff6216, 0xff36f078, 0x7ffe9cb2,
@@ -400,7 +404,9 @@ static const q31_t WeightsQ31_512[1024] =
     0x1921d20, 0x800277a6, 0x12d96b1, 0x8001634e, 0xc90f88, 0x80009dea,
     0x6487e3, 0x8000277a,
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_2048)
 static const q31_t WeightsQ31_2048[4096] =
 {
     0x7fffffff, 0x0, 0x7ffffd88, 0xffe6de05, 0x7ffff621, 0xffcdbc0b, 0x7fffe9cb,
@@ -1428,7 +1434,9 @@ static const q31_t WeightsQ31_2048[4096] =
     0x6487e3, 0x8000277a, 0x4b65ee, 0x80001635, 0x3243f5, 0x800009df, 0x1921fb,
     0x80000278,
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_8192)
 static const q31_t WeightsQ31_8192[16384] =
 {
     0x7fffffff, 0x0, 0x7fffffd9, 0xfff9b781, 0x7fffff62, 0xfff36f02, 0x7ffffe9d,
@@ -5529,6 +5537,7 @@ static const q31_t WeightsQ31_8192[16384] =
     0x80000027,
 
 };
+#endif
 
 /**
 * \par
@@ -5547,6 +5556,7 @@ static const q31_t WeightsQ31_8192[16384] =
 */
 
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_128)
 static const q31_t cos_factorsQ31_128[128] =
 {
     0x7fff6216, 0x7ffa72d1, 0x7ff09478, 0x7fe1c76b, 0x7fce0c3e, 0x7fb563b3,
@@ -5582,7 +5592,9 @@ static const q31_t cos_factorsQ31_128[128] =
     0xbc3ac35, 0xa3308bd, 0x8a2009a, 0x710a345, 0x57f0035, 0x3ed26e6, 0x25b26d7,
     0xc90f88,
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_512)
 static const q31_t cos_factorsQ31_512[512] =
 {
     0x7ffff621, 0x7fffa72c, 0x7fff0943, 0x7ffe1c65, 0x7ffce093, 0x7ffb55ce,
@@ -5714,7 +5726,9 @@ static const q31_t cos_factorsQ31_512[512] =
     0x2f1ea6c, 0x28d6870, 0x228e4e2, 0x1c45ffe, 0x15fda03, 0xfb5330, 0x96cbc1,
     0x3243f5,
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_2048)
 static const q31_t cos_factorsQ31_2048[2048] =
 {
     0x7fffff62, 0x7ffffa73, 0x7ffff094, 0x7fffe1c6, 0x7fffce09, 0x7fffb55c,
@@ -6231,7 +6245,9 @@ static const q31_t cos_factorsQ31_2048[2048] =
     0xc90fe,
 
 };
+#endif
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_8192)
 static const q31_t cos_factorsQ31_8192[8192] =
 {
     0x7ffffff6, 0x7fffffa7, 0x7fffff09, 0x7ffffe1c, 0x7ffffce1, 0x7ffffb56,
@@ -8283,6 +8299,7 @@ static const q31_t cos_factorsQ31_8192[8192] =
     0x2f1fb6, 0x28d738, 0x228eb9, 0x1c463b, 0x15fdbc, 0xfb53d, 0x96cbe, 0x3243f,
 
 };
+#endif
 
 /**
  * @brief  Initialization function for the Q31 DCT4/IDCT4.
@@ -8310,18 +8327,6 @@ arm_status arm_dct4_init_q31(
     /*  Initialise the default arm status */
     arm_status status = ARM_MATH_SUCCESS;
 
-    /* Initializing the pointer array with the weight table base addresses of different lengths */
-    q31_t *twiddlePtr[4] = { (q31_t *) WeightsQ31_128, (q31_t *) WeightsQ31_512,
-                             (q31_t *) WeightsQ31_2048, (q31_t *) WeightsQ31_8192
-                           };
-
-    /* Initializing the pointer array with the cos factor table base addresses of different lengths */
-    q31_t *pCosFactor[4] =
-    {
-        (q31_t *) cos_factorsQ31_128, (q31_t *) cos_factorsQ31_512,
-        (q31_t *) cos_factorsQ31_2048, (q31_t *) cos_factorsQ31_8192
-    };
-
     /* Initialize the DCT4 length */
     S->N = N;
 
@@ -8340,22 +8345,30 @@ arm_status arm_dct4_init_q31(
     switch(N)
     {
         /* Initialize the table modifier values */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_8192)
         case 8192u:
-            S->pTwiddle = twiddlePtr[3];
-            S->pCosFactor = pCosFactor[3];
+            S->pTwiddle = (q31_t *) WeightsQ31_8192;
+            S->pCosFactor = (q31_t *) cos_factorsQ31_8192;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_2048)
         case 2048u:
-            S->pTwiddle = twiddlePtr[2];
-            S->pCosFactor = pCosFactor[2];
+            S->pTwiddle = (q31_t *) WeightsQ31_2048;
+            S->pCosFactor = (q31_t *) cos_factorsQ31_2048;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_512)
         case 512u:
-            S->pTwiddle = twiddlePtr[1];
-            S->pCosFactor = pCosFactor[1];
+            S->pTwiddle = (q31_t *) WeightsQ31_512;
+            S->pCosFactor = (q31_t *) cos_factorsQ31_512;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_128)
         case 128u:
-            S->pTwiddle = twiddlePtr[0];
-            S->pCosFactor = pCosFactor[0];
+            S->pTwiddle = (q31_t *) WeightsQ31_128;
+            S->pCosFactor = (q31_t *) cos_factorsQ31_128;
             break;
+#endif
         default:
             status = ARM_MATH_ARGUMENT_ERROR;
     }
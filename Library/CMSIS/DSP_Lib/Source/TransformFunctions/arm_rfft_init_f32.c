@@ -39,6 +39,7 @@
 
 
 #include "arm_math.h"
+#include "arm_common_tables.h"
 
 /**
  * @ingroup groupTransforms
@@ -63,6 +64,7 @@
 
 
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_F32)
 static const float32_t realCoefA[8192] =
 {
     0.500000000000000f, -0.500000000000000f, 0.499616503715515f,
@@ -4162,6 +4164,7 @@ static const float32_t realCoefA[8192] =
     0.499233007431030f, 0.499999403953552f, 0.499616503715515f,
     0.499999850988388f,
 };
+#endif
 
 
 /**
@@ -4176,6 +4179,7 @@ static const float32_t realCoefA[8192] =
 *  } </pre>
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_F32)
 static const float32_t realCoefB[8192] =
 {
     0.500000000000000f, 0.500000000000000f, 0.500383496284485f,
@@ -8275,6 +8279,7 @@ static const float32_t realCoefB[8192] =
     0.500766992568970f, -0.499999403953552f, 0.500383496284485f,
     -0.499999850988388f,
 };
+#endif
 
 
 
@@ -8319,11 +8324,13 @@ arm_status arm_rfft_init_f32(
     /*  Initialize the Complex FFT length */
     S->fftLenBy2 = (uint16_t) fftLenReal / 2u;
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_F32)
     /*  Initialize the Twiddle coefficientA pointer */
     S->pTwiddleAReal = (float32_t *) realCoefA;
 
     /*  Initialize the Twiddle coefficientB pointer */
     S->pTwiddleBReal = (float32_t *) realCoefB;
+#endif
 
     /*  Initialize the Flag for selection of RFFT or RIFFT */
     S->ifftFlagR = (uint8_t) ifftFlagR;
@@ -8335,18 +8342,26 @@ arm_status arm_rfft_init_f32(
     switch(S->fftLenReal)
     {
         /* Init table modifier value */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_F32_8192)
         case 8192u:
             S->twidCoefRModifier = 1u;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_F32_2048)
         case 2048u:
             S->twidCoefRModifier = 4u;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_F32_512)
         case 512u:
             S->twidCoefRModifier = 16u;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_F32_128)
         case 128u:
             S->twidCoefRModifier = 64u;
             break;
+#endif
         default:
             /*  Reporting argument error if rfftSize is not valid value */
             status = ARM_MATH_ARGUMENT_ERROR;
@@ -67,6 +67,7 @@
 * Convert to fixed point Q15 format
 *       round(pATable[i] * pow(2, 15))
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_Q15)
 static const q15_t ALIGN4 realCoefAQ15[8192] =
 {
     0x4000, 0xc000, 0x3ff3, 0xc000, 0x3fe7, 0xc000, 0x3fda, 0xc000,
@@ -1094,6 +1095,7 @@ static const q15_t ALIGN4 realCoefAQ15[8192] =
     0x3f9b, 0x4000, 0x3fa8, 0x4000, 0x3fb5, 0x4000, 0x3fc1, 0x4000,
     0x3fce, 0x4000, 0x3fda, 0x4000, 0x3fe7, 0x4000, 0x3ff3, 0x4000,
 };
+#endif
 
 /**
 * \par
@@ -1110,6 +1112,7 @@ static const q15_t ALIGN4 realCoefAQ15[8192] =
 *       round(pBTable[i] * pow(2, 15))
 *
 */
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_Q15)
 static const q15_t ALIGN4 realCoefBQ15[8192] =
 {
     0x4000, 0x4000, 0x400d, 0x4000, 0x4019, 0x4000, 0x4026, 0x4000,
@@ -2137,6 +2140,7 @@ static const q15_t ALIGN4 realCoefBQ15[8192] =
     0x4065, 0xc000, 0x4058, 0xc000, 0x404b, 0xc000, 0x403f, 0xc000,
     0x4032, 0xc000, 0x4026, 0xc000, 0x4019, 0xc000, 0x400d, 0xc000,
 };
+#endif
 
 /**
 * @brief  Initialization function for the Q15 RFFT/RIFFT.
@@ -2170,11 +2174,13 @@ arm_status arm_rfft_init_q15(
     /*  Initialize the Real FFT length */
     S->fftLenReal = (uint16_t) fftLenReal;
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_Q15)
     /*  Initialize the Twiddle coefficientA pointer */
     S->pTwiddleAReal = (q15_t *) realCoefAQ15;
 
     /*  Initialize the Twiddle coefficientB pointer */
     S->pTwiddleBReal = (q15_t *) realCoefBQ15;
+#endif
 
     /*  Initialize the Flag for selection of RFFT or RIFFT */
     S->ifftFlagR = (uint8_t) ifftFlagR;
@@ -2185,42 +2191,60 @@ arm_status arm_rfft_init_q15(
     /*  Initialization of coef modifier depending on the FFT length */
     switch(S->fftLenReal)
     {
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q15_8192)
         case 8192u:
             S->twidCoefRModifier = 1u;
             S->pCfft = &arm_cfft_sR_q15_len4096;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q15_4096)
         case 4096u:
             S->twidCoefRModifier = 2u;
             S->pCfft = &arm_cfft_sR_q15_len2048;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q15_2048)
         case 2048u:
             S->twidCoefRModifier = 4u;
             S->pCfft = &arm_cfft_sR_q15_len1024;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q15_1024)
         case 1024u:
             S->twidCoefRModifier = 8u;
             S->pCfft = &arm_cfft_sR_q15_len512;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q15_512)
         case 512u:
             S->twidCoefRModifier = 16u;
             S->pCfft = &arm_cfft_sR_q15_len256;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q15_256)
         case 256u:
             S->twidCoefRModifier = 32u;
             S->pCfft = &arm_cfft_sR_q15_len128;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q15_128)
         case 128u:
             S->twidCoefRModifier = 64u;
             S->pCfft = &arm_cfft_sR_q15_len64;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q15_64)
         case 64u:
             S->twidCoefRModifier = 128u;
             S->pCfft = &arm_cfft_sR_q15_len32;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q15_32)
         case 32u:
             S->twidCoefRModifier = 256u;
             S->pCfft = &arm_cfft_sR_q15_len16;
             break;
+#endif
         default:
             /*  Reporting argument error if rfftSize is not valid value */
             status = ARM_MATH_ARGUMENT_ERROR;
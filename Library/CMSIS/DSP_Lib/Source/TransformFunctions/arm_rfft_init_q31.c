@@ -66,6 +66,7 @@
 */
 
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_Q31)
 static const q31_t realCoefAQ31[8192] =
 {
     0x40000000, 0xc0000000, 0x3ff36f02, 0xc000013c,
@@ -2117,6 +2118,7 @@ static const q31_t realCoefAQ31[8192] =
     0x3fcdbc0f, 0x3fffec43, 0x3fda4d09, 0x3ffff4e6,
     0x3fe6de05, 0x3ffffb11, 0x3ff36f02, 0x3ffffec4,
 };
+#endif
 
 
 /**
@@ -2135,6 +2137,7 @@ static const q31_t realCoefAQ31[8192] =
 *
 */
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_Q31)
 static const q31_t realCoefBQ31[8192] =
 {
     0x40000000, 0x40000000, 0x400c90fe, 0x3ffffec4,
@@ -4186,6 +4189,7 @@ static const q31_t realCoefBQ31[8192] =
     0x403243f1, 0xc00013bd, 0x4025b2f7, 0xc0000b1a,
     0x401921fb, 0xc00004ef, 0x400c90fe, 0xc000013c,
 };
+#endif
 
 /**
 * @brief  Initialization function for the Q31 RFFT/RIFFT.
@@ -4220,11 +4224,13 @@ arm_status arm_rfft_init_q31(
     /*  Initialize the Real FFT length */
     S->fftLenReal = (uint16_t) fftLenReal;
 
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_Q31)
     /*  Initialize the Twiddle coefficientA pointer */
     S->pTwiddleAReal = (q31_t *) realCoefAQ31;
 
     /*  Initialize the Twiddle coefficientB pointer */
     S->pTwiddleBReal = (q31_t *) realCoefBQ31;
+#endif
 
     /*  Initialize the Flag for selection of RFFT or RIFFT */
     S->ifftFlagR = (uint8_t) ifftFlagR;
@@ -4235,42 +4241,60 @@ arm_status arm_rfft_init_q31(
     /*  Initialization of coef modifier depending on the FFT length */
     switch(S->fftLenReal)
     {
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q31_8192)
         case 8192u:
             S->twidCoefRModifier = 1u;
             S->pCfft = &arm_cfft_sR_q31_len4096;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q31_4096)
         case 4096u:
             S->twidCoefRModifier = 2u;
             S->pCfft = &arm_cfft_sR_q31_len2048;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q31_2048)
         case 2048u:
             S->twidCoefRModifier = 4u;
             S->pCfft = &arm_cfft_sR_q31_len1024;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q31_1024)
         case 1024u:
             S->twidCoefRModifier = 8u;
             S->pCfft = &arm_cfft_sR_q31_len512;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q31_512)
         case 512u:
             S->twidCoefRModifier = 16u;
             S->pCfft = &arm_cfft_sR_q31_len256;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q31_256)
         case 256u:
             S->twidCoefRModifier = 32u;
             S->pCfft = &arm_cfft_sR_q31_len128;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q31_128)
         case 128u:
             S->twidCoefRModifier = 64u;
             S->pCfft = &arm_cfft_sR_q31_len64;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q31_64)
         case 64u:
             S->twidCoefRModifier = 128u;
             S->pCfft = &arm_cfft_sR_q31_len32;
             break;
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_RFFT_Q31_32)
         case 32u:
             S->twidCoefRModifier = 256u;
             S->pCfft = &arm_cfft_sR_q31_len16;
             break;
+#endif
         default:
             /*  Reporting argument error if rfftSize is not valid value */
             status = ARM_MATH_ARGUMENT_ERROR;
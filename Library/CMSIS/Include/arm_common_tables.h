@@ -42,6 +42,193 @@
 
 #include "arm_math.h"
 
+/*
+ * Table selection
+ *
+ * By default all tables are built. When ARM_DSP_CONFIG_TABLES is defined, only the tables
+ * needed by the transforms selected below are built, which saves flash on small parts.
+ * Define the macros for the library build and the application (e.g. in the project options):
+ *
+ *   ARM_TABLE_CFFT_F32_<N>       arm_cfft_f32, arm_cfft_radix2_f32, arm_cfft_radix4_f32  N = 16 .. 4096
+ *   ARM_TABLE_CFFT_Q31_<N>       arm_cfft_q31, arm_cfft_radix2_q31, arm_cfft_radix4_q31  N = 16 .. 4096
+ *   ARM_TABLE_CFFT_Q15_<N>       arm_cfft_q15, arm_cfft_radix2_q15, arm_cfft_radix4_q15  N = 16 .. 4096
+ *   ARM_TABLE_RFFT_FAST_F32_<N>  arm_rfft_fast_f32                                       N = 32 .. 4096
+ *   ARM_TABLE_RFFT_F32_<N>       arm_rfft_f32                                            N = 128, 512, 2048, 8192
+ *   ARM_TABLE_RFFT_Q31_<N>       arm_rfft_q31                                            N = 32 .. 8192
+ *   ARM_TABLE_RFFT_Q15_<N>       arm_rfft_q15                                            N = 32 .. 8192
+ *   ARM_TABLE_DCT4_F32_<N>       arm_dct4_f32                                            N = 128, 512, 2048, 8192
+ *   ARM_TABLE_DCT4_Q31_<N>       arm_dct4_q31                                            N = 128, 512, 2048, 8192
+ *   ARM_TABLE_DCT4_Q15_<N>       arm_dct4_q15                                            N = 128, 512, 2048, 8192
+ *
+ * e.g. ARM_DSP_CONFIG_TABLES and ARM_TABLE_CFFT_Q15_256 for a 256 point arm_cfft_radix4_q15.
+ * Radix-2 and radix-4 transforms then use the twiddle table of their own length instead of the
+ * 4096 point table. Init functions return ARM_MATH_ARGUMENT_ERROR for a length not selected.
+ * Sine, cosine and reciprocal tables are not affected.
+ */
+#ifndef ARM_DSP_CONFIG_TABLES
+#define ARM_ALL_FFT_TABLES
+#else
+
+/* DCT4 uses the real FFT of the same length */
+#if defined(ARM_TABLE_DCT4_F32_128) && !defined(ARM_TABLE_RFFT_F32_128)
+#define ARM_TABLE_RFFT_F32_128
+#endif
+#if defined(ARM_TABLE_DCT4_F32_512) && !defined(ARM_TABLE_RFFT_F32_512)
+#define ARM_TABLE_RFFT_F32_512
+#endif
+#if defined(ARM_TABLE_DCT4_F32_2048) && !defined(ARM_TABLE_RFFT_F32_2048)
+#define ARM_TABLE_RFFT_F32_2048
+#endif
+#if defined(ARM_TABLE_DCT4_F32_8192) && !defined(ARM_TABLE_RFFT_F32_8192)
+#define ARM_TABLE_RFFT_F32_8192
+#endif
+#if defined(ARM_TABLE_DCT4_Q31_128) && !defined(ARM_TABLE_RFFT_Q31_128)
+#define ARM_TABLE_RFFT_Q31_128
+#endif
+#if defined(ARM_TABLE_DCT4_Q31_512) && !defined(ARM_TABLE_RFFT_Q31_512)
+#define ARM_TABLE_RFFT_Q31_512
+#endif
+#if defined(ARM_TABLE_DCT4_Q31_2048) && !defined(ARM_TABLE_RFFT_Q31_2048)
+#define ARM_TABLE_RFFT_Q31_2048
+#endif
+#if defined(ARM_TABLE_DCT4_Q31_8192) && !defined(ARM_TABLE_RFFT_Q31_8192)
+#define ARM_TABLE_RFFT_Q31_8192
+#endif
+#if defined(ARM_TABLE_DCT4_Q15_128) && !defined(ARM_TABLE_RFFT_Q15_128)
+#define ARM_TABLE_RFFT_Q15_128
+#endif
+#if defined(ARM_TABLE_DCT4_Q15_512) && !defined(ARM_TABLE_RFFT_Q15_512)
+#define ARM_TABLE_RFFT_Q15_512
+#endif
+#if defined(ARM_TABLE_DCT4_Q15_2048) && !defined(ARM_TABLE_RFFT_Q15_2048)
+#define ARM_TABLE_RFFT_Q15_2048
+#endif
+#if defined(ARM_TABLE_DCT4_Q15_8192) && !defined(ARM_TABLE_RFFT_Q15_8192)
+#define ARM_TABLE_RFFT_Q15_8192
+#endif
+
+/* Real FFT uses the complex FFT of half length */
+#if defined(ARM_TABLE_RFFT_FAST_F32_32) && !defined(ARM_TABLE_CFFT_F32_16)
+#define ARM_TABLE_CFFT_F32_16
+#endif
+#if defined(ARM_TABLE_RFFT_FAST_F32_64) && !defined(ARM_TABLE_CFFT_F32_32)
+#define ARM_TABLE_CFFT_F32_32
+#endif
+#if defined(ARM_TABLE_RFFT_FAST_F32_128) && !defined(ARM_TABLE_CFFT_F32_64)
+#define ARM_TABLE_CFFT_F32_64
+#endif
+#if defined(ARM_TABLE_RFFT_FAST_F32_256) && !defined(ARM_TABLE_CFFT_F32_128)
+#define ARM_TABLE_CFFT_F32_128
+#endif
+#if defined(ARM_TABLE_RFFT_FAST_F32_512) && !defined(ARM_TABLE_CFFT_F32_256)
+#define ARM_TABLE_CFFT_F32_256
+#endif
+#if defined(ARM_TABLE_RFFT_FAST_F32_1024) && !defined(ARM_TABLE_CFFT_F32_512)
+#define ARM_TABLE_CFFT_F32_512
+#endif
+#if defined(ARM_TABLE_RFFT_FAST_F32_2048) && !defined(ARM_TABLE_CFFT_F32_1024)
+#define ARM_TABLE_CFFT_F32_1024
+#endif
+#if defined(ARM_TABLE_RFFT_FAST_F32_4096) && !defined(ARM_TABLE_CFFT_F32_2048)
+#define ARM_TABLE_CFFT_F32_2048
+#endif
+#if defined(ARM_TABLE_RFFT_F32_128) && !defined(ARM_TABLE_CFFT_F32_64)
+#define ARM_TABLE_CFFT_F32_64
+#endif
+#if defined(ARM_TABLE_RFFT_F32_512) && !defined(ARM_TABLE_CFFT_F32_256)
+#define ARM_TABLE_CFFT_F32_256
+#endif
+#if defined(ARM_TABLE_RFFT_F32_2048) && !defined(ARM_TABLE_CFFT_F32_1024)
+#define ARM_TABLE_CFFT_F32_1024
+#endif
+#if defined(ARM_TABLE_RFFT_F32_8192) && !defined(ARM_TABLE_CFFT_F32_4096)
+#define ARM_TABLE_CFFT_F32_4096
+#endif
+#if defined(ARM_TABLE_RFFT_Q31_32) && !defined(ARM_TABLE_CFFT_Q31_16)
+#define ARM_TABLE_CFFT_Q31_16
+#endif
+#if defined(ARM_TABLE_RFFT_Q31_64) && !defined(ARM_TABLE_CFFT_Q31_32)
+#define ARM_TABLE_CFFT_Q31_32
+#endif
+#if defined(ARM_TABLE_RFFT_Q31_128) && !defined(ARM_TABLE_CFFT_Q31_64)
+#define ARM_TABLE_CFFT_Q31_64
+#endif
+#if defined(ARM_TABLE_RFFT_Q31_256) && !defined(ARM_TABLE_CFFT_Q31_128)
+#define ARM_TABLE_CFFT_Q31_128
+#endif
+#if defined(ARM_TABLE_RFFT_Q31_512) && !defined(ARM_TABLE_CFFT_Q31_256)
+#define ARM_TABLE_CFFT_Q31_256
+#endif
+#if defined(ARM_TABLE_RFFT_Q31_1024) && !defined(ARM_TABLE_CFFT_Q31_512)
+#define ARM_TABLE_CFFT_Q31_512
+#endif
+#if defined(ARM_TABLE_RFFT_Q31_2048) && !defined(ARM_TABLE_CFFT_Q31_1024)
+#define ARM_TABLE_CFFT_Q31_1024
+#endif
+#if defined(ARM_TABLE_RFFT_Q31_4096) && !defined(ARM_TABLE_CFFT_Q31_2048)
+#define ARM_TABLE_CFFT_Q31_2048
+#endif
+#if defined(ARM_TABLE_RFFT_Q31_8192) && !defined(ARM_TABLE_CFFT_Q31_4096)
+#define ARM_TABLE_CFFT_Q31_4096
+#endif
+#if defined(ARM_TABLE_RFFT_Q15_32) && !defined(ARM_TABLE_CFFT_Q15_16)
+#define ARM_TABLE_CFFT_Q15_16
+#endif
+#if defined(ARM_TABLE_RFFT_Q15_64) && !defined(ARM_TABLE_CFFT_Q15_32)
+#define ARM_TABLE_CFFT_Q15_32
+#endif
+#if defined(ARM_TABLE_RFFT_Q15_128) && !defined(ARM_TABLE_CFFT_Q15_64)
+#define ARM_TABLE_CFFT_Q15_64
+#endif
+#if defined(ARM_TABLE_RFFT_Q15_256) && !defined(ARM_TABLE_CFFT_Q15_128)
+#define ARM_TABLE_CFFT_Q15_128
+#endif
+#if defined(ARM_TABLE_RFFT_Q15_512) && !defined(ARM_TABLE_CFFT_Q15_256)
+#define ARM_TABLE_CFFT_Q15_256
+#endif
+#if defined(ARM_TABLE_RFFT_Q15_1024) && !defined(ARM_TABLE_CFFT_Q15_512)
+#define ARM_TABLE_CFFT_Q15_512
+#endif
+#if defined(ARM_TABLE_RFFT_Q15_2048) && !defined(ARM_TABLE_CFFT_Q15_1024)
+#define ARM_TABLE_CFFT_Q15_1024
+#endif
+#if defined(ARM_TABLE_RFFT_Q15_4096) && !defined(ARM_TABLE_CFFT_Q15_2048)
+#define ARM_TABLE_CFFT_Q15_2048
+#endif
+#if defined(ARM_TABLE_RFFT_Q15_8192) && !defined(ARM_TABLE_CFFT_Q15_4096)
+#define ARM_TABLE_CFFT_Q15_4096
+#endif
+
+/* Real FFT coefficient tables are shared by all lengths */
+#if defined(ARM_TABLE_RFFT_F32_128) || defined(ARM_TABLE_RFFT_F32_512) || defined(ARM_TABLE_RFFT_F32_2048) || \
+    defined(ARM_TABLE_RFFT_F32_8192)
+#define ARM_TABLE_REALCOEF_F32
+#endif
+#if defined(ARM_TABLE_RFFT_Q31_32) || defined(ARM_TABLE_RFFT_Q31_64) || defined(ARM_TABLE_RFFT_Q31_128) || \
+    defined(ARM_TABLE_RFFT_Q31_256) || defined(ARM_TABLE_RFFT_Q31_512) || defined(ARM_TABLE_RFFT_Q31_1024) || \
+    defined(ARM_TABLE_RFFT_Q31_2048) || defined(ARM_TABLE_RFFT_Q31_4096) || defined(ARM_TABLE_RFFT_Q31_8192)
+#define ARM_TABLE_REALCOEF_Q31
+#endif
+#if defined(ARM_TABLE_RFFT_Q15_32) || defined(ARM_TABLE_RFFT_Q15_64) || defined(ARM_TABLE_RFFT_Q15_128) || \
+    defined(ARM_TABLE_RFFT_Q15_256) || defined(ARM_TABLE_RFFT_Q15_512) || defined(ARM_TABLE_RFFT_Q15_1024) || \
+    defined(ARM_TABLE_RFFT_Q15_2048) || defined(ARM_TABLE_RFFT_Q15_4096) || defined(ARM_TABLE_RFFT_Q15_8192)
+#define ARM_TABLE_REALCOEF_Q15
+#endif
+
+/* Bit reversal table of radix-2 and radix-4 transforms */
+#if defined(ARM_TABLE_CFFT_F32_16) || defined(ARM_TABLE_CFFT_F32_32) || defined(ARM_TABLE_CFFT_F32_64) || \
+    defined(ARM_TABLE_CFFT_F32_128) || defined(ARM_TABLE_CFFT_F32_256) || defined(ARM_TABLE_CFFT_F32_512) || \
+    defined(ARM_TABLE_CFFT_F32_1024) || defined(ARM_TABLE_CFFT_F32_2048) || defined(ARM_TABLE_CFFT_F32_4096) || \
+    defined(ARM_TABLE_CFFT_Q31_16) || defined(ARM_TABLE_CFFT_Q31_32) || defined(ARM_TABLE_CFFT_Q31_64) || \
+    defined(ARM_TABLE_CFFT_Q31_128) || defined(ARM_TABLE_CFFT_Q31_256) || defined(ARM_TABLE_CFFT_Q31_512) || \
+    defined(ARM_TABLE_CFFT_Q31_1024) || defined(ARM_TABLE_CFFT_Q31_2048) || defined(ARM_TABLE_CFFT_Q31_4096) || \
+    defined(ARM_TABLE_CFFT_Q15_16) || defined(ARM_TABLE_CFFT_Q15_32) || defined(ARM_TABLE_CFFT_Q15_64) || \
+    defined(ARM_TABLE_CFFT_Q15_128) || defined(ARM_TABLE_CFFT_Q15_256) || defined(ARM_TABLE_CFFT_Q15_512) || \
+    defined(ARM_TABLE_CFFT_Q15_1024) || defined(ARM_TABLE_CFFT_Q15_2048) || defined(ARM_TABLE_CFFT_Q15_4096)
+#define ARM_TABLE_BITREV_1024
+#endif
+#endif /* ARM_DSP_CONFIG_TABLES */
+
 extern const uint16_t armBitRevTable[1024];
 extern const q15_t armRecipTableQ15[64];
 extern const q31_t armRecipTableQ31[64];
@@ -132,4 +319,149 @@ extern const float32_t sinTable_f32[FAST_MATH_TABLE_SIZE + 1];
 extern const q31_t sinTable_q31[FAST_MATH_TABLE_SIZE + 1];
 extern const q15_t sinTable_q15[FAST_MATH_TABLE_SIZE + 1];
 
+#ifndef ARM_ALL_FFT_TABLES
+/*
+ * Twiddle table of the given length for radix-2 and radix-4 transforms, used with
+ * twiddle coefficient modifier 1. Returns NULL if the length is not selected.
+ */
+static __INLINE const float32_t * arm_cfft_radix_twiddle_f32(
+    uint16_t fftLen)
+{
+    switch(fftLen)
+    {
+#if defined(ARM_TABLE_CFFT_F32_16)
+        case 16u:
+            return twiddleCoef_16;
+#endif
+#if defined(ARM_TABLE_CFFT_F32_32)
+        case 32u:
+            return twiddleCoef_32;
+#endif
+#if defined(ARM_TABLE_CFFT_F32_64)
+        case 64u:
+            return twiddleCoef_64;
+#endif
+#if defined(ARM_TABLE_CFFT_F32_128)
+        case 128u:
+            return twiddleCoef_128;
+#endif
+#if defined(ARM_TABLE_CFFT_F32_256)
+        case 256u:
+            return twiddleCoef_256;
+#endif
+#if defined(ARM_TABLE_CFFT_F32_512)
+        case 512u:
+            return twiddleCoef_512;
+#endif
+#if defined(ARM_TABLE_CFFT_F32_1024)
+        case 1024u:
+            return twiddleCoef_1024;
+#endif
+#if defined(ARM_TABLE_CFFT_F32_2048)
+        case 2048u:
+            return twiddleCoef_2048;
+#endif
+#if defined(ARM_TABLE_CFFT_F32_4096)
+        case 4096u:
+            return twiddleCoef_4096;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+static __INLINE const q31_t * arm_cfft_radix_twiddle_q31(
+    uint16_t fftLen)
+{
+    switch(fftLen)
+    {
+#if defined(ARM_TABLE_CFFT_Q31_16)
+        case 16u:
+            return twiddleCoef_16_q31;
+#endif
+#if defined(ARM_TABLE_CFFT_Q31_32)
+        case 32u:
+            return twiddleCoef_32_q31;
+#endif
+#if defined(ARM_TABLE_CFFT_Q31_64)
+        case 64u:
+            return twiddleCoef_64_q31;
+#endif
+#if defined(ARM_TABLE_CFFT_Q31_128)
+        case 128u:
+            return twiddleCoef_128_q31;
+#endif
+#if defined(ARM_TABLE_CFFT_Q31_256)
+        case 256u:
+            return twiddleCoef_256_q31;
+#endif
+#if defined(ARM_TABLE_CFFT_Q31_512)
+        case 512u:
+            return twiddleCoef_512_q31;
+#endif
+#if defined(ARM_TABLE_CFFT_Q31_1024)
+        case 1024u:
+            return twiddleCoef_1024_q31;
+#endif
+#if defined(ARM_TABLE_CFFT_Q31_2048)
+        case 2048u:
+            return twiddleCoef_2048_q31;
+#endif
+#if defined(ARM_TABLE_CFFT_Q31_4096)
+        case 4096u:
+            return twiddleCoef_4096_q31;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+static __INLINE const q15_t * arm_cfft_radix_twiddle_q15(
+    uint16_t fftLen)
+{
+    switch(fftLen)
+    {
+#if defined(ARM_TABLE_CFFT_Q15_16)
+        case 16u:
+            return twiddleCoef_16_q15;
+#endif
+#if defined(ARM_TABLE_CFFT_Q15_32)
+        case 32u:
+            return twiddleCoef_32_q15;
+#endif
+#if defined(ARM_TABLE_CFFT_Q15_64)
+        case 64u:
+            return twiddleCoef_64_q15;
+#endif
+#if defined(ARM_TABLE_CFFT_Q15_128)
+        case 128u:
+            return twiddleCoef_128_q15;
+#endif
+#if defined(ARM_TABLE_CFFT_Q15_256)
+        case 256u:
+            return twiddleCoef_256_q15;
+#endif
+#if defined(ARM_TABLE_CFFT_Q15_512)
+        case 512u:
+            return twiddleCoef_512_q15;
+#endif
+#if defined(ARM_TABLE_CFFT_Q15_1024)
+        case 1024u:
+            return twiddleCoef_1024_q15;
+#endif
+#if defined(ARM_TABLE_CFFT_Q15_2048)
+        case 2048u:
+            return twiddleCoef_2048_q15;
+#endif
+#if defined(ARM_TABLE_CFFT_Q15_4096)
+        case 4096u:
+            return twiddleCoef_4096_q15;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+#endif /* ARM_ALL_FFT_TABLES */
+
 #endif /*  ARM_COMMON_TABLES_H */
@@ -104,6 +104,26 @@ typedef enum IRQn
 #endif
 
 
+/**
+ * Place a function in SRAM
+ *
+ * A function defined with RAMFUNC is copied from flash to SRAM at boot and runs without flash wait states.
+ *  - IAR : __ramfunc, copied by the C startup with the initialized data.
+ *  - GCC : section .ramfunc, linked into .data by gcc_arm.ld and copied by Reset_Handler.
+ *  - Keil: section .ramfunc, copied by scatter-loading. The project must use a scatter file placing
+ *          .ramfunc in SRAM, such as Source/ARM/ramfunc.sct. Otherwise the function stays in flash.
+ */
+#ifndef RAMFUNC
+#if defined ( __ICCARM__ )
+#define RAMFUNC     __ramfunc
+#elif defined ( __CC_ARM ) || defined ( __GNUC__ )
+#define RAMFUNC     __attribute__((section(".ramfunc"), noinline))
+#else
+#define RAMFUNC
+#endif
+#endif
+
+
 /**
  * Initialize the system clock
  *
@@ -17545,12 +17565,12 @@ typedef volatile unsigned short vu16;
 #include "wdt.h"
 #include "wwdt.h"
 #include "rtc.h"
+#include "pdma.h"
 #include "uart.h"
 #include "hdiv.h"
 #include "acmp.h"
 #include "crc.h"
 #include "usbd.h"
-#include "pdma.h"
 #include "ebi.h"
 #include "sc.h"
 #include "scuart.h"
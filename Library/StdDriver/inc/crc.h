@@ -51,9 +51,32 @@ extern "C"
 #define CRC_CPU_WDATA_16    0x10000000UL            /*!<CRC CPU Write Data length is 16-bit */
 #define CRC_CPU_WDATA_32    0x20000000UL            /*!<CRC CPU Write Data length is 32-bit */
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*  CRC_Calculate Constant Definitions                                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+#define CRC_PDMA_MIN_LEN    32UL                    /*!<Minimum aligned byte count to feed CRC by PDMA */
+#define CRC_PDMA_MAX_CNT    16384UL                 /*!<Maximum word count of one PDMA job descriptor */
+
 /*@}*/ /* end of group CRC_EXPORTED_CONSTANTS */
 
 
+/** @addtogroup CRC_EXPORTED_STRUCTS CRC Exported Structs
+  @{
+*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Software CRC context. Gives the same checksum as CRC controller with the same settings.                */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct
+{
+    uint32_t u32Attribute;      /*!<CRC operation data attribute */
+    uint32_t u32Width;          /*!<Polynomial width in bits */
+    uint32_t u32Crc;            /*!<Current CRC register value */
+    uint32_t au32Table[16];     /*!<4-bit lookup table of polynomial */
+} S_CRC_SW_T;
+
+/*@}*/ /* end of group CRC_EXPORTED_STRUCTS */
+
+
 /** @addtogroup CRC_EXPORTED_FUNCTIONS CRC Exported Functions
   @{
 */
@@ -96,6 +119,10 @@ extern "C"
 
 void CRC_Open(uint32_t u32Mode, uint32_t u32Attribute, uint32_t u32Seed, uint32_t u32DataLen);
 uint32_t CRC_GetChecksum(void);
+void CRC_SetPDMA(uint32_t u32Enable);
+uint32_t CRC_Calculate(const uint8_t *pu8Buf, uint32_t u32Len);
+void CRC_SwOpen(S_CRC_SW_T *psCrc, uint32_t u32Mode, uint32_t u32Attribute, uint32_t u32Seed);
+uint32_t CRC_SwCalculate(S_CRC_SW_T *psCrc, const uint8_t *pu8Buf, uint32_t u32Len);
 
 /*@}*/ /* end of group CRC_EXPORTED_FUNCTIONS */
 
@@ -51,6 +51,17 @@ extern "C"
 
 #define FMC_FLASH_PAGE_SIZE     0x800           /*!< Flash Page Size (2048 Bytes) */
 #define FMC_LDROM_SIZE          0x1000          /*!< LDROM Size (4 kBytes)       */
+#define FMC_MULTI_WORD_PROG_LEN 256             /*!< The maximum length of a multi-word program (256 Bytes) */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Code placement                                                                                         */
+/*  FMC_RAMFUNC is the attribute of the multi-word program loop of FMC_WriteBuffer. When the loop runs     */
+/*  from flash, program stops on every CPU code fetch and is restarted, so it should run from SRAM.        */
+/*  Define FMC_RAMFUNC as empty to keep the loop in flash and save SRAM.                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef FMC_RAMFUNC
+#define FMC_RAMFUNC             RAMFUNC         /*!< Run multi-word program loop in SRAM */
+#endif
 
 /*---------------------------------------------------------------------------------------------------------*/
 /*  ISPCTL constant definitions                                                                            */
@@ -592,6 +603,10 @@ int32_t FMC_GetBootSource(void);
 uint32_t FMC_ReadDataFlashBaseAddr(void);
 void FMC_EnableFreqOptimizeMode(uint32_t u32Mode);
 void FMC_DisableFreqOptimizeMode(void);
+int32_t FMC_ErasePages(uint32_t u32Addr, uint32_t u32Len);
+int32_t FMC_WriteBuffer(uint32_t u32Addr, const uint32_t *pu32Buf, uint32_t u32Len);
+void FMC_EnableEraseAhead(uint32_t u32Addr, uint32_t u32Len);
+int32_t FMC_DisableEraseAhead(void);
 
 /*@}*/ /* end of group FMC_EXPORTED_FUNCTIONS */
 
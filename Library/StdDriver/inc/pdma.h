@@ -112,9 +112,65 @@ extern "C"
 #define PDMA_INT_TEMPTY     0x00000001UL            /*!<Table Empty Interrupt  \hideinitializer */
 #define PDMA_INT_TIMEOUT    0x00000002UL            /*!<Timeout Interrupt  \hideinitializer */
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Job Scheduler Constant Definitions                                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef PDMA_JOB_DESC_NUM
+#define PDMA_JOB_DESC_NUM   16                      /*!<Number of scatter-gather descriptors in job descriptor pool, 1 ~ 32  \hideinitializer */
+#endif
+
+#define PDMA_JOB_IDLE       0x00000000UL            /*!<Job is not submitted  \hideinitializer */
+#define PDMA_JOB_QUEUED     0x00000001UL            /*!<Job is waiting for a free channel  \hideinitializer */
+#define PDMA_JOB_BUSY       0x00000002UL            /*!<Job is running on a channel  \hideinitializer */
+#define PDMA_JOB_DONE       0x00000003UL            /*!<Job is finished  \hideinitializer */
+#define PDMA_JOB_ABORT      0x00000004UL            /*!<Job is stopped by target abort or cancelled  \hideinitializer */
+
 
 /*@}*/ /* end of group PDMA_EXPORTED_CONSTANTS */
 
+
+/** @addtogroup PDMA_EXPORTED_STRUCTS PDMA Exported Structs
+  @{
+*/
+/**
+  * @details    PDMA scatter-gather descriptor. The layout is defined by hardware.
+  */
+typedef struct
+{
+    uint32_t u32Ctl;        /*!< Control word, same format as PDMA_DSCT_CTL */
+    uint32_t u32Src;        /*!< Source address */
+    uint32_t u32Dst;        /*!< Destination address */
+    uint32_t u32Next;       /*!< Offset of next descriptor from PDMA_SCATBA */
+} S_PDMA_DESC_T;
+
+struct s_pdma_job;
+
+typedef void (*PDMA_JOB_CB)(struct s_pdma_job *psJob, uint32_t u32Status);   /*!< Functional pointer type declaration for PDMA job completion callback */
+
+/**
+  * @details    PDMA job. A job is a list of descriptors taken from the driver descriptor pool and executed on
+  *             one channel in scatter-gather mode. Descriptors are returned to the pool when the job finishes.
+  *             A cyclic job runs its descriptors as a ring until it is cancelled.
+  */
+typedef struct s_pdma_job
+{
+    uint32_t u32Peripheral;             /*!< Request source, PDMA_MEM or a peripheral request */
+    uint32_t u32Burst;                  /*!< Burst type and size of every descriptor */
+    S_PDMA_DESC_T *psFirst;             /*!< First descriptor of the job */
+    S_PDMA_DESC_T *psLast;              /*!< Last descriptor of the job */
+    uint32_t u32DescMask;               /*!< Descriptors owned by the job, one bit per pool entry */
+    uint32_t u32Cyclic;                 /*!< 1 if the last descriptor links back to the first one */
+    S_PDMA_DESC_T *psCur;               /*!< Descriptor in transfer of a running cyclic job */
+    struct s_pdma_job *psChain;         /*!< Job started on the same channel when this job is done. Can be NULL */
+    struct s_pdma_job *psNext;          /*!< Pending queue link, used by driver */
+    int32_t i32Ch;                      /*!< Channel running the job, -1 if not running */
+    volatile uint32_t u32Status;        /*!< PDMA_JOB_IDLE, PDMA_JOB_QUEUED, PDMA_JOB_BUSY, PDMA_JOB_DONE or PDMA_JOB_ABORT */
+    PDMA_JOB_CB pfnCallback;            /*!< Completion callback, called from PDMA_JobIRQHandler(). Can be NULL */
+    void *pvUserData;                   /*!< User data for callback */
+} S_PDMA_JOB_T;
+
+/*@}*/ /* end of group PDMA_EXPORTED_STRUCTS */
+
 /** @addtogroup PDMA_EXPORTED_FUNCTIONS PDMA Exported Functions
   @{
 */
@@ -290,6 +346,18 @@ extern "C"
  */
 #define PDMA_RESET(u32Ch) ((uint32_t)(PDMA->RESET = (1 << (u32Ch))))
 
+/**
+ * @brief       Check Job Finished
+ *
+ * @param[in]   psJob     The pointer of PDMA job
+ *
+ * @retval      0 Job is idle, queued or running
+ * @retval      1 Job is done or aborted
+ *
+ * @details     This macro checks whether the job has been finished.
+ */
+#define PDMA_JOB_IS_FINISHED(psJob) (((psJob)->u32Status >= PDMA_JOB_DONE) ? 1 : 0)
+
 /*---------------------------------------------------------------------------------------------------------*/
 /* Define PWM functions prototype                                                                          */
 /*---------------------------------------------------------------------------------------------------------*/
@@ -305,6 +373,17 @@ void PDMA_SetTimeOut(uint32_t u32Ch, uint32_t u32OnOff, uint32_t u32TimeOutCnt);
 void PDMA_Trigger(uint32_t u32Ch);
 void PDMA_EnableInt(uint32_t u32Ch, uint32_t u32Mask);
 void PDMA_DisableInt(uint32_t u32Ch, uint32_t u32Mask);
+void PDMA_JobOpen(uint32_t u32Mask);
+void PDMA_JobInit(S_PDMA_JOB_T *psJob, uint32_t u32Peripheral, PDMA_JOB_CB pfnCallback, void *pvUserData);
+int32_t PDMA_JobAddDesc(S_PDMA_JOB_T *psJob, uint32_t u32Width, uint32_t u32SrcAddr, uint32_t u32SrcCtrl, uint32_t u32DstAddr, uint32_t u32DstCtrl, uint32_t u32TransCount);
+void PDMA_JobChain(S_PDMA_JOB_T *psJob, S_PDMA_JOB_T *psNextJob);
+int32_t PDMA_JobSetCyclic(S_PDMA_JOB_T *psJob);
+int32_t PDMA_JobSubmit(S_PDMA_JOB_T *psJob);
+int32_t PDMA_JobWait(S_PDMA_JOB_T *psJob);
+void PDMA_JobCancel(S_PDMA_JOB_T *psJob);
+void PDMA_JobRelease(S_PDMA_JOB_T *psJob);
+uint32_t PDMA_JobGetFreeDesc(void);
+void PDMA_JobIRQHandler(void);
 
 
 /*@}*/ /* end of group PDMA_EXPORTED_FUNCTIONS */
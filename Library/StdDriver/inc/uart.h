@@ -110,10 +110,58 @@ extern "C"
 #define UART_BAUD_MODE2     (UART_BAUD_BAUDM1_Msk | UART_BAUD_BAUDM0_Msk) /*!< Set UART Baudrate Mode is Mode2 */
 
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* UART asynchronous transfer event constants definitions                                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+#define UART_ASYNC_EVT_RX           (0x01UL) /*!< New data has been queued in the RX ring */
+#define UART_ASYNC_EVT_TX_EMPTY     (0x02UL) /*!< TX ring has been drained to the transmitter */
+#define UART_ASYNC_EVT_RX_DONE      (0x04UL) /*!< PDMA bulk receive completed */
+#define UART_ASYNC_EVT_RX_OVERFLOW  (0x08UL) /*!< RX ring or RX FIFO overflow, data has been dropped */
+#define UART_ASYNC_EVT_LINE_ERR     (0x10UL) /*!< Parity, frame or break error has been detected */
+
+#define UART_ASYNC_RX_TOUT          (40)     /*!< RX time-out comparator used by asynchronous mode, in bit time */
+#define UART_ASYNC_PDMA_MAX_CNT     (16384)  /*!< Maximum bytes moved by one PDMA basic mode transfer */
+
 
 /*@}*/ /* end of group UART_EXPORTED_CONSTANTS */
 
 
+/** @addtogroup UART_EXPORTED_STRUCTS UART Exported Structs
+  @{
+*/
+struct s_uart_async;
+
+typedef void (*UART_ASYNC_CB)(struct s_uart_async *psAsync, uint32_t u32Event);   /*!< Functional pointer type declaration for UART asynchronous event callback */
+
+/**
+  * @details    UART asynchronous transfer context.
+  *             RX ring is written by the interrupt handler and read by the application; TX ring is written by the
+  *             application and read by the interrupt handler or PDMA. Ring indexes are free running counters, so
+  *             each index has exactly one writer and no lock is required.
+  */
+typedef struct s_uart_async
+{
+    UART_T *uart;                       /*!< UART module bound to this context */
+    uint8_t *pu8RxBuf;                  /*!< RX ring buffer */
+    uint32_t u32RxMask;                 /*!< RX ring size - 1 */
+    volatile uint32_t u32RxHead;        /*!< RX ring write index, updated by interrupt handler */
+    volatile uint32_t u32RxTail;        /*!< RX ring read index, updated by application */
+    uint8_t *pu8TxBuf;                  /*!< TX ring buffer */
+    uint32_t u32TxMask;                 /*!< TX ring size - 1 */
+    volatile uint32_t u32TxHead;        /*!< TX ring write index, updated by application */
+    volatile uint32_t u32TxTail;        /*!< TX ring read index, updated by interrupt handler */
+    uint32_t u32TxPdmaEn;               /*!< 1 if TX ring is drained by PDMA jobs, 0 for interrupt mode */
+    uint32_t u32RxPdmaEn;               /*!< 1 if bulk receive by PDMA job is supported */
+    S_PDMA_JOB_T sTxJob;                /*!< PDMA job draining the TX ring */
+    S_PDMA_JOB_T sRxJob;                /*!< PDMA job of bulk receive */
+    volatile uint32_t u32TxPdmaCnt;     /*!< Bytes in flight on TX PDMA job, 0 when idle */
+    volatile uint32_t u32RxPdmaCnt;     /*!< Bytes requested by RX PDMA job, 0 when idle */
+    UART_ASYNC_CB pfnCallback;          /*!< Event callback, called in interrupt context. Can be NULL */
+} S_UART_ASYNC_T;
+
+/*@}*/ /* end of group UART_EXPORTED_STRUCTS */
+
+
 /** @addtogroup UART_EXPORTED_FUNCTIONS UART Exported Functions
   @{
 */
@@ -430,6 +478,43 @@ __STATIC_INLINE void UART_SET_RTS(UART_T* uart)
 #define UART_RS485_GET_ADDR_FLAG(uart)    (((uart)->FIFOSTS  & UART_FIFOSTS_ADDRDETF_Msk) >> UART_FIFOSTS_ADDRDETF_Pos)
 
 
+/**
+ *    @brief        Get data count in asynchronous RX ring
+ *
+ *    @param[in]    psAsync The pointer of the UART asynchronous context
+ *
+ *    @return       Number of received bytes waiting in RX ring
+ *
+ *    @details      This macro gets the number of bytes that can be fetched by UART_AsyncRead() without waiting.
+ */
+#define UART_ASYNC_GET_RX_COUNT(psAsync)    ((psAsync)->u32RxHead - (psAsync)->u32RxTail)
+
+
+/**
+ *    @brief        Get free space in asynchronous TX ring
+ *
+ *    @param[in]    psAsync The pointer of the UART asynchronous context
+ *
+ *    @return       Number of bytes that can be queued to TX ring
+ *
+ *    @details      This macro gets the number of bytes that can be accepted by UART_AsyncWrite().
+ */
+#define UART_ASYNC_GET_TX_FREE(psAsync)    ((psAsync)->u32TxMask + 1 - ((psAsync)->u32TxHead - (psAsync)->u32TxTail))
+
+
+/**
+ *    @brief        Check if asynchronous TX is idle
+ *
+ *    @param[in]    psAsync The pointer of the UART asynchronous context
+ *
+ *    @retval       0 TX ring still has data to send
+ *    @retval       1 TX ring is empty
+ *
+ *    @details      This macro checks whether all queued data has been moved to the UART TX FIFO.
+ */
+#define UART_ASYNC_IS_TX_IDLE(psAsync)    ((psAsync)->u32TxHead == (psAsync)->u32TxTail)
+
+
 
 void UART_ClearIntFlag(UART_T* uart, uint32_t u32InterruptFlag);
 void UART_Close(UART_T* uart);
@@ -445,6 +530,15 @@ void UART_SelectIrDAMode(UART_T* uart, uint32_t u32Buadrate, uint32_t u32Directi
 void UART_SelectRS485Mode(UART_T* uart, uint32_t u32Mode, uint32_t u32Addr);
 void UART_SelectLINMode(UART_T* uart, uint32_t u32Mode, uint32_t u32BreakLength);
 uint32_t UART_Write(UART_T* uart, uint8_t *pu8TxBuf, uint32_t u32WriteBytes);
+void UART_AsyncOpen(S_UART_ASYNC_T *psAsync, UART_T* uart, uint8_t *pu8RxBuf, uint32_t u32RxSize, uint8_t *pu8TxBuf, uint32_t u32TxSize, UART_ASYNC_CB pfnCallback);
+void UART_AsyncClose(S_UART_ASYNC_T *psAsync);
+void UART_AsyncSetPDMA(S_UART_ASYNC_T *psAsync, uint32_t u32TxEn, uint32_t u32RxEn);
+uint32_t UART_AsyncRead(S_UART_ASYNC_T *psAsync, uint8_t *pu8RxBuf, uint32_t u32ReadBytes);
+uint32_t UART_AsyncWrite(S_UART_ASYNC_T *psAsync, uint8_t *pu8TxBuf, uint32_t u32WriteBytes);
+int32_t UART_AsyncReadPDMA(S_UART_ASYNC_T *psAsync, uint8_t *pu8RxBuf, uint32_t u32ReadBytes);
+uint32_t UART_AsyncGetReadPDMACount(S_UART_ASYNC_T *psAsync);
+uint32_t UART_AsyncAbortReadPDMA(S_UART_ASYNC_T *psAsync);
+void UART_AsyncIRQHandler(S_UART_ASYNC_T *psAsync);
 
 
 /*@}*/ /* end of group UART_EXPORTED_FUNCTIONS */
@@ -36,6 +36,30 @@ typedef struct s_usbd_info
 
 extern const S_USBD_INFO_T gsInfo;
 
+typedef struct s_usbd_dbuf
+{
+    uint8_t *apu8Buf[2];                  /*!< Two SRAM buffers for received packets      */
+    volatile uint32_t au32Len[2];         /*!< Packet length in each buffer               */
+    uint32_t u32MaxPktSize;               /*!< Endpoint maximum packet size               */
+    uint8_t u8Ep;                         /*!< Endpoint ID (EP0 ~ EP7)                    */
+    volatile uint8_t u8Head;              /*!< Buffer to be filled by next packet         */
+    volatile uint8_t u8Tail;              /*!< Buffer to be consumed by class code        */
+    volatile uint8_t u8Count;             /*!< Number of buffers holding unconsumed data  */
+    volatile uint8_t u8Armed;             /*!< Endpoint is ready to receive next packet   */
+} S_USBD_DBUF_T;
+
+typedef struct s_usbd_fb
+{
+    uint32_t u32Nominal;                  /*!< Nominal samples per frame in 10.14 format   */
+    uint32_t u32Rate;                     /*!< Measured samples per frame in 10.14 format  */
+    volatile uint32_t u32Value;           /*!< Feedback value sent to host (10.14 format)  */
+    uint32_t u32SampleCnt;                /*!< Sample count at start of measure window     */
+    uint32_t u32SofCnt;                   /*!< SOF count in current measure window         */
+    uint8_t u8Ep;                         /*!< Endpoint ID (EP0 ~ EP7)                     */
+    uint8_t u8Shift;                      /*!< Measure window is 2^u8Shift frames          */
+    uint8_t u8Started;                    /*!< Measure window is started                   */
+} S_USBD_FB_T;
+
 /*@}*/ /* end of group USBD_EXPORTED_STRUCTS */
 
 
@@ -47,6 +71,12 @@ extern const S_USBD_INFO_T gsInfo;
 #define USBD_BUF_BASE   (USBD_BASE+0x100)
 #define USBD_MAX_EP     8
 
+/* Define USBD_MEMCOPY_PDMA to let USBD_MemCopy use a PDMA job for large word aligned copies.
+   The PDMA job scheduler must be opened by PDMA_JobOpen(). */
+#ifndef USBD_MEMCOPY_PDMA_MIN
+#define USBD_MEMCOPY_PDMA_MIN   64      /*!< Minimum byte count to copy by PDMA */
+#endif
+
 #define EP0     0       /*!< Endpoint 0 */
 #define EP1     1       /*!< Endpoint 1 */
 #define EP2     2       /*!< Endpoint 2 */
@@ -133,6 +163,7 @@ extern const S_USBD_INFO_T gsInfo;
 #define USBD_INT_FLDET          USBD_INTEN_VBDETIEN_Msk     /*!< USB VBUS Detection Interrupt */
 #define USBD_INT_VBDET          USBD_INTEN_VBDETIEN_Msk     /*!< USB VBUS Detection Interrupt */
 #define USBD_INT_WAKEUP_IDLE    (USBD_INTEN_WKIDLEIEN_Msk | USBD_INTEN_WKEN_Msk)    /*!< USB No-Event-Wake-Up Interrupt */
+#define USBD_INT_SOF            USBD_INTEN_SOFIEN_Msk       /*!< USB Start of Frame Interrupt */
 
 #define USBD_INTSTS_WAKEUP      USBD_INTSTS_WKIDLEIF_Msk    /*!< USB No-Event-Wake-Up Interrupt Status */
 #define USBD_INTSTS_FLDET       USBD_INTSTS_VBDETIF_Msk     /*!< USB Float Detect Interrupt Status */
@@ -140,6 +171,7 @@ extern const S_USBD_INFO_T gsInfo;
 #define USBD_INTSTS_BUS         USBD_INTSTS_BUSIF_Msk       /*!< USB Bus Event Interrupt Status */
 #define USBD_INTSTS_USB         USBD_INTSTS_USBIF_Msk       /*!< USB Event Interrupt Status */
 #define USBD_INTSTS_SETUP       USBD_INTSTS_SETUP_Msk       /*!< USB Setup Event */
+#define USBD_INTSTS_SOF         USBD_INTSTS_SOFIF_Msk       /*!< USB Start of Frame Event */
 #define USBD_INTSTS_EP0         USBD_INTSTS_EPEVT0_Msk      /*!< USB Endpoint 0 Event */
 #define USBD_INTSTS_EP1         USBD_INTSTS_EPEVT1_Msk      /*!< USB Endpoint 1 Event */
 #define USBD_INTSTS_EP2         USBD_INTSTS_EPEVT2_Msk      /*!< USB Endpoint 2 Event */
@@ -520,6 +552,10 @@ extern const S_USBD_INFO_T gsInfo;
   */
 #define USBD_GET_EP_STALL(ep)        (*((__IO uint32_t *) ((uint32_t)&USBD->EP[0].CFGP + (uint32_t)((ep) << 4))) & USBD_CFGP_SSTALL_Msk)
 
+#ifdef USBD_MEMCOPY_PDMA
+int32_t USBD_MemCopyPDMA(uint8_t *dest, uint8_t *src, int32_t size);
+#endif
+
 /**
   * @brief      To support byte access between USB SRAM and system SRAM
   *
@@ -532,11 +568,48 @@ extern const S_USBD_INFO_T gsInfo;
   * @return     None
   *
   * @details    This function will copy the number of data specified by size and src parameters to the address specified by dest parameter.
+  *             If both pointers are word aligned, data is copied by words, 4 words per loop.
+  *             If USBD_MEMCOPY_PDMA is defined, aligned copies of USBD_MEMCOPY_PDMA_MIN bytes or more are done by PDMA
+  *             when a descriptor and a channel of the job scheduler are free.
+  *             The remaining bytes are copied by bytes.
   *
   */
 static __INLINE void USBD_MemCopy(uint8_t *dest, uint8_t *src, int32_t size)
 {
-    while(size--) *dest++ = *src++;
+    uint32_t *pu32Dest, *pu32Src;
+
+    if(((((uint32_t)dest) | ((uint32_t)src)) & 3) == 0)
+    {
+#ifdef USBD_MEMCOPY_PDMA
+        if((size >= USBD_MEMCOPY_PDMA_MIN) && (USBD_MemCopyPDMA(dest, src, size) == 0))
+        {
+            dest += (size & ~3);
+            src += (size & ~3);
+            size &= 3;
+        }
+#endif
+        pu32Dest = (uint32_t *)dest;
+        pu32Src = (uint32_t *)src;
+        while(size >= 16)
+        {
+            pu32Dest[0] = pu32Src[0];
+            pu32Dest[1] = pu32Src[1];
+            pu32Dest[2] = pu32Src[2];
+            pu32Dest[3] = pu32Src[3];
+            pu32Dest += 4;
+            pu32Src += 4;
+            size -= 16;
+        }
+        while(size >= 4)
+        {
+            *pu32Dest++ = *pu32Src++;
+            size -= 4;
+        }
+        dest = (uint8_t *)pu32Dest;
+        src = (uint8_t *)pu32Src;
+    }
+
+    while(size-- > 0) *dest++ = *src++;
 }
 
 
@@ -659,6 +732,13 @@ void USBD_SwReset(void);
 void USBD_SetVendorRequest(VENDOR_REQ pfnVendorReq);
 void USBD_SetConfigCallback(SET_CONFIG_CB pfnSetConfigCallback);
 void USBD_LockEpStall(uint32_t u32EpBitmap);
+void USBD_DBufOpen(S_USBD_DBUF_T *psDBuf, uint32_t u32Ep, uint8_t *pu8Buf0, uint8_t *pu8Buf1, uint32_t u32MaxPktSize);
+void USBD_DBufOutHandler(S_USBD_DBUF_T *psDBuf);
+uint8_t *USBD_DBufGet(S_USBD_DBUF_T *psDBuf, uint32_t *pu32Len);
+void USBD_DBufRelease(S_USBD_DBUF_T *psDBuf);
+void USBD_FbOpen(S_USBD_FB_T *psFb, uint32_t u32Ep, uint32_t u32SampleRate, uint32_t u32Shift);
+void USBD_FbSOF(S_USBD_FB_T *psFb, uint32_t u32SampleCnt, int32_t i32FillErr);
+void USBD_FbInHandler(S_USBD_FB_T *psFb);
 
 /*@}*/ /* end of group USBD_EXPORTED_FUNCTIONS */
 
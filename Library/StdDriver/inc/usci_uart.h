@@ -63,6 +63,36 @@ extern "C"
 /*@}*/ /* end of group USCI_UART_EXPORTED_CONSTANTS */
 
 
+/** @addtogroup USCI_UART_EXPORTED_STRUCTS USCI_UART Exported Structs
+  @{
+*/
+struct s_uuart_async;
+
+typedef void (*UUART_ASYNC_CB)(struct s_uuart_async *psAsync, uint32_t u32Event);   /*!< Functional pointer type declaration for USCI_UART asynchronous event callback */
+
+/**
+  * @details    USCI_UART asynchronous transfer context.
+  *             It works the same as S_UART_ASYNC_T and reports the same UART_ASYNC_EVT_* events, but it is
+  *             interrupt driven only because USCI has no PDMA request.
+  */
+typedef struct s_uuart_async
+{
+    UUART_T *uuart;                     /*!< USCI_UART module bound to this context */
+    uint8_t *pu8RxBuf;                  /*!< RX ring buffer */
+    uint32_t u32RxMask;                 /*!< RX ring size - 1 */
+    volatile uint32_t u32RxHead;        /*!< RX ring write index, updated by interrupt handler */
+    volatile uint32_t u32RxTail;        /*!< RX ring read index, updated by application */
+    uint8_t *pu8TxBuf;                  /*!< TX ring buffer */
+    uint32_t u32TxMask;                 /*!< TX ring size - 1 */
+    volatile uint32_t u32TxHead;        /*!< TX ring write index, updated by application */
+    volatile uint32_t u32TxTail;        /*!< TX ring read index, updated by interrupt handler */
+    volatile uint32_t u32TxBusy;        /*!< 1 while TX end interrupt chain is running */
+    UUART_ASYNC_CB pfnCallback;         /*!< Event callback, called in interrupt context. Can be NULL */
+} S_UUART_ASYNC_T;
+
+/*@}*/ /* end of group USCI_UART_EXPORTED_STRUCTS */
+
+
 /** @addtogroup USCI_UART_EXPORTED_FUNCTIONS USCI_UART Exported Functions
   @{
 */
@@ -401,6 +431,11 @@ void UUART_EnableWakeup(UUART_T* uuart, uint32_t u32WakeupMode);
 void UUART_DisableWakeup(UUART_T* uuart);
 void UUART_EnableFlowCtrl(UUART_T* uuart);
 void UUART_DisableFlowCtrl(UUART_T* uuart);
+void UUART_AsyncOpen(S_UUART_ASYNC_T *psAsync, UUART_T* uuart, uint8_t *pu8RxBuf, uint32_t u32RxSize, uint8_t *pu8TxBuf, uint32_t u32TxSize, UUART_ASYNC_CB pfnCallback);
+void UUART_AsyncClose(S_UUART_ASYNC_T *psAsync);
+uint32_t UUART_AsyncRead(S_UUART_ASYNC_T *psAsync, uint8_t *pu8RxBuf, uint32_t u32ReadBytes);
+uint32_t UUART_AsyncWrite(S_UUART_ASYNC_T *psAsync, uint8_t *pu8TxBuf, uint32_t u32WriteBytes);
+void UUART_AsyncIRQHandler(S_UUART_ASYNC_T *psAsync);
 
 
 /*@}*/ /* end of group USCI_UART_EXPORTED_FUNCTIONS */
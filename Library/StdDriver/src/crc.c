@@ -10,6 +10,21 @@
 *****************************************************************************/
 #include "NUC1261.h"
 
+/// @cond HIDDEN_SYMBOLS
+static uint32_t s_u32CrcPdma = 0;       /* CRC_Calculate feeds CRC by PDMA jobs */
+
+static uint32_t CRC_Reflect(uint32_t u32Data, uint32_t u32Bits)
+{
+    uint32_t u32Out = 0;
+
+    while(u32Bits--)
+    {
+        u32Out = (u32Out << 1) | (u32Data & 1);
+        u32Data >>= 1;
+    }
+    return u32Out;
+}
+/// @endcond HIDDEN_SYMBOLS
 
 /** @addtogroup Standard_Driver Standard Driver
   @{
@@ -84,6 +99,205 @@ uint32_t CRC_GetChecksum(void)
     }
 }
 
+/**
+  * @brief      Enable PDMA Feed of CRC Calculate
+  *
+  * @param[in]  u32Enable   1 to feed CRC by PDMA jobs, 0 to feed CRC by CPU only.
+  *
+  * @return     None
+  *
+  * @details    CRC_Calculate submits memory to CRC_DAT jobs to the PDMA job scheduler, so PDMA_JobOpen must be
+  *             called and PDMA_IRQHandler must call PDMA_JobIRQHandler before it is enabled.
+  */
+void CRC_SetPDMA(uint32_t u32Enable)
+{
+    s_u32CrcPdma = u32Enable;
+}
+
+/**
+  * @brief      Calculate CRC of a Buffer
+  *
+  * @param[in]  pu8Buf      Data buffer. It could be not word aligned.
+  * @param[in]  u32Len      Data length in bytes
+  *
+  * @return     Checksum Result
+  *
+  * @details    This function continues CRC operation of CRC controller opened by CRC_Open with data in buffer,
+  *             so a long data could be calculated by several calls.
+  *             Unaligned head and tail bytes are written by 8-bit and 16-bit writes, and word aligned data is
+  *             written by 32-bit writes. If PDMA is enabled by CRC_SetPDMA, word aligned data of
+  *             CRC_PDMA_MIN_LEN bytes or more is fed by PDMA jobs of up to CRC_PDMA_MAX_CNT words, waited by
+  *             polling. If the descriptor pool is empty the remaining data is written by CPU.
+  *             Data is processed in memory byte order. CPU write data length of CRC_Open is restored before return.
+  */
+uint32_t CRC_Calculate(const uint8_t *pu8Buf, uint32_t u32Len)
+{
+    uint32_t u32Ctl, u32DatLen, u32Cnt;
+    S_PDMA_JOB_T sJob;
+
+    u32DatLen = CRC->CTL & CRC_CTL_DATLEN_Msk;
+    u32Ctl = CRC->CTL & ~(CRC_CTL_DATLEN_Msk | CRC_CTL_CHKSINIT_Msk);
+
+    /* Unaligned head */
+    CRC->CTL = u32Ctl | CRC_CPU_WDATA_8;
+    while((((uint32_t)pu8Buf) & 3) && u32Len)
+    {
+        CRC->DAT = *pu8Buf++;
+        u32Len--;
+    }
+
+    /* Word aligned body */
+    CRC->CTL = u32Ctl | CRC_CPU_WDATA_32;
+    if(s_u32CrcPdma && (u32Len >= CRC_PDMA_MIN_LEN))
+    {
+        while(u32Len >= 4)
+        {
+            u32Cnt = u32Len >> 2;
+            if(u32Cnt > CRC_PDMA_MAX_CNT)
+                u32Cnt = CRC_PDMA_MAX_CNT;
+
+            PDMA_JobInit(&sJob, PDMA_MEM, NULL, NULL);
+            sJob.u32Burst = PDMA_REQ_BURST | PDMA_BURST_4;
+            if(PDMA_JobAddDesc(&sJob, PDMA_WIDTH_32, (uint32_t)pu8Buf, PDMA_SAR_INC, (uint32_t)&CRC->DAT, PDMA_DAR_FIX, u32Cnt) != 0)
+                break;
+
+            PDMA_JobSubmit(&sJob);
+            PDMA_JobWait(&sJob);
+
+            pu8Buf += (u32Cnt << 2);
+            u32Len -= (u32Cnt << 2);
+        }
+    }
+
+    while(u32Len >= 4)
+    {
+        CRC->DAT = *(uint32_t *)pu8Buf;
+        pu8Buf += 4;
+        u32Len -= 4;
+    }
+
+    /* Tail */
+    if(u32Len >= 2)
+    {
+        CRC->CTL = u32Ctl | CRC_CPU_WDATA_16;
+        CRC->DAT = *(uint16_t *)pu8Buf;
+        pu8Buf += 2;
+        u32Len -= 2;
+    }
+    if(u32Len)
+    {
+        CRC->CTL = u32Ctl | CRC_CPU_WDATA_8;
+        CRC->DAT = *pu8Buf;
+    }
+
+    CRC->CTL = u32Ctl | u32DatLen;
+
+    return CRC_GetChecksum();
+}
+
+/**
+  * @brief      Open Software CRC Context
+  *
+  * @param[in]  psCrc           Software CRC context
+  * @param[in]  u32Mode         CRC operation polynomial mode. Valid values are:
+  *                             - \ref CRC_CCITT
+  *                             - \ref CRC_8
+  *                             - \ref CRC_16
+  *                             - \ref CRC_32
+  * @param[in]  u32Attribute    CRC operation data attribute. Valid values are combined with:
+  *                             - \ref CRC_CHECKSUM_COM
+  *                             - \ref CRC_CHECKSUM_RVS
+  *                             - \ref CRC_WDATA_COM
+  *                             - \ref CRC_WDATA_RVS
+  * @param[in]  u32Seed         Seed value.
+  *
+  * @return     None
+  *
+  * @details    This function prepares a table driven software CRC which gives the same checksum as
+  *             CRC controller opened by CRC_Open with the same settings. It needs no CRC controller.
+  */
+void CRC_SwOpen(S_CRC_SW_T *psCrc, uint32_t u32Mode, uint32_t u32Attribute, uint32_t u32Seed)
+{
+    uint32_t u32Poly, u32Msb, u32Mask, u32Crc, i, j;
+
+    switch(u32Mode)
+    {
+        case CRC_8:
+            u32Poly = 0x07;
+            psCrc->u32Width = 8;
+            break;
+        case CRC_16:
+            u32Poly = 0x8005;
+            psCrc->u32Width = 16;
+            break;
+        case CRC_32:
+            u32Poly = 0x04C11DB7;
+            psCrc->u32Width = 32;
+            break;
+        case CRC_CCITT:
+        default:
+            u32Poly = 0x1021;
+            psCrc->u32Width = 16;
+            break;
+    }
+
+    u32Msb = 1UL << (psCrc->u32Width - 1);
+    u32Mask = (u32Msb << 1) - 1;
+
+    /* Remainder of each 4-bit value at top of CRC register */
+    for(i = 0; i < 16; i++)
+    {
+        u32Crc = i << (psCrc->u32Width - 4);
+        for(j = 0; j < 4; j++)
+            u32Crc = (u32Crc & u32Msb) ? ((u32Crc << 1) ^ u32Poly) : (u32Crc << 1);
+        psCrc->au32Table[i] = u32Crc & u32Mask;
+    }
+
+    psCrc->u32Attribute = u32Attribute;
+    psCrc->u32Crc = u32Seed & u32Mask;
+}
+
+/**
+  * @brief      Calculate CRC of a Buffer by Software
+  *
+  * @param[in]  psCrc       Software CRC context opened by CRC_SwOpen
+  * @param[in]  pu8Buf      Data buffer
+  * @param[in]  u32Len      Data length in bytes
+  *
+  * @return     Checksum Result
+  *
+  * @details    This function continues CRC operation of the context, so a long data could be
+  *             calculated by several calls. The result equals CRC_Calculate with the same settings.
+  */
+uint32_t CRC_SwCalculate(S_CRC_SW_T *psCrc, const uint8_t *pu8Buf, uint32_t u32Len)
+{
+    uint32_t u32Width = psCrc->u32Width;
+    uint32_t u32Mask = ((1UL << (u32Width - 1)) << 1) - 1;
+    uint32_t u32Crc = psCrc->u32Crc;
+    uint32_t u32Data;
+
+    while(u32Len--)
+    {
+        u32Data = *pu8Buf++;
+        if(psCrc->u32Attribute & CRC_WDATA_COM)
+            u32Data = ~u32Data & 0xFF;
+        if(psCrc->u32Attribute & CRC_WDATA_RVS)
+            u32Data = CRC_Reflect(u32Data, 8);
+
+        u32Crc ^= u32Data << (u32Width - 8);
+        u32Crc = ((u32Crc << 4) ^ psCrc->au32Table[(u32Crc >> (u32Width - 4)) & 0xF]) & u32Mask;
+        u32Crc = ((u32Crc << 4) ^ psCrc->au32Table[(u32Crc >> (u32Width - 4)) & 0xF]) & u32Mask;
+    }
+    psCrc->u32Crc = u32Crc;
+
+    if(psCrc->u32Attribute & CRC_CHECKSUM_RVS)
+        u32Crc = CRC_Reflect(u32Crc, u32Width);
+    if(psCrc->u32Attribute & CRC_CHECKSUM_COM)
+        u32Crc ^= u32Mask;
+
+    return u32Crc;
+}
+
 /*@}*/ /* end of group CRC_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group CRC_Driver */
@@ -11,6 +11,87 @@
 #include <stdio.h>
 #include "NUC1261.h"
 
+/// @cond HIDDEN_SYMBOLS
+static uint32_t s_u32EraseAheadAddr = 0;    /* The next page to erase ahead of FMC_WriteBuffer */
+static uint32_t s_u32EraseAheadEnd = 0;     /* The end of erase ahead area. 0 if erase ahead is disabled. */
+static uint8_t s_u8ErasePending = 0;        /* A page erase has been triggered and not checked */
+
+/*
+    Multi-word program of u32Words words (multiple of 4) within one 256 bytes block.
+    MPDAT0~3 are refilled while the previous words are programmed. If the program has stopped because data
+    did not come in time, it is restarted from the 4 words at MPADDR.
+*/
+static FMC_RAMFUNC void FMC_MultiWordProgram(uint32_t u32Addr, const uint32_t *pu32Buf, uint32_t u32Words)
+{
+    uint32_t i, u32Primask;
+
+    u32Primask = __get_PRIMASK();
+    FMC->ISPCMD = FMC_ISPCMD_MULTI_PROG;
+    i = 0;
+
+retrigger:
+    FMC->ISPADDR = u32Addr + i * 4;
+    FMC->MPDAT0 = pu32Buf[i];
+    FMC->MPDAT1 = pu32Buf[i + 1];
+    FMC->MPDAT2 = pu32Buf[i + 2];
+    FMC->MPDAT3 = pu32Buf[i + 3];
+    FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
+
+    for(i += 4; i < u32Words; i += 4)
+    {
+        /* Mask interrupt to avoid status check coherence error */
+        __set_PRIMASK(1);
+        do
+        {
+            if((FMC->MPSTS & FMC_MPSTS_MPBUSY_Msk) == 0)
+            {
+                __set_PRIMASK(u32Primask);
+                i = ((FMC->MPADDR & ~0xFul) - u32Addr) / 4;
+                goto retrigger;
+            }
+        }
+        while(FMC->MPSTS & (FMC_MPSTS_D0_Msk | FMC_MPSTS_D1_Msk));
+
+        FMC->MPDAT0 = pu32Buf[i];
+        FMC->MPDAT1 = pu32Buf[i + 1];
+
+        do
+        {
+            if((FMC->MPSTS & FMC_MPSTS_MPBUSY_Msk) == 0)
+            {
+                __set_PRIMASK(u32Primask);
+                i = ((FMC->MPADDR & ~0xFul) - u32Addr) / 4;
+                goto retrigger;
+            }
+        }
+        while(FMC->MPSTS & (FMC_MPSTS_D2_Msk | FMC_MPSTS_D3_Msk));
+
+        FMC->MPDAT2 = pu32Buf[i + 2];
+        FMC->MPDAT3 = pu32Buf[i + 3];
+        __set_PRIMASK(u32Primask);
+    }
+
+    while(FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk);
+}
+
+/* Wait for the page erase triggered by erase ahead. Return -1 if it failed. */
+static int32_t FMC_WaitEraseAhead(void)
+{
+    if(s_u8ErasePending == 0)
+        return 0;
+
+    s_u8ErasePending = 0;
+    while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk);
+
+    if(FMC->ISPCTL & FMC_ISPCTL_ISPFF_Msk)
+    {
+        FMC->ISPCTL |= FMC_ISPCTL_ISPFF_Msk;
+        return -1;
+    }
+    return 0;
+}
+/// @endcond HIDDEN_SYMBOLS
+
 /** @addtogroup Standard_Driver Standard Driver
   @{
 */
@@ -305,6 +386,147 @@ void FMC_DisableFreqOptimizeMode(void)
     FMC->FTCTL &= ~FMC_FTCTL_FOM_Msk;
 }
 
+/**
+ * @brief      Erase flash pages
+ *
+ * @param[in]  u32Addr  Flash address including APROM, LDROM, Data Flash, and CONFIG
+ * @param[in]  u32Len   Length of the area to erase in bytes
+ *
+ * @retval      0 Success
+ * @retval     -1 Erase failed
+ *
+ * @details    All pages with any byte in the area from u32Addr to (u32Addr + u32Len - 1) are erased.
+ *
+ */
+int32_t FMC_ErasePages(uint32_t u32Addr, uint32_t u32Len)
+{
+    uint32_t u32End = u32Addr + u32Len;
+
+    if(FMC_WaitEraseAhead() != 0)
+        return -1;
+
+    for(u32Addr &= ~(FMC_FLASH_PAGE_SIZE - 1); u32Addr < u32End; u32Addr += FMC_FLASH_PAGE_SIZE)
+    {
+        if(FMC_Erase(u32Addr) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief      Program a buffer into flash
+ *
+ * @param[in]  u32Addr  Flash address include APROM, LDROM, Data Flash, and CONFIG. It must be word aligned.
+ * @param[in]  pu32Buf  The data to program
+ * @param[in]  u32Len   Length of the data in bytes. It must be multiple of 4.
+ *
+ * @retval      0 Success
+ * @retval     -1 Program or erase failed, or the address or length is not word aligned
+ *
+ * @details    16 bytes aligned blocks are programmed by multi-word program, up to 256 bytes per ISP trigger.
+ *             The other words are programmed one by one. The area must have been erased, or be in the area
+ *             given to FMC_EnableEraseAhead.
+ *
+ */
+int32_t FMC_WriteBuffer(uint32_t u32Addr, const uint32_t *pu32Buf, uint32_t u32Len)
+{
+    uint32_t u32Size, u32Page;
+
+    if((u32Addr | u32Len) & 0x3)
+        return -1;
+
+    while(u32Len)
+    {
+        if(FMC_WaitEraseAhead() != 0)
+            return -1;
+
+        /* Erase the page when the first data come in */
+        u32Page = u32Addr & ~(FMC_FLASH_PAGE_SIZE - 1);
+        if((u32Page >= s_u32EraseAheadAddr) && (u32Page < s_u32EraseAheadEnd))
+        {
+            if(FMC_Erase(u32Page) != 0)
+                return -1;
+            s_u32EraseAheadAddr = u32Page + FMC_FLASH_PAGE_SIZE;
+        }
+
+        if(((u32Addr & 0xF) == 0) && (u32Len >= 16))
+        {
+            u32Size = FMC_MULTI_WORD_PROG_LEN - (u32Addr & (FMC_MULTI_WORD_PROG_LEN - 1));
+            if(u32Size > (u32Len & ~0xFul))
+                u32Size = u32Len & ~0xFul;
+            FMC_MultiWordProgram(u32Addr, pu32Buf, u32Size / 4);
+        }
+        else
+        {
+            u32Size = 4;
+            FMC_Write(u32Addr, *pu32Buf);
+        }
+
+        if(FMC->ISPCTL & FMC_ISPCTL_ISPFF_Msk)
+        {
+            FMC->ISPCTL |= FMC_ISPCTL_ISPFF_Msk;
+            return -1;
+        }
+
+        u32Addr += u32Size;
+        pu32Buf += u32Size / 4;
+        u32Len -= u32Size;
+
+        /* A page is completed. Start to erase the next page and let it run while the next data come in. */
+        if((u32Addr == s_u32EraseAheadAddr) && (u32Addr < s_u32EraseAheadEnd))
+        {
+            FMC->ISPCMD = FMC_ISPCMD_PAGE_ERASE;
+            FMC->ISPADDR = u32Addr;
+            FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
+            s_u32EraseAheadAddr = u32Addr + FMC_FLASH_PAGE_SIZE;
+            s_u8ErasePending = 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief      Enable erase ahead of FMC_WriteBuffer
+ *
+ * @param[in]  u32Addr  Start address of the area. It must be page aligned.
+ * @param[in]  u32Len   Length of the area in bytes
+ *
+ * @return     None
+ *
+ * @details    Pages in the area are erased by FMC_WriteBuffer instead of erasing the whole area first.
+ *             A page is erased before the first data are programmed into it, and the erase of the next page
+ *             is started as soon as a page is completed, without waiting for it to finish. So the erase runs
+ *             while the next data are received, if the code that receives them runs from SRAM or the
+ *             receiver can buffer them. Data must be written in ascending address order.
+ *
+ * @note       An erase may be in progress when FMC_WriteBuffer returns. Call FMC_DisableEraseAhead to wait for
+ *             it before using other ISP functions.
+ *
+ */
+void FMC_EnableEraseAhead(uint32_t u32Addr, uint32_t u32Len)
+{
+    FMC_WaitEraseAhead();
+    s_u32EraseAheadAddr = u32Addr;
+    s_u32EraseAheadEnd = u32Addr + u32Len;
+}
+
+/**
+ * @brief      Disable erase ahead of FMC_WriteBuffer
+ *
+ * @param      None
+ *
+ * @retval      0 Success
+ * @retval     -1 The last page erase started by FMC_WriteBuffer failed
+ *
+ * @details    This function waits for the page erase started by FMC_WriteBuffer and disables erase ahead.
+ *
+ */
+int32_t FMC_DisableEraseAhead(void)
+{
+    s_u32EraseAheadEnd = 0;
+    return FMC_WaitEraseAhead();
+}
+
 
 /*@}*/ /* end of group FMC_EXPORTED_FUNCTIONS */
 
@@ -0,0 +1,187 @@
+/**************************************************************************//**
+ * @file     hdiv.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 16/10/25 4:25p $
+ * @brief    NUC1261 series Hardware Divider(HDIV) run-time division source file
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC1261.h"
+
+/*
+    Adding this file to a project replaces the integer division helpers of the compiler run-time library
+    (__aeabi_idiv, __aeabi_uidiv, __aeabi_idivmod and __aeabi_uidivmod, used by Keil, IAR and GCC) so the
+    '/' and '%' operators use HDIV. HDIV divides a 32-bit signed dividend by a 16-bit signed divisor, other
+    operands, and all divisions while HDIV clock is disabled, are done by software.
+    Each HDIV calculation is done with PRIMASK set, so division is safe in interrupt handlers. NMI and
+    HardFault handlers cannot be masked and always use software.
+    An interrupt handler may divide between the register accesses of HDIV_Div() or HDIV_Mod() in thread
+    code, so DIVIDEND and DIVISOR are restored after each calculation and the preempted one gets its result.
+*/
+
+/// @cond HIDDEN_SYMBOLS
+static uint64_t HDIV_SoftUDivMod(uint32_t u32Dividend, uint32_t u32Divisor)
+{
+    uint32_t u32Quo = 0, u32Bit = 1;
+
+    /* Divide by zero gives quotient 0 and the dividend as remainder */
+    if(u32Divisor == 0)
+        return ((uint64_t)u32Dividend << 32);
+
+    while((u32Divisor < u32Dividend) && !(u32Divisor & 0x80000000ul))
+    {
+        u32Divisor <<= 1;
+        u32Bit <<= 1;
+    }
+
+    while(u32Bit)
+    {
+        if(u32Dividend >= u32Divisor)
+        {
+            u32Dividend -= u32Divisor;
+            u32Quo |= u32Bit;
+        }
+        u32Divisor >>= 1;
+        u32Bit >>= 1;
+    }
+
+    return (((uint64_t)u32Dividend << 32) | u32Quo);
+}
+
+static uint64_t HDIV_HwDivMod(uint32_t u32Dividend, uint32_t u32Divisor)
+{
+    uint32_t u32Primask, u32SaveDividend, u32SaveDivisor, u32Quo, u32Rem;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    u32SaveDividend = HDIV->DIVIDEND;
+    u32SaveDivisor = HDIV->DIVISOR;
+    HDIV->DIVIDEND = u32Dividend;
+    HDIV->DIVISOR = u32Divisor;
+    u32Quo = HDIV->DIVQUO;
+    u32Rem = HDIV->DIVREM;
+    /* Writing DIVISOR calculates again with the operands of the preempted code */
+    HDIV->DIVIDEND = u32SaveDividend;
+    HDIV->DIVISOR = u32SaveDivisor;
+    __set_PRIMASK(u32Primask);
+
+    return (((uint64_t)u32Rem << 32) | u32Quo);
+}
+
+static __INLINE uint32_t HDIV_IsUsable(void)
+{
+    uint32_t u32Ipsr = __get_IPSR();
+
+    /* IPSR 2 is NMI and 3 is HardFault, they are not masked by PRIMASK */
+    return ((CLK->AHBCLK & CLK_AHBCLK_HDIVCKEN_Msk) && ((u32Ipsr - 2) > 1));
+}
+/// @endcond HIDDEN_SYMBOLS
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup HDIV_Driver HDIV Driver
+  @{
+*/
+
+/** @addtogroup HDIV_EXPORTED_FUNCTIONS HDIV Exported Functions
+  @{
+*/
+
+/**
+ * @brief      Run-time unsigned division with remainder
+ *
+ * @param[in]  u32Dividend  The dividend of the division
+ * @param[in]  u32Divisor   The divisor of the division
+ *
+ * @return     The quotient in bits [31:0] and the remainder in bits [63:32]
+ *
+ * @details    HDIV is used when u32Dividend is less than 0x80000000 and u32Divisor is 1 to 0x7FFF.
+ *             Divide by zero gives quotient 0 and u32Dividend as remainder.
+ */
+uint64_t __aeabi_uidivmod(uint32_t u32Dividend, uint32_t u32Divisor)
+{
+    if((u32Dividend & 0x80000000ul) || (u32Divisor - 1 >= 0x7FFFul) || !HDIV_IsUsable())
+        return HDIV_SoftUDivMod(u32Dividend, u32Divisor);
+
+    return HDIV_HwDivMod(u32Dividend, u32Divisor);
+}
+
+/**
+ * @brief      Run-time unsigned division
+ *
+ * @param[in]  u32Dividend  The dividend of the division
+ * @param[in]  u32Divisor   The divisor of the division
+ *
+ * @return     The quotient of (u32Dividend / u32Divisor)
+ *
+ * @details    See __aeabi_uidivmod.
+ */
+uint32_t __aeabi_uidiv(uint32_t u32Dividend, uint32_t u32Divisor)
+{
+    return (uint32_t)__aeabi_uidivmod(u32Dividend, u32Divisor);
+}
+
+/**
+ * @brief      Run-time signed division with remainder
+ *
+ * @param[in]  i32Dividend  The dividend of the division
+ * @param[in]  i32Divisor   The divisor of the division
+ *
+ * @return     The quotient in bits [31:0] and the remainder in bits [63:32]
+ *
+ * @details    The quotient is rounded toward zero and the remainder has the sign of i32Dividend.
+ *             HDIV is used when i32Divisor is -32768 to 32767 except 0 and -1.
+ *             Divide by zero gives quotient 0 and i32Dividend as remainder.
+ */
+int64_t __aeabi_idivmod(int32_t i32Dividend, int32_t i32Divisor)
+{
+    uint32_t u32Quo, u32Rem, u32Abs, u32AbsDivisor;
+    uint64_t u64Res;
+
+    /* -1 is done by software for the overflow of 0x80000000 / -1 */
+    if((i32Divisor + 0x8000ul > 0xFFFFul) || (i32Divisor == 0) || (i32Divisor == -1) || !HDIV_IsUsable())
+    {
+        u32Abs = (i32Dividend < 0) ? (0 - (uint32_t)i32Dividend) : (uint32_t)i32Dividend;
+        u32AbsDivisor = (i32Divisor < 0) ? (0 - (uint32_t)i32Divisor) : (uint32_t)i32Divisor;
+        u64Res = HDIV_SoftUDivMod(u32Abs, u32AbsDivisor);
+        u32Quo = (uint32_t)u64Res;
+        u32Rem = (uint32_t)(u64Res >> 32);
+        if((i32Dividend ^ i32Divisor) < 0)
+            u32Quo = 0 - u32Quo;
+        if(i32Dividend < 0)
+            u32Rem = 0 - u32Rem;
+    }
+    else
+    {
+        return (int64_t)HDIV_HwDivMod((uint32_t)i32Dividend, (uint32_t)i32Divisor);
+    }
+
+    return (int64_t)(((uint64_t)u32Rem << 32) | u32Quo);
+}
+
+/**
+ * @brief      Run-time signed division
+ *
+ * @param[in]  i32Dividend  The dividend of the division
+ * @param[in]  i32Divisor   The divisor of the division
+ *
+ * @return     The quotient of (i32Dividend / i32Divisor)
+ *
+ * @details    See __aeabi_idivmod.
+ */
+int32_t __aeabi_idiv(int32_t i32Dividend, int32_t i32Divisor)
+{
+    return (int32_t)__aeabi_idivmod(i32Dividend, i32Divisor);
+}
+
+/*@}*/ /* end of group HDIV_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group HDIV_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
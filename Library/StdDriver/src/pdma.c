@@ -13,6 +13,15 @@
 
 static uint8_t u32ChSelect[PDMA_CH_MAX];
 
+static S_PDMA_DESC_T s_asPdmaDescPool[PDMA_JOB_DESC_NUM];   /* Scatter-gather descriptor pool of job scheduler */
+static uint32_t s_au32PdmaDescCtl[PDMA_JOB_DESC_NUM];      /* Control word of each descriptor, to re-arm cyclic jobs */
+static uint8_t s_au8PdmaDescNext[PDMA_JOB_DESC_NUM];       /* Pool index of next descriptor in the same job */
+static uint32_t s_u32PdmaDescUsed = 0;                      /* Allocated descriptors, one bit per pool entry */
+static uint32_t s_u32PdmaJobChMask = 0;                     /* Channels owned by job scheduler */
+static S_PDMA_JOB_T *s_apsPdmaChJob[PDMA_CH_MAX];           /* Job running on each channel */
+static S_PDMA_JOB_T *s_psPdmaJobHead = NULL;                /* Pending job queue */
+static S_PDMA_JOB_T *s_psPdmaJobTail = NULL;
+
 /** @addtogroup Standard_Driver Standard Driver
   @{
 */
@@ -353,6 +362,546 @@ void PDMA_DisableInt(uint32_t u32Ch, uint32_t u32Mask)
     }
 }
 
+/// @cond HIDDEN_SYMBOLS
+/**
+ * @brief       Return descriptors of a job to the pool
+ *
+ * @param[in]   psJob           The pointer of PDMA job
+ *
+ * @return      None
+ */
+static void PDMA_JobFreeDesc(S_PDMA_JOB_T *psJob)
+{
+    uint32_t u32Primask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+    s_u32PdmaDescUsed &= ~psJob->u32DescMask;
+    __set_PRIMASK(u32Primask);
+
+    psJob->u32DescMask = 0;
+    psJob->psFirst = NULL;
+    psJob->psLast = NULL;
+}
+
+/**
+ * @brief       Start a job on the selected channel
+ *
+ * @param[in]   u32Ch           The selected channel
+ * @param[in]   psJob           The pointer of PDMA job
+ *
+ * @return      None
+ *
+ * @details     The channel embedded descriptor is the scatter-gather head, so the first pool descriptor is loaded
+ *              by hardware at once. Caller must make sure PDMA interrupt cannot preempt this function.
+ */
+static void PDMA_JobStart(uint32_t u32Ch, S_PDMA_JOB_T *psJob)
+{
+    s_apsPdmaChJob[u32Ch] = psJob;
+    psJob->i32Ch = (int32_t)u32Ch;
+    psJob->u32Status = PDMA_JOB_BUSY;
+    psJob->psCur = psJob->psFirst;
+
+    PDMA->CHCTL |= (1 << u32Ch);
+    PDMA_SetTransferMode(u32Ch, psJob->u32Peripheral, TRUE, (uint32_t)psJob->psFirst);
+    PDMA_Trigger(u32Ch);
+}
+
+/**
+ * @brief       Finish the transfer of the job running on the selected channel
+ *
+ * @param[in]   u32Ch           The selected channel
+ * @param[in]   u32Status       PDMA_JOB_DONE or PDMA_JOB_ABORT
+ *
+ * @return      The job to be called back. NULL if no job is running on the channel.
+ *
+ * @details     The chained job or the first pending job is started before the callback is called,
+ *              so the channel does not stay idle while callback is running. A cyclic job only
+ *              finishes one descriptor and keeps running.
+ *              Caller must make sure PDMA interrupt cannot preempt this function.
+ */
+static S_PDMA_JOB_T *PDMA_JobFinish(uint32_t u32Ch, uint32_t u32Status)
+{
+    S_PDMA_JOB_T *psJob = s_apsPdmaChJob[u32Ch];
+    S_PDMA_JOB_T *psNext;
+    uint32_t u32Idx;
+
+    if(psJob == NULL)
+        return NULL;
+
+    if(psJob->u32Cyclic && (u32Status == PDMA_JOB_DONE))
+    {
+        /* Hardware sets the finished descriptor idle. Re-arm it for next turn of the ring. */
+        u32Idx = (uint32_t)(psJob->psCur - s_asPdmaDescPool);
+        psJob->psCur->u32Ctl = s_au32PdmaDescCtl[u32Idx];
+        psJob->psCur = &s_asPdmaDescPool[s_au8PdmaDescNext[u32Idx]];
+        return psJob;
+    }
+
+    s_apsPdmaChJob[u32Ch] = NULL;
+    PDMA_JobFreeDesc(psJob);
+    psJob->i32Ch = -1;
+    psJob->u32Status = u32Status;
+
+    if(u32Status == PDMA_JOB_DONE)
+    {
+        psNext = psJob->psChain;
+    }
+    else
+    {
+        /* Drop the rest of chain after target abort or cancel */
+        psNext = psJob->psChain;
+        while(psNext != NULL)
+        {
+            PDMA_JobFreeDesc(psNext);
+            psNext->u32Status = PDMA_JOB_ABORT;
+            psNext = psNext->psChain;
+        }
+    }
+
+    if((psNext == NULL) && (s_psPdmaJobHead != NULL))
+    {
+        psNext = s_psPdmaJobHead;
+        s_psPdmaJobHead = psNext->psNext;
+        if(s_psPdmaJobHead == NULL)
+            s_psPdmaJobTail = NULL;
+    }
+
+    if(psNext != NULL)
+        PDMA_JobStart(u32Ch, psNext);
+
+    return psJob;
+}
+
+/**
+ * @brief       Serve the flags of the selected channel
+ *
+ * @param[in]   u32Ch           The selected channel
+ *
+ * @return      None
+ *
+ * @details     A flag is taken and its job is finished with interrupts disabled, so PDMA_JobWait() and
+ *              PDMA_JobIRQHandler() never serve the same transfer twice. Callbacks run with interrupts enabled.
+ */
+static void PDMA_JobService(uint32_t u32Ch)
+{
+    S_PDMA_JOB_T *psJob = NULL;
+    S_PDMA_JOB_T *psChain;
+    uint32_t u32Mask = (1UL << u32Ch);
+    uint32_t u32Primask, u32Status = PDMA_JOB_IDLE;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    if(PDMA_GET_ABORT_STS() & u32Mask)
+    {
+        PDMA_CLR_ABORT_FLAG(u32Mask);
+        psJob = PDMA_JobFinish(u32Ch, PDMA_JOB_ABORT);
+    }
+    else if(PDMA_GET_TD_STS() & u32Mask)
+    {
+        PDMA_CLR_TD_FLAG(u32Mask);
+        PDMA_CLR_EMPTY_FLAG(u32Mask);
+        psJob = PDMA_JobFinish(u32Ch, PDMA_JOB_DONE);
+    }
+
+    /* PDMA_JOB_BUSY for a descriptor of cyclic job */
+    if(psJob != NULL)
+        u32Status = psJob->u32Status;
+
+    __set_PRIMASK(u32Primask);
+
+    if(psJob == NULL)
+        return;
+
+    if(u32Status == PDMA_JOB_ABORT)
+    {
+        for(psChain = psJob->psChain; psChain != NULL; psChain = psChain->psChain)
+        {
+            if(psChain->pfnCallback)
+                psChain->pfnCallback(psChain, PDMA_JOB_ABORT);
+        }
+    }
+
+    if(psJob->pfnCallback)
+        psJob->pfnCallback(psJob, u32Status);
+}
+/// @endcond HIDDEN_SYMBOLS
+
+/**
+ * @brief       Open PDMA Job Scheduler
+ *
+ * @param[in]   u32Mask         Channel enable bits of the channels shared by job scheduler.
+ *
+ * @return      None
+ *
+ * @details     This function enables the selected channels and their transfer done interrupt, and hands them over
+ *              to job scheduler. Channels not in u32Mask can still be used by PDMA_SetTransferMode() directly.
+ *              PDMA_JobIRQHandler() must be called in PDMA_IRQHandler().
+ */
+void PDMA_JobOpen(uint32_t u32Mask)
+{
+    uint32_t i;
+
+    PDMA_Open(u32Mask);
+
+    for(i = 0UL; i < PDMA_CH_MAX; i++)
+    {
+        if((1 << i) & u32Mask)
+        {
+            s_apsPdmaChJob[i] = NULL;
+            PDMA_EnableInt(i, PDMA_INT_TRANS_DONE);
+        }
+    }
+
+    s_u32PdmaJobChMask = u32Mask;
+    s_psPdmaJobHead = NULL;
+    s_psPdmaJobTail = NULL;
+
+    NVIC_EnableIRQ(PDMA_IRQn);
+}
+
+/**
+ * @brief       Initialize PDMA Job
+ *
+ * @param[in]   psJob           The pointer of PDMA job
+ * @param[in]   u32Peripheral   The request source. Valid values are the same as PDMA_SetTransferMode().
+ * @param[in]   pfnCallback     Completion callback. Can be NULL.
+ * @param[in]   pvUserData      User data for callback.
+ *
+ * @return      None
+ *
+ * @details     This function initializes an empty job. Memory to memory job uses burst transfer and
+ *              peripheral job uses single transfer. User can change u32Burst before adding descriptors.
+ */
+void PDMA_JobInit(S_PDMA_JOB_T *psJob, uint32_t u32Peripheral, PDMA_JOB_CB pfnCallback, void *pvUserData)
+{
+    psJob->u32Peripheral = u32Peripheral;
+    psJob->u32Burst = (u32Peripheral == PDMA_MEM) ? (PDMA_REQ_BURST | PDMA_BURST_128) : PDMA_REQ_SINGLE;
+    psJob->psFirst = NULL;
+    psJob->psLast = NULL;
+    psJob->u32DescMask = 0;
+    psJob->u32Cyclic = 0;
+    psJob->psCur = NULL;
+    psJob->psChain = NULL;
+    psJob->psNext = NULL;
+    psJob->i32Ch = -1;
+    psJob->u32Status = PDMA_JOB_IDLE;
+    psJob->pfnCallback = pfnCallback;
+    psJob->pvUserData = pvUserData;
+}
+
+/**
+ * @brief       Add a Transfer to PDMA Job
+ *
+ * @param[in]   psJob           The pointer of PDMA job
+ * @param[in]   u32Width        Data width. Valid values are
+ *                - \ref PDMA_WIDTH_8
+ *                - \ref PDMA_WIDTH_16
+ *                - \ref PDMA_WIDTH_32
+ * @param[in]   u32SrcAddr      Source address
+ * @param[in]   u32SrcCtrl      Source control attribute. Valid values are
+ *                - \ref PDMA_SAR_INC
+ *                - \ref PDMA_SAR_FIX
+ * @param[in]   u32DstAddr      Destination address
+ * @param[in]   u32DstCtrl      Destination control attribute. Valid values are
+ *                - \ref PDMA_DAR_INC
+ *                - \ref PDMA_DAR_FIX
+ * @param[in]   u32TransCount   Transfer count, 1 ~ 16384
+ *
+ * @retval      0   Success
+ * @retval      -1  Descriptor pool is empty, job is already submitted or job is cyclic
+ *
+ * @details     This function takes one descriptor from the pool and links it to the end of job.
+ *              Only the last descriptor of a job raises transfer done interrupt.
+ */
+int32_t PDMA_JobAddDesc(S_PDMA_JOB_T *psJob, uint32_t u32Width, uint32_t u32SrcAddr, uint32_t u32SrcCtrl, uint32_t u32DstAddr, uint32_t u32DstCtrl, uint32_t u32TransCount)
+{
+    S_PDMA_DESC_T *psDesc;
+    uint32_t u32Primask, i;
+
+    if((psJob->u32Status != PDMA_JOB_IDLE) || psJob->u32Cyclic)
+        return -1;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    for(i = 0UL; i < PDMA_JOB_DESC_NUM; i++)
+    {
+        if((s_u32PdmaDescUsed & (1UL << i)) == 0)
+        {
+            s_u32PdmaDescUsed |= (1UL << i);
+            break;
+        }
+    }
+    __set_PRIMASK(u32Primask);
+
+    if(i == PDMA_JOB_DESC_NUM)
+        return -1;
+
+    psDesc = &s_asPdmaDescPool[i];
+    psJob->u32DescMask |= (1UL << i);
+
+    psDesc->u32Ctl = ((u32TransCount - 1) << PDMA_DSCT_CTL_TXCNT_Pos) | u32Width | u32SrcCtrl | u32DstCtrl |
+                     psJob->u32Burst | PDMA_OP_BASIC;
+    psDesc->u32Src = u32SrcAddr;
+    psDesc->u32Dst = u32DstAddr;
+    psDesc->u32Next = 0;
+    s_au8PdmaDescNext[i] = (uint8_t)i;
+
+    if(psJob->psLast == NULL)
+    {
+        psJob->psFirst = psDesc;
+    }
+    else
+    {
+        /* Previous descriptor continues to this one without interrupt */
+        psJob->psLast->u32Ctl = (psJob->psLast->u32Ctl & ~PDMA_DSCT_CTL_OPMODE_Msk) | PDMA_OP_SCATTER | PDMA_DSCT_CTL_TBINTDIS_Msk;
+        psJob->psLast->u32Next = (uint32_t)psDesc - PDMA->SCATBA;
+        s_au8PdmaDescNext[psJob->psLast - s_asPdmaDescPool] = (uint8_t)i;
+    }
+    psJob->psLast = psDesc;
+
+    return 0;
+}
+
+/**
+ * @brief       Chain PDMA Jobs
+ *
+ * @param[in]   psJob           The pointer of PDMA job
+ * @param[in]   psNextJob       The job started on the same channel after psJob is done. NULL to remove the chain.
+ *
+ * @return      None
+ *
+ * @details     Chained job is not submitted by itself. It is started from PDMA interrupt as soon as psJob is done,
+ *              before any pending job, and it is aborted if psJob is aborted.
+ */
+void PDMA_JobChain(S_PDMA_JOB_T *psJob, S_PDMA_JOB_T *psNextJob)
+{
+    psJob->psChain = psNextJob;
+}
+
+/**
+ * @brief       Make PDMA Job Cyclic
+ *
+ * @param[in]   psJob           The pointer of PDMA job
+ *
+ * @retval      0   Success
+ * @retval      -1  Job has no descriptor or is already submitted
+ *
+ * @details     This function links the last descriptor back to the first one, so the job runs its descriptors
+ *              as a ring. Every descriptor raises transfer done interrupt and the callback is called with
+ *              PDMA_JOB_BUSY after each one, when the driver has re-armed it for the next turn. A cyclic job
+ *              does not finish by itself. It is stopped by PDMA_JobCancel(). Descriptors cannot be added after
+ *              this function is called.
+ */
+int32_t PDMA_JobSetCyclic(S_PDMA_JOB_T *psJob)
+{
+    S_PDMA_DESC_T *psDesc;
+    uint32_t u32Idx;
+
+    if((psJob->psFirst == NULL) || (psJob->u32Status == PDMA_JOB_QUEUED) || (psJob->u32Status == PDMA_JOB_BUSY))
+        return -1;
+
+    psJob->psLast->u32Next = (uint32_t)psJob->psFirst - PDMA->SCATBA;
+    s_au8PdmaDescNext[psJob->psLast - s_asPdmaDescPool] = (uint8_t)(psJob->psFirst - s_asPdmaDescPool);
+
+    psDesc = psJob->psFirst;
+    do
+    {
+        u32Idx = (uint32_t)(psDesc - s_asPdmaDescPool);
+        psDesc->u32Ctl = (psDesc->u32Ctl & ~(PDMA_DSCT_CTL_OPMODE_Msk | PDMA_DSCT_CTL_TBINTDIS_Msk)) | PDMA_OP_SCATTER;
+        s_au32PdmaDescCtl[u32Idx] = psDesc->u32Ctl;
+        psDesc = &s_asPdmaDescPool[s_au8PdmaDescNext[u32Idx]];
+    }
+    while(psDesc != psJob->psFirst);
+
+    psJob->u32Cyclic = 1;
+
+    return 0;
+}
+
+/**
+ * @brief       Submit PDMA Job
+ *
+ * @param[in]   psJob           The pointer of PDMA job
+ *
+ * @retval      0   Job is running or queued
+ * @retval      -1  Job has no descriptor or is already submitted
+ *
+ * @details     This function starts the job on a free scheduler channel, or appends it to the pending queue if all
+ *              channels are busy. Memory to memory job is triggered by software. For peripheral job, the PDMA
+ *              request of the peripheral must be enabled by user and it is served when the job is started.
+ */
+int32_t PDMA_JobSubmit(S_PDMA_JOB_T *psJob)
+{
+    uint32_t u32Primask, i;
+
+    if((psJob->psFirst == NULL) || (psJob->u32Status == PDMA_JOB_QUEUED) || (psJob->u32Status == PDMA_JOB_BUSY))
+        return -1;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    for(i = 0UL; i < PDMA_CH_MAX; i++)
+    {
+        if(((1 << i) & s_u32PdmaJobChMask) && (s_apsPdmaChJob[i] == NULL))
+            break;
+    }
+
+    if(i < PDMA_CH_MAX)
+    {
+        PDMA_JobStart(i, psJob);
+    }
+    else
+    {
+        psJob->psNext = NULL;
+        psJob->u32Status = PDMA_JOB_QUEUED;
+        if(s_psPdmaJobTail == NULL)
+            s_psPdmaJobHead = psJob;
+        else
+            s_psPdmaJobTail->psNext = psJob;
+        s_psPdmaJobTail = psJob;
+    }
+
+    __set_PRIMASK(u32Primask);
+
+    return 0;
+}
+
+/**
+ * @brief       Wait PDMA Job
+ *
+ * @param[in]   psJob           The pointer of a submitted PDMA job
+ *
+ * @retval      0   Job is done
+ * @retval      -1  Job is aborted
+ *
+ * @details     This function waits until the job is finished. It serves the scheduler channels by polling, so it
+ *              also works with interrupts disabled or in an interrupt handler that PDMA interrupt cannot
+ *              preempt. Callbacks of the jobs finished while waiting are called by this function.
+ *              It must not be used for a cyclic job.
+ */
+int32_t PDMA_JobWait(S_PDMA_JOB_T *psJob)
+{
+    while(!PDMA_JOB_IS_FINISHED(psJob))
+        PDMA_JobIRQHandler();
+
+    return (psJob->u32Status == PDMA_JOB_DONE) ? 0 : -1;
+}
+
+/**
+ * @brief       Cancel PDMA Job
+ *
+ * @param[in]   psJob           The pointer of PDMA job
+ *
+ * @return      None
+ *
+ * @details     This function removes a queued job from the pending queue, or resets the channel of a running job.
+ *              The job and its chained jobs are finished with PDMA_JOB_ABORT and their descriptors are returned
+ *              to the pool. No callback is called. For a peripheral job, user should disable the PDMA request of
+ *              the peripheral first, so the transferred count read before cancelling is final.
+ */
+void PDMA_JobCancel(S_PDMA_JOB_T *psJob)
+{
+    S_PDMA_JOB_T **ppsLink;
+    S_PDMA_JOB_T *psPrev = NULL;
+    uint32_t u32Primask, u32Ch;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    if(psJob->u32Status == PDMA_JOB_QUEUED)
+    {
+        for(ppsLink = &s_psPdmaJobHead; *ppsLink != psJob; ppsLink = &(*ppsLink)->psNext)
+            psPrev = *ppsLink;
+        *ppsLink = psJob->psNext;
+        if(s_psPdmaJobTail == psJob)
+            s_psPdmaJobTail = psPrev;
+
+        PDMA_JobFreeDesc(psJob);
+        psJob->u32Status = PDMA_JOB_ABORT;
+    }
+    else if(psJob->u32Status == PDMA_JOB_BUSY)
+    {
+        u32Ch = (uint32_t)psJob->i32Ch;
+
+        /* Channel reset completes the transfer unit in progress and disables the channel */
+        PDMA_RESET(u32Ch);
+        while(PDMA->RESET & (1UL << u32Ch));
+        PDMA_CLR_ABORT_FLAG(1UL << u32Ch);
+        PDMA_CLR_TD_FLAG(1UL << u32Ch);
+        PDMA_CLR_EMPTY_FLAG(1UL << u32Ch);
+
+        /* The cyclic flag is cleared so the job is finished instead of re-armed */
+        psJob->u32Cyclic = 0;
+        PDMA_JobFinish(u32Ch, PDMA_JOB_ABORT);
+    }
+
+    __set_PRIMASK(u32Primask);
+}
+
+/**
+ * @brief       Release PDMA Job
+ *
+ * @param[in]   psJob           The pointer of PDMA job
+ *
+ * @return      None
+ *
+ * @details     This function returns the descriptors of a job that is not submitted to the pool and resets
+ *              the job to idle state. Descriptors of a finished job are returned automatically.
+ */
+void PDMA_JobRelease(S_PDMA_JOB_T *psJob)
+{
+    if((psJob->u32Status == PDMA_JOB_QUEUED) || (psJob->u32Status == PDMA_JOB_BUSY))
+        return;
+
+    PDMA_JobFreeDesc(psJob);
+    psJob->u32Cyclic = 0;
+    psJob->u32Status = PDMA_JOB_IDLE;
+}
+
+/**
+ * @brief       Get Free Descriptor Count
+ *
+ * @param       None
+ *
+ * @return      Number of free descriptors in job descriptor pool
+ *
+ * @details     This function counts the descriptors that can be added to jobs.
+ */
+uint32_t PDMA_JobGetFreeDesc(void)
+{
+    uint32_t u32Count = 0, i;
+
+    for(i = 0UL; i < PDMA_JOB_DESC_NUM; i++)
+    {
+        if((s_u32PdmaDescUsed & (1UL << i)) == 0)
+            u32Count++;
+    }
+
+    return u32Count;
+}
+
+/**
+ * @brief       PDMA Job Scheduler Interrupt Handler
+ *
+ * @param       None
+ *
+ * @return      None
+ *
+ * @details     User must call this function in PDMA_IRQHandler(). Only the flags of scheduler channels are
+ *              cleared, so other channels can be handled by user in the same IRQ handler.
+ */
+void PDMA_JobIRQHandler(void)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < PDMA_CH_MAX; i++)
+    {
+        if((1UL << i) & s_u32PdmaJobChMask)
+            PDMA_JobService(i);
+    }
+}
+
 /*@}*/ /* end of group PDMA_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group PDMA_Driver */
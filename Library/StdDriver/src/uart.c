@@ -493,6 +493,520 @@ uint32_t UART_Write(UART_T* uart, uint8_t *pu8TxBuf, uint32_t u32WriteBytes)
 }
 
 
+/// @cond HIDDEN_SYMBOLS
+/**
+ *    @brief        Get PDMA TX request source of UART module
+ *
+ *    @param[in]    uart    The pointer of the specified UART module.
+ *
+ *    @return       PDMA TX request source. RX request source is TX request source + 1.
+ */
+static uint32_t UART_GetPDMAReq(UART_T* uart)
+{
+    if(uart == UART0)
+        return PDMA_UART0_TX;
+    else if(uart == UART1)
+        return PDMA_UART1_TX;
+    else
+        return PDMA_UART2_TX;
+}
+
+/**
+ *    @brief        Submit one PDMA job of UART data
+ *
+ *    @param[in]    psAsync     The pointer of the UART asynchronous context.
+ *    @param[in]    psJob       The TX or RX job of psAsync.
+ *    @param[in]    u32Req      PDMA request source.
+ *    @param[in]    pfnCallback Job completion callback.
+ *    @param[in]    u32SrcAddr  Source address.
+ *    @param[in]    u32SrcCtrl  Source address attribute.
+ *    @param[in]    u32DstAddr  Destination address.
+ *    @param[in]    u32DstCtrl  Destination address attribute.
+ *    @param[in]    u32Len      Transfer byte count.
+ *
+ *    @retval       0   Job is running or queued
+ *    @retval       -1  PDMA descriptor pool is empty
+ */
+static int32_t UART_AsyncSubmitPDMA(S_UART_ASYNC_T *psAsync, S_PDMA_JOB_T *psJob, uint32_t u32Req, PDMA_JOB_CB pfnCallback,
+                                    uint32_t u32SrcAddr, uint32_t u32SrcCtrl, uint32_t u32DstAddr, uint32_t u32DstCtrl, uint32_t u32Len)
+{
+    PDMA_JobInit(psJob, u32Req, pfnCallback, psAsync);
+    if(PDMA_JobAddDesc(psJob, PDMA_WIDTH_8, u32SrcAddr, u32SrcCtrl, u32DstAddr, u32DstCtrl, u32Len) != 0)
+        return -1;
+
+    return PDMA_JobSubmit(psJob);
+}
+
+static void UART_AsyncTxPDMADone(S_PDMA_JOB_T *psJob, uint32_t u32Status);
+
+/**
+ *    @brief        Start TX PDMA on the contiguous part of TX ring
+ *
+ *    @param[in]    psAsync The pointer of the UART asynchronous context.
+ *
+ *    @return       None
+ *
+ *    @details      Caller must make sure TX PDMA interrupt cannot preempt this function.
+ *                  If no PDMA descriptor is free, the data is sent by THRE interrupt and TX PDMA is
+ *                  started again by the next UART_AsyncWrite() after TX ring is drained.
+ */
+static void UART_AsyncKickTxPDMA(S_UART_ASYNC_T *psAsync)
+{
+    uint32_t u32Tail = psAsync->u32TxTail;
+    uint32_t u32Len = psAsync->u32TxHead - u32Tail;
+    uint32_t u32Idx = u32Tail & psAsync->u32TxMask;
+
+    if((psAsync->u32TxPdmaCnt != 0) || (u32Len == 0) || (psAsync->uart->INTEN & UART_INTEN_THREIEN_Msk))
+        return;
+
+    /* One transfer covers the data up to the end of ring, the wrapped part is sent by next transfer */
+    if(u32Len > (psAsync->u32TxMask + 1 - u32Idx))
+        u32Len = psAsync->u32TxMask + 1 - u32Idx;
+    if(u32Len > UART_ASYNC_PDMA_MAX_CNT)
+        u32Len = UART_ASYNC_PDMA_MAX_CNT;
+
+    if(UART_AsyncSubmitPDMA(psAsync, &psAsync->sTxJob, UART_GetPDMAReq(psAsync->uart), UART_AsyncTxPDMADone,
+                            (uint32_t)&psAsync->pu8TxBuf[u32Idx], PDMA_SAR_INC,
+                            (uint32_t)&psAsync->uart->DAT, PDMA_DAR_FIX, u32Len) != 0)
+    {
+        UART_ENABLE_INT(psAsync->uart, UART_INTEN_THREIEN_Msk);
+        return;
+    }
+
+    psAsync->u32TxPdmaCnt = u32Len;
+    psAsync->uart->INTEN |= UART_INTEN_TXPDMAEN_Msk;
+}
+
+/**
+ *    @brief        TX PDMA job callback
+ *
+ *    @param[in]    psJob       The TX job of a UART asynchronous context.
+ *    @param[in]    u32Status   PDMA_JOB_DONE or PDMA_JOB_ABORT
+ *
+ *    @return       None
+ */
+static void UART_AsyncTxPDMADone(S_PDMA_JOB_T *psJob, uint32_t u32Status)
+{
+    S_UART_ASYNC_T *psAsync = (S_UART_ASYNC_T *)psJob->pvUserData;
+    uint32_t u32Primask;
+    uint32_t u32Event = 0;
+
+    (void)u32Status;
+
+    psAsync->uart->INTEN &= ~UART_INTEN_TXPDMAEN_Msk;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    psAsync->u32TxTail += psAsync->u32TxPdmaCnt;
+    psAsync->u32TxPdmaCnt = 0;
+
+    if(psAsync->u32TxTail == psAsync->u32TxHead)
+        u32Event = UART_ASYNC_EVT_TX_EMPTY;
+    else
+        UART_AsyncKickTxPDMA(psAsync);
+
+    __set_PRIMASK(u32Primask);
+
+    if(u32Event && psAsync->pfnCallback)
+        psAsync->pfnCallback(psAsync, u32Event);
+}
+
+/**
+ *    @brief        RX PDMA job callback
+ *
+ *    @param[in]    psJob       The RX job of a UART asynchronous context.
+ *    @param[in]    u32Status   PDMA_JOB_DONE or PDMA_JOB_ABORT
+ *
+ *    @return       None
+ */
+static void UART_AsyncRxPDMADone(S_PDMA_JOB_T *psJob, uint32_t u32Status)
+{
+    S_UART_ASYNC_T *psAsync = (S_UART_ASYNC_T *)psJob->pvUserData;
+    UART_T *uart = psAsync->uart;
+
+    uart->INTEN &= ~UART_INTEN_RXPDMAEN_Msk;
+    psAsync->u32RxPdmaCnt = 0;
+
+    /* Feed RX ring again */
+    UART_ENABLE_INT(uart, (UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk));
+
+    if((u32Status == PDMA_JOB_DONE) && psAsync->pfnCallback)
+        psAsync->pfnCallback(psAsync, UART_ASYNC_EVT_RX_DONE);
+}
+/// @endcond HIDDEN_SYMBOLS
+
+
+/**
+ *    @brief        Open UART asynchronous transfer
+ *
+ *    @param[in]    psAsync         The pointer of the UART asynchronous context.
+ *    @param[in]    uart            The pointer of the specified UART module. It must be opened by UART_Open() first.
+ *    @param[in]    pu8RxBuf        The RX ring buffer.
+ *    @param[in]    u32RxSize       The RX ring size. It must be a power of 2.
+ *    @param[in]    pu8TxBuf        The TX ring buffer.
+ *    @param[in]    u32TxSize       The TX ring size. It must be a power of 2.
+ *    @param[in]    pfnCallback     The event callback function. It is called in interrupt context with
+ *                                  a combination of UART_ASYNC_EVT_* events. Can be NULL.
+ *
+ *    @return       None
+ *
+ *    @details      The function initializes the ring buffers and enables RDA, RX time-out, line status and buffer
+ *                  error interrupts. RX FIFO trigger level is set to 8 bytes so that one interrupt moves a burst
+ *                  of data, and the time-out interrupt flushes the remaining bytes of a frame.
+ *                  User must call UART_AsyncIRQHandler() in the UART IRQ handler.
+ */
+void UART_AsyncOpen(S_UART_ASYNC_T *psAsync, UART_T* uart, uint8_t *pu8RxBuf, uint32_t u32RxSize, uint8_t *pu8TxBuf, uint32_t u32TxSize, UART_ASYNC_CB pfnCallback)
+{
+    psAsync->uart = uart;
+    psAsync->pu8RxBuf = pu8RxBuf;
+    psAsync->u32RxMask = u32RxSize - 1;
+    psAsync->u32RxHead = 0;
+    psAsync->u32RxTail = 0;
+    psAsync->pu8TxBuf = pu8TxBuf;
+    psAsync->u32TxMask = u32TxSize - 1;
+    psAsync->u32TxHead = 0;
+    psAsync->u32TxTail = 0;
+    psAsync->u32TxPdmaEn = 0;
+    psAsync->u32RxPdmaEn = 0;
+    psAsync->u32TxPdmaCnt = 0;
+    psAsync->u32RxPdmaCnt = 0;
+    psAsync->pfnCallback = pfnCallback;
+
+    /* Set RX FIFO interrupt trigger level */
+    uart->FIFO = (uart->FIFO & ~UART_FIFO_RFITL_Msk) | UART_FIFO_RFITL_8BYTES;
+
+    /* Set RX time-out counter */
+    UART_SetTimeoutCnt(uart, UART_ASYNC_RX_TOUT);
+
+    UART_EnableInt(uart, (UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk | UART_INTEN_RLSIEN_Msk | UART_INTEN_BUFERRIEN_Msk));
+}
+
+
+/**
+ *    @brief        Close UART asynchronous transfer
+ *
+ *    @param[in]    psAsync The pointer of the UART asynchronous context.
+ *
+ *    @return       None
+ *
+ *    @details      The function disables the interrupts and PDMA requests used by asynchronous transfer and
+ *                  cancels its PDMA jobs. NVIC is not changed because UART0 and UART2 share the same IRQ.
+ */
+void UART_AsyncClose(S_UART_ASYNC_T *psAsync)
+{
+    UART_T *uart = psAsync->uart;
+
+    UART_DISABLE_INT(uart, (UART_INTEN_RDAIEN_Msk | UART_INTEN_THREIEN_Msk | UART_INTEN_RXTOIEN_Msk |
+                            UART_INTEN_RLSIEN_Msk | UART_INTEN_BUFERRIEN_Msk | UART_INTEN_TOCNTEN_Msk |
+                            UART_INTEN_TXPDMAEN_Msk | UART_INTEN_RXPDMAEN_Msk));
+
+    if(psAsync->u32TxPdmaEn)
+        PDMA_JobCancel(&psAsync->sTxJob);
+    if(psAsync->u32RxPdmaEn)
+        PDMA_JobCancel(&psAsync->sRxJob);
+
+    psAsync->u32TxPdmaCnt = 0;
+    psAsync->u32RxPdmaCnt = 0;
+}
+
+
+/**
+ *    @brief        Use PDMA jobs for UART asynchronous transfer
+ *
+ *    @param[in]    psAsync The pointer of the UART asynchronous context.
+ *    @param[in]    u32TxEn 1 to drain TX ring by PDMA jobs. 0 means TX is interrupt driven.
+ *    @param[in]    u32RxEn 1 to support UART_AsyncReadPDMA(). 0 means bulk receive is not supported.
+ *
+ *    @return       None
+ *
+ *    @details      Each transfer is a PDMA job which runs on a free channel of PDMA job scheduler.
+ *                  PDMA_JobOpen() must be called first and PDMA_JobIRQHandler() must be called in PDMA_IRQHandler().
+ *                  It must be called while TX ring is empty.
+ */
+void UART_AsyncSetPDMA(S_UART_ASYNC_T *psAsync, uint32_t u32TxEn, uint32_t u32RxEn)
+{
+    /* TX ring is drained by PDMA instead of THRE interrupt */
+    if(u32TxEn)
+        UART_DISABLE_INT(psAsync->uart, UART_INTEN_THREIEN_Msk);
+
+    psAsync->u32TxPdmaEn = u32TxEn;
+    psAsync->u32RxPdmaEn = u32RxEn;
+    PDMA_JobInit(&psAsync->sTxJob, UART_GetPDMAReq(psAsync->uart), UART_AsyncTxPDMADone, psAsync);
+    PDMA_JobInit(&psAsync->sRxJob, UART_GetPDMAReq(psAsync->uart) + 1, UART_AsyncRxPDMADone, psAsync);
+}
+
+
+/**
+ *    @brief        Read data from UART asynchronous RX ring
+ *
+ *    @param[in]    psAsync         The pointer of the UART asynchronous context.
+ *    @param[out]   pu8RxBuf        The buffer to receive the data.
+ *    @param[in]    u32ReadBytes    The maximum byte number to read.
+ *
+ *    @return       Received byte count. It can be less than u32ReadBytes, including 0.
+ *
+ *    @details      The function copies the data already received by interrupt handler and never waits.
+ */
+uint32_t UART_AsyncRead(S_UART_ASYNC_T *psAsync, uint8_t *pu8RxBuf, uint32_t u32ReadBytes)
+{
+    uint32_t u32Tail = psAsync->u32RxTail;
+    uint32_t u32Count = psAsync->u32RxHead - u32Tail;
+    uint32_t i;
+
+    if(u32ReadBytes < u32Count)
+        u32Count = u32ReadBytes;
+
+    for(i = 0; i < u32Count; i++)
+        pu8RxBuf[i] = psAsync->pu8RxBuf[(u32Tail + i) & psAsync->u32RxMask];
+
+    /* Release the space to interrupt handler after data is copied */
+    psAsync->u32RxTail = u32Tail + u32Count;
+
+    return u32Count;
+}
+
+
+/**
+ *    @brief        Write data to UART asynchronous TX ring
+ *
+ *    @param[in]    psAsync         The pointer of the UART asynchronous context.
+ *    @param[in]    pu8TxBuf        The buffer of data to send.
+ *    @param[in]    u32WriteBytes   The byte number of data.
+ *
+ *    @return       Queued byte count. It is less than u32WriteBytes if TX ring is full.
+ *
+ *    @details      The function queues data to TX ring and starts THRE interrupt or TX PDMA. It never waits.
+ *                  UART_ASYNC_EVT_TX_EMPTY is reported when all queued data is moved to UART TX FIFO.
+ */
+uint32_t UART_AsyncWrite(S_UART_ASYNC_T *psAsync, uint8_t *pu8TxBuf, uint32_t u32WriteBytes)
+{
+    uint32_t u32Head = psAsync->u32TxHead;
+    uint32_t u32Free = psAsync->u32TxMask + 1 - (u32Head - psAsync->u32TxTail);
+    uint32_t u32Primask, i;
+
+    if(u32WriteBytes > u32Free)
+        u32WriteBytes = u32Free;
+
+    if(u32WriteBytes == 0)
+        return 0;
+
+    for(i = 0; i < u32WriteBytes; i++)
+        psAsync->pu8TxBuf[(u32Head + i) & psAsync->u32TxMask] = pu8TxBuf[i];
+
+    /* Publish the data to interrupt handler after it is copied */
+    psAsync->u32TxHead = u32Head + u32WriteBytes;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    if(psAsync->u32TxPdmaEn)
+        UART_AsyncKickTxPDMA(psAsync);
+    else
+        UART_ENABLE_INT(psAsync->uart, UART_INTEN_THREIEN_Msk);
+    __set_PRIMASK(u32Primask);
+
+    return u32WriteBytes;
+}
+
+
+/**
+ *    @brief        Receive a block of data by PDMA
+ *
+ *    @param[in]    psAsync         The pointer of the UART asynchronous context.
+ *    @param[out]   pu8RxBuf        The buffer to receive the data. It must be valid until transfer done.
+ *    @param[in]    u32ReadBytes    The byte number of data, 1 ~ 16384.
+ *
+ *    @retval       0   Bulk receive is started
+ *    @retval       -1  RX PDMA is not enabled, a bulk receive is in progress, invalid length or no free descriptor
+ *
+ *    @details      The function moves the following u32ReadBytes bytes from UART RX FIFO to pu8RxBuf directly.
+ *                  RX ring is not fed until UART_ASYNC_EVT_RX_DONE is reported.
+ */
+int32_t UART_AsyncReadPDMA(S_UART_ASYNC_T *psAsync, uint8_t *pu8RxBuf, uint32_t u32ReadBytes)
+{
+    UART_T *uart = psAsync->uart;
+    uint32_t u32Primask;
+
+    if((psAsync->u32RxPdmaEn == 0) || (psAsync->u32RxPdmaCnt != 0) ||
+            (u32ReadBytes == 0) || (u32ReadBytes > UART_ASYNC_PDMA_MAX_CNT))
+        return -1;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    if(UART_AsyncSubmitPDMA(psAsync, &psAsync->sRxJob, UART_GetPDMAReq(uart) + 1, UART_AsyncRxPDMADone,
+                            (uint32_t)&uart->DAT, PDMA_SAR_FIX,
+                            (uint32_t)pu8RxBuf, PDMA_DAR_INC, u32ReadBytes) != 0)
+    {
+        __set_PRIMASK(u32Primask);
+        return -1;
+    }
+
+    UART_DISABLE_INT(uart, (UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk));
+    psAsync->u32RxPdmaCnt = u32ReadBytes;
+    uart->INTEN |= UART_INTEN_RXPDMAEN_Msk;
+
+    __set_PRIMASK(u32Primask);
+
+    return 0;
+}
+
+
+/**
+ *    @brief        Get progress of PDMA bulk receive
+ *
+ *    @param[in]    psAsync The pointer of the UART asynchronous context.
+ *
+ *    @return       Byte count already moved to the buffer of the bulk receive in progress.
+ *                  0 if no bulk receive is in progress.
+ *
+ *    @details      PDMA is requested for every received byte, so the count is exact and does not wait
+ *                  for RX time-out. It can be called at any time to track the head of received data.
+ */
+uint32_t UART_AsyncGetReadPDMACount(S_UART_ASYNC_T *psAsync)
+{
+    S_PDMA_JOB_T *psJob = &psAsync->sRxJob;
+    uint32_t u32Primask, u32Cnt, u32Ctl;
+
+    /* Job state and channel must not change under PDMA interrupt while they are read */
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    u32Cnt = psAsync->u32RxPdmaCnt;
+    if(u32Cnt != 0)
+    {
+        if(psJob->u32Status == PDMA_JOB_QUEUED)
+        {
+            /* Waiting for a free channel, nothing moved yet */
+            u32Cnt = 0;
+        }
+        else if(psJob->u32Status == PDMA_JOB_BUSY)
+        {
+            u32Ctl = PDMA->DSCT[psJob->i32Ch].CTL;
+
+            /* Operation mode goes back to idle when the transfer is done */
+            if(u32Ctl & PDMA_DSCT_CTL_OPMODE_Msk)
+                u32Cnt -= ((u32Ctl & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos) + 1;
+        }
+    }
+
+    __set_PRIMASK(u32Primask);
+
+    return u32Cnt;
+}
+
+
+/**
+ *    @brief        Abort PDMA bulk receive
+ *
+ *    @param[in]    psAsync The pointer of the UART asynchronous context.
+ *
+ *    @return       Byte count moved to the buffer before the bulk receive is aborted.
+ *
+ *    @details      The function stops the PDMA request of the bulk receive in progress and lets interrupts feed
+ *                  RX ring again. UART_ASYNC_EVT_RX_DONE is not reported for an aborted bulk receive.
+ */
+uint32_t UART_AsyncAbortReadPDMA(S_UART_ASYNC_T *psAsync)
+{
+    UART_T *uart = psAsync->uart;
+    uint32_t u32Primask, u32Cnt;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    u32Cnt = 0;
+    if(psAsync->u32RxPdmaCnt != 0)
+    {
+        /* Stop PDMA request before the count is read */
+        uart->INTEN &= ~UART_INTEN_RXPDMAEN_Msk;
+        u32Cnt = UART_AsyncGetReadPDMACount(psAsync);
+        /* No callback is called for a cancelled job */
+        PDMA_JobCancel(&psAsync->sRxJob);
+        psAsync->u32RxPdmaCnt = 0;
+
+        UART_ENABLE_INT(uart, (UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk));
+    }
+
+    __set_PRIMASK(u32Primask);
+
+    return u32Cnt;
+}
+
+
+/**
+ *    @brief        UART asynchronous transfer interrupt handler
+ *
+ *    @param[in]    psAsync The pointer of the UART asynchronous context.
+ *
+ *    @return       None
+ *
+ *    @details      User must call this function in UART02_IRQHandler() or UART1_IRQHandler().
+ *                  For UART0 and UART2 sharing one IRQ, it can be called for both contexts.
+ */
+void UART_AsyncIRQHandler(S_UART_ASYNC_T *psAsync)
+{
+    UART_T *uart = psAsync->uart;
+    uint32_t u32IntSts = uart->INTSTS;
+    uint32_t u32Event = 0;
+    uint32_t u32Idx, u32Cnt;
+
+    if(u32IntSts & (UART_INTSTS_RDAINT_Msk | UART_INTSTS_RXTOINT_Msk))
+    {
+        /* Drain RX FIFO. RDA and RX time-out flags are cleared by reading data */
+        u32Idx = psAsync->u32RxHead;
+        while((uart->FIFOSTS & UART_FIFOSTS_RXEMPTY_Msk) == 0)
+        {
+            if((u32Idx - psAsync->u32RxTail) <= psAsync->u32RxMask)
+            {
+                psAsync->pu8RxBuf[u32Idx & psAsync->u32RxMask] = uart->DAT;
+                u32Idx++;
+            }
+            else
+            {
+                /* RX ring full, drop the data */
+                (void)uart->DAT;
+                u32Event |= UART_ASYNC_EVT_RX_OVERFLOW;
+            }
+        }
+        psAsync->u32RxHead = u32Idx;
+        u32Event |= UART_ASYNC_EVT_RX;
+    }
+
+    if(u32IntSts & UART_INTSTS_THREINT_Msk)
+    {
+        /* TX FIFO is empty, refill up to FIFO depth */
+        u32Idx = psAsync->u32TxTail;
+        for(u32Cnt = 0; (u32Cnt < UART0_FIFO_SIZE) && (u32Idx != psAsync->u32TxHead); u32Cnt++)
+        {
+            uart->DAT = psAsync->pu8TxBuf[u32Idx & psAsync->u32TxMask];
+            u32Idx++;
+        }
+        psAsync->u32TxTail = u32Idx;
+
+        if(u32Idx == psAsync->u32TxHead)
+        {
+            UART_DISABLE_INT(uart, UART_INTEN_THREIEN_Msk);
+            u32Event |= UART_ASYNC_EVT_TX_EMPTY;
+        }
+    }
+
+    if(u32IntSts & UART_INTSTS_RLSINT_Msk)
+    {
+        uart->FIFOSTS = UART_FIFOSTS_BIF_Msk | UART_FIFOSTS_FEF_Msk | UART_FIFOSTS_PEF_Msk;
+        u32Event |= UART_ASYNC_EVT_LINE_ERR;
+    }
+
+    if(u32IntSts & UART_INTSTS_BUFERRINT_Msk)
+    {
+        uart->FIFOSTS = UART_FIFOSTS_RXOVIF_Msk | UART_FIFOSTS_TXOVIF_Msk;
+        u32Event |= UART_ASYNC_EVT_RX_OVERFLOW;
+    }
+
+    if(u32Event && psAsync->pfnCallback)
+        psAsync->pfnCallback(psAsync, u32Event);
+}
+
+
 /*@}*/ /* end of group UART_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group UART_Driver */
@@ -682,6 +682,43 @@ void USBD_CtrlOut(void)
     }
 }
 
+#ifdef USBD_MEMCOPY_PDMA
+/**
+  * @brief    Copy words by a PDMA job
+  *
+  * @param[in]  dest Word aligned destination pointer.
+  *
+  * @param[in]  src  Word aligned source pointer.
+  *
+  * @param[in]  size Byte count. Only the whole words are copied.
+  *
+  * @retval   0   Words are copied
+  * @retval   -1  Nothing is copied, or the job is aborted. Caller copies by CPU.
+  *
+  * @details  This function is called by USBD_MemCopy(). It waits the job by polling, so it can be called in
+  *           USB interrupt. The job is not queued behind other jobs. If no scheduler channel is free, it is
+  *           cancelled and the caller copies by CPU.
+  *
+  */
+int32_t USBD_MemCopyPDMA(uint8_t *dest, uint8_t *src, int32_t size)
+{
+    S_PDMA_JOB_T sJob;
+
+    PDMA_JobInit(&sJob, PDMA_MEM, NULL, NULL);
+    if(PDMA_JobAddDesc(&sJob, PDMA_WIDTH_32, (uint32_t)src, PDMA_SAR_INC, (uint32_t)dest, PDMA_DAR_INC, (uint32_t)size >> 2) != 0)
+        return -1;
+
+    PDMA_JobSubmit(&sJob);
+    if(sJob.u32Status == PDMA_JOB_QUEUED)
+    {
+        PDMA_JobCancel(&sJob);
+        return -1;
+    }
+
+    return PDMA_JobWait(&sJob);
+}
+#endif
+
 /**
   * @brief    Reset software flags
   *
@@ -758,6 +795,217 @@ void USBD_LockEpStall(uint32_t u32EpBitmap)
 }
 
 
+/**
+ * @brief       Open double buffer for an OUT endpoint
+ *
+ * @param[in]   psDBuf          Double buffer control structure
+ * @param[in]   u32Ep           Endpoint ID. It could be EP0 ~ EP7.
+ * @param[in]   pu8Buf0         First SRAM buffer. Its size must be u32MaxPktSize at least.
+ * @param[in]   pu8Buf1         Second SRAM buffer. Its size must be u32MaxPktSize at least.
+ * @param[in]   u32MaxPktSize   Maximum packet size of the endpoint
+ *
+ * @return      None
+ *
+ * @details     This function resets both buffers to empty and triggers the endpoint to receive OUT data.
+ *              Word aligned buffers let USBD_MemCopy copy by words.
+ */
+void USBD_DBufOpen(S_USBD_DBUF_T *psDBuf, uint32_t u32Ep, uint8_t *pu8Buf0, uint8_t *pu8Buf1, uint32_t u32MaxPktSize)
+{
+    psDBuf->apu8Buf[0] = pu8Buf0;
+    psDBuf->apu8Buf[1] = pu8Buf1;
+    psDBuf->au32Len[0] = 0;
+    psDBuf->au32Len[1] = 0;
+    psDBuf->u32MaxPktSize = u32MaxPktSize;
+    psDBuf->u8Ep = (uint8_t)u32Ep;
+    psDBuf->u8Head = 0;
+    psDBuf->u8Tail = 0;
+    psDBuf->u8Count = 0;
+    psDBuf->u8Armed = 1;
+
+    USBD_SET_PAYLOAD_LEN(u32Ep, u32MaxPktSize);
+}
+
+/**
+ * @brief       Double buffer OUT endpoint handler
+ *
+ * @param[in]   psDBuf          Double buffer control structure
+ *
+ * @return      None
+ *
+ * @details     Call this function in endpoint interrupt handler when new OUT data is received.
+ *              The packet is copied to a free SRAM buffer and the endpoint is triggered again at once
+ *              if the other buffer is still free. Otherwise host is NAKed until USBD_DBufRelease is called.
+ */
+void USBD_DBufOutHandler(S_USBD_DBUF_T *psDBuf)
+{
+    uint32_t u32Len;
+    uint8_t u8Idx;
+
+    u8Idx = psDBuf->u8Head;
+    u32Len = USBD_GET_PAYLOAD_LEN(psDBuf->u8Ep);
+    USBD_MemCopy(psDBuf->apu8Buf[u8Idx], (uint8_t *)(USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(psDBuf->u8Ep)), u32Len);
+    psDBuf->au32Len[u8Idx] = u32Len;
+    psDBuf->u8Head = u8Idx ^ 1;
+    psDBuf->u8Count++;
+
+    if(psDBuf->u8Count < 2)
+        USBD_SET_PAYLOAD_LEN(psDBuf->u8Ep, psDBuf->u32MaxPktSize);
+    else
+        psDBuf->u8Armed = 0;
+}
+
+/**
+ * @brief       Get the oldest received packet of double buffer
+ *
+ * @param[in]   psDBuf          Double buffer control structure
+ * @param[out]  pu32Len         Packet length
+ *
+ * @return      Pointer to packet data. NULL if no packet is received.
+ *
+ * @details     The buffer is owned by caller until USBD_DBufRelease is called.
+ */
+uint8_t *USBD_DBufGet(S_USBD_DBUF_T *psDBuf, uint32_t *pu32Len)
+{
+    if(psDBuf->u8Count == 0)
+        return NULL;
+
+    *pu32Len = psDBuf->au32Len[psDBuf->u8Tail];
+    return psDBuf->apu8Buf[psDBuf->u8Tail];
+}
+
+/**
+ * @brief       Release the packet got by USBD_DBufGet
+ *
+ * @param[in]   psDBuf          Double buffer control structure
+ *
+ * @return      None
+ *
+ * @details     The buffer becomes free for next packet. The endpoint is triggered again if it was stopped.
+ */
+void USBD_DBufRelease(S_USBD_DBUF_T *psDBuf)
+{
+    uint32_t u32Primask;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    if(psDBuf->u8Count)
+    {
+        psDBuf->u8Tail ^= 1;
+        psDBuf->u8Count--;
+
+        if(psDBuf->u8Armed == 0)
+        {
+            psDBuf->u8Armed = 1;
+            USBD_SET_PAYLOAD_LEN(psDBuf->u8Ep, psDBuf->u32MaxPktSize);
+        }
+    }
+
+    __set_PRIMASK(u32Primask);
+}
+
+
+/**
+ * @brief       Open feedback value control of an isochronous feedback endpoint
+ *
+ * @param[in]   psFb            Feedback control structure
+ * @param[in]   u32Ep           Endpoint ID of feedback IN endpoint. It could be EP0 ~ EP7.
+ * @param[in]   u32SampleRate   Nominal sampling rate in Hz
+ * @param[in]   u32Shift        Measure window is 2^u32Shift frames. It could be 1 ~ 10 and
+ *                              should be the same as bRefresh of feedback endpoint descriptor.
+ *
+ * @return      None
+ *
+ * @details     Feedback value is started from nominal rate. It is in 10.14 format of full speed,
+ *              that is samples per 1 ms frame with 14-bit fraction.
+ */
+void USBD_FbOpen(S_USBD_FB_T *psFb, uint32_t u32Ep, uint32_t u32SampleRate, uint32_t u32Shift)
+{
+    psFb->u32Nominal = (u32SampleRate << 14) / 1000;
+    psFb->u32Rate = psFb->u32Nominal;
+    psFb->u32Value = psFb->u32Nominal;
+    psFb->u32SampleCnt = 0;
+    psFb->u32SofCnt = 0;
+    psFb->u8Ep = (uint8_t)u32Ep;
+    psFb->u8Shift = (uint8_t)u32Shift;
+    psFb->u8Started = 0;
+}
+
+/**
+ * @brief       Update feedback value at SOF
+ *
+ * @param[in]   psFb            Feedback control structure
+ * @param[in]   u32SampleCnt    Free running count of samples consumed by device at this SOF
+ * @param[in]   i32FillErr      Samples in device buffer minus its target level
+ *
+ * @return      None
+ *
+ * @details     This function is called in SOF interrupt. The consumed samples are measured over
+ *              each window of 2^u8Shift frames to get device rate. The buffer fill error is added
+ *              to steer buffer level back to target in about 256 frames.
+ *              A window out of +-1/64 nominal rate, e.g. disturbed by lost SOF, is ignored.
+ */
+void USBD_FbSOF(S_USBD_FB_T *psFb, uint32_t u32SampleCnt, int32_t i32FillErr)
+{
+    int32_t i32Rate, i32Value, i32Limit;
+
+    if(psFb->u8Started == 0)
+    {
+        psFb->u32SampleCnt = u32SampleCnt;
+        psFb->u32SofCnt = 0;
+        psFb->u8Started = 1;
+        return;
+    }
+
+    if(++psFb->u32SofCnt < (1UL << psFb->u8Shift))
+        return;
+
+    /* Samples per frame of this window in 10.14 format */
+    i32Rate = (int32_t)((u32SampleCnt - psFb->u32SampleCnt) << (14 - psFb->u8Shift));
+    psFb->u32SampleCnt = u32SampleCnt;
+    psFb->u32SofCnt = 0;
+
+    i32Limit = (int32_t)(psFb->u32Nominal >> 6);
+    if((i32Rate > (int32_t)psFb->u32Nominal + i32Limit) || (i32Rate < (int32_t)psFb->u32Nominal - i32Limit))
+        return;
+
+    /* Low pass the measured rate */
+    i32Rate = (int32_t)psFb->u32Rate + ((i32Rate - (int32_t)psFb->u32Rate) >> 2);
+    psFb->u32Rate = (uint32_t)i32Rate;
+
+    /* Ask host for less data when buffer is above target and vice versa */
+    i32Value = i32Rate - i32FillErr * ((1 << 14) / 256);
+    if(i32Value > (int32_t)psFb->u32Nominal + i32Limit)
+        i32Value = (int32_t)psFb->u32Nominal + i32Limit;
+    else if(i32Value < (int32_t)psFb->u32Nominal - i32Limit)
+        i32Value = (int32_t)psFb->u32Nominal - i32Limit;
+
+    psFb->u32Value = (uint32_t)i32Value;
+}
+
+/**
+ * @brief       Prepare feedback value for next feedback IN transfer
+ *
+ * @param[in]   psFb            Feedback control structure
+ *
+ * @return      None
+ *
+ * @details     This function is called to arm the endpoint after USBD_FbOpen and in the IN ACK event
+ *              of feedback endpoint. The value is sent as 3 bytes, LSB first.
+ */
+void USBD_FbInHandler(S_USBD_FB_T *psFb)
+{
+    uint8_t *pu8Buf;
+    uint32_t u32Value = psFb->u32Value;
+
+    pu8Buf = (uint8_t *)(USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(psFb->u8Ep));
+    pu8Buf[0] = (uint8_t)u32Value;
+    pu8Buf[1] = (uint8_t)(u32Value >> 8);
+    pu8Buf[2] = (uint8_t)(u32Value >> 16);
+    USBD_SET_PAYLOAD_LEN(psFb->u8Ep, 3);
+}
+
+
 
 
 
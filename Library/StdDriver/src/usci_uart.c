@@ -638,6 +638,224 @@ void UUART_DisableFlowCtrl(UUART_T* uuart)
 }
 
 
+/// @cond HIDDEN_SYMBOLS
+/**
+ *    @brief        Move data from asynchronous TX ring to USCI_UART TX buffer
+ *
+ *    @param[in]    psAsync The pointer of the USCI_UART asynchronous context.
+ *
+ *    @return       None
+ */
+static void UUART_AsyncFillTx(S_UUART_ASYNC_T *psAsync)
+{
+    UUART_T *uuart = psAsync->uuart;
+    uint32_t u32Idx = psAsync->u32TxTail;
+
+    while((u32Idx != psAsync->u32TxHead) && ((uuart->BUFSTS & UUART_BUFSTS_TXFULL_Msk) == 0))
+    {
+        uuart->TXDAT = psAsync->pu8TxBuf[u32Idx & psAsync->u32TxMask];
+        u32Idx++;
+    }
+    psAsync->u32TxTail = u32Idx;
+}
+/// @endcond HIDDEN_SYMBOLS
+
+
+/**
+ *    @brief        Open USCI_UART asynchronous transfer
+ *
+ *    @param[in]    psAsync         The pointer of the USCI_UART asynchronous context.
+ *    @param[in]    uuart           The pointer of the specified USCI_UART module. It must be opened by UUART_Open() first.
+ *    @param[in]    pu8RxBuf        The RX ring buffer.
+ *    @param[in]    u32RxSize       The RX ring size. It must be a power of 2.
+ *    @param[in]    pu8TxBuf        The TX ring buffer.
+ *    @param[in]    u32TxSize       The TX ring size. It must be a power of 2.
+ *    @param[in]    pfnCallback     The event callback function. It is called in interrupt context with
+ *                                  a combination of UART_ASYNC_EVT_* events. Can be NULL.
+ *
+ *    @return       None
+ *
+ *    @details      The function initializes the ring buffers and enables RX end, TX end, line status and
+ *                  RX overrun interrupts. User must call UUART_AsyncIRQHandler() in USCI_IRQHandler().
+ */
+void UUART_AsyncOpen(S_UUART_ASYNC_T *psAsync, UUART_T* uuart, uint8_t *pu8RxBuf, uint32_t u32RxSize, uint8_t *pu8TxBuf, uint32_t u32TxSize, UUART_ASYNC_CB pfnCallback)
+{
+    psAsync->uuart = uuart;
+    psAsync->pu8RxBuf = pu8RxBuf;
+    psAsync->u32RxMask = u32RxSize - 1;
+    psAsync->u32RxHead = 0;
+    psAsync->u32RxTail = 0;
+    psAsync->pu8TxBuf = pu8TxBuf;
+    psAsync->u32TxMask = u32TxSize - 1;
+    psAsync->u32TxHead = 0;
+    psAsync->u32TxTail = 0;
+    psAsync->u32TxBusy = 0;
+    psAsync->pfnCallback = pfnCallback;
+
+    UUART_EnableInt(uuart, (UUART_RXEND_INT_MASK | UUART_TXEND_INT_MASK | UUART_RLS_INT_MASK | UUART_BUF_RXOV_INT_MASK));
+    NVIC_EnableIRQ(USCI_IRQn);
+}
+
+
+/**
+ *    @brief        Close USCI_UART asynchronous transfer
+ *
+ *    @param[in]    psAsync The pointer of the USCI_UART asynchronous context.
+ *
+ *    @return       None
+ *
+ *    @details      The function disables the interrupts used by asynchronous transfer.
+ *                  NVIC is not changed because all USCI modules share the same IRQ.
+ */
+void UUART_AsyncClose(S_UUART_ASYNC_T *psAsync)
+{
+    UUART_DisableInt(psAsync->uuart, (UUART_RXEND_INT_MASK | UUART_TXEND_INT_MASK | UUART_RLS_INT_MASK | UUART_BUF_RXOV_INT_MASK));
+    psAsync->u32TxBusy = 0;
+}
+
+
+/**
+ *    @brief        Read data from USCI_UART asynchronous RX ring
+ *
+ *    @param[in]    psAsync         The pointer of the USCI_UART asynchronous context.
+ *    @param[out]   pu8RxBuf        The buffer to receive the data.
+ *    @param[in]    u32ReadBytes    The maximum byte number to read.
+ *
+ *    @return       Received byte count. It can be less than u32ReadBytes, including 0.
+ *
+ *    @details      The function copies the data already received by interrupt handler and never waits.
+ */
+uint32_t UUART_AsyncRead(S_UUART_ASYNC_T *psAsync, uint8_t *pu8RxBuf, uint32_t u32ReadBytes)
+{
+    uint32_t u32Tail = psAsync->u32RxTail;
+    uint32_t u32Count = psAsync->u32RxHead - u32Tail;
+    uint32_t i;
+
+    if(u32ReadBytes < u32Count)
+        u32Count = u32ReadBytes;
+
+    for(i = 0; i < u32Count; i++)
+        pu8RxBuf[i] = psAsync->pu8RxBuf[(u32Tail + i) & psAsync->u32RxMask];
+
+    psAsync->u32RxTail = u32Tail + u32Count;
+
+    return u32Count;
+}
+
+
+/**
+ *    @brief        Write data to USCI_UART asynchronous TX ring
+ *
+ *    @param[in]    psAsync         The pointer of the USCI_UART asynchronous context.
+ *    @param[in]    pu8TxBuf        The buffer of data to send.
+ *    @param[in]    u32WriteBytes   The byte number of data.
+ *
+ *    @return       Queued byte count. It is less than u32WriteBytes if TX ring is full.
+ *
+ *    @details      The function queues data to TX ring. If transmitter is idle, it writes the first bytes to start
+ *                  the TX end interrupt chain. It never waits.
+ *                  UART_ASYNC_EVT_TX_EMPTY is reported when the last byte has been transmitted.
+ */
+uint32_t UUART_AsyncWrite(S_UUART_ASYNC_T *psAsync, uint8_t *pu8TxBuf, uint32_t u32WriteBytes)
+{
+    uint32_t u32Head = psAsync->u32TxHead;
+    uint32_t u32Free = psAsync->u32TxMask + 1 - (u32Head - psAsync->u32TxTail);
+    uint32_t u32Primask, i;
+
+    if(u32WriteBytes > u32Free)
+        u32WriteBytes = u32Free;
+
+    if(u32WriteBytes == 0)
+        return 0;
+
+    for(i = 0; i < u32WriteBytes; i++)
+        psAsync->pu8TxBuf[(u32Head + i) & psAsync->u32TxMask] = pu8TxBuf[i];
+
+    psAsync->u32TxHead = u32Head + u32WriteBytes;
+
+    u32Primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    if(psAsync->u32TxBusy == 0)
+    {
+        psAsync->u32TxBusy = 1;
+        UUART_AsyncFillTx(psAsync);
+    }
+    __set_PRIMASK(u32Primask);
+
+    return u32WriteBytes;
+}
+
+
+/**
+ *    @brief        USCI_UART asynchronous transfer interrupt handler
+ *
+ *    @param[in]    psAsync The pointer of the USCI_UART asynchronous context.
+ *
+ *    @return       None
+ *
+ *    @details      User must call this function in USCI_IRQHandler().
+ */
+void UUART_AsyncIRQHandler(S_UUART_ASYNC_T *psAsync)
+{
+    UUART_T *uuart = psAsync->uuart;
+    uint32_t u32ProtSts = uuart->PROTSTS;
+    uint32_t u32Event = 0;
+    uint32_t u32Idx;
+
+    if(u32ProtSts & UUART_PROTSTS_RXENDIF_Msk)
+    {
+        uuart->PROTSTS = UUART_PROTSTS_RXENDIF_Msk;
+
+        u32Idx = psAsync->u32RxHead;
+        while((uuart->BUFSTS & UUART_BUFSTS_RXEMPTY_Msk) == 0)
+        {
+            if((u32Idx - psAsync->u32RxTail) <= psAsync->u32RxMask)
+            {
+                psAsync->pu8RxBuf[u32Idx & psAsync->u32RxMask] = uuart->RXDAT;
+                u32Idx++;
+            }
+            else
+            {
+                /* RX ring full, drop the data */
+                (void)uuart->RXDAT;
+                u32Event |= UART_ASYNC_EVT_RX_OVERFLOW;
+            }
+        }
+        psAsync->u32RxHead = u32Idx;
+        u32Event |= UART_ASYNC_EVT_RX;
+    }
+
+    if(u32ProtSts & UUART_PROTSTS_TXENDIF_Msk)
+    {
+        uuart->PROTSTS = UUART_PROTSTS_TXENDIF_Msk;
+
+        UUART_AsyncFillTx(psAsync);
+
+        /* Stop the chain once ring and TX buffer are both empty */
+        if((psAsync->u32TxTail == psAsync->u32TxHead) && (uuart->BUFSTS & UUART_BUFSTS_TXEMPTY_Msk))
+        {
+            psAsync->u32TxBusy = 0;
+            u32Event |= UART_ASYNC_EVT_TX_EMPTY;
+        }
+    }
+
+    if(u32ProtSts & (UUART_PROTSTS_PARITYERR_Msk | UUART_PROTSTS_FRMERR_Msk | UUART_PROTSTS_BREAK_Msk))
+    {
+        uuart->PROTSTS = (UUART_PROTSTS_PARITYERR_Msk | UUART_PROTSTS_FRMERR_Msk | UUART_PROTSTS_BREAK_Msk);
+        u32Event |= UART_ASYNC_EVT_LINE_ERR;
+    }
+
+    if(uuart->BUFSTS & UUART_BUFSTS_RXOVIF_Msk)
+    {
+        uuart->BUFSTS = UUART_BUFSTS_RXOVIF_Msk;
+        u32Event |= UART_ASYNC_EVT_RX_OVERFLOW;
+    }
+
+    if(u32Event && psAsync->pfnCallback)
+        psAsync->pfnCallback(psAsync, u32Event);
+}
+
+
 
 
 /*@}*/ /* end of group USCI_UART_EXPORTED_FUNCTIONS */
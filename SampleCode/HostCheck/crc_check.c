@@ -0,0 +1,70 @@
+/******************************************************************************
+ * @file     crc_check.c
+ * @version  V3.00
+ * @brief    Host check of the software CRC against the standard check values
+ *
+ * @details  Builds crc.c on the host PC and runs CRC_SwOpen and CRC_SwCalculate with the CRC
+ *           controller settings of the CRC samples. The CRC of "123456789" must give the
+ *           standard check value of each model, also when the data is given in several pieces.
+ *           CRC_Calculate needs the CRC controller, so it is compared with CRC_SwCalculate on
+ *           target by the CRC_CRC32 sample.
+ *           Build and run on the host PC:
+ *             gcc -O2 -I../../Library/Device/Nuvoton/NUC1261/Include -I../../Library/CMSIS/Include
+ *                 -I../../Library/StdDriver/inc crc_check.c -o crc_check
+ *           It returns non-zero if a check fails.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "host_shim.h"
+#include "NUC1261.h"
+#include "../../Library/StdDriver/src/pdma.c"
+#include "../../Library/StdDriver/src/crc.c"
+
+HOST_SHIM_DATA
+
+typedef struct
+{
+    const char *pcName;
+    uint32_t u32Mode;
+    uint32_t u32Attribute;
+    uint32_t u32Seed;
+    uint32_t u32Check;
+} S_CRC_MODEL_T;
+
+static const S_CRC_MODEL_T s_asModel[] =
+{
+    /* Settings of CRC_CRC32 sample, as zlib crc32 */
+    {"CRC-32",              CRC_32,    CRC_WDATA_RVS | CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM, 0xFFFFFFFF, 0xCBF43926},
+    /* Settings of CRC_CCITT sample */
+    {"CRC-16/CCITT-FALSE",  CRC_CCITT, 0,                                                   0xFFFF,     0x29B1},
+    /* Polynomial of CRC_CRC8 sample with seed 0 */
+    {"CRC-8",               CRC_8,     0,                                                   0x00,       0xF4},
+    {"CRC-16/ARC",          CRC_16,    CRC_WDATA_RVS | CRC_CHECKSUM_RVS,                    0x0000,     0xBB3D},
+    {"CRC-32/BZIP2",        CRC_32,    CRC_CHECKSUM_COM,                                    0xFFFFFFFF, 0xFC891918},
+    {"CRC-16/XMODEM",       CRC_CCITT, 0,                                                   0x0000,     0x31C3},
+};
+
+int main(void)
+{
+    static const uint8_t au8Data[] = "123456789";
+    S_CRC_SW_T sCrc;
+    uint32_t i, u32Split, u32Crc;
+
+    for(i = 0; i < sizeof(s_asModel) / sizeof(s_asModel[0]); i++)
+    {
+        for(u32Split = 0; u32Split <= 9; u32Split++)
+        {
+            CRC_SwOpen(&sCrc, s_asModel[i].u32Mode, s_asModel[i].u32Attribute, s_asModel[i].u32Seed);
+            CRC_SwCalculate(&sCrc, au8Data, u32Split);
+            u32Crc = CRC_SwCalculate(&sCrc, &au8Data[u32Split], 9 - u32Split);
+            HOST_CHECK(u32Crc == s_asModel[i].u32Check);
+        }
+        printf("%-20s 0x%08X\n", s_asModel[i].pcName, u32Crc);
+    }
+
+    printf("CRC check passed\n");
+    return 0;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,209 @@
+/******************************************************************************
+ * @file     dap_replay_check.c
+ * @version  V3.00
+ * @brief    Host replay benchmark of the queued CMSIS-DAP HID transport
+ *
+ * @details  Builds hid_dap.c of the NUC1261 CMSIS-DAP example on the host PC and replays
+ *           DAP request traces through its endpoint handlers and HID_DAP_Process().
+ *           The USB host model runs one interrupt OUT and one interrupt IN transaction per
+ *           1 ms frame and keeps up to a window of requests outstanding. A request freed by a
+ *           response is sent no earlier than the next frame. DAP_ExecuteCommand is a model which
+ *           takes SWD_BITS per SWD transfer at DAP_DEFAULT_SWJ_CLOCK, and USB frames that fall
+ *           inside it are handled as interrupts. Window 1 is the host view of a single buffer
+ *           debug unit, window DAP_PACKET_COUNT uses the whole ring.
+ *           It reports commands per second and checks that every response comes back in order
+ *           and that a DAP_QueueCommands chain runs only after its closing packet.
+ *           Build and run on the host PC:
+ *             gcc -O2 -D__forceinline=inline -include host_shim.h -I../../Library/CMSIS/DAP/Firmware/Examples/NUC1261
+ *                 -I../../Library/CMSIS/DAP/Firmware/Include -I../../Library/Device/Nuvoton/NUC1261/Include
+ *                 -I../../Library/CMSIS/Include -I../../Library/StdDriver/inc dap_replay_check.c
+ *                 ../../Library/StdDriver/src/usbd.c -o dap_replay_check
+ *           It returns non-zero if a check fails.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "host_shim.h"
+#include "../../Library/CMSIS/DAP/Firmware/Examples/NUC1261/hid_dap.c"
+
+#define FRAME_US        1000        /* Full speed frame */
+#define SWD_BITS        46          /* Request, ACK, data, parity and turnarounds of one SWD transfer */
+#define CMD_US          20          /* Command decode and response overhead */
+#define TRACE_LEN       2000        /* Requests of each trace */
+#define QUEUE_CHAIN     4           /* Packets of a queued chain, the last one closes it */
+#define SEQ_OFFSET      (DAP_PACKET_SIZE - 4)   /* Sequence number of a request, echoed by the response */
+
+HOST_SHIM_DATA
+
+volatile uint8_t DAP_TransferAbort;
+
+/* No SWO trace in the replay */
+uint32_t SWO_GetStreamData(uint8_t *data, uint32_t num)
+{
+    (void)data;
+    (void)num;
+    return 0;
+}
+
+const S_USBD_INFO_T gsInfo;
+
+static uint8_t s_au8Trace[TRACE_LEN][DAP_PACKET_SIZE];
+static double s_dNow, s_dNextFrame;
+static uint32_t s_u32Window, s_u32Sent, s_u32Received, s_u32Freed, s_u32Executed;
+
+/* Host side of one frame: read a response, then send a request if the window has room */
+static void UsbFrame(void)
+{
+    uint8_t *pu8Buf;
+    uint32_t u32Seq;
+
+    /* Slots freed in earlier frames are usable now */
+    s_u32Freed = s_u32Received;
+
+    if(USBD_GET_PAYLOAD_LEN(EP2))
+    {
+        pu8Buf = (uint8_t *)(uintptr_t)(USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(EP2));
+        memcpy(&u32Seq, &pu8Buf[SEQ_OFFSET], 4);
+        HOST_CHECK(u32Seq == s_u32Received);
+        HOST_CHECK(pu8Buf[0] == ((s_au8Trace[u32Seq][0] == ID_DAP_QueueCommands) ? ID_DAP_ExecuteCommands : s_au8Trace[u32Seq][0]));
+        s_u32Received++;
+        USBD_SET_PAYLOAD_LEN(EP2, 0);
+        EP2_Handler();
+    }
+
+    if((s_u32Sent < TRACE_LEN) && (s_u32Sent - s_u32Freed < s_u32Window) && !s_u8OutHold)
+    {
+        pu8Buf = (uint8_t *)(uintptr_t)(USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(EP3));
+        memcpy(pu8Buf, s_au8Trace[s_u32Sent++], DAP_PACKET_SIZE);
+        USBD_SET_PAYLOAD_LEN(EP3, DAP_PACKET_SIZE);
+        EP3_Handler();
+    }
+
+    s_dNextFrame += FRAME_US;
+}
+
+/* Let time pass. USB frames on the way interrupt the main loop. */
+static void RunFor(double dUs)
+{
+    double dEnd = s_dNow + dUs;
+
+    while(s_dNextFrame <= dEnd)
+    {
+        s_dNow = s_dNextFrame;
+        UsbFrame();
+    }
+    s_dNow = dEnd;
+}
+
+/* Model of the DAP command engine: time from the number of SWD transfers, response echoes the request */
+uint32_t DAP_ExecuteCommand(const uint8_t *request, uint8_t *response)
+{
+    uint32_t u32Transfers = 0, u32Seq, i;
+    const uint8_t *pu8Cmd;
+
+    if(request[0] == ID_DAP_TransferBlock)
+    {
+        u32Transfers = request[2] | (request[3] << 8);
+    }
+    else
+    {
+        /* DAP_ExecuteCommands of DAP_Transfer commands. hid_dap.c has renamed DAP_QueueCommands. */
+        HOST_CHECK(request[0] == ID_DAP_ExecuteCommands);
+        for(i = 0, pu8Cmd = &request[2]; i < request[1]; i++, pu8Cmd += 4)
+            u32Transfers += pu8Cmd[2];
+    }
+
+    memcpy(&u32Seq, &request[SEQ_OFFSET], 4);
+    HOST_CHECK(u32Seq == s_u32Executed);
+
+    /* A queued chain runs only when its closing packet has been received */
+    if(s_au8Trace[u32Seq][0] == ID_DAP_QueueCommands)
+        HOST_CHECK((s_u32Sent > (u32Seq | (QUEUE_CHAIN - 1))) || (s_u32RequestIn - s_u32RequestOut == DAP_PACKET_COUNT));
+
+    s_u32Executed++;
+    RunFor(CMD_US + 1e6 * u32Transfers * SWD_BITS / DAP_DEFAULT_SWJ_CLOCK);
+
+    response[0] = request[0];
+    memcpy(&response[SEQ_OFFSET], &u32Seq, 4);
+    return DAP_PACKET_SIZE;
+}
+
+/* Block writes of 13 words, block reads of 15 words, or register accesses, queued in chains or not */
+static void MakeTrace(uint32_t u32Kind, uint32_t u32Queue)
+{
+    uint32_t i, j;
+    uint8_t *pu8Req;
+
+    memset(s_au8Trace, 0, sizeof(s_au8Trace));
+    for(i = 0; i < TRACE_LEN; i++)
+    {
+        pu8Req = s_au8Trace[i];
+        if(u32Kind < 2)
+        {
+            pu8Req[0] = ID_DAP_TransferBlock;
+            pu8Req[2] = u32Kind ? 15 : 13;
+            pu8Req[4] = u32Kind ? 0x0F : 0x0D;     /* AP DRW read or write */
+        }
+        else
+        {
+            pu8Req[0] = (u32Queue && ((i % QUEUE_CHAIN) != QUEUE_CHAIN - 1)) ? ID_DAP_QueueCommands : ID_DAP_ExecuteCommands;
+            pu8Req[1] = 8;
+            for(j = 0; j < 8; j++)
+            {
+                pu8Req[2 + j * 4] = ID_DAP_Transfer;
+                pu8Req[2 + j * 4 + 2] = 2;
+            }
+        }
+        memcpy(&pu8Req[SEQ_OFFSET], &i, 4);
+    }
+}
+
+/* Replay the trace and return commands per second */
+static double Replay(uint32_t u32Window)
+{
+    HID_Init();
+    USBD_SET_PAYLOAD_LEN(EP2, 0);
+    s_dNow = s_dNextFrame = 0;
+    s_u32Window = u32Window;
+    s_u32Sent = s_u32Received = s_u32Freed = s_u32Executed = 0;
+
+    while(s_u32Received < TRACE_LEN)
+    {
+        HID_DAP_Process();
+        if(s_u32RequestIn == s_u32RequestOut)
+            RunFor(s_dNextFrame - s_dNow);
+        else
+            RunFor(1);
+        HOST_CHECK(s_dNow < 1e6 * 60);
+    }
+
+    return TRACE_LEN / (s_dNow / 1e6);
+}
+
+int main(void)
+{
+    static const char *const apcKind[] = {"Block write 13 words", "Block read 15 words", "16 register transfers"};
+    double dSingle, dQueued;
+    uint32_t i;
+
+    HostMapPeripherals();
+    USBD_SET_EP_BUF_ADDR(EP2, EP2_BUF_BASE);
+    USBD_SET_EP_BUF_ADDR(EP3, EP3_BUF_BASE);
+
+    printf("Trace                   Window 1     Window %u\n", DAP_PACKET_COUNT);
+    for(i = 0; i < 3; i++)
+    {
+        MakeTrace(i, 0);
+        dSingle = Replay(1);
+        /* A chain of queued packets needs room for the whole chain, so window 1 sends them unqueued */
+        MakeTrace(i, 1);
+        dQueued = Replay(DAP_PACKET_COUNT);
+        printf("%-22s  %6.0f/s     %6.0f/s\n", apcKind[i], dSingle, dQueued);
+        HOST_CHECK(dQueued >= dSingle);
+    }
+
+    printf("DAP replay check passed\n");
+    return 0;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
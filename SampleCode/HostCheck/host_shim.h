@@ -0,0 +1,83 @@
+/**************************************************************************//**
+ * @file     host_shim.h
+ * @version  V3.00
+ * @brief    Host PC build support for the checks in this folder
+ *
+ * @details  Include it before NUC1261.h. It replaces the CMSIS core intrinsics, which are
+ *           Cortex-M instructions, by host code, and HostMapPeripherals() maps RAM at the
+ *           peripheral addresses so driver code can access its registers. A register
+ *           reads back the last value written to it.
+ *           Linux or another POSIX host is needed to map the fixed addresses.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#ifndef __HOST_SHIM_H__
+#define __HOST_SHIM_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/* Skip cmsis_gcc.h, the intrinsics below take its place */
+#define __CMSIS_GCC_H
+
+extern uint32_t g_u32HostPrimask;
+
+static inline void __NOP(void) {}
+static inline void __ISB(void) {}
+static inline void __DSB(void) {}
+static inline void __DMB(void) {}
+static inline void __WFI(void) {}
+static inline uint32_t __get_PRIMASK(void)
+{
+    return g_u32HostPrimask;
+}
+static inline void __set_PRIMASK(uint32_t u32Primask)
+{
+    g_u32HostPrimask = u32Primask;
+}
+static inline void __enable_irq(void)
+{
+    g_u32HostPrimask = 0;
+}
+static inline void __disable_irq(void)
+{
+    g_u32HostPrimask = 1;
+}
+
+/* Define it in one file of the check, with the globals of system_NUC1261.c */
+#define HOST_SHIM_DATA      uint32_t g_u32HostPrimask, SystemCoreClock, CyclesPerUs;
+
+/* APB1, APB2 and AHB peripherals, and the system control space for NVIC and SysTick */
+static inline void HostMapPeripherals(void)
+{
+    static const uint32_t au32Base[] = {0x40000000, 0x50000000, 0xE000E000};
+    static const uint32_t au32Size[] = {0x200000, 0x200000, 0x1000};
+    uint32_t i;
+
+    for(i = 0; i < sizeof(au32Base) / sizeof(au32Base[0]); i++)
+    {
+        if(mmap((void *)(uintptr_t)au32Base[i], au32Size[i], PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) != (void *)(uintptr_t)au32Base[i])
+        {
+            printf("Cannot map peripherals at 0x%08x\n", au32Base[i]);
+            exit(2);
+        }
+    }
+}
+
+#define HOST_CHECK(cond)                                                    \
+    do {                                                                    \
+        if(!(cond))                                                         \
+        {                                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                        \
+        }                                                                   \
+    } while(0)
+
+#endif  /* __HOST_SHIM_H__ */
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,338 @@
+/******************************************************************************
+ * @file     isp_lock_check.c
+ * @version  V3.00
+ * @brief    Host check of the security lock gating in ParseCmd of the UART and RS485 ISP
+ *
+ * @details  Builds isp_user.c of ISP_UART (ISP_RS485 has the same file) on the host PC with
+ *           a flash model behind the fmc_user.h functions, and sends command packets to ParseCmd.
+ *           On a security locked chip CMD_VERIFY_CRC32 and CMD_UPDATE_CONFIG must be refused
+ *           until APROM has been erased by an update in this session. CMD_VERIFY_CRC32 must also
+ *           refuse ranges that wrap, are not word aligned or lie outside APROM and data flash.
+ *           CMD_UPDATE_DELTA on a locked chip must make the new image in the staging pages at the
+ *           top of APROM and replace the old image only when the new CRC matches. It must refuse
+ *           an old image of length 0 or images which do not fit twice, without a change, and it
+ *           must erase APROM when the old or the new CRC does not match. Unlocked, the update
+ *           is made in place.
+ *           Build and run on the host PC:
+ *             gcc -O2 -DISP_DELTA_UPDATE=1 -I../ISP/ISP_UART -I../../Library/Device/Nuvoton/NUC1261/Include
+ *                 -I../../Library/CMSIS/Include -I../../Library/StdDriver/inc
+ *                 isp_lock_check.c -o isp_lock_check
+ *           It returns non-zero if a check fails.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "host_shim.h"
+
+#define __align(x)
+#include "../ISP/ISP_UART/isp_user.c"
+
+#if (ISP_DELTA_UPDATE == 0)
+#error Build with -DISP_DELTA_UPDATE=1
+#endif
+
+#define APROM_SIZE      0x20000
+#define CONFIG0_LOCKED  0xFFFFFF7D      /* CBS = 0 to boot from LDROM, LOCK = 0 */
+#define CONFIG0_OPEN    0xFFFFFF7F
+
+HOST_SHIM_DATA
+
+static uint8_t s_au8Aprom[APROM_SIZE];
+static uint32_t s_au32Config[2];
+static uint32_t s_u32CrcCalls, s_u32ConfigCalls;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Flash model behind fmc_user.h                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t *FlashWord(unsigned int u32Addr)
+{
+    if(u32Addr + 4 <= APROM_SIZE)
+        return (uint32_t *)&s_au8Aprom[u32Addr];
+
+    if((u32Addr >= FMC_CONFIG_BASE) && (u32Addr < FMC_CONFIG_BASE + sizeof(s_au32Config)))
+        return &s_au32Config[(u32Addr - FMC_CONFIG_BASE) / 4];
+
+    return NULL;
+}
+
+int FMC_Proc(unsigned int u32Cmd, unsigned int addr_start, unsigned int addr_end, unsigned int *data)
+{
+    uint32_t *pu32Word;
+
+    for(; addr_start < addr_end; addr_start += 4)
+    {
+        if((pu32Word = FlashWord(addr_start)) == NULL)
+            return -1;
+
+        if(u32Cmd == FMC_ISPCMD_READ)
+            *data++ = *pu32Word;
+        else if(u32Cmd == FMC_ISPCMD_PROGRAM)
+            *pu32Word &= *data++;
+        else if(u32Cmd == FMC_ISPCMD_PAGE_ERASE)
+        {
+            addr_start &= ~(FMC_FLASH_PAGE_SIZE - 1);
+            memset(FlashWord(addr_start), 0xFF, FMC_FLASH_PAGE_SIZE);
+            addr_start += FMC_FLASH_PAGE_SIZE - 4;
+        }
+    }
+
+    return 0;
+}
+
+void UpdateConfig(unsigned int *data, unsigned int *res)
+{
+    s_u32ConfigCalls++;
+    s_au32Config[0] = data[0];
+    s_au32Config[1] = data[1];
+
+    if(res)
+    {
+        res[0] = data[0];
+        res[1] = data[1];
+    }
+}
+
+int FMC_CRC32_User(unsigned int addr_start, unsigned int addr_end, unsigned int *crc)
+{
+    uint32_t u32Crc = 0xFFFFFFFF, i;
+
+    s_u32CrcCalls++;
+    HOST_CHECK((addr_start < addr_end) && (addr_end <= APROM_SIZE));
+
+    for(; addr_start < addr_end; addr_start++)
+    {
+        u32Crc ^= (addr_start < APROM_SIZE) ? s_au8Aprom[addr_start] : 0xFF;
+        for(i = 0; i < 8; i++)
+            u32Crc = (u32Crc >> 1) ^ (0xEDB88320 & (0 - (u32Crc & 1)));
+    }
+
+    *crc = ~u32Crc;
+    return 0;
+}
+
+static uint32_t Crc32(uint32_t u32Start, uint32_t u32End)
+{
+    unsigned int u32Crc;
+
+    HOST_CHECK(FMC_CRC32_User(u32Start, u32End, &u32Crc) == 0);
+    return u32Crc;
+}
+
+unsigned int FMC_GetChecksum_User(unsigned int addr_start, unsigned int size)
+{
+    (void)addr_start;
+    (void)size;
+    return 0;
+}
+
+void GetDataFlashInfo(uint32_t *addr, uint32_t *size)
+{
+    *addr = APROM_SIZE;
+    *size = 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Packets                                                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t s_au32Packet[16];
+
+static void SendCmd(uint32_t u32Cmd, uint32_t u32Arg0, uint32_t u32Arg1)
+{
+    memset(s_au32Packet, 0, sizeof(s_au32Packet));
+    s_au32Packet[0] = u32Cmd;
+    s_au32Packet[2] = u32Arg0;
+    s_au32Packet[3] = u32Arg1;
+    HOST_CHECK(ParseCmd((unsigned char *)s_au32Packet, 64) == ISP_RESP_SEND);
+}
+
+/* CMD_UPDATE_DELTA with a patch which fits in the first packet. Returns the delta status. */
+static uint32_t SendDelta(uint32_t u32OldLen, uint32_t u32OldCrc, uint32_t u32NewLen, uint32_t u32NewCrc,
+                          const uint8_t *pu8Cmd, uint32_t u32CmdLen)
+{
+    memset(s_au32Packet, 0, sizeof(s_au32Packet));
+    s_au32Packet[0] = CMD_UPDATE_DELTA;
+    s_au32Packet[2] = u32OldLen;
+    s_au32Packet[3] = u32OldCrc;
+    s_au32Packet[4] = u32NewLen;
+    s_au32Packet[5] = u32NewCrc;
+    s_au32Packet[6] = u32CmdLen;
+    memcpy(&s_au32Packet[7], pu8Cmd, u32CmdLen);
+    HOST_CHECK(ParseCmd((unsigned char *)s_au32Packet, 64) == ISP_RESP_SEND);
+
+    /* Status comes with the first data packet */
+    SendCmd(0, 0, 0);
+    return inpw(response_buff + 8);
+}
+
+/* Contents of APROM after Reset */
+static uint8_t Pattern(uint32_t u32Addr)
+{
+    return (uint8_t)(u32Addr * 13 + (u32Addr >> 8));
+}
+
+static int IsPattern(uint32_t u32Start, uint32_t u32End, uint32_t u32From)
+{
+    for(; u32Start < u32End; u32Start++, u32From++)
+    {
+        if(s_au8Aprom[u32Start] != Pattern(u32From))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+static int IsErased(uint32_t u32Start, uint32_t u32End)
+{
+    for(; u32Start < u32End; u32Start++)
+    {
+        if(s_au8Aprom[u32Start] != 0xFF)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+static void Reset(uint32_t u32Config0)
+{
+    uint32_t i;
+
+    for(i = 0; i < APROM_SIZE; i++)
+        s_au8Aprom[i] = Pattern(i);
+
+    s_au32Config[0] = u32Config0;
+    s_au32Config[1] = 0xFFFFFFFF;
+    bUpdateApromCmd = FALSE;
+    g_apromSize = APROM_SIZE;
+    GetDataFlashInfo(&g_dataFlashAddr, &g_dataFlashSize);
+    SendCmd(CMD_CONNECT, 0, 0);
+}
+
+int main(void)
+{
+    /* 8 literal bytes. Old page 1 copied twice, the second copy reads back new page 0. */
+    static const uint8_t au8Literal[] = {0x10, 1, 2, 3, 4, 5, 6, 7, 8};
+    static const uint8_t au8CopyPage[] = {0x81, 0x20, 0x80, 0x20, 0x81, 0x20, 0xFF, 0x3F};
+    const uint32_t u32Page = FMC_FLASH_PAGE_SIZE, u32Stage = APROM_SIZE - 2 * FMC_FLASH_PAGE_SIZE;
+    uint32_t u32Calls, u32NewCrc;
+
+    HostMapPeripherals();
+
+    /* CRC of the image au8CopyPage makes */
+    Reset(CONFIG0_OPEN);
+    memcpy(s_au8Aprom, &s_au8Aprom[u32Page], u32Page);
+    u32NewCrc = Crc32(0, 2 * u32Page);
+
+    /* Locked: no CRC of any range and no config update */
+    Reset(CONFIG0_LOCKED);
+    u32Calls = s_u32CrcCalls;
+    SendCmd(CMD_VERIFY_CRC32, 0, 4);
+    SendCmd(CMD_VERIFY_CRC32, 0x100, APROM_SIZE - 0x100);
+    HOST_CHECK(s_u32CrcCalls == u32Calls);
+    HOST_CHECK(inpw(response_buff + 8) == 0);
+    HOST_CHECK(inpw(response_buff + 16) == ISP_VERIFY_LOCKED);
+
+    SendCmd(CMD_UPDATE_CONFIG, CONFIG0_OPEN, 0xFFFFFFFF);
+    HOST_CHECK(s_u32ConfigCalls == 0);
+    HOST_CHECK(s_au32Config[0] == CONFIG0_LOCKED);
+
+    /* Other commands do not open the lock */
+    SendCmd(CMD_GET_FWVER, 0, 0);
+    SendCmd(CMD_SET_WINDOW, 4, ISP_OPT_NO_READBACK);
+    SendCmd(CMD_SYNC_PACKNO, 1, 0);
+    SendCmd(CMD_VERIFY_CRC32, 0, 4);
+    HOST_CHECK(s_u32CrcCalls == u32Calls);
+
+    /* Locked: delta update of an empty old image, or of images which cannot be staged, changes nothing */
+    HOST_CHECK(SendDelta(0, 0, 8, 0, au8Literal, sizeof(au8Literal)) == ISP_DELTA_ERR_BASE);
+    HOST_CHECK(SendDelta(APROM_SIZE - u32Page, Crc32(0, APROM_SIZE - u32Page), 2 * u32Page, 0,
+                         au8Literal, sizeof(au8Literal)) == ISP_DELTA_ERR_BASE);
+    HOST_CHECK(IsPattern(0, APROM_SIZE, 0));
+
+    /* Locked: a bad patch drops the staging pages and keeps the old image */
+    HOST_CHECK(SendDelta(2 * u32Page, Crc32(0, 2 * u32Page), 2 * u32Page, u32NewCrc,
+                         au8Literal, sizeof(au8Literal)) == ISP_DELTA_ERR_PATCH);
+    HOST_CHECK(IsPattern(0, u32Stage, 0) && IsErased(u32Stage, APROM_SIZE));
+
+    /* Locked: staged delta update replaces the old image, the lock stays */
+    Reset(CONFIG0_LOCKED);
+    HOST_CHECK(SendDelta(2 * u32Page, Crc32(0, 2 * u32Page), 2 * u32Page, u32NewCrc,
+                         au8CopyPage, sizeof(au8CopyPage)) == ISP_DELTA_DONE);
+    HOST_CHECK(IsPattern(0, u32Page, u32Page) && IsPattern(u32Page, 2 * u32Page, u32Page));
+    HOST_CHECK(IsPattern(2 * u32Page, u32Stage, 2 * u32Page) && IsErased(u32Stage, APROM_SIZE));
+    u32Calls = s_u32CrcCalls;
+    SendCmd(CMD_VERIFY_CRC32, 0x100, 4);
+    HOST_CHECK(s_u32CrcCalls == u32Calls);
+    SendCmd(CMD_UPDATE_CONFIG, CONFIG0_OPEN, 0xFFFFFFFF);
+    HOST_CHECK(s_u32ConfigCalls == 0);
+
+    /* Locked: a wrong new CRC erases APROM */
+    Reset(CONFIG0_LOCKED);
+    HOST_CHECK(SendDelta(2 * u32Page, Crc32(0, 2 * u32Page), 2 * u32Page, ~u32NewCrc,
+                         au8CopyPage, sizeof(au8CopyPage)) == ISP_DELTA_ERR_IMAGE);
+    HOST_CHECK(IsErased(0, APROM_SIZE));
+
+    /* Locked: a wrong old CRC erases APROM */
+    Reset(CONFIG0_LOCKED);
+    HOST_CHECK(s_u32ConfigCalls == 0);
+    HOST_CHECK(SendDelta(2 * u32Page, ~Crc32(0, 2 * u32Page), 2 * u32Page, u32NewCrc,
+                         au8CopyPage, sizeof(au8CopyPage)) == ISP_DELTA_ERR_BASE);
+    HOST_CHECK(IsErased(0, APROM_SIZE));
+
+    /* Locked, after APROM erase: CRC of the new image is allowed */
+    u32Calls = s_u32CrcCalls;
+    SendCmd(CMD_UPDATE_APROM, 0, 8);
+    SendCmd(CMD_VERIFY_CRC32, 0, 4);
+    HOST_CHECK(s_u32CrcCalls == u32Calls + 1);
+    HOST_CHECK(inpw(response_buff + 16) == ISP_VERIFY_OK);
+    HOST_CHECK(inpw(response_buff + 8) == Crc32(0, 4));
+
+    SendCmd(CMD_UPDATE_CONFIG, CONFIG0_OPEN, 0xFFFFFFFF);
+    HOST_CHECK(s_u32ConfigCalls == 1);
+
+    /* Locked, after APROM update: delta update of the new image is made in place */
+    s_au32Config[0] = CONFIG0_LOCKED;
+    HOST_CHECK(SendDelta(16, Crc32(0, 16), 8, 0, au8Literal, sizeof(au8Literal)) == ISP_DELTA_DONE);
+    HOST_CHECK((s_au8Aprom[0] == 1) && (s_au8Aprom[7] == 8) && (s_au8Aprom[8] == 0xFF));
+
+    /* Unlocked: allowed at once */
+    Reset(CONFIG0_OPEN);
+    u32Calls = s_u32CrcCalls;
+    SendCmd(CMD_VERIFY_CRC32, 0x100, 0x200);
+    HOST_CHECK(s_u32CrcCalls == u32Calls + 1);
+    HOST_CHECK(inpw(response_buff + 16) == ISP_VERIFY_OK);
+    HOST_CHECK(inpw(response_buff + 8) == Crc32(0x100, 0x300));
+
+    /* Bad ranges are refused with a status, not a CRC of 0 */
+    u32Calls = s_u32CrcCalls;
+    SendCmd(CMD_VERIFY_CRC32, 0xFFFFFF00, 0x200);           /* Wraps */
+    HOST_CHECK(inpw(response_buff + 16) == ISP_VERIFY_RANGE);
+    SendCmd(CMD_VERIFY_CRC32, 0x100, 6);                    /* Not a multiple of 4 */
+    HOST_CHECK(inpw(response_buff + 16) == ISP_VERIFY_RANGE);
+    SendCmd(CMD_VERIFY_CRC32, 0x102, 8);                    /* Not word aligned */
+    HOST_CHECK(inpw(response_buff + 16) == ISP_VERIFY_RANGE);
+    SendCmd(CMD_VERIFY_CRC32, 0x100, 0);                    /* Empty */
+    HOST_CHECK(inpw(response_buff + 16) == ISP_VERIFY_RANGE);
+    SendCmd(CMD_VERIFY_CRC32, APROM_SIZE - 4, 8);           /* Past APROM */
+    HOST_CHECK(inpw(response_buff + 16) == ISP_VERIFY_RANGE);
+    SendCmd(CMD_VERIFY_CRC32, FMC_CONFIG_BASE, 8);          /* User configuration */
+    HOST_CHECK(inpw(response_buff + 16) == ISP_VERIFY_RANGE);
+    HOST_CHECK(inpw(response_buff + 8) == 0);
+    HOST_CHECK(s_u32CrcCalls == u32Calls);
+
+    /* Unlocked: delta update needs a real old image, a wrong one changes nothing */
+    HOST_CHECK(SendDelta(0, 0, 8, 0, au8Literal, sizeof(au8Literal)) == ISP_DELTA_ERR_BASE);
+    HOST_CHECK(SendDelta(2 * u32Page, ~Crc32(0, 2 * u32Page), 2 * u32Page, u32NewCrc,
+                         au8CopyPage, sizeof(au8CopyPage)) == ISP_DELTA_ERR_BASE);
+    HOST_CHECK(IsPattern(0, APROM_SIZE, 0));
+
+    /* Unlocked: in place, no staging pages used */
+    HOST_CHECK(SendDelta(3 * u32Page, Crc32(0, 3 * u32Page), 2 * u32Page, u32NewCrc,
+                         au8CopyPage, sizeof(au8CopyPage)) == ISP_DELTA_DONE);
+    HOST_CHECK(IsPattern(0, u32Page, u32Page) && IsPattern(u32Page, 2 * u32Page, u32Page));
+    HOST_CHECK(IsErased(2 * u32Page, 3 * u32Page) && IsPattern(3 * u32Page, APROM_SIZE, 3 * u32Page));
+
+    printf("ISP lock check passed\n");
+    return 0;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,293 @@
+/******************************************************************************
+ * @file     isp_window_check.c
+ * @version  V3.00
+ * @brief    Host loopback of a 128 KB APROM update through the windowed UART and RS485 ISP
+ *
+ * @details  Builds isp_user.c of ISP_UART (ISP_RS485 has the same file) on the host PC with
+ *           a flash model behind the fmc_user.h functions. A host model sends CMD_CONNECT,
+ *           CMD_SET_WINDOW, CMD_UPDATE_APROM and the data packets to ParseCmd, and waits for a
+ *           response after each window of packets like the ISP tool does.
+ *           Packets go through the two receive buffers of uart_transfer.c. The loader must be done
+ *           with a packet before the packet after next starts to overwrite its buffer.
+ *           Time comes from the UART, flash and host model below. It reports the update time and
+ *           the data phase throughput for each window size, and checks the response checksums and
+ *           packet numbers, the programmed image and a CMD_RESEND_PACKET of a whole window, and
+ *           verifies the image by CMD_VERIFY_CRC32 at the end.
+ *           Build and run on the host PC:
+ *             gcc -O2 -I../ISP/ISP_UART -I../../Library/Device/Nuvoton/NUC1261/Include
+ *                 -I../../Library/CMSIS/Include -I../../Library/StdDriver/inc
+ *                 isp_window_check.c -o isp_window_check
+ *           It returns non-zero if a check fails.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "host_shim.h"
+
+#define __align(x)
+#include "../ISP/ISP_UART/isp_user.c"
+
+#define APROM_SIZE      0x20000
+#define IMAGE_SIZE      0x20000
+#define PKT_SIZE        64
+#define PKT_US          (PKT_SIZE * 10 * 1e6 / 115200)  /* 64 bytes at 115200 bps, 8N1 */
+#define HOST_US         1000        /* Host turnaround from response to next packet */
+#define PARSE_US        50          /* ParseCmd and checksum of one packet */
+#define ERASE_US        20000       /* Page erase time */
+#define PROG_US         30          /* Word program time */
+#define READ_US         1           /* Word read time */
+
+HOST_SHIM_DATA
+
+static uint8_t s_au8Aprom[APROM_SIZE];
+static uint8_t s_au8Image[IMAGE_SIZE];
+static uint32_t s_au32Config[2] = {0xFFFFFF7F, 0xFFFFFFFF};
+static double s_dFlashUs;           /* Flash time of the current ParseCmd call */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Flash model behind fmc_user.h                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t *FlashWord(unsigned int u32Addr)
+{
+    if(u32Addr + 4 <= APROM_SIZE)
+        return (uint32_t *)&s_au8Aprom[u32Addr];
+
+    if((u32Addr >= FMC_CONFIG_BASE) && (u32Addr < FMC_CONFIG_BASE + sizeof(s_au32Config)))
+        return &s_au32Config[(u32Addr - FMC_CONFIG_BASE) / 4];
+
+    return NULL;
+}
+
+int FMC_Proc(unsigned int u32Cmd, unsigned int addr_start, unsigned int addr_end, unsigned int *data)
+{
+    uint32_t *pu32Word;
+
+    for(; addr_start < addr_end; addr_start += 4)
+    {
+        if((pu32Word = FlashWord(addr_start)) == NULL)
+            return -1;
+
+        if(u32Cmd == FMC_ISPCMD_READ)
+        {
+            *data++ = *pu32Word;
+            s_dFlashUs += READ_US;
+        }
+        else if(u32Cmd == FMC_ISPCMD_PROGRAM)
+        {
+            /* A word must not be programmed twice without erase */
+            HOST_CHECK(*pu32Word == 0xFFFFFFFF);
+            *pu32Word = *data++;
+            s_dFlashUs += PROG_US;
+        }
+        else if(u32Cmd == FMC_ISPCMD_PAGE_ERASE)
+        {
+            addr_start &= ~(FMC_FLASH_PAGE_SIZE - 1);
+            memset(FlashWord(addr_start), 0xFF, FMC_FLASH_PAGE_SIZE);
+            addr_start += FMC_FLASH_PAGE_SIZE - 4;
+            s_dFlashUs += ERASE_US;
+        }
+    }
+
+    return 0;
+}
+
+void UpdateConfig(unsigned int *data, unsigned int *res)
+{
+    (void)data;
+    (void)res;
+}
+
+static uint32_t Crc32(const uint8_t *pu8Buf, uint32_t u32Len)
+{
+    uint32_t u32Crc = 0xFFFFFFFF, i;
+
+    while(u32Len--)
+    {
+        u32Crc ^= *pu8Buf++;
+        for(i = 0; i < 8; i++)
+            u32Crc = (u32Crc >> 1) ^ (0xEDB88320 & (0 - (u32Crc & 1)));
+    }
+
+    return ~u32Crc;
+}
+
+int FMC_CRC32_User(unsigned int addr_start, unsigned int addr_end, unsigned int *crc)
+{
+    HOST_CHECK((addr_start < addr_end) && (addr_end <= APROM_SIZE));
+    s_dFlashUs += (addr_end - addr_start) / 4 * READ_US;
+    *crc = Crc32(&s_au8Aprom[addr_start], addr_end - addr_start);
+    return 0;
+}
+
+unsigned int FMC_GetChecksum_User(unsigned int addr_start, unsigned int size)
+{
+    (void)addr_start;
+    (void)size;
+    return 0;
+}
+
+void GetDataFlashInfo(uint32_t *addr, uint32_t *size)
+{
+    *addr = APROM_SIZE;
+    *size = 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Host and UART model                                                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint8_t s_au8RcvBuf[2][PKT_SIZE];    /* uart_rcvbuf of uart_transfer.c */
+static uint32_t s_u32BufIdx, s_u32PackNo, s_u32Packets;
+static double s_dNow;               /* Host time */
+static double s_dLoaderFree;        /* Loader is done with the previous packet */
+static double s_dBufFree[2];        /* Loader is done with the packet in this buffer */
+
+/* Send one packet and run ParseCmd on it when it has arrived and the loader is free. Returns the checksum. */
+static uint16_t SendPacket(uint32_t u32Cmd, const uint32_t *pu32Arg, uint32_t u32ArgLen, int32_t *pi32Ret)
+{
+    uint8_t *pu8Pkt = s_au8RcvBuf[s_u32BufIdx];
+    uint16_t u16Sum;
+    double dStart;
+
+    /* Receive interrupt writes the first byte into the buffer of the packet before last */
+    HOST_CHECK(s_dBufFree[s_u32BufIdx] <= s_dNow + PKT_US / PKT_SIZE);
+
+    memset(pu8Pkt, 0, PKT_SIZE);
+    outpw(pu8Pkt, u32Cmd);
+    outpw(pu8Pkt + 4, s_u32PackNo);
+    memcpy(pu8Pkt + 8, pu32Arg, u32ArgLen);
+    u16Sum = Checksum(pu8Pkt, PKT_SIZE);
+
+    s_dNow += PKT_US;
+    dStart = (s_dNow > s_dLoaderFree) ? s_dNow : s_dLoaderFree;
+    s_dFlashUs = 0;
+    *pi32Ret = ParseCmd(pu8Pkt, PKT_SIZE);
+    s_dLoaderFree = s_dBufFree[s_u32BufIdx] = dStart + PARSE_US + s_dFlashUs;
+
+    s_u32BufIdx ^= 1;
+    s_u32PackNo += 2;
+    s_u32Packets++;
+    return u16Sum;
+}
+
+/* Wait for the response and check its checksum and packet number */
+static void RecvResponse(uint16_t u16Sum)
+{
+    s_dNow = ((s_dNow > s_dLoaderFree) ? s_dNow : s_dLoaderFree) + PKT_US + HOST_US;
+    HOST_CHECK(inps(response_buff) == u16Sum);
+    HOST_CHECK(inpw(response_buff + 4) == s_u32PackNo - 1);
+}
+
+static void SendCmd(uint32_t u32Cmd, uint32_t u32Arg0, uint32_t u32Arg1)
+{
+    uint32_t au32Arg[2] = {u32Arg0, u32Arg1};
+    uint16_t u16Sum;
+    int32_t i32Ret;
+
+    u16Sum = SendPacket(u32Cmd, au32Arg, sizeof(au32Arg), &i32Ret);
+    HOST_CHECK(i32Ret == ISP_RESP_SEND);
+    RecvResponse(u16Sum);
+}
+
+/* Send data packets from u32Addr until a response comes. Returns the address after the window. */
+static uint32_t SendWindow(uint32_t u32Addr, uint32_t u32Window)
+{
+    uint32_t u32Len, i;
+    uint16_t u16Sum = 0;
+    int32_t i32Ret = ISP_RESP_HOLD;
+
+    for(i = 0; (i < u32Window) && (i32Ret == ISP_RESP_HOLD); i++)
+    {
+        u32Len = (IMAGE_SIZE - u32Addr < PKT_SIZE - 8) ? (IMAGE_SIZE - u32Addr) : (PKT_SIZE - 8);
+        HOST_CHECK(u32Len);
+        u16Sum += SendPacket(0, (uint32_t *)&s_au8Image[u32Addr], u32Len, &i32Ret);
+        u32Addr += u32Len;
+    }
+
+    /* Response after a full window or the last packet */
+    HOST_CHECK(i32Ret == ISP_RESP_SEND);
+    HOST_CHECK((i == u32Window) || (u32Addr == IMAGE_SIZE));
+    RecvResponse(u16Sum);
+    return u32Addr;
+}
+
+/* Update APROM with the image and return the time of the data phase in us */
+static double Update(uint32_t u32Window, double *pdTotal)
+{
+    uint32_t au32Arg[(PKT_SIZE - 8) / 4];
+    uint32_t u32Addr, u32Resend;
+    uint16_t u16Sum;
+    int32_t i32Ret;
+    double dData;
+
+    memset(s_au8Aprom, 0x5A, sizeof(s_au8Aprom));
+    memset(s_dBufFree, 0, sizeof(s_dBufFree));
+    s_dNow = s_dLoaderFree = 0;
+    s_u32PackNo = 1;
+    s_u32Packets = 0;
+    g_apromSize = APROM_SIZE;
+    GetDataFlashInfo(&g_dataFlashAddr, &g_dataFlashSize);
+
+    SendCmd(CMD_CONNECT, 0, 0);
+    SendCmd(CMD_SET_WINDOW, u32Window, 0);
+    HOST_CHECK(inpw(response_buff + 8) == u32Window);
+
+    /* First packet carries start, length and 48 bytes of the image */
+    au32Arg[0] = 0;
+    au32Arg[1] = IMAGE_SIZE;
+    memcpy(&au32Arg[2], s_au8Image, 48);
+    u16Sum = SendPacket(CMD_UPDATE_APROM, au32Arg, sizeof(au32Arg), &i32Ret);
+    HOST_CHECK(i32Ret == ISP_RESP_SEND);
+    RecvResponse(u16Sum);
+
+    dData = s_dNow;
+    u32Addr = 48;
+    u32Resend = IMAGE_SIZE / 3;
+    while(u32Addr < IMAGE_SIZE)
+    {
+        uint32_t u32Next = SendWindow(u32Addr, u32Window);
+
+        /* Host resends a window once, as if its response was corrupted */
+        if((u32Addr < u32Resend) && (u32Next >= u32Resend))
+        {
+            u32Resend = IMAGE_SIZE;
+            SendCmd(CMD_RESEND_PACKET, 0, 0);
+            u32Next = SendWindow(u32Addr, u32Window);
+        }
+
+        u32Addr = u32Next;
+    }
+
+    HOST_CHECK(memcmp(s_au8Aprom, s_au8Image, IMAGE_SIZE) == 0);
+    dData = s_dNow - dData;
+
+    /* Host verifies the whole image */
+    SendCmd(CMD_VERIFY_CRC32, 0, IMAGE_SIZE);
+    HOST_CHECK(inpw(response_buff + 16) == ISP_VERIFY_OK);
+    HOST_CHECK(inpw(response_buff + 8) == Crc32(s_au8Image, IMAGE_SIZE));
+    *pdTotal = s_dNow;
+    return dData;
+}
+
+int main(void)
+{
+    static const uint32_t au32Window[] = {1, 2, 4, ISP_MAX_WINDOW};
+    double dData, dTotal;
+    uint32_t i;
+
+    for(i = 0; i < IMAGE_SIZE; i++)
+        s_au8Image[i] = (uint8_t)(i * 13 + (i >> 8));
+
+    printf("128 KB APROM update at 115200 bps\n");
+    printf("Window  Packets  Total time   Data phase\n");
+    for(i = 0; i < sizeof(au32Window) / sizeof(au32Window[0]); i++)
+    {
+        dData = Update(au32Window[i], &dTotal);
+        printf("%6u  %7u  %8.2f s  %6.2f KB/s\n", au32Window[i], s_u32Packets, dTotal / 1e6,
+               IMAGE_SIZE / 1024.0 / (dData / 1e6));
+    }
+
+    printf("ISP window check passed\n");
+    return 0;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,286 @@
+/******************************************************************************
+ * @file     kvstore_check.c
+ * @version  V3.00
+ * @brief    Host model of the FMC_KVStore flash wear and power loss recovery
+ *
+ * @details  Builds kvstore.c of FMC_KVStore on the host PC with a flash model behind FMC_Erase and
+ *           FMC_WriteBuffer. Flash is RAM mapped at KV_BASE, erase sets a page to 0xFF and program
+ *           can only clear bits.
+ *           Power loss test: random writes and deletes of KV_KEYS keys. Power is lost at a random
+ *           flash word operation, which is left half done with random bits. After KV_Init every key
+ *           must hold its last value, and the interrupted key its old or its new value.
+ *           Wear test: a 4-byte counter is updated WEAR_UPDATES times, with a few other keys stored.
+ *           The erase count of each page is reported, pages must wear evenly.
+ *           Build and run on the host PC:
+ *             gcc -O2 -I../../Library/Device/Nuvoton/NUC1261/Include -I../../Library/CMSIS/Include
+ *                 -I../../Library/StdDriver/inc kvstore_check.c -o kvstore_check
+ *           It returns non-zero if a check fails.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <setjmp.h>
+#include "host_shim.h"
+#include "NUC1261.h"
+
+/* vu32 of NUC1261.h is unsigned long, which has 64 bits on the host */
+#undef M32
+#define M32(adr)            (*((volatile uint32_t *)(uintptr_t)(adr)))
+
+/* kvstore.c calls the flash model */
+#define FMC_Erase           HostFlashErase
+#define FMC_WriteBuffer     HostFlashWriteBuffer
+static int32_t HostFlashErase(uint32_t u32Addr);
+static int32_t HostFlashWriteBuffer(uint32_t u32Addr, const uint32_t *pu32Buf, uint32_t u32Len);
+#include "../StdDriver/FMC_KVStore/kvstore.c"
+
+#define KV_BASE             0x10000000      /* Host address of the store */
+#define KV_MAX_PAGES        16
+#define KV_KEYS             16              /* Keys used by the power loss test */
+#define LOSS_UPDATES        200000          /* Writes and deletes of the power loss test */
+#define LOSS_RATE           20              /* Power is lost in one of LOSS_RATE updates */
+#define LOSS_OPS            24              /* at one of the first LOSS_OPS flash word operations */
+#define WEAR_UPDATES        1000000
+
+HOST_SHIM_DATA
+
+static uint32_t s_u32PageCnt;
+static uint32_t s_au32PageErase[KV_MAX_PAGES];
+static uint32_t s_u32FlashOps;
+static uint32_t s_u32LossAt;                /* Flash word operation to lose power at, 0 for none */
+static uint32_t s_u32LossAtErase;          /* Lose power at the next page erase */
+static uint32_t s_u32EraseLoss;             /* Power losses during a page erase */
+static jmp_buf s_sPowerLoss;
+
+/* Expected value of each key, length 0 if deleted */
+static uint8_t s_au8Value[KV_MAX_KEYS][KV_MAX_VALUE_LEN];
+static uint32_t s_au32Len[KV_MAX_KEYS];
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Flash model                                                                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+/* Count a flash word operation. At the loss point the operation is left half done and power goes off. */
+static int32_t PowerLost(void)
+{
+    return (s_u32LossAt != 0) && (++s_u32FlashOps == s_u32LossAt);
+}
+
+static int32_t HostFlashErase(uint32_t u32Addr)
+{
+    uint32_t i;
+
+    HOST_CHECK((u32Addr >= KV_BASE) && (u32Addr < KV_BASE + s_u32PageCnt * FMC_FLASH_PAGE_SIZE));
+    HOST_CHECK((u32Addr & (FMC_FLASH_PAGE_SIZE - 1)) == 0);
+
+    if(PowerLost() || s_u32LossAtErase)
+    {
+        s_u32LossAtErase = 0;
+        s_u32EraseLoss++;
+        /* Some of the bits to set are set */
+        for(i = 0; i < FMC_FLASH_PAGE_SIZE; i += 4)
+        {
+            if(rand() & 1)
+                M32(u32Addr + i) |= (uint32_t)rand() | ((uint32_t)rand() << 16);
+        }
+        longjmp(s_sPowerLoss, 1);
+    }
+
+    s_au32PageErase[(u32Addr - KV_BASE) / FMC_FLASH_PAGE_SIZE]++;
+    memset((void *)(uintptr_t)u32Addr, 0xFF, FMC_FLASH_PAGE_SIZE);
+    return 0;
+}
+
+static int32_t HostFlashWriteBuffer(uint32_t u32Addr, const uint32_t *pu32Buf, uint32_t u32Len)
+{
+    HOST_CHECK((u32Addr >= KV_BASE) && (u32Addr + u32Len <= KV_BASE + s_u32PageCnt * FMC_FLASH_PAGE_SIZE));
+    HOST_CHECK(((u32Addr | u32Len) & 3) == 0);
+
+    for(; u32Len; u32Len -= 4, u32Addr += 4, pu32Buf++)
+    {
+        if(PowerLost())
+        {
+            /* Some of the bits to clear are cleared */
+            M32(u32Addr) &= *pu32Buf | (uint32_t)rand() | ((uint32_t)rand() << 16);
+            longjmp(s_sPowerLoss, 1);
+        }
+
+        /* Program never sets a bit */
+        M32(u32Addr) &= *pu32Buf;
+    }
+    return 0;
+}
+
+static void FlashBlank(uint32_t u32PageCnt)
+{
+    s_u32PageCnt = u32PageCnt;
+    s_u32LossAt = 0;
+    s_u32LossAtErase = 0;
+    memset((void *)(uintptr_t)KV_BASE, 0xFF, u32PageCnt * FMC_FLASH_PAGE_SIZE);
+    memset(s_au32PageErase, 0, sizeof(s_au32PageErase));
+    memset(s_au32Len, 0, sizeof(s_au32Len));
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Checks                                                                                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+static void CheckKey(uint32_t u32Key)
+{
+    uint8_t au8Buf[KV_MAX_VALUE_LEN];
+    int32_t i32Len;
+
+    i32Len = KV_Read(u32Key, au8Buf, sizeof(au8Buf));
+    if(s_au32Len[u32Key] == 0)
+        HOST_CHECK(i32Len == -1);
+    else
+        HOST_CHECK((i32Len == (int32_t)s_au32Len[u32Key]) && (memcmp(au8Buf, s_au8Value[u32Key], i32Len) == 0));
+}
+
+static void CheckAll(void)
+{
+    uint32_t i;
+
+    for(i = 0; i < KV_MAX_KEYS; i++)
+        CheckKey(i);
+}
+
+/* Random updates with power loss. Returns the number of power losses. */
+static uint32_t PowerLossTest(uint32_t u32PageCnt)
+{
+    static uint8_t au8Old[KV_MAX_VALUE_LEN];
+    uint8_t au8New[KV_MAX_VALUE_LEN];
+    uint32_t u32Update, u32Key, u32Len, u32OldLen, u32Loss = 0, i;
+    int32_t i32Read;
+
+    FlashBlank(u32PageCnt);
+    HOST_CHECK(KV_Init(KV_BASE, u32PageCnt) == 0);
+    s_u32EraseLoss = 0;
+
+    for(u32Update = 0; u32Update < LOSS_UPDATES; u32Update++)
+    {
+        /* Short values, the live data of KV_KEYS keys must stay below (page count - 2) pages */
+        u32Key = rand() % KV_KEYS;
+        u32Len = (rand() % 10) ? 1 + rand() % 16 : 0;
+        for(i = 0; i < u32Len; i++)
+            au8New[i] = (uint8_t)rand();
+        u32OldLen = s_au32Len[u32Key];
+        memcpy(au8Old, s_au8Value[u32Key], sizeof(au8Old));
+
+        s_u32FlashOps = 0;
+        s_u32LossAt = (rand() % LOSS_RATE) ? 0 : 1 + rand() % LOSS_OPS;
+        if((rand() % LOSS_RATE) == 0)
+            s_u32LossAtErase = 1;
+
+        if(setjmp(s_sPowerLoss))
+        {
+            /* Power on again. The interrupted update is done or not done at all. */
+            s_u32LossAt = 0;
+            u32Loss++;
+            HOST_CHECK(KV_Init(KV_BASE, u32PageCnt) == 0);
+
+            i32Read = KV_Read(u32Key, s_au8Value[u32Key], KV_MAX_VALUE_LEN);
+            if(u32Len ? ((i32Read == (int32_t)u32Len) && (memcmp(s_au8Value[u32Key], au8New, u32Len) == 0)) : (i32Read == -1))
+                s_au32Len[u32Key] = u32Len;
+            else
+            {
+                HOST_CHECK(i32Read == (u32OldLen ? (int32_t)u32OldLen : -1));
+                HOST_CHECK(memcmp(s_au8Value[u32Key], au8Old, u32OldLen) == 0);
+            }
+            CheckAll();
+            continue;
+        }
+
+        if(u32Len)
+        {
+            HOST_CHECK(KV_Write(u32Key, au8New, u32Len) == 0);
+            memcpy(s_au8Value[u32Key], au8New, u32Len);
+        }
+        else
+            HOST_CHECK(KV_Delete(u32Key) == 0);
+        s_au32Len[u32Key] = u32Len;
+        s_u32LossAt = 0;
+        CheckKey(u32Key);
+
+        /* A reset without power loss finds the same data */
+        if((rand() % 1000) == 0)
+        {
+            HOST_CHECK(KV_Init(KV_BASE, u32PageCnt) == 0);
+            CheckAll();
+        }
+    }
+
+    return u32Loss;
+}
+
+/* Counter updates. Returns the number of erases. */
+static uint32_t WearTest(uint32_t u32PageCnt)
+{
+    uint32_t u32Count, u32Min = 0xFFFFFFFF, u32Max = 0, u32Sum = 0, i;
+    char acSetting[] = "setting 0";
+
+    FlashBlank(u32PageCnt);
+    HOST_CHECK(KV_Init(KV_BASE, u32PageCnt) == 0);
+
+    /* A few settings that are written once */
+    for(i = 1; i < 4; i++)
+    {
+        acSetting[8] = (char)('0' + i);
+        HOST_CHECK(KV_Write(i, acSetting, sizeof(acSetting)) == 0);
+    }
+
+    for(u32Count = 0; u32Count < WEAR_UPDATES; u32Count++)
+        HOST_CHECK(KV_Write(0, &u32Count, sizeof(u32Count)) == 0);
+
+    printf("  %2u pages, %u counter updates, erases per page:", u32PageCnt, WEAR_UPDATES);
+    for(i = 0; i < u32PageCnt; i++)
+    {
+        printf(" %u", s_au32PageErase[i]);
+        u32Sum += s_au32PageErase[i];
+        if(s_au32PageErase[i] < u32Min)
+            u32Min = s_au32PageErase[i];
+        if(s_au32PageErase[i] > u32Max)
+            u32Max = s_au32PageErase[i];
+    }
+    printf("\n");
+
+    /* The pages are used as a ring, so they wear evenly */
+    HOST_CHECK(u32Max - u32Min <= 1);
+    HOST_CHECK(KV_GetEraseCount() == u32Sum);
+
+    /* The data is kept */
+    HOST_CHECK(KV_Init(KV_BASE, u32PageCnt) == 0);
+    u32Count = 0;
+    HOST_CHECK(KV_Read(0, &u32Count, sizeof(u32Count)) == sizeof(u32Count));
+    HOST_CHECK(u32Count == WEAR_UPDATES - 1);
+
+    return u32Sum;
+}
+
+int main(void)
+{
+    static const uint32_t au32Pages[] = {3, 4, 8, 16};
+    uint32_t u32Loss, i;
+
+    if(mmap((void *)(uintptr_t)KV_BASE, KV_MAX_PAGES * FMC_FLASH_PAGE_SIZE, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) != (void *)(uintptr_t)KV_BASE)
+    {
+        printf("Cannot map flash at 0x%08x\n", KV_BASE);
+        return 2;
+    }
+    srand(1261);
+
+    printf("Power loss test, %u updates of %u keys\n", LOSS_UPDATES, KV_KEYS);
+    for(i = 1; i < sizeof(au32Pages) / sizeof(au32Pages[0]); i++)
+    {
+        u32Loss = PowerLossTest(au32Pages[i]);
+        printf("  %2u pages, %u power losses, %u of them during erase, all recovered\n", au32Pages[i], u32Loss, s_u32EraseLoss);
+    }
+
+    printf("Wear test\n");
+    for(i = 0; i < sizeof(au32Pages) / sizeof(au32Pages[0]); i++)
+        WearTest(au32Pages[i]);
+
+    printf("KV store check passed\n");
+    return 0;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,216 @@
+/******************************************************************************
+ * @file     msc_cache_check.c
+ * @version  V3.00
+ * @brief    Host replay of FAT copy traces through the DataFlash mass storage page cache
+ *
+ * @details  Builds DataFlashProg.c of USBD_MassStorage_DataFlash on the host PC with a flash model
+ *           behind FMC_ErasePages and FMC_WriteBuffer. The storage is RAM mapped at MASS_STORAGE_OFFSET,
+ *           and a word can only be programmed once after erase.
+ *           The traces are the sector writes a host makes to copy files to the 64 KB FAT12 volume:
+ *           boot sector at LBA 0, FAT1 at LBA 1, FAT2 at LBA 2, root directory at LBA 3 ~ 6 and
+ *           data clusters of one sector from LBA 7. Data writes are split to STORAGE_BUFFER_SIZE
+ *           like MSC_Write() does. Every read back and the flash contents after the final flush
+ *           must match the written data.
+ *           It reports page erases, programmed words and throughput from the flash and USB time
+ *           model below. Build it with -DFLASH_CACHE_PAGE_NUM=1, 2 and 4 to compare cache sizes:
+ *             gcc -O2 -DFLASH_CACHE_PAGE_NUM=2 -I../../Library/Device/Nuvoton/NUC1261/Include
+ *                 -I../../Library/CMSIS/Include -I../../Library/StdDriver/inc msc_cache_check.c
+ *                 -o msc_cache_check
+ *           It returns non-zero if a check fails.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "host_shim.h"
+#include "NUC1261.h"
+#include "../StdDriver/USBD_MassStorage_DataFlash/DataFlashProg.h"
+#include "../StdDriver/USBD_MassStorage_DataFlash/massstorage.h"
+
+/* vu32 of NUC1261.h is unsigned long, which has 64 bits on the host */
+#undef M32
+#define M32(adr)            (*((volatile uint32_t *)(uintptr_t)(adr)))
+
+/* DataFlashProg.c calls the flash model */
+#define FMC_ErasePages      HostFlashErasePages
+#define FMC_WriteBuffer     HostFlashWriteBuffer
+static int32_t HostFlashErasePages(uint32_t u32Addr, uint32_t u32Len);
+static int32_t HostFlashWriteBuffer(uint32_t u32Addr, const uint32_t *pu32Buf, uint32_t u32Len);
+#include "../StdDriver/USBD_MassStorage_DataFlash/DataFlashProg.c"
+
+#define ERASE_US            20000       /* Page erase time */
+#define PROG_US             30          /* Word program time */
+#define USB_BYTES_PER_MS    1000        /* Full speed bulk OUT with MSC protocol overhead */
+
+#define SECTOR_NUM          (DATA_FLASH_STORAGE_SIZE / UDC_SECTOR_SIZE)
+#define LBA_FAT1            1
+#define LBA_FAT2            2
+#define LBA_ROOT            3
+#define LBA_DATA            7
+
+HOST_SHIM_DATA
+
+static uint32_t s_u32Erases, s_u32Words, s_u32HostBytes, s_u32FileBytes;
+static uint8_t s_au8Disk[DATA_FLASH_STORAGE_SIZE];      /* Expected volume contents */
+
+/* Transfer buffer. DataFlashWrite takes a 32-bit address, so it lives in the mapped storage window. */
+#define XFER_BUF            (MASS_STORAGE_OFFSET + DATA_FLASH_STORAGE_SIZE)
+#define XFER_SIZE           (64 * 1024)
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Flash model                                                                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+static int32_t HostFlashErasePages(uint32_t u32Addr, uint32_t u32Len)
+{
+    HOST_CHECK((u32Addr >= MASS_STORAGE_OFFSET) && (u32Addr + u32Len <= MASS_STORAGE_OFFSET + DATA_FLASH_STORAGE_SIZE));
+    HOST_CHECK(((u32Addr | u32Len) & (FLASH_PAGE_SIZE - 1)) == 0);
+
+    memset((void *)(uintptr_t)u32Addr, 0xFF, u32Len);
+    s_u32Erases += u32Len / FLASH_PAGE_SIZE;
+    return 0;
+}
+
+static int32_t HostFlashWriteBuffer(uint32_t u32Addr, const uint32_t *pu32Buf, uint32_t u32Len)
+{
+    uint32_t i;
+
+    HOST_CHECK((u32Addr >= MASS_STORAGE_OFFSET) && (u32Addr + u32Len <= MASS_STORAGE_OFFSET + DATA_FLASH_STORAGE_SIZE));
+    HOST_CHECK(((u32Addr | u32Len) & 3) == 0);
+
+    for(i = 0; i < u32Len; i += 4)
+    {
+        /* A word must not be programmed twice without erase */
+        HOST_CHECK(M32(u32Addr + i) == 0xFFFFFFFF);
+        M32(u32Addr + i) = pu32Buf[i / 4];
+        s_u32Words++;
+    }
+    return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* MSC commands                                                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+/* WRITE(10) of random data, in STORAGE_BUFFER_SIZE pieces like MSC_Write() */
+static void HostWrite(uint32_t u32Lba, uint32_t u32Sectors)
+{
+    uint8_t *pu8Buf = (uint8_t *)(uintptr_t)XFER_BUF;
+    uint32_t u32Len = u32Sectors * UDC_SECTOR_SIZE;
+    uint32_t i;
+
+    HOST_CHECK((u32Lba + u32Sectors <= SECTOR_NUM) && (u32Len <= XFER_SIZE));
+
+    for(i = 0; i < u32Len; i++)
+        pu8Buf[i] = (uint8_t)rand();
+    memcpy(&s_au8Disk[u32Lba * UDC_SECTOR_SIZE], pu8Buf, u32Len);
+
+    for(i = 0; i < u32Len; i += STORAGE_BUFFER_SIZE)
+        DataFlashWrite(u32Lba * UDC_SECTOR_SIZE + i, STORAGE_BUFFER_SIZE, XFER_BUF + i);
+
+    s_u32HostBytes += u32Len;
+}
+
+/* READ(10) and compare with the expected contents */
+static void HostRead(uint32_t u32Lba, uint32_t u32Sectors)
+{
+    uint32_t u32Len = u32Sectors * UDC_SECTOR_SIZE;
+
+    DataFlashRead(u32Lba * UDC_SECTOR_SIZE, u32Len, XFER_BUF);
+    HOST_CHECK(memcmp((void *)(uintptr_t)XFER_BUF, &s_au8Disk[u32Lba * UDC_SECTOR_SIZE], u32Len) == 0);
+}
+
+/* FAT1, FAT2 and directory entry update after clusters are allocated */
+static void HostUpdateFat(uint32_t u32DirLba)
+{
+    HostWrite(LBA_FAT1, 1);
+    HostWrite(LBA_FAT2, 1);
+    HostWrite(u32DirLba, 1);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Traces                                                                                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+/* One 48 KB file written in 16 KB commands */
+static void TraceLargeFile(void)
+{
+    uint32_t u32Lba;
+
+    HostWrite(LBA_ROOT, 1);
+    HostUpdateFat(LBA_ROOT);
+    for(u32Lba = LBA_DATA; u32Lba < LBA_DATA + 96; u32Lba += 32)
+        HostWrite(u32Lba, 32);
+    HostUpdateFat(LBA_ROOT);
+    s_u32FileBytes += 48 * 1024;
+}
+
+/* 24 files of 2 KB. Each one creates its directory entry, allocates clusters, writes data and sets size. */
+static void TraceSmallFiles(void)
+{
+    uint32_t i;
+
+    for(i = 0; i < 24; i++)
+    {
+        HostWrite(LBA_ROOT + (i / 16), 1);
+        HostUpdateFat(LBA_ROOT + (i / 16));
+        HostWrite(LBA_DATA + i * 4, 4);
+        HostWrite(LBA_ROOT + (i / 16), 1);
+        HostRead(LBA_DATA + i * 4, 4);
+        s_u32FileBytes += 2048;
+    }
+}
+
+/* A log file appended by 512 bytes 96 times */
+static void TraceAppend(void)
+{
+    uint32_t i;
+
+    for(i = 0; i < 96; i++)
+    {
+        HostWrite(LBA_DATA + i, 1);
+        HostUpdateFat(LBA_ROOT);
+        HostRead(LBA_ROOT, 1);
+        s_u32FileBytes += 512;
+    }
+}
+
+static void Replay(const char *pcName, void (*pfnTrace)(void))
+{
+    double dFlashMs, dUsbMs;
+
+    s_u32Erases = s_u32Words = s_u32HostBytes = s_u32FileBytes = 0;
+
+    pfnTrace();
+
+    /* Host stops writing, main loop writes back the cache */
+    FlashCacheRequestFlush();
+    FlashCacheIdle();
+    HOST_CHECK(s_u32DirtyCnt == 0);
+    HOST_CHECK(memcmp((void *)(uintptr_t)MASS_STORAGE_OFFSET, s_au8Disk, DATA_FLASH_STORAGE_SIZE) == 0);
+
+    dFlashMs = (s_u32Erases * (double)ERASE_US + s_u32Words * (double)PROG_US) / 1000;
+    dUsbMs = (double)s_u32HostBytes / USB_BYTES_PER_MS;
+    printf("%-22s %6u %8u %8.0f ms %7.1f KB/s\n", pcName, s_u32Erases, s_u32Words, dFlashMs,
+           s_u32FileBytes / 1024.0 / ((dFlashMs + dUsbMs) / 1000));
+}
+
+int main(void)
+{
+    if(mmap((void *)(uintptr_t)MASS_STORAGE_OFFSET, DATA_FLASH_STORAGE_SIZE + XFER_SIZE, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) != (void *)(uintptr_t)MASS_STORAGE_OFFSET)
+    {
+        printf("Cannot map storage at 0x%08x\n", MASS_STORAGE_OFFSET);
+        return 2;
+    }
+    memset((void *)(uintptr_t)MASS_STORAGE_OFFSET, 0xFF, DATA_FLASH_STORAGE_SIZE);
+    memset(s_au8Disk, 0xFF, sizeof(s_au8Disk));
+    srand(1);
+
+    printf("Cache pages: %d\n", FLASH_CACHE_PAGE_NUM);
+    printf("Trace                  Erases    Words    Flash time  Throughput\n");
+    Replay("Copy one 48 KB file", TraceLargeFile);
+    Replay("Copy 24 files of 2 KB", TraceSmallFiles);
+    Replay("Append 512 B x 96", TraceAppend);
+
+    printf("MSC cache check passed\n");
+    return 0;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
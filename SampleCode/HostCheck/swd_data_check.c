@@ -0,0 +1,383 @@
+/******************************************************************************
+ * @file     swd_data_check.c
+ * @version  V3.00
+ * @brief    Host check of the SWD transfer with the data phase shifted by SPI1
+ *
+ * @details  Builds SW_DP.c of CMSIS-DAP on the host PC with SWD_DATA_HW enabled and runs
+ *           SWD_Transfer against a bit level model of an SWD target. The pin functions of
+ *           DAP_config.h are replaced by the model below. PIN_SWD_DATA_WRITE and
+ *           PIN_SWD_DATA_READ model SPI1 as the NUC1261 DAP_config.h sets it up: SWCLK idles
+ *           high, SWDIO is driven on the falling edge (TXNEG) and sampled on the falling
+ *           edge (RXNEG), LSB first, 32 clocks.
+ *           Every transfer runs with the fast clock, which uses the SPI1 data phase, and
+ *           again with the slow clock, which bit-bangs it. Both must give the same SWDIO
+ *           level and driver at each rising SWCLK edge, the same ACK and the same data.
+ *           Reads with a bad parity bit must return DAP_TRANSFER_ERROR and WAIT responses
+ *           must be handled. The SPI1 register sequence of DAP_config.h is not run here,
+ *           it is only verified on target.
+ *           Build and run on the host PC:
+ *             gcc -O2 -I../../Library/CMSIS/DAP/Firmware/Examples/NUC1261
+ *                 -I../../Library/CMSIS/DAP/Firmware/Include swd_data_check.c -o swd_data_check
+ *           It returns non-zero if a check fails.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "host_shim.h"
+
+#define __forceinline       inline
+
+/* Replaces DAP_config.h of the example */
+#define __DAP_CONFIG_H__
+#define DAP_SWD             1
+#define DAP_JTAG            0
+#define DAP_JTAG_DEV_CNT    0U
+#define SWD_DATA_HW         1
+
+#define TRANSFER_NUM        4000
+#define TRACE_LEN           128         /* Rising edges of one transfer, enough for 2 idle cycles */
+
+/* Target states */
+#define TGT_IDLE            0
+#define TGT_REQ             1
+#define TGT_TRN             2
+#define TGT_ACK             3
+#define TGT_RDATA           4
+#define TGT_TRN_W           5
+#define TGT_WDATA           6
+
+HOST_SHIM_DATA
+
+static uint32_t s_u32Clk = 1, s_u32HostDrive = 1, s_u32HostBit = 1;
+static uint32_t s_u32SpiDrive, s_u32SpiBit;
+
+static struct
+{
+    uint32_t u32State, u32Cnt, u32Req, u32Ack, u32Shift;
+    uint32_t u32Drive, u32Bit;
+    uint32_t au32Reg[8];
+    uint32_t u32Wait, u32BadParity;     /* Faults of the next transfer */
+    uint32_t u32WriteErrors;
+} s_sTgt;
+
+static uint8_t s_au8Trace[TRACE_LEN];
+static uint32_t s_u32TraceLen;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* SWD target model                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t Parity(uint32_t u32Val)
+{
+    return (uint32_t)__builtin_parity(u32Val);
+}
+
+static uint32_t LineLevel(void)
+{
+    HOST_CHECK(!((s_u32HostDrive || s_u32SpiDrive) && s_sTgt.u32Drive));
+
+    if(s_u32SpiDrive)
+        return s_u32SpiBit;
+    if(s_u32HostDrive)
+        return s_u32HostBit;
+    if(s_sTgt.u32Drive)
+        return s_sTgt.u32Bit;
+    return 1;       /* Pull-up */
+}
+
+static void TargetDrive(uint32_t u32Bit)
+{
+    s_sTgt.u32Drive = 1;
+    s_sTgt.u32Bit = u32Bit & 1;
+}
+
+/* The target samples SWDIO and changes its output on the rising SWCLK edge */
+static void TargetRise(void)
+{
+    uint32_t u32Line = LineLevel();
+    uint32_t u32HostDrive = s_u32HostDrive || s_u32SpiDrive;
+
+    HOST_CHECK(s_u32TraceLen < TRACE_LEN);
+    s_au8Trace[s_u32TraceLen++] = (uint8_t)(u32Line | (u32HostDrive << 1) | (s_sTgt.u32Drive << 2));
+
+    switch(s_sTgt.u32State)
+    {
+        case TGT_IDLE:
+            /* Start bit */
+            if(u32HostDrive && u32Line)
+            {
+                s_sTgt.u32State = TGT_REQ;
+                s_sTgt.u32Cnt = 0;
+                s_sTgt.u32Req = 0;
+            }
+            break;
+
+        case TGT_REQ:
+            /* APnDP, RnW, A2, A3, parity, stop and park */
+            HOST_CHECK(u32HostDrive);
+            s_sTgt.u32Req |= u32Line << s_sTgt.u32Cnt;
+            if(++s_sTgt.u32Cnt == 7)
+            {
+                HOST_CHECK(Parity(s_sTgt.u32Req & 0x1F) == 0);
+                HOST_CHECK((s_sTgt.u32Req & 0x60) == 0x40);
+                s_sTgt.u32State = TGT_TRN;
+                s_sTgt.u32Cnt = 0;
+            }
+            break;
+
+        case TGT_TRN:
+            /* One turnaround cycle, then ACK[0] */
+            HOST_CHECK(!u32HostDrive);
+            s_sTgt.u32Ack = 1;
+            if(s_sTgt.u32Wait)
+            {
+                s_sTgt.u32Wait--;
+                s_sTgt.u32Ack = 2;
+            }
+            TargetDrive(s_sTgt.u32Ack);
+            s_sTgt.u32State = TGT_ACK;
+            s_sTgt.u32Cnt = 1;
+            break;
+
+        case TGT_ACK:
+            if(s_sTgt.u32Cnt < 3)
+            {
+                TargetDrive(s_sTgt.u32Ack >> s_sTgt.u32Cnt++);
+            }
+            else if(s_sTgt.u32Ack != 1)
+            {
+                s_sTgt.u32Drive = 0;
+                s_sTgt.u32State = TGT_IDLE;
+            }
+            else if(s_sTgt.u32Req & 2)
+            {
+                s_sTgt.u32Shift = s_sTgt.au32Reg[(s_sTgt.u32Req & 1) | ((s_sTgt.u32Req >> 1) & 6)];
+                TargetDrive(s_sTgt.u32Shift);
+                s_sTgt.u32State = TGT_RDATA;
+                s_sTgt.u32Cnt = 1;
+            }
+            else
+            {
+                s_sTgt.u32Drive = 0;
+                s_sTgt.u32State = TGT_TRN_W;
+            }
+            break;
+
+        case TGT_RDATA:
+            /* RDATA[0:31], parity, then release for the turnaround */
+            if(s_sTgt.u32Cnt < 32)
+                TargetDrive(s_sTgt.u32Shift >> s_sTgt.u32Cnt);
+            else if(s_sTgt.u32Cnt == 32)
+                TargetDrive(Parity(s_sTgt.u32Shift) ^ s_sTgt.u32BadParity);
+            else
+            {
+                s_sTgt.u32Drive = 0;
+                s_sTgt.u32State = TGT_IDLE;
+            }
+            s_sTgt.u32Cnt++;
+            break;
+
+        case TGT_TRN_W:
+            HOST_CHECK(!u32HostDrive);
+            s_sTgt.u32State = TGT_WDATA;
+            s_sTgt.u32Cnt = 0;
+            s_sTgt.u32Shift = 0;
+            break;
+
+        case TGT_WDATA:
+            /* WDATA[0:31] and parity */
+            HOST_CHECK(u32HostDrive);
+            if(s_sTgt.u32Cnt < 32)
+            {
+                s_sTgt.u32Shift |= u32Line << s_sTgt.u32Cnt++;
+            }
+            else
+            {
+                if(Parity(s_sTgt.u32Shift) != u32Line)
+                    s_sTgt.u32WriteErrors++;
+                else
+                    s_sTgt.au32Reg[(s_sTgt.u32Req & 1) | ((s_sTgt.u32Req >> 1) & 6)] = s_sTgt.u32Shift;
+                s_sTgt.u32State = TGT_IDLE;
+            }
+            break;
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Pins of DAP_config.h                                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+static inline void PIN_SWCLK_TCK_SET(void)
+{
+    if(s_u32Clk == 0)
+    {
+        s_u32Clk = 1;
+        TargetRise();
+    }
+}
+
+static inline void PIN_SWCLK_TCK_CLR(void)
+{
+    s_u32Clk = 0;
+}
+
+static inline void PIN_SWDIO_TMS_SET(void)
+{
+    s_u32HostBit = 1;
+}
+
+static inline void PIN_SWDIO_TMS_CLR(void)
+{
+    s_u32HostBit = 0;
+}
+
+static inline uint32_t PIN_SWDIO_IN(void)
+{
+    return LineLevel();
+}
+
+static inline void PIN_SWDIO_OUT(uint32_t bit)
+{
+    s_u32HostBit = bit & 1U;
+}
+
+static inline void PIN_SWDIO_OUT_ENABLE(void)
+{
+    s_u32HostDrive = 1;
+}
+
+static inline void PIN_SWDIO_OUT_DISABLE(void)
+{
+    s_u32HostDrive = 0;
+}
+
+/* SPI1 takes SWCLK and SWDIO for 32 clocks. SWCLK idles high and SWDIO changes on the falling edge. */
+static inline void PIN_SWD_DATA_WRITE(uint32_t data)
+{
+    uint32_t i;
+
+    /* SWDIO is left in output mode when SPI1 returns it to GPIO */
+    HOST_CHECK(s_u32Clk && s_u32HostDrive);
+    s_u32SpiDrive = 1;
+    for(i = 0; i < 32; i++)
+    {
+        s_u32Clk = 0;
+        s_u32SpiBit = (data >> i) & 1U;
+        s_u32Clk = 1;
+        TargetRise();
+    }
+    s_u32SpiDrive = 0;
+}
+
+/* SPI1 samples SWDIO on the falling edge, after the target has driven it on the rising edge */
+static inline uint32_t PIN_SWD_DATA_READ(void)
+{
+    uint32_t i, u32Data = 0;
+
+    HOST_CHECK(s_u32Clk && !s_u32HostDrive);
+    for(i = 0; i < 32; i++)
+    {
+        s_u32Clk = 0;
+        u32Data |= LineLevel() << i;
+        s_u32Clk = 1;
+        TargetRise();
+    }
+    return u32Data;
+}
+
+#include "DAP.h"
+
+DAP_Data_t DAP_Data;
+
+#include "../../Library/CMSIS/DAP/Firmware/Source/SW_DP.c"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Transfers                                                                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct
+{
+    uint8_t u8Ack;
+    uint32_t u32Data;
+    uint32_t au32Reg[8];
+    uint8_t au8Trace[TRACE_LEN];
+    uint32_t u32TraceLen;
+} S_RESULT_T;
+
+static void Transfer(uint32_t u32Fast, uint32_t u32Req, uint32_t u32Data, uint32_t u32Wait,
+                     uint32_t u32BadParity, S_RESULT_T *psResult)
+{
+    s_sTgt.u32Wait = u32Wait;
+    s_sTgt.u32BadParity = u32BadParity;
+    s_u32TraceLen = 0;
+
+    DAP_Data.fast_clock = (uint8_t)u32Fast;
+    psResult->u32Data = u32Data;
+    psResult->u8Ack = SWD_Transfer(u32Req, &psResult->u32Data);
+
+    HOST_CHECK(s_sTgt.u32State == TGT_IDLE);
+    HOST_CHECK(!s_sTgt.u32Drive && s_u32HostDrive && s_u32HostBit && s_u32Clk);
+    memcpy(psResult->au32Reg, s_sTgt.au32Reg, sizeof(psResult->au32Reg));
+    memcpy(psResult->au8Trace, s_au8Trace, sizeof(psResult->au8Trace));
+    psResult->u32TraceLen = s_u32TraceLen;
+}
+
+int main(void)
+{
+    static S_RESULT_T sFast, sSlow;
+    uint32_t au32Reg[8];
+    uint32_t i, u32Req, u32Data, u32Wait, u32BadParity;
+    uint32_t u32Reads = 0, u32Writes = 0, u32Waits = 0, u32Errors = 0;
+
+    srand(1);
+    for(i = 0; i < 8; i++)
+        s_sTgt.au32Reg[i] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+
+    DAP_Data.clock_delay = 1;
+    DAP_Data.swd_conf.turnaround = 1;
+    DAP_Data.swd_conf.data_phase = 0;
+
+    for(i = 0; i < TRANSFER_NUM; i++)
+    {
+        u32Req = (uint32_t)rand() & 0xF;
+        u32Data = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        u32Wait = ((rand() & 7) == 0);
+        u32BadParity = ((rand() & 7) == 0);
+        DAP_Data.transfer.idle_cycles = (uint8_t)((i & 1) * 2);
+
+        memcpy(au32Reg, s_sTgt.au32Reg, sizeof(au32Reg));
+        Transfer(1, u32Req, u32Data, u32Wait, u32BadParity, &sFast);
+        memcpy(s_sTgt.au32Reg, au32Reg, sizeof(au32Reg));
+        Transfer(0, u32Req, u32Data, u32Wait, u32BadParity, &sSlow);
+
+        /* The SPI1 data phase is not visible on the SWD wires */
+        HOST_CHECK(sFast.u8Ack == sSlow.u8Ack);
+        HOST_CHECK(sFast.u32Data == sSlow.u32Data);
+        HOST_CHECK(sFast.u32TraceLen == sSlow.u32TraceLen);
+        HOST_CHECK(memcmp(sFast.au8Trace, sSlow.au8Trace, sFast.u32TraceLen) == 0);
+        HOST_CHECK(memcmp(sFast.au32Reg, sSlow.au32Reg, sizeof(au32Reg)) == 0);
+
+        if(u32Wait)
+        {
+            HOST_CHECK(sFast.u8Ack == DAP_TRANSFER_WAIT);
+            u32Waits++;
+        }
+        else if(u32Req & DAP_TRANSFER_RnW)
+        {
+            HOST_CHECK(sFast.u32Data == au32Reg[(u32Req & 1) | ((u32Req >> 1) & 6)]);
+            HOST_CHECK(sFast.u8Ack == (u32BadParity ? DAP_TRANSFER_ERROR : DAP_TRANSFER_OK));
+            u32Reads++;
+            u32Errors += u32BadParity;
+        }
+        else
+        {
+            HOST_CHECK(sFast.u8Ack == DAP_TRANSFER_OK);
+            HOST_CHECK(sFast.au32Reg[(u32Req & 1) | ((u32Req >> 1) & 6)] == u32Data);
+            u32Writes++;
+        }
+    }
+    HOST_CHECK(s_sTgt.u32WriteErrors == 0);
+
+    printf("Reads %u, writes %u, WAIT %u, parity errors %u\n", u32Reads, u32Writes, u32Waits, u32Errors);
+    printf("SWD data check passed\n");
+    return 0;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,195 @@
+/******************************************************************************
+ * @file     uac_drift_check.c
+ * @version  V3.00
+ * @brief    Host model of the USB audio play loop with resampling clock drift tracking
+ *
+ * @details  Builds usbd_audio.c of USBD_Audio_NAU8822 with UAC_SYNC_MODE = UAC_SYNC_RESAMPLE.
+ *           The USB host sends a 1 kHz tone, 48 frames per 1 ms packet, to EP3_Handler. The I2S
+ *           clock runs off by a given ppm, and each finished play segment is passed to the PDMA
+ *           job scheduler as a transfer done of the play job channel. For drifts from -1000 to
+ *           +1000 ppm it reports the play buffer level, the underruns and the SNR (THD + noise)
+ *           of the played tone after the loop has settled.
+ *           It fails if any underrun happens or the SNR is below CHECK_MIN_SNR.
+ *           Build and run on the host PC:
+ *             gcc -O2 -DUAC_SYNC_MODE=UAC_SYNC_RESAMPLE -DPDMA_JOB_DESC_NUM=20 -include host_shim.h
+ *                 -I../StdDriver/USBD_Audio_NAU8822
+ *                 -I../../Library/Device/Nuvoton/NUC1261/Include -I../../Library/CMSIS/Include
+ *                 -I../../Library/StdDriver/inc uac_drift_check.c ../../Library/StdDriver/src/usbd.c
+ *                 ../../Library/StdDriver/src/pdma.c ../../Library/StdDriver/src/gpio.c -lm -o uac_drift_check
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <math.h>
+#include "host_shim.h"
+#include "../StdDriver/USBD_Audio_NAU8822/usbd_audio.c"
+
+#if (UAC_SYNC_MODE != UAC_SYNC_RESAMPLE)
+#error Build with -DUAC_SYNC_MODE=UAC_SYNC_RESAMPLE
+#endif
+
+#define RUN_SECONDS     120         /* Simulated play time for each drift */
+#define SETTLE_SECONDS  60          /* Buffer level and SNR are taken after it */
+#define TONE_HZ         1000
+#define TONE_AMP        16000
+#define SNR_LEN         4800        /* Played frames for SNR */
+#define CHECK_MIN_SNR   60.0        /* dB */
+
+HOST_SHIM_DATA
+
+static const int32_t s_ai32DriftPpm[] = {-1000, -500, -100, 0, 100, 500, 1000};
+static double s_adSnr[SNR_LEN];
+
+void PDMA_IRQHandler(void)
+{
+    PDMA_JobIRQHandler();
+}
+
+/* Residual power after removing a sine of frequency dFreq (cycles per frame) and DC. Returns signal power too. */
+static double SineResidual(const double *pdData, uint32_t u32Len, double dFreq, double *pdSignal)
+{
+    double s = 0, c = 0, ss = 0, cc = 0, sc = 0, m = 0, a, b, e, r = 0, d;
+    uint32_t i;
+
+    for(i = 0; i < u32Len; i++)
+        m += pdData[i];
+    m /= u32Len;
+
+    for(i = 0; i < u32Len; i++)
+    {
+        d = pdData[i] - m;
+        s += d * sin(2 * M_PI * dFreq * i);
+        c += d * cos(2 * M_PI * dFreq * i);
+        ss += sin(2 * M_PI * dFreq * i) * sin(2 * M_PI * dFreq * i);
+        cc += cos(2 * M_PI * dFreq * i) * cos(2 * M_PI * dFreq * i);
+        sc += sin(2 * M_PI * dFreq * i) * cos(2 * M_PI * dFreq * i);
+    }
+
+    /* Least squares of a * sin + b * cos */
+    a = (s * cc - c * sc) / (ss * cc - sc * sc);
+    b = (c * ss - s * sc) / (ss * cc - sc * sc);
+
+    for(i = 0; i < u32Len; i++)
+    {
+        e = pdData[i] - m - a * sin(2 * M_PI * dFreq * i) - b * cos(2 * M_PI * dFreq * i);
+        r += e * e;
+    }
+
+    *pdSignal = (a * a + b * b) / 2 * u32Len;
+    return r;
+}
+
+/* SNR of a tone near dFreq. The played frequency moves a little with the resample step. */
+static double ToneSnr(const double *pdData, uint32_t u32Len, double dFreq)
+{
+    double dLo = dFreq * 0.997, dHi = dFreq * 1.003, dM1, dM2, dSig, dRes1, dRes2;
+    uint32_t i;
+
+    for(i = 0; i < 60; i++)
+    {
+        dM1 = dLo + (dHi - dLo) / 3;
+        dM2 = dHi - (dHi - dLo) / 3;
+        dRes1 = SineResidual(pdData, u32Len, dM1, &dSig);
+        dRes2 = SineResidual(pdData, u32Len, dM2, &dSig);
+        if(dRes1 < dRes2)
+            dHi = dM2;
+        else
+            dLo = dM1;
+    }
+
+    dRes1 = SineResidual(pdData, u32Len, (dLo + dHi) / 2, &dSig);
+    return 10 * log10(dSig / dRes1);
+}
+
+/* Run the loop with the I2S clock off by i32Ppm. Returns the number of failed checks. */
+static int RunDrift(int32_t i32Ppm)
+{
+    double dTime = 0, dNextPkt = 0, dNextSeg, dSegTime, dSnr;
+    uint32_t u32Frame = 0, u32Underrun = 0, u32Min = BUF_LEN, u32Max = 0, u32Level, u32Snr = 0, i;
+    uint32_t *pu32UsbBuf;
+    int16_t i16Sample;
+
+    /* Fresh state of the play path */
+    memset(g_au32PcmPlayBuf, 0, sizeof(g_au32PcmPlayBuf));
+    g_u32PlayPos_Out = BUF_LEN - 1;
+    g_u32PlayPos_In = BUF_LEN - 1;
+    s_u32PlaySeg = 0;
+    memset(s_au32ResampleHist, 0, sizeof(s_au32ResampleHist));
+    s_u32ResamplePhase = 0;
+    s_i32FillAvg = (BUF_LEN / 2) << 8;
+    g_u8PlayEn = 0;
+    UAC_DeviceEnable(UAC_SPEAKER);
+
+    USBD_SET_EP_BUF_ADDR(EP3, EP3_BUF_BASE);
+    pu32UsbBuf = (uint32_t *)(uintptr_t)(USBD_BUF_BASE + EP3_BUF_BASE);
+    dSegTime = (double)PLAY_SEG_LEN / (PLAY_RATE * (1.0 + i32Ppm / 1e6));
+    dNextSeg = dSegTime;
+
+    while(dTime < RUN_SECONDS)
+    {
+        if(dNextPkt <= dNextSeg)
+        {
+            /* USB host sends 1 ms of the tone at its own 48 kHz */
+            dTime = dNextPkt;
+            for(i = 0; i < PLAY_RATE / 1000; i++, u32Frame++)
+            {
+                i16Sample = (int16_t)lrint(TONE_AMP * sin(2 * M_PI * TONE_HZ * u32Frame / PLAY_RATE));
+                pu32UsbBuf[i] = (uint16_t)i16Sample | ((uint32_t)(uint16_t)i16Sample << 16);
+            }
+            USBD_SET_PAYLOAD_LEN(EP3, PLAY_RATE / 1000 * 4);
+            EP3_Handler();
+            dNextPkt += 0.001;
+        }
+        else
+        {
+            /* I2S finishes a play segment. The handler sees an underrun when the next segment is not filled. */
+            dTime = dNextSeg;
+            if(GetSamplesInBuf() < PLAY_SEG_LEN)
+                u32Underrun++;
+
+            if((dTime >= SETTLE_SECONDS) && (u32Snr < SNR_LEN))
+            {
+                for(i = 0; (i < PLAY_SEG_LEN) && (u32Snr < SNR_LEN); i++)
+                    s_adSnr[u32Snr++] = (int16_t)g_au32PcmPlayBuf[s_u32PlaySeg * PLAY_SEG_LEN + i];
+            }
+
+            PDMA->TDSTS = (1 << s_sPlayJob.i32Ch);
+            PDMA_IRQHandler();
+            PDMA->TDSTS = 0;
+            dNextSeg += dSegTime;
+        }
+
+        if(dTime >= SETTLE_SECONDS)
+        {
+            u32Level = GetSamplesInBuf();
+            if(u32Level < u32Min)
+                u32Min = u32Level;
+            if(u32Level > u32Max)
+                u32Max = u32Level;
+        }
+    }
+
+    dSnr = ToneSnr(s_adSnr, SNR_LEN, (double)TONE_HZ / PLAY_RATE / (1.0 + i32Ppm / 1e6));
+    printf("  %+5d ppm   %4u ~ %4u of %u   %5u   %5.1f dB\n", i32Ppm, u32Min, u32Max, BUF_LEN, u32Underrun, dSnr);
+
+    return (u32Underrun != 0) + (dSnr < CHECK_MIN_SNR);
+}
+
+int main(void)
+{
+    uint32_t i;
+    int i32Fail = 0;
+
+    HostMapPeripherals();
+    PDMA_JobOpen(I2S_PDMA_CH_MASK);
+    UAC_I2SPdmaStart();
+
+    printf("  Drift      Buffer level     Underruns  SNR\n");
+    for(i = 0; i < sizeof(s_ai32DriftPpm) / sizeof(s_ai32DriftPpm[0]); i++)
+        i32Fail += RunDrift(s_ai32DriftPpm[i]);
+
+    printf(i32Fail ? "Drift check failed\n" : "Drift check passed\n");
+    return i32Fail ? 1 : 0;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
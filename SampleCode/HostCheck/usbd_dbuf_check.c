@@ -0,0 +1,111 @@
+/******************************************************************************
+ * @file     usbd_dbuf_check.c
+ * @version  V3.00
+ * @brief    Host check of the USBD double-buffered OUT endpoint helper
+ *
+ * @details  Builds usbd.c on the host PC and runs random sequences of OUT packets from the
+ *           USB host and USBD_DBufGet/USBD_DBufRelease calls from the main loop. It checks
+ *           that packets are consumed in order with their length and data, that a buffer
+ *           held by the main loop is never overwritten, and that the endpoint is armed
+ *           whenever fewer than two packets wait.
+ *           Build and run on the host PC:
+ *             gcc -O2 -I../../Library/Device/Nuvoton/NUC1261/Include -I../../Library/CMSIS/Include
+ *                 -I../../Library/StdDriver/inc usbd_dbuf_check.c -o usbd_dbuf_check
+ *           It returns non-zero if a check fails.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "host_shim.h"
+#include "../../Library/StdDriver/src/usbd.c"
+
+#define TEST_EP         EP3
+#define TEST_BUF_SEG    0x40
+#define MAX_PKT_SIZE    64      /* Test packets are 1 to MAX_PKT_SIZE - 1 bytes, MXPLD = MAX_PKT_SIZE means armed */
+#define TEST_STEPS      1000000
+
+HOST_SHIM_DATA
+
+const S_USBD_INFO_T gsInfo;
+
+static S_USBD_DBUF_T s_sDBuf;
+static uint32_t s_au32Buf0[MAX_PKT_SIZE / 4], s_au32Buf1[MAX_PKT_SIZE / 4];
+
+/* Packet n has length and data made from n */
+static uint32_t PacketLen(uint32_t n)
+{
+    return (n * 13) % (MAX_PKT_SIZE - 1) + 1;
+}
+
+static uint8_t PacketByte(uint32_t n, uint32_t i)
+{
+    return (uint8_t)(n * 31 + i * 7);
+}
+
+int main(void)
+{
+    uint32_t u32Step, u32Sent = 0, u32Consumed = 0, u32Len, u32Held = 0, i;
+    uint32_t u32Stalls = 0;
+    uint8_t *pu8Pkt = NULL, *pu8EpBuf;
+
+    HostMapPeripherals();
+
+    USBD_SET_EP_BUF_ADDR(TEST_EP, TEST_BUF_SEG);
+    pu8EpBuf = (uint8_t *)(uintptr_t)(USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(TEST_EP));
+    USBD_DBufOpen(&s_sDBuf, TEST_EP, (uint8_t *)s_au32Buf0, (uint8_t *)s_au32Buf1, MAX_PKT_SIZE);
+    srand(1261);
+
+    for(u32Step = 0; u32Step < TEST_STEPS; u32Step++)
+    {
+        switch(rand() % 3)
+        {
+            case 0:
+                /* USB host sends the next packet if the endpoint is armed, otherwise it is NAKed */
+                if(USBD_GET_PAYLOAD_LEN(TEST_EP) != MAX_PKT_SIZE)
+                {
+                    u32Stalls++;
+                    break;
+                }
+                u32Len = PacketLen(u32Sent);
+                for(i = 0; i < u32Len; i++)
+                    pu8EpBuf[i] = PacketByte(u32Sent, i);
+                USBD_SET_PAYLOAD_LEN(TEST_EP, u32Len);
+                u32Sent++;
+                USBD_DBufOutHandler(&s_sDBuf);
+                break;
+
+            case 1:
+                /* Main loop takes the oldest packet */
+                if(u32Held)
+                    break;
+                pu8Pkt = USBD_DBufGet(&s_sDBuf, &u32Len);
+                HOST_CHECK((pu8Pkt != NULL) == (u32Sent != u32Consumed));
+                if(pu8Pkt == NULL)
+                    break;
+                HOST_CHECK(u32Len == PacketLen(u32Consumed));
+                u32Held = 1;
+                break;
+
+            default:
+                /* Main loop is done with the packet. Its data must be unchanged. */
+                if(!u32Held)
+                    break;
+                for(i = 0; i < PacketLen(u32Consumed); i++)
+                    HOST_CHECK(pu8Pkt[i] == PacketByte(u32Consumed, i));
+                USBD_DBufRelease(&s_sDBuf);
+                u32Consumed++;
+                u32Held = 0;
+                break;
+        }
+
+        /* NAK only while both buffers hold packets */
+        HOST_CHECK(u32Sent - u32Consumed <= 2);
+        HOST_CHECK((USBD_GET_PAYLOAD_LEN(TEST_EP) == MAX_PKT_SIZE) == (u32Sent - u32Consumed < 2));
+        HOST_CHECK(g_u32HostPrimask == 0);
+    }
+
+    printf("USBD double buffer check passed: %u packets, %u NAKed attempts\n", u32Sent, u32Stalls);
+    return 0;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * @file     usbd_memcopy_check.c
+ * @version  V3.00
+ * @brief    Host check and benchmark of USBD_MemCopy word and byte paths
+ *
+ * @details  Copies every length from 0 to 200 bytes at every source and destination
+ *           offset 0 to 3 and checks the copied bytes and the guard bytes around them.
+ *           Then it times 64-byte packet copies by the old byte loop and by USBD_MemCopy,
+ *           aligned and unaligned, and prints bytes per ns of the host CPU. Only the ratio
+ *           between the paths is meaningful for the Cortex-M0.
+ *           Build with -DUSBD_MEMCOPY_PDMA to check the PDMA dispatch of USBD_MemCopy instead of
+ *           timing. A model of USBD_MemCopyPDMA copies the words, and fails every third call like
+ *           a busy scheduler, so the CPU fallback is checked too. The registers are plain memory
+ *           on the host, so the PDMA path can only be timed on target.
+ *           Build and run on the host PC:
+ *             gcc -O2 -I../../Library/Device/Nuvoton/NUC1261/Include -I../../Library/CMSIS/Include
+ *                 -I../../Library/StdDriver/inc usbd_memcopy_check.c -o usbd_memcopy_check
+ *           It returns non-zero if a check fails.
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <time.h>
+#include "host_shim.h"
+#include "NUC1261.h"
+
+#define MAX_LEN     200
+#define GUARD       8
+#define PKT_LEN     64          /* Full speed bulk max packet size */
+#define BENCH_LOOPS 2000000
+
+HOST_SHIM_DATA
+
+static uint32_t s_au32Src[(MAX_LEN + 2 * GUARD) / 4 + 1];
+static uint32_t s_au32Dest[(MAX_LEN + 2 * GUARD) / 4 + 1];
+
+#ifdef USBD_MEMCOPY_PDMA
+static uint32_t s_u32PdmaCalls, s_u32PdmaCopies;
+
+/* Model of the PDMA job copy */
+int32_t USBD_MemCopyPDMA(uint8_t *dest, uint8_t *src, int32_t size)
+{
+    HOST_CHECK(((((uintptr_t)dest) | ((uintptr_t)src)) & 3) == 0);
+    HOST_CHECK(size >= USBD_MEMCOPY_PDMA_MIN);
+
+    if((++s_u32PdmaCalls % 3) == 0)
+        return -1;
+
+    memcpy(dest, src, size & ~3);
+    s_u32PdmaCopies++;
+    return 0;
+}
+#endif
+
+/* USBD_MemCopy before the word path. Volatile keeps the host compiler from turning it into memcpy. */
+static void ByteCopy(uint8_t *dest, uint8_t *src, int32_t size)
+{
+    volatile uint8_t *pu8Dest = dest;
+
+    while(size-- > 0) *pu8Dest++ = *src++;
+}
+
+static void WordCopy(uint8_t *dest, uint8_t *src, int32_t size)
+{
+    USBD_MemCopy(dest, src, size);
+}
+
+/* Bytes per ns of one copy function */
+static double Bench(void (*pfnCopy)(uint8_t *, uint8_t *, int32_t), uint32_t u32Ofs)
+{
+    struct timespec sStart, sEnd;
+    uint8_t *pu8Src = (uint8_t *)s_au32Src, *pu8Dest = (uint8_t *)s_au32Dest;
+    uint32_t i;
+
+    clock_gettime(CLOCK_MONOTONIC, &sStart);
+    for(i = 0; i < BENCH_LOOPS; i++)
+    {
+        pfnCopy(pu8Dest + u32Ofs, pu8Src, PKT_LEN);
+        /* Keep the copy from being hoisted out of the loop */
+        __asm volatile("" ::: "memory");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &sEnd);
+
+    return (double)BENCH_LOOPS * PKT_LEN /
+           ((sEnd.tv_sec - sStart.tv_sec) * 1e9 + (sEnd.tv_nsec - sStart.tv_nsec));
+}
+
+int main(void)
+{
+    uint8_t *pu8Src = (uint8_t *)s_au32Src, *pu8Dest = (uint8_t *)s_au32Dest;
+    int32_t i32Len, i;
+    uint32_t u32SrcOfs, u32DestOfs;
+
+    for(i = 0; i < (int32_t)sizeof(s_au32Src); i++)
+        pu8Src[i] = (uint8_t)(i * 7 + 1);
+
+    for(i32Len = 0; i32Len <= MAX_LEN; i32Len++)
+    {
+        for(u32SrcOfs = 0; u32SrcOfs < 4; u32SrcOfs++)
+        {
+            for(u32DestOfs = 0; u32DestOfs < 4; u32DestOfs++)
+            {
+                memset(pu8Dest, 0xA5, sizeof(s_au32Dest));
+
+                USBD_MemCopy(pu8Dest + GUARD + u32DestOfs, pu8Src + GUARD + u32SrcOfs, i32Len);
+
+                for(i = 0; i < (int32_t)sizeof(s_au32Dest); i++)
+                {
+                    if((i >= GUARD + (int32_t)u32DestOfs) && (i < GUARD + (int32_t)u32DestOfs + i32Len))
+                        HOST_CHECK(pu8Dest[i] == pu8Src[i - u32DestOfs + u32SrcOfs]);
+                    else
+                        HOST_CHECK(pu8Dest[i] == 0xA5);
+                }
+            }
+        }
+    }
+
+    /* Negative size copies nothing */
+    memset(pu8Dest, 0xA5, sizeof(s_au32Dest));
+    USBD_MemCopy(pu8Dest, pu8Src, -1);
+    for(i = 0; i < (int32_t)sizeof(s_au32Dest); i++)
+        HOST_CHECK(pu8Dest[i] == 0xA5);
+
+#ifdef USBD_MEMCOPY_PDMA
+    /* Aligned copies of USBD_MEMCOPY_PDMA_MIN bytes or more went to PDMA, and some fell back to CPU */
+    printf("PDMA copies: %u of %u calls\n", s_u32PdmaCopies, s_u32PdmaCalls);
+    HOST_CHECK((s_u32PdmaCopies > 0) && (s_u32PdmaCopies < s_u32PdmaCalls));
+#else
+    printf("%d-byte packet copy     bytes/ns\n", PKT_LEN);
+    printf("Byte loop              %8.2f\n", Bench(ByteCopy, 0));
+    printf("USBD_MemCopy aligned   %8.2f\n", Bench(WordCopy, 0));
+    printf("USBD_MemCopy unaligned %8.2f\n", Bench(WordCopy, 1));
+#endif
+
+    printf("USBD_MemCopy check passed\n");
+    return 0;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,429 @@
+/******************************************************************************
+ * @file     isp_delta.c
+ * @brief    Host tool to make and check the patches of CMD_UPDATE_DELTA
+ * @version  0x31
+ *
+ * @note
+ * The patch is applied by ISP_UART and ISP_RS485 loaders built with ISP_DELTA_UPDATE = 1,
+ * see isp_user.h for the format. A security locked chip makes the new image in the pages at
+ * the top of APROM, so the pages of both images must fit in APROM. The patch is the same,
+ * copies read only the old image and the new pages already made.
+ * Build it on the host PC, e.g. "gcc -O2 -o isp_delta isp_delta.c" or "cl isp_delta.c".
+ *   isp_delta diff <old.bin> <new.bin> <patch.bin>     Make a patch and check it
+ *   isp_delta apply <old.bin> <patch.bin> <out.bin>    Apply a patch as the loader does
+ * The host sends the patch as the data of CMD_UPDATE_DELTA and the following data packets,
+ * then checks the new image by CMD_VERIFY_CRC32 if the chip is not locked. After any error
+ * it sends the whole new image by CMD_UPDATE_APROM.
+ * Copyright (C) 2019 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define PAGE_SIZE       2048            /* FMC_FLASH_PAGE_SIZE */
+#define MAX_IMAGE       (256 * 1024)
+#define HEADER_SIZE     20
+#define PACKET_DATA     56              /* Data bytes of a 64 bytes packet */
+#define HASH_SIZE       (1 << 16)
+#define MAX_CHAIN       64              /* Candidates checked for each output byte */
+#define MIN_GAIN        3               /* Bytes a copy must save over literal bytes */
+#define NO_POS          0xFFFFFFFF
+
+static uint8_t s_au8Old[MAX_IMAGE], s_au8New[MAX_IMAGE], s_au8Flash[MAX_IMAGE];
+static uint8_t s_au8Patch[HEADER_SIZE + MAX_IMAGE * 2];
+static uint32_t s_u32OldLen, s_u32NewLen, s_u32PatchLen;
+static uint32_t s_au32OldHead[HASH_SIZE], s_au32OldPrev[MAX_IMAGE];
+static uint32_t s_au32NewHead[HASH_SIZE], s_au32NewPrev[MAX_IMAGE];
+
+static uint32_t Crc32(const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t u32Crc = 0xFFFFFFFF, i;
+
+    while (u32Len--) {
+        u32Crc ^= *pu8Data++;
+
+        for (i = 0; i < 8; i++) {
+            u32Crc = (u32Crc >> 1) ^ (0xEDB88320 & (0 - (u32Crc & 1)));
+        }
+    }
+
+    return ~u32Crc;
+}
+
+static uint32_t GetWord(const uint8_t *pu8Data)
+{
+    return pu8Data[0] | (pu8Data[1] << 8) | (pu8Data[2] << 16) | ((uint32_t)pu8Data[3] << 24);
+}
+
+static void PutWord(uint8_t *pu8Data, uint32_t u32Data)
+{
+    pu8Data[0] = (uint8_t)u32Data;
+    pu8Data[1] = (uint8_t)(u32Data >> 8);
+    pu8Data[2] = (uint8_t)(u32Data >> 16);
+    pu8Data[3] = (uint8_t)(u32Data >> 24);
+}
+
+/* Read a file. Images are padded with 0xFF to word size as CMD_UPDATE_APROM programs them. */
+static int LoadFile(const char *pcName, uint8_t *pu8Buf, uint32_t u32Max, uint32_t *pu32Len, int bImage)
+{
+    FILE *fp;
+    size_t len;
+
+    if ((fp = fopen(pcName, "rb")) == NULL) {
+        printf("Cannot open %s\n", pcName);
+        return -1;
+    }
+
+    len = fread(pu8Buf, 1, u32Max, fp);
+
+    if (!feof(fp) || fgetc(fp) != EOF) {
+        printf("%s is larger than %u bytes\n", pcName, u32Max);
+        fclose(fp);
+        return -1;
+    }
+
+    fclose(fp);
+
+    if (bImage) {
+        while (len & 3) {
+            pu8Buf[len++] = 0xFF;
+        }
+
+        if (len == 0) {
+            printf("%s is empty\n", pcName);
+            return -1;
+        }
+    }
+
+    *pu32Len = (uint32_t)len;
+    return 0;
+}
+
+static int SaveFile(const char *pcName, const uint8_t *pu8Buf, uint32_t u32Len)
+{
+    FILE *fp;
+
+    if (((fp = fopen(pcName, "wb")) == NULL) || (fwrite(pu8Buf, 1, u32Len, fp) != u32Len)) {
+        printf("Cannot write %s\n", pcName);
+
+        if (fp) {
+            fclose(fp);
+        }
+
+        return -1;
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Apply a patch to s_au8Flash the same way as DeltaPutByte and DeltaParse of isp_user.c                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint8_t s_au8Page[PAGE_SIZE];
+static uint32_t s_u32Out, s_u32End, s_u32State, s_u32Var, s_u32Shift, s_u32Run, s_u32Src;
+
+static int ApplyPutByte(uint8_t u8Data)
+{
+    uint32_t u32Page;
+
+    if (s_u32Out >= s_u32NewLen) {
+        return -1;
+    }
+
+    s_au8Page[s_u32Out % PAGE_SIZE] = u8Data;
+    s_u32Out++;
+
+    if (((s_u32Out % PAGE_SIZE) == 0) || (s_u32Out == s_u32NewLen)) {
+        u32Page = (s_u32Out - 1) & ~(PAGE_SIZE - 1);
+        memset(&s_au8Page[s_u32Out - u32Page], 0xFF, u32Page + PAGE_SIZE - s_u32Out);
+        memcpy(&s_au8Flash[u32Page], s_au8Page, PAGE_SIZE);
+    }
+
+    return 0;
+}
+
+static int ApplyParse(uint8_t u8Data)
+{
+    uint32_t u32Var, u32Src;
+
+    if (s_u32State == 1) {
+        if (--s_u32Run == 0) {
+            s_u32State = 0;
+        }
+
+        return ApplyPutByte(u8Data);
+    }
+
+    s_u32Var |= (uint32_t)(u8Data & 0x7F) << s_u32Shift;
+    s_u32Shift += 7;
+
+    if (u8Data & 0x80) {
+        return (s_u32Shift < 32) ? 0 : -1;
+    }
+
+    u32Var = s_u32Var;
+    s_u32Var = 0;
+    s_u32Shift = 0;
+
+    if (s_u32State == 0) {
+        s_u32Run = u32Var >> 1;
+        s_u32State = (u32Var & 1) ? 2 : 1;
+        return (s_u32Run != 0) ? 0 : -1;
+    }
+
+    s_u32Src += (u32Var >> 1) ^ (0 - (u32Var & 1));
+    u32Src = s_u32Out + s_u32Src;
+    s_u32State = 0;
+
+    if ((u32Src >= s_u32End) || (s_u32Run > s_u32End - u32Src)) {
+        return -1;
+    }
+
+    for (; s_u32Run; s_u32Run--, u32Src++) {
+        if (ApplyPutByte(s_au8Flash[u32Src]) < 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Return the new image length, or 0 if the patch does not fit the old image */
+static uint32_t Apply(void)
+{
+    uint32_t u32Left, i;
+
+    if ((s_u32PatchLen < HEADER_SIZE) || (GetWord(s_au8Patch) != s_u32OldLen) ||
+            (GetWord(s_au8Patch + 4) != Crc32(s_au8Old, s_u32OldLen))) {
+        printf("Patch is not made for this old image\n");
+        return 0;
+    }
+
+    s_u32NewLen = GetWord(s_au8Patch + 8);
+    u32Left = GetWord(s_au8Patch + 16);
+    s_u32End = MAX_IMAGE;
+
+    if ((s_u32NewLen == 0) || (s_u32NewLen > MAX_IMAGE) || (s_u32NewLen & 3) || (u32Left != s_u32PatchLen - HEADER_SIZE)) {
+        printf("Bad patch header\n");
+        return 0;
+    }
+
+    /* The loader keeps the old image and erased pages after it */
+    memset(s_au8Flash, 0xFF, sizeof(s_au8Flash));
+    memcpy(s_au8Flash, s_au8Old, s_u32OldLen);
+    s_u32Out = s_u32State = s_u32Var = s_u32Shift = s_u32Src = 0;
+
+    for (i = 0; i < u32Left; i++) {
+        if (ApplyParse(s_au8Patch[HEADER_SIZE + i]) < 0) {
+            printf("Bad patch command at %u\n", i);
+            return 0;
+        }
+    }
+
+    if ((s_u32Out != s_u32NewLen) || (s_u32State != 0)) {
+        printf("Patch ends at %u of %u bytes\n", s_u32Out, s_u32NewLen);
+        return 0;
+    }
+
+    /* A locked chip checks this before it replaces the old image */
+    if (GetWord(s_au8Patch + 12) != Crc32(s_au8Flash, s_u32NewLen)) {
+        printf("New image does not match the CRC of the patch\n");
+        return 0;
+    }
+
+    return s_u32NewLen;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Make a patch                                                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t Hash(const uint8_t *pu8Data)
+{
+    return (GetWord(pu8Data) * 2654435761u) >> 16;
+}
+
+/* Flash byte at u32Addr when output byte u32Out is made, -1 if it is unknown */
+static int FlashByte(uint32_t u32Addr, uint32_t u32Out)
+{
+    if (u32Addr < (u32Out & ~(PAGE_SIZE - 1))) {
+        return s_au8New[u32Addr];
+    }
+
+    if (u32Addr < s_u32OldLen) {
+        return s_au8Old[u32Addr];
+    }
+
+    return -1;
+}
+
+static uint32_t MatchLen(uint32_t u32Src, uint32_t u32Out)
+{
+    uint32_t n = 0;
+
+    while ((u32Out + n < s_u32NewLen) && (FlashByte(u32Src + n, u32Out + n) == s_au8New[u32Out + n])) {
+        n++;
+    }
+
+    return n;
+}
+
+static uint32_t VarLen(uint32_t u32Var)
+{
+    uint32_t n = 1;
+
+    while (u32Var >= 0x80) {
+        u32Var >>= 7;
+        n++;
+    }
+
+    return n;
+}
+
+static uint32_t ZigZag(int32_t i32Delta)
+{
+    return ((uint32_t)i32Delta << 1) ^ (uint32_t)(i32Delta >> 31);
+}
+
+static void PutVar(uint32_t u32Var)
+{
+    while (u32Var >= 0x80) {
+        s_au8Patch[s_u32PatchLen++] = (uint8_t)(u32Var | 0x80);
+        u32Var >>= 7;
+    }
+
+    s_au8Patch[s_u32PatchLen++] = (uint8_t)u32Var;
+}
+
+static void PutLiteral(uint32_t u32Start, uint32_t u32End)
+{
+    if (u32End > u32Start) {
+        PutVar((u32End - u32Start) << 1);
+        memcpy(&s_au8Patch[s_u32PatchLen], &s_au8New[u32Start], u32End - u32Start);
+        s_u32PatchLen += u32End - u32Start;
+    }
+}
+
+/* Bytes saved by copying n bytes from u32Src to u32Out */
+static int32_t CopyGain(uint32_t u32Src, uint32_t u32Out, uint32_t n, int32_t i32Last)
+{
+    return (int32_t)n - (int32_t)VarLen((n << 1) | 1) - (int32_t)VarLen(ZigZag((int32_t)(u32Src - u32Out) - i32Last));
+}
+
+static void Diff(void)
+{
+    uint32_t u32Out, u32Literal, u32Indexed, u32Src, u32Best, u32BestLen, u32Chain, u32Pos, n, i;
+    int32_t i32Last, i32Gain, i32BestGain;
+
+    /* Old image positions, the latest is checked first */
+    memset(s_au32OldHead, 0xFF, sizeof(s_au32OldHead));
+    memset(s_au32NewHead, 0xFF, sizeof(s_au32NewHead));
+
+    for (i = 0; i + 4 <= s_u32OldLen; i++) {
+        s_au32OldPrev[i] = s_au32OldHead[Hash(&s_au8Old[i])];
+        s_au32OldHead[Hash(&s_au8Old[i])] = i;
+    }
+
+    s_u32PatchLen = HEADER_SIZE;
+    u32Out = u32Literal = u32Indexed = 0;
+    i32Last = 0;
+
+    while (u32Out < s_u32NewLen) {
+        /* New image positions become sources when their pages are programmed */
+        for (; u32Indexed + 4 <= (u32Out & ~(PAGE_SIZE - 1)); u32Indexed++) {
+            s_au32NewPrev[u32Indexed] = s_au32NewHead[Hash(&s_au8New[u32Indexed])];
+            s_au32NewHead[Hash(&s_au8New[u32Indexed])] = u32Indexed;
+        }
+
+        /* The offset of the last copy is the cheapest one */
+        u32Best = u32Out + i32Last;
+        u32BestLen = ((int64_t)u32Out + i32Last >= 0) ? MatchLen(u32Best, u32Out) : 0;
+        i32BestGain = CopyGain(u32Best, u32Out, u32BestLen, i32Last);
+
+        if (u32Out + 4 <= s_u32NewLen) {
+            for (i = 0; i < 2; i++) {
+                u32Pos = (i ? s_au32NewHead : s_au32OldHead)[Hash(&s_au8New[u32Out])];
+
+                for (u32Chain = 0; (u32Pos != NO_POS) && (u32Chain < MAX_CHAIN); u32Chain++) {
+                    u32Src = u32Pos;
+                    u32Pos = (i ? s_au32NewPrev : s_au32OldPrev)[u32Pos];
+                    n = MatchLen(u32Src, u32Out);
+                    i32Gain = CopyGain(u32Src, u32Out, n, i32Last);
+
+                    if (i32Gain > i32BestGain) {
+                        u32Best = u32Src;
+                        u32BestLen = n;
+                        i32BestGain = i32Gain;
+                    }
+                }
+            }
+        }
+
+        if (i32BestGain < MIN_GAIN) {
+            u32Out++;
+            continue;
+        }
+
+        PutLiteral(u32Literal, u32Out);
+        PutVar((u32BestLen << 1) | 1);
+        PutVar(ZigZag((int32_t)(u32Best - u32Out) - i32Last));
+        i32Last = (int32_t)(u32Best - u32Out);
+        u32Out += u32BestLen;
+        u32Literal = u32Out;
+    }
+
+    PutLiteral(u32Literal, s_u32NewLen);
+
+    PutWord(s_au8Patch, s_u32OldLen);
+    PutWord(s_au8Patch + 4, Crc32(s_au8Old, s_u32OldLen));
+    PutWord(s_au8Patch + 8, s_u32NewLen);
+    PutWord(s_au8Patch + 12, Crc32(s_au8New, s_u32NewLen));
+    PutWord(s_au8Patch + 16, s_u32PatchLen - HEADER_SIZE);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t u32NewLen;
+
+    if ((argc != 5) || (strcmp(argv[1], "diff") && strcmp(argv[1], "apply"))) {
+        printf("Usage: isp_delta diff <old.bin> <new.bin> <patch.bin>\n");
+        printf("       isp_delta apply <old.bin> <patch.bin> <out.bin>\n");
+        return 1;
+    }
+
+    if (LoadFile(argv[2], s_au8Old, MAX_IMAGE, &s_u32OldLen, 1) < 0) {
+        return 1;
+    }
+
+    if (strcmp(argv[1], "diff") == 0) {
+        if (LoadFile(argv[3], s_au8New, MAX_IMAGE, &s_u32NewLen, 1) < 0) {
+            return 1;
+        }
+
+        Diff();
+        u32NewLen = s_u32NewLen;
+
+        /* Check the patch by the loader model */
+        if ((Apply() != u32NewLen) || memcmp(s_au8Flash, s_au8New, u32NewLen)) {
+            printf("Patch check failed\n");
+            return 1;
+        }
+
+        if (SaveFile(argv[4], s_au8Patch, s_u32PatchLen) < 0) {
+            return 1;
+        }
+    } else {
+        if ((LoadFile(argv[3], s_au8Patch, sizeof(s_au8Patch), &s_u32PatchLen, 0) < 0) ||
+                ((u32NewLen = Apply()) == 0) || (SaveFile(argv[4], s_au8Flash, u32NewLen) < 0)) {
+            return 1;
+        }
+    }
+
+    printf("Old image %u bytes, CRC32 0x%08X\n", s_u32OldLen, Crc32(s_au8Old, s_u32OldLen));
+    printf("New image %u bytes, CRC32 0x%08X\n", u32NewLen, Crc32(s_au8Flash, u32NewLen));
+    printf("Patch     %u bytes (%u%%), %u packets\n", s_u32PatchLen, s_u32PatchLen * 100 / u32NewLen,
+           (s_u32PatchLen + PACKET_DATA - 1) / PACKET_DATA);
+    return 0;
+}
@@ -47,6 +47,59 @@ int FMC_Proc(unsigned int u32Cmd, unsigned int addr_start, unsigned int addr_end
     return 0;
 }
 
+/* Standard CRC-32 (IEEE 802.3, reflected, seed and final XOR 0xFFFFFFFF) of flash by CRC engine.
+   Returns -1 if a word cannot be read. */
+int FMC_CRC32_User(unsigned int addr_start, unsigned int addr_end, unsigned int *crc)
+{
+    unsigned int u32Data, i;
+
+    CLK->AHBCLK |= CLK_AHBCLK_CRCCKEN_Msk;
+    CRC->SEED = 0xFFFFFFFF;
+    CRC->CTL = CRC_32 | CRC_WDATA_RVS | CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM | CRC_CPU_WDATA_8 | CRC_CTL_CRCEN_Msk;
+    CRC->CTL |= CRC_CTL_CHKSINIT_Msk;
+
+    for (; addr_start < addr_end; addr_start += 4) {
+        if (FMC_Read_User(addr_start, &u32Data) < 0) {
+            return -1;
+        }
+
+        for (i = 0; i < 4; i++) {
+            CRC->DAT = u32Data & 0xFF;
+            u32Data >>= 8;
+        }
+    }
+
+    *crc = CRC->CHECKSUM;
+    return 0;
+}
+
+/* Hardware checksum of FMC. Address and size must be page aligned. */
+unsigned int FMC_GetChecksum_User(unsigned int addr_start, unsigned int size)
+{
+    FMC->ISPCMD = FMC_ISPCMD_CAL_CHECKSUM;
+    FMC->ISPADDR = addr_start;
+    FMC->ISPDAT = size;
+    FMC->ISPTRG = 0x1;
+    __ISB();
+
+    while (FMC->ISPTRG & 0x1) ;
+
+    FMC->ISPCMD = FMC_ISPCMD_CHECKSUM;
+    FMC->ISPADDR = addr_start;
+    FMC->ISPDAT = size;
+    FMC->ISPTRG = 0x1;
+    __ISB();
+
+    while (FMC->ISPTRG & 0x1) ;
+
+    if (FMC->ISPCTL & FMC_ISPCTL_ISPFF_Msk) {
+        FMC->ISPCTL |= FMC_ISPCTL_ISPFF_Msk;
+        return 0;
+    }
+
+    return FMC->ISPDAT;
+}
+
 void UpdateConfig(unsigned int *data, unsigned int *res)
 {
     unsigned int u32Size = CONFIG_SIZE;
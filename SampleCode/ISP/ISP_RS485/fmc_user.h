@@ -55,6 +55,8 @@ extern int FMC_Proc(unsigned int u32Cmd, unsigned int addr_start, unsigned int a
 #define EraseAP(addr_start, size) (FMC_Proc(FMC_ISPCMD_PAGE_ERASE, addr_start, (addr_start) + (size), NULL))
 
 extern void UpdateConfig(unsigned int *data, unsigned int *res);
+extern int FMC_CRC32_User(unsigned int addr_start, unsigned int addr_end, unsigned int *crc);
+extern unsigned int FMC_GetChecksum_User(unsigned int addr_start, unsigned int size);
 
 #endif
 
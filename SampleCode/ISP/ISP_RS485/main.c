@@ -71,6 +71,8 @@ void SYS_Init(void)
 /*---------------------------------------------------------------------------------------------------------*/
 int32_t main(void)
 {
+    uint8_t *pu8Pkt;
+
     /* Unlock protected registers */
     SYS_UnlockReg();
     
@@ -109,6 +111,7 @@ int32_t main(void)
             } else {
                 bUartDataReady = FALSE;
                 bufhead = 0;
+                bufidx = 0;
             }
         }
 
@@ -126,8 +129,15 @@ int32_t main(void)
             WDT->CTL &= ~(WDT_CTL_WDTEN_Msk | WDT_CTL_ICEDEBUG_Msk);
             WDT->CTL |= (WDT_TIMEOUT_2POW18 | WDT_CTL_RSTEN_Msk);
             
+            __set_PRIMASK(1);
+            pu8Pkt = pu8UartPkt;            /* Get received packet */
             bUartDataReady = FALSE;;        /* Reset UART data ready flag */     
-            ParseCmd(uart_rcvbuf, 64);      /* Parse command from master */  
+            __set_PRIMASK(0);
+
+            if (ParseCmd(pu8Pkt, 64) == ISP_RESP_HOLD) {
+                continue;                   /* No response inside data window */
+            }
+
             NVIC_DisableIRQ(UART_T_IRQn);   /* Disable NVIC */
             nRTSPin = TRANSMIT_MODE;        /* Control RTS in transmit mode */
             PutString();                    /* Send response to master */
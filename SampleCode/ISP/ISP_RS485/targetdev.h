@@ -7,7 +7,7 @@
  * Copyright (C) 2019 Nuvoton Technology Corp. All rights reserved.
  ******************************************************************************/
 #include "NUC1261.h"
-#include "ISP_USER.h"
+#include "isp_user.h"
 
 
 /* rename for uart_transfer.c */
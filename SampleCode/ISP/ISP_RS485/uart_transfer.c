@@ -12,10 +12,13 @@
 #include "targetdev.h"
 #include "uart_transfer.h"
 
-__align(4) uint8_t  uart_rcvbuf[MAX_PKT_SIZE] = {0};
+/* Two packet buffers. Next packet is received while previous one is programmed. */
+__align(4) uint8_t  uart_rcvbuf[MAX_PKT_SIZE * 2] = {0};
 
 uint8_t volatile bUartDataReady = 0;
 uint8_t volatile bufhead = 0;
+uint8_t volatile bufidx = 0;                    /* Half of uart_rcvbuf being received */
+uint8_t *volatile pu8UartPkt = uart_rcvbuf;     /* Last received packet */
 
 
 /* please check "targetdev.h" for chip specifc define option */
@@ -33,12 +36,14 @@ void UART_T_IRQHandler(void)
         
         /* Read data until RX FIFO is empty or data is over maximum packet size */
         while (((UART_T->FIFOSTS & UART_FIFOSTS_RXEMPTY_Msk) == 0) && (bufhead < MAX_PKT_SIZE)) {	
-            uart_rcvbuf[bufhead++] = UART_T->DAT;
+            uart_rcvbuf[bufidx * MAX_PKT_SIZE + bufhead++] = UART_T->DAT;
         }
     }
 
     /* Reset data buffer index */      
     if (bufhead == MAX_PKT_SIZE) {
+        pu8UartPkt = &uart_rcvbuf[bufidx * MAX_PKT_SIZE];
+        bufidx ^= 1;
         bUartDataReady = TRUE;
         bufhead = 0;
     } else if (u32IntSrc & UART_INTSTS_RXTOIF_Msk) {
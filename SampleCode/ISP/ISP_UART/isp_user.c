@@ -31,9 +31,159 @@ __STATIC_INLINE uint16_t Checksum(unsigned char *buf, int len)
     return (c);
 }
 
+/* Range lies inside APROM or inside data flash */
+static int IsFlashRange(uint32_t u32Start, uint32_t u32Size)
+{
+    uint32_t u32ApromEnd = (g_apromSize < g_dataFlashAddr) ? g_apromSize : g_dataFlashAddr;
+
+    if ((u32Size == 0) || ((u32Start | u32Size) & 3) || (u32Start + u32Size < u32Start)) {
+        return FALSE;
+    }
+
+    if (u32Start + u32Size <= u32ApromEnd) {
+        return TRUE;
+    }
+
+    return (u32Start >= g_dataFlashAddr) && (u32Start + u32Size <= g_dataFlashAddr + g_dataFlashSize);
+}
+
+#if ISP_DELTA_UPDATE
+/* State of CMD_UPDATE_DELTA. aprom_buf holds the page being made. */
+#define DELTA_ST_HEADER     0
+#define DELTA_ST_LITERAL    1
+#define DELTA_ST_OFFSET     2
+
+static uint32_t s_u32DeltaStatus = ISP_DELTA_ERR_PATCH;
+static uint32_t s_u32DeltaOldLen, s_u32DeltaNewLen, s_u32DeltaNewCrc, s_u32DeltaEnd, s_u32DeltaStage, s_u32DeltaLeft, s_u32DeltaOut;
+static uint32_t s_u32DeltaState, s_u32DeltaVar, s_u32DeltaShift, s_u32DeltaRun, s_u32DeltaSrc;
+
+#define DELTA_PAGES(len)    (((len) + FMC_FLASH_PAGE_SIZE - 1) & ~(FMC_FLASH_PAGE_SIZE - 1))
+
+/* Put a byte of the new image. A page is programmed when it is complete, at s_u32DeltaStage if staged. */
+static int DeltaPutByte(uint8_t u8Data)
+{
+    uint32_t u32Page;
+
+    if (s_u32DeltaOut >= s_u32DeltaNewLen) {
+        return -1;
+    }
+
+    aprom_buf[s_u32DeltaOut % FMC_FLASH_PAGE_SIZE] = u8Data;
+    s_u32DeltaOut++;
+
+    if (((s_u32DeltaOut % FMC_FLASH_PAGE_SIZE) == 0) || (s_u32DeltaOut == s_u32DeltaNewLen)) {
+        u32Page = (s_u32DeltaOut - 1) & ~(FMC_FLASH_PAGE_SIZE - 1);
+        memset(&aprom_buf[s_u32DeltaOut - u32Page], 0xFF, u32Page + FMC_FLASH_PAGE_SIZE - s_u32DeltaOut);
+
+        u32Page += s_u32DeltaStage;
+
+        if ((FMC_Erase_User(u32Page) < 0) || (WriteData(u32Page, u32Page + FMC_FLASH_PAGE_SIZE, (uint32_t *)aprom_buf) < 0)) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Parse a byte of patch commands */
+static int DeltaParse(uint8_t u8Data)
+{
+    uint32_t u32Var, u32Src, u32Addr, u32Data;
+
+    if (s_u32DeltaState == DELTA_ST_LITERAL) {
+        if (--s_u32DeltaRun == 0) {
+            s_u32DeltaState = DELTA_ST_HEADER;
+        }
+
+        return DeltaPutByte(u8Data);
+    }
+
+    s_u32DeltaVar |= (uint32_t)(u8Data & 0x7F) << s_u32DeltaShift;
+    s_u32DeltaShift += 7;
+
+    if (u8Data & 0x80) {
+        return (s_u32DeltaShift < 32) ? 0 : -1;
+    }
+
+    u32Var = s_u32DeltaVar;
+    s_u32DeltaVar = 0;
+    s_u32DeltaShift = 0;
+
+    if (s_u32DeltaState == DELTA_ST_HEADER) {
+        s_u32DeltaRun = u32Var >> 1;
+        s_u32DeltaState = (u32Var & 1) ? DELTA_ST_OFFSET : DELTA_ST_LITERAL;
+        return (s_u32DeltaRun != 0) ? 0 : -1;
+    }
+
+    /* Copy s_u32DeltaRun bytes. Source offset to output is kept by s_u32DeltaSrc. */
+    s_u32DeltaSrc += (u32Var >> 1) ^ (0 - (u32Var & 1));
+    u32Src = s_u32DeltaOut + s_u32DeltaSrc;
+    s_u32DeltaState = DELTA_ST_HEADER;
+
+    if ((u32Src >= s_u32DeltaEnd) || (s_u32DeltaRun > s_u32DeltaEnd - u32Src)) {
+        return -1;
+    }
+
+    for (; s_u32DeltaRun; s_u32DeltaRun--, u32Src++) {
+        /* Pages of the new image already made are in the staging area. The old image ends below it. */
+        u32Addr = u32Src;
+
+        if (u32Src < (s_u32DeltaOut & ~(FMC_FLASH_PAGE_SIZE - 1))) {
+            u32Addr += s_u32DeltaStage;
+        } else if (s_u32DeltaStage && (u32Src >= s_u32DeltaStage)) {
+            return -1;
+        }
+
+        if ((FMC_Read_User(u32Addr & ~3ul, &u32Data) < 0) || (DeltaPutByte((uint8_t)(u32Data >> ((u32Addr & 3) * 8))) < 0)) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* A locked chip tells nothing about its image. A failed CRC check erases APROM like CMD_UPDATE_APROM. */
+static uint32_t DeltaWipe(uint32_t u32Status)
+{
+    EraseAP(FMC_APROM_BASE, s_u32DeltaEnd);
+    bUpdateApromCmd = TRUE;
+    return u32Status;
+}
+
+/* Complete the new image. A staged image must match the new CRC before it replaces the old one. */
+static uint32_t DeltaFinish(void)
+{
+    uint32_t u32NewEnd = DELTA_PAGES(s_u32DeltaNewLen), u32Addr, u32Crc;
+
+    if (s_u32DeltaStage) {
+        if ((FMC_CRC32_User(s_u32DeltaStage, s_u32DeltaStage + s_u32DeltaNewLen, &u32Crc) < 0) || (u32Crc != s_u32DeltaNewCrc)) {
+            return DeltaWipe(ISP_DELTA_ERR_IMAGE);
+        }
+
+        for (u32Addr = 0; u32Addr < u32NewEnd; u32Addr += FMC_FLASH_PAGE_SIZE) {
+            if ((ReadData(s_u32DeltaStage + u32Addr, s_u32DeltaStage + u32Addr + FMC_FLASH_PAGE_SIZE, (uint32_t *)aprom_buf) < 0) ||
+                    (FMC_Erase_User(u32Addr) < 0) || (WriteData(u32Addr, u32Addr + FMC_FLASH_PAGE_SIZE, (uint32_t *)aprom_buf) < 0)) {
+                return DeltaWipe(ISP_DELTA_ERR_IMAGE);
+            }
+        }
+
+        EraseAP(s_u32DeltaStage, s_u32DeltaEnd - s_u32DeltaStage);
+    }
+
+    /* Erase the pages of the old image after the new one */
+    if (s_u32DeltaOldLen > u32NewEnd) {
+        EraseAP(u32NewEnd, s_u32DeltaOldLen - u32NewEnd);
+    }
+
+    return ISP_DELTA_DONE;
+}
+#endif
+
 int ParseCmd(unsigned char *buffer, uint8_t len)
 {
     static uint32_t StartAddress, TotalLen, LastDataLen, g_packno = 1;
+    static uint32_t u32Window = 1, u32WindowCnt = 0, u32Option = 0;
+    static uint16_t u16WindowSum = 0;
     uint8_t *response;
     uint16_t lcksum;
     uint32_t lcmd, srclen, i, regcnf0, security;
@@ -83,7 +233,82 @@ int ParseCmd(unsigned char *buffer, uint8_t len)
         while (1);
     } else if (lcmd == CMD_CONNECT) {
         g_packno = 1;
+        u32Window = 1;
+        u32Option = 0;
+        goto out;
+    } else if (lcmd == CMD_SET_WINDOW) {
+        /* Old host tools never send it and keep one response per packet */
+        u32Window = inpw(pSrc);
+
+        if (u32Window > ISP_MAX_WINDOW) {
+            u32Window = ISP_MAX_WINDOW;
+        } else if (u32Window == 0) {
+            u32Window = 1;
+        }
+
+        u32Option = inpw(pSrc + 4) & ISP_OPT_NO_READBACK;
+        outpw(response + 8, u32Window);
+        outpw(response + 12, u32Option);
         goto out;
+    } else if (lcmd == CMD_VERIFY_CRC32) {
+        uint32_t u32Start, u32Size, u32Crc;
+
+        u32Start = inpw(pSrc);
+        u32Size = inpw(pSrc + 4);
+        outpw(response + 8, 0);
+        outpw(response + 12, 0);
+
+        if ((security == 0) && (!bUpdateApromCmd)) { //security lock
+            outpw(response + 16, ISP_VERIFY_LOCKED);
+        } else if (!IsFlashRange(u32Start, u32Size)) {
+            outpw(response + 16, ISP_VERIFY_RANGE);
+        } else if (FMC_CRC32_User(u32Start, u32Start + u32Size, &u32Crc) < 0) {
+            outpw(response + 16, ISP_VERIFY_READ);
+        } else {
+            outpw(response + 8, u32Crc);
+
+            /* FMC checksum needs page alignment */
+            if (((u32Start | u32Size) & (FMC_FLASH_PAGE_SIZE - 1)) == 0) {
+                outpw(response + 12, FMC_GetChecksum_User(u32Start, u32Size));
+            }
+
+            outpw(response + 16, ISP_VERIFY_OK);
+        }
+
+        goto out;
+#if ISP_DELTA_UPDATE
+    } else if (lcmd == CMD_UPDATE_DELTA) {
+        uint32_t u32Crc;
+
+        s_u32DeltaOldLen = inpw(pSrc);
+        s_u32DeltaNewLen = inpw(pSrc + 8);
+        s_u32DeltaNewCrc = inpw(pSrc + 12);
+        s_u32DeltaLeft = inpw(pSrc + 16);
+        s_u32DeltaEnd = (g_apromSize < g_dataFlashAddr) ? g_apromSize : g_dataFlashAddr;
+        s_u32DeltaStatus = ISP_DELTA_ERR_BASE;
+
+        /* A locked chip makes the new image at the top of APROM and checks it before the old image is replaced */
+        i = ((security == 0) && (!bUpdateApromCmd)) ? DELTA_PAGES(s_u32DeltaNewLen) : 0;
+
+        if ((s_u32DeltaOldLen != 0) && (s_u32DeltaOldLen <= s_u32DeltaEnd) && (s_u32DeltaNewLen != 0) && (s_u32DeltaNewLen <= s_u32DeltaEnd) &&
+                (((s_u32DeltaOldLen | s_u32DeltaNewLen) & 3) == 0) && (DELTA_PAGES(s_u32DeltaOldLen) + i <= s_u32DeltaEnd)) {
+            s_u32DeltaStage = i ? (s_u32DeltaEnd - i) : 0;
+
+            if ((FMC_CRC32_User(FMC_APROM_BASE, s_u32DeltaOldLen, &u32Crc) == 0) && (u32Crc == inpw(pSrc + 4))) {
+                s_u32DeltaOut = 0;
+                s_u32DeltaSrc = 0;
+                s_u32DeltaState = DELTA_ST_HEADER;
+                s_u32DeltaVar = 0;
+                s_u32DeltaShift = 0;
+                s_u32DeltaStatus = ISP_DELTA_BUSY;
+            } else if (s_u32DeltaStage) {
+                s_u32DeltaStatus = DeltaWipe(ISP_DELTA_ERR_BASE);
+            }
+        }
+
+        pSrc += 20;
+        srclen -= 20;
+#endif
     } else if ((lcmd == CMD_UPDATE_APROM) || (lcmd == CMD_ERASE_ALL)) {
         EraseAP(FMC_APROM_BASE, (g_apromSize < g_dataFlashAddr) ? g_apromSize : g_dataFlashAddr); // erase APROM // g_dataFlashAddr, g_apromSize
 
@@ -149,19 +374,72 @@ int ParseCmd(unsigned char *buffer, uint8_t len)
 
         TotalLen -= srclen;
         WriteData(StartAddress, StartAddress + srclen, (uint32_t *)pSrc);
-        memset(pSrc, 0, srclen);
-        ReadData(StartAddress, StartAddress + srclen, (uint32_t *)pSrc);
+
+        if ((u32Option & ISP_OPT_NO_READBACK) == 0) {
+            memset(pSrc, 0, srclen);
+            ReadData(StartAddress, StartAddress + srclen, (uint32_t *)pSrc);
+        }
+
         StartAddress += srclen;
-        LastDataLen =  srclen;
+        /* Resend rolls back all data packets since last response */
+        LastDataLen = (u32WindowCnt ? LastDataLen : 0) + srclen;
+#if ISP_DELTA_UPDATE
+    } else if (gcmd == CMD_UPDATE_DELTA) {
+        if (s_u32DeltaStatus == ISP_DELTA_BUSY) {
+            if (s_u32DeltaLeft < srclen) {
+                srclen = s_u32DeltaLeft;
+            }
+
+            s_u32DeltaLeft -= srclen;
+
+            for (i = 0; i < srclen; i++) {
+                if (DeltaParse(pSrc[i]) < 0) {
+                    s_u32DeltaStatus = ISP_DELTA_ERR_PATCH;
+                    break;
+                }
+            }
+
+            if ((s_u32DeltaStatus == ISP_DELTA_BUSY) && (s_u32DeltaLeft == 0)) {
+                if ((s_u32DeltaOut == s_u32DeltaNewLen) && (s_u32DeltaState == DELTA_ST_HEADER)) {
+                    s_u32DeltaStatus = DeltaFinish();
+                } else {
+                    s_u32DeltaStatus = ISP_DELTA_ERR_PATCH;
+                }
+            }
+
+            /* The old image is still in place, drop the staged pages */
+            if ((s_u32DeltaStatus == ISP_DELTA_ERR_PATCH) && s_u32DeltaStage) {
+                EraseAP(s_u32DeltaStage, s_u32DeltaEnd - s_u32DeltaStage);
+            }
+        }
+
+        outpw(response + 8, s_u32DeltaStatus);
+        outpw(response + 12, s_u32DeltaOut);
+#endif
     }
 
 out:
     lcksum = Checksum(buffer, len);
+
+    if ((lcmd == 0) && ((gcmd == CMD_UPDATE_APROM) || (gcmd == CMD_UPDATE_DATAFLASH))) {
+        /* Acknowledge the window by one response carrying the sum of packet checksums */
+        u16WindowSum += lcksum;
+
+        if ((++u32WindowCnt < u32Window) && TotalLen) {
+            g_packno += 2;
+            return ISP_RESP_HOLD;
+        }
+
+        lcksum = u16WindowSum;
+    }
+
+    u32WindowCnt = 0;
+    u16WindowSum = 0;
     outps(response, lcksum);
     ++g_packno;
     outpw(response + 4, g_packno);
     g_packno++;
-    return 0;
+    return ISP_RESP_SEND;
 }
 
 /*** (C) COPYRIGHT 2019 Nuvoton Technology Corp. ***/
@@ -9,7 +9,7 @@
 #ifndef ISP_USER_H
 #define ISP_USER_H
 
-#define FW_VERSION 0x34
+#define FW_VERSION 0x35
 
 #include "fmc_user.h"
 #include <string.h>
@@ -25,9 +25,62 @@
 #define CMD_RESET             0x000000AD
 #define CMD_CONNECT           0x000000AE
 #define CMD_GET_DEVICEID      0x000000B1
+#define CMD_SET_WINDOW        0x000000B4
+#define CMD_VERIFY_CRC32      0x000000B5
+#define CMD_UPDATE_DELTA      0x000000B6
 #define CMD_UPDATE_DATAFLASH  0x000000C3
 #define CMD_RESEND_PACKET     0x000000FF
 
+/* Number of data packets acknowledged by one response. Host negotiates it by CMD_SET_WINDOW. */
+#define ISP_MAX_WINDOW        8
+
+/* Option flags of CMD_SET_WINDOW */
+#define ISP_OPT_NO_READBACK   0x00000001  /* Skip per packet read back. Host verifies image by CMD_VERIFY_CRC32. */
+
+/* Status of CMD_VERIFY_CRC32 at response +16. CRC and checksum are 0 unless it is ISP_VERIFY_OK. */
+#define ISP_VERIFY_OK         0
+#define ISP_VERIFY_LOCKED     1   /* Security locked and no APROM update in this session */
+#define ISP_VERIFY_RANGE      2   /* Not word aligned, empty, wraps, or not inside APROM or data flash */
+#define ISP_VERIFY_READ       3   /* Flash read failed */
+
+/*
+    CMD_UPDATE_DELTA needs the patch decoder in the loader. Its LDROM size has not been measured,
+    so it is off by default. Set ISP_DELTA_UPDATE to 1 only after a build with it is checked to still
+    fit in LDROM. Without it the command is ignored and the host falls back to CMD_UPDATE_APROM.
+*/
+#ifndef ISP_DELTA_UPDATE
+#define ISP_DELTA_UPDATE      0
+#endif
+
+/*
+    CMD_UPDATE_DELTA rebuilds APROM from the installed image and a patch.
+    The patch is sent as the data of CMD_UPDATE_DELTA and the following data packets:
+      +0  old image length, +4 CRC-32 of the old image, +8 new image length, +12 CRC-32 of the new
+      image, +16 length of the commands, +20 commands. Image lengths are word aligned and not 0.
+    An unlocked chip, or a locked one after CMD_UPDATE_APROM in this session, makes the new image
+    page by page in place. The host verifies it by CMD_VERIFY_CRC32.
+    A locked chip makes the new image in the pages at the top of APROM, checks its CRC, then copies
+    it down and erases the staging pages. CMD_VERIFY_CRC32 stays refused. The pages of the old and
+    the new image together must fit in APROM, otherwise it is refused and the host has to use
+    CMD_UPDATE_APROM. Whatever was kept at the top of APROM is erased.
+    A locked chip erases APROM when the old or the new image does not match its CRC.
+    A command starts with a LEB128 varint h. If bit 0 of h is 0, h >> 1 literal bytes follow.
+    If bit 0 is 1, h >> 1 bytes are copied from flash, and a zigzag coded varint follows which
+    changes the offset of the copy source to the output. A source read while output byte n is made
+    gives the new image below the page of n and the old image from the page of n on.
+    Each packet is responded with the status at +8 and the new image bytes made at +12.
+    Resend is not supported, the host updates APROM by CMD_UPDATE_APROM after an error.
+*/
+#define ISP_DELTA_BUSY        0x00000000  /* Patch accepted so far */
+#define ISP_DELTA_DONE        0x00000001  /* New image complete */
+#define ISP_DELTA_ERR_BASE    0x80000001  /* Old image does not match or does not fit. APROM is erased if locked. */
+#define ISP_DELTA_ERR_PATCH   0x80000002  /* Bad patch or flash error. Only a staged update keeps the old image. */
+#define ISP_DELTA_ERR_IMAGE   0x80000003  /* Staged image does not match the new CRC. APROM is erased. */
+
+/* Return value of ParseCmd */
+#define ISP_RESP_SEND         0   /* Send response_buff to host */
+#define ISP_RESP_HOLD         1   /* Data packet inside window. No response. */
+
 #define V6M_AIRCR_VECTKEY_DATA    0x05FA0000UL
 #define V6M_AIRCR_SYSRESETREQ     0x00000004UL
 
@@ -63,6 +63,8 @@ void SYS_Init(void)
 /*---------------------------------------------------------------------------------------------------------*/
 int32_t main(void)
 {
+    uint8_t *pu8Pkt;
+
     /* Unlock protected registers */
     SYS_UnlockReg();
     
@@ -101,6 +103,7 @@ int32_t main(void)
             } else {
                 bUartDataReady = FALSE;
                 bufhead = 0;
+                bufidx = 0;
             }
         }
 
@@ -115,9 +118,14 @@ int32_t main(void)
         if (bUartDataReady == TRUE) {
             WDT->CTL &= ~(WDT_CTL_WDTEN_Msk | WDT_CTL_ICEDEBUG_Msk);
             WDT->CTL |= (WDT_TIMEOUT_2POW18 | WDT_CTL_RSTEN_Msk);
+            __set_PRIMASK(1);
+            pu8Pkt = pu8UartPkt;
             bUartDataReady = FALSE;
-            ParseCmd(uart_rcvbuf, 64);
-            PutString();
+            __set_PRIMASK(0);
+
+            if (ParseCmd(pu8Pkt, 64) == ISP_RESP_SEND) {
+                PutString();
+            }
         }
     }
 
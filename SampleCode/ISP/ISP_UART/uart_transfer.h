@@ -20,6 +20,8 @@
 extern uint8_t  uart_rcvbuf[];
 extern uint8_t volatile bUartDataReady;
 extern uint8_t volatile bufhead;
+extern uint8_t volatile bufidx;
+extern uint8_t *volatile pu8UartPkt;
 
 /*-------------------------------------------------------------*/
 void UART_Init(void);
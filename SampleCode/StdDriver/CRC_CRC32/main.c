@@ -3,7 +3,7 @@
  * @version  V3.00
  * $Revision: 2 $
  * $Date: 16/10/25 4:28p $
- * @brief    Implement CRC in CRC-32 mode with PDMA transfer.
+ * @brief    Implement CRC in CRC-32 mode with CPU and PDMA transfer by CRC_Calculate.
  * @note
  * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
  ******************************************************************************/
@@ -41,6 +41,7 @@ void SYS_Init(void)
     /* Enable peripheral clock */
     CLK_EnableModuleClock(UART0_MODULE);
     CLK_EnableModuleClock(CRC_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
 
     /* Peripheral clock source */
     CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_PLL, CLK_CLKDIV0_UART(1));
@@ -75,52 +76,9 @@ uint32_t GetFMCChecksum(uint32_t u32Address, uint32_t u32Size)
     return u32CHKS;
 }
 
-typedef struct dma_desc_t
+void PDMA_IRQHandler(void)
 {
-    uint32_t ctl;
-    uint32_t src;
-    uint32_t dest;
-    uint32_t offset;
-} DMA_DESC_T;
-DMA_DESC_T DMA_DESC[1];
-
-uint32_t GetPDMAChecksum(uint32_t u32Address, uint32_t u32Size)
-{
-    volatile uint32_t loop = 0;
-
-    /* Enable PDMA module clock */
-    CLK->AHBCLK |= CLK_AHBCLK_PDMACKEN_Msk;
-
-    /* Give valid source address and transfer count and program PDMA memory to memory, dest => CRC_WDATA */
-    PDMA->CHCTL = (1 << 0); // use PDMA CH0
-    DMA_DESC[0].ctl =
-        (1 << PDMA_DSCT_CTL_OPMODE_Pos)  | (0 << PDMA_DSCT_CTL_TXTYPE_Pos) |
-        (7 << PDMA_DSCT_CTL_BURSIZE_Pos) |
-        (0 << PDMA_DSCT_CTL_SAINC_Pos)   | (3 << PDMA_DSCT_CTL_DAINC_Pos) |
-        (2 << PDMA_DSCT_CTL_TXWIDTH_Pos) | (((u32Size / 4) - 1) << PDMA_DSCT_CTL_TXCNT_Pos);
-    DMA_DESC[0].src = (uint32_t)u32Address;
-    DMA_DESC[0].dest = (uint32_t) & (CRC->DAT);
-    DMA_DESC[0].offset = 0;
-
-    PDMA->DSCT[0].CTL = PDMA_OP_SCATTER;
-    PDMA->DSCT[0].NEXT = (uint32_t)&DMA_DESC[0] - (PDMA->SCATBA);
-
-    PDMA->INTSTS = PDMA->INTSTS;
-    PDMA->INTEN = (1 << 0);
-
-    /* Trigger PDMA CH0 transfer ... */
-    PDMA->SWREQ = (1 << 0);
-
-    while(PDMA->TRGSTS & 0x1)   // wait PDMA finish
-    {
-        if(loop++ > (SystemCoreClock / 100))
-        {
-            printf("\n[PDMA transfer time-out]\n");
-            while(1);
-        }
-    }
-
-    return CRC->CHECKSUM;
+    PDMA_JobIRQHandler();
 }
 
 /*---------------------------------------------------------------------------------------------------------*/
@@ -128,7 +86,9 @@ uint32_t GetPDMAChecksum(uint32_t u32Address, uint32_t u32Size)
 /*---------------------------------------------------------------------------------------------------------*/
 int main(void)
 {
-    volatile uint32_t addr, size, u32FMCChecksum, u32CRC32Checksum, u32PDMAChecksum;
+    volatile uint32_t size, u32FMCChecksum, u32CRC32Checksum, u32PDMAChecksum, u32SwChecksum;
+    uint32_t u32CpuOdd, u32PdmaOdd, u32SwOdd;
+    S_CRC_SW_T sCrc;
 
     /* Unlock protected registers */
     SYS_UnlockReg();
@@ -139,6 +99,9 @@ int main(void)
     /* Init UART0 for printf */
     UART0_Init();
 
+    /* PDMA channel 0 serves the jobs of CRC_Calculate */
+    PDMA_JobOpen(1 << 0);
+
     size = 1024 * 2;
 
     printf("\n\nCPU @ %d Hz\n", SystemCoreClock);
@@ -146,42 +109,49 @@ int main(void)
     printf("|    CRC32 with PDMA Sample Code                      |\n");
     printf("|       - Get APROM first %d bytes CRC result by    |\n", size);
     printf("|          a.) FMC checksum command                   |\n");
-    printf("|          b.) CPU write CRC data register directly   |\n");
-    printf("|          c.) PDMA write CRC data register           |\n");
+    printf("|          b.) CRC_Calculate with CPU write           |\n");
+    printf("|          c.) CRC_Calculate with PDMA write          |\n");
+    printf("|          d.) CRC_SwCalculate                        |\n");
     printf("+-----------------------------------------------------+\n\n");
 
-
-    /* Disable CRC function */
-    CRC->CTL = 0;
-
-    CRC->CTL = CRC_CTL_CRCEN_Msk;
-    CRC->CTL |= CRC_32;
-    CRC->CTL |= CRC_CPU_WDATA_32 | CRC_WDATA_RVS | CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM;
-
     /*  Case a. */
     u32FMCChecksum = GetFMCChecksum(0x0, size);
 
     /*  Case b. */
     /* Configure CRC controller for CRC-CRC32 mode */
     CRC_Open(CRC_32, (CRC_WDATA_RVS | CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM), 0xFFFFFFFF, CRC_CPU_WDATA_32);
-    /* Start to execute CRC-CRC32 operation */
-    for(addr = 0; addr < size; addr += 4)
-    {
-        CRC_WRITE_DATA(inpw(addr));
-    }
-    u32CRC32Checksum = CRC_GetChecksum();
+    CRC_SetPDMA(0);
+    u32CRC32Checksum = CRC_Calculate((const uint8_t *)0x0, size);
+    /* Unaligned head and tail are written by 8-bit and 16-bit writes */
+    CRC_Open(CRC_32, (CRC_WDATA_RVS | CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM), 0xFFFFFFFF, CRC_CPU_WDATA_32);
+    u32CpuOdd = CRC_Calculate((const uint8_t *)0x1, size - 4);
 
     /*  Case c. */
-    /* Configure CRC controller for CRC-CRC32 mode */
     CRC_Open(CRC_32, (CRC_WDATA_RVS | CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM), 0xFFFFFFFF, CRC_CPU_WDATA_32);
-    u32PDMAChecksum = GetPDMAChecksum(0x0, size);
+    CRC_SetPDMA(1);
+    u32PDMAChecksum = CRC_Calculate((const uint8_t *)0x0, size);
+    CRC_Open(CRC_32, (CRC_WDATA_RVS | CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM), 0xFFFFFFFF, CRC_CPU_WDATA_32);
+    u32PdmaOdd = CRC_Calculate((const uint8_t *)0x1, size - 4);
+    CRC_SetPDMA(0);
+
+    /*  Case d. */
+    CRC_SwOpen(&sCrc, CRC_32, (CRC_WDATA_RVS | CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM), 0xFFFFFFFF);
+    u32SwChecksum = CRC_SwCalculate(&sCrc, (const uint8_t *)0x0, size);
+    CRC_SwOpen(&sCrc, CRC_32, (CRC_WDATA_RVS | CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM), 0xFFFFFFFF);
+    u32SwOdd = CRC_SwCalculate(&sCrc, (const uint8_t *)0x1, size - 4);
 
     printf("APROM first %d bytes checksum:\n", size);
     printf("   - by FMC command: 0x%08X\n", u32FMCChecksum);
     printf("   - by CPU write:   0x%08X\n", u32CRC32Checksum);
     printf("   - by PDMA write:  0x%08X\n", u32PDMAChecksum);
-
-    if((u32FMCChecksum == u32CRC32Checksum) && (u32CRC32Checksum == u32PDMAChecksum))
+    printf("   - by software:    0x%08X\n", u32SwChecksum);
+    printf("APROM %d bytes from address 1 checksum:\n", size - 4);
+    printf("   - by CPU write:   0x%08X\n", u32CpuOdd);
+    printf("   - by PDMA write:  0x%08X\n", u32PdmaOdd);
+    printf("   - by software:    0x%08X\n", u32SwOdd);
+
+    if((u32FMCChecksum == u32CRC32Checksum) && (u32CRC32Checksum == u32PDMAChecksum) && (u32PDMAChecksum == u32SwChecksum) &&
+            (u32CpuOdd == u32SwOdd) && (u32PdmaOdd == u32SwOdd))
     {
         if((u32FMCChecksum == 0) || (u32FMCChecksum == 0xFFFFFFFF))
         {
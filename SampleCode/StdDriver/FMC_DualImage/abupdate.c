@@ -0,0 +1,640 @@
+/**************************************************************************//**
+ * @file     abupdate.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 16/10/25 4:29p $
+ * @brief    A/B dual-image update manager
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC1261.h"
+#include "abupdate.h"
+
+/*
+    APROM holds a small boot manager at address 0 and two image slots. A new image is written to the slot
+    which is not running, so the running image and the last confirmed image are never touched by an update.
+    The chip boots in APROM with IAP mode. After a chip reset VECMAP is 0 and the boot manager runs, it sets
+    VECMAP to the base of the selected slot and makes a system reset, which keeps VECMAP, so the CPU starts
+    with the vector table of the image.
+
+    The state of the slots is kept in a log of records in two flash pages:
+      AB_REC_ERASE   : the slot is going to be written
+      AB_REC_IMAGE   : a new image is written and its CRC-32 is checked by the CRC controller, it is pending
+      AB_REC_ATTEMPT : the pending image is started once more
+      AB_REC_CONFIRM : the image confirmed itself, it becomes the active image
+      AB_REC_REJECT  : the pending image did not confirm in AB_MAX_ATTEMPTS boots, it is rolled back
+    Page   : word 0 sequence number, word 1 inverted sequence number, word 2 AB_LOG_MAGIC, then records.
+    Record : word 0 AB_REC_TAG(type, slot), word 1 image length, word 2 image CRC-32,
+             word 3 inverted XOR of words 0 to 2.
+    A torn record fails the check word and is skipped. When a page is full, the state is written as new
+    records to the other page and its header is programmed last, so the old page is used until then.
+
+    A pending image is started with WDT enabled. If it hangs, or is reset by power off before AB_Confirm,
+    the boot manager counts one more attempt, and then rolls back to the confirmed image.
+    With no log, slot A is taken as a confirmed image programmed by a writer, and only its vector table
+    is checked.
+
+    ISP must be enabled by FMC_Open and protected registers must be unlocked before using these functions.
+*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define AB_LOG_MAGIC            0x314C4241ul    /* "ABL1" */
+#define AB_LOG_HDR_SIZE         16
+#define AB_REC_SIZE             16
+
+#define AB_REC_ERASE            1
+#define AB_REC_IMAGE            2
+#define AB_REC_ATTEMPT          3
+#define AB_REC_CONFIRM          4
+#define AB_REC_REJECT           5
+
+#define AB_REC_TAG(type, slot)  (0xAB000000ul | ((type) << 8) | (slot))
+#define AB_REC_TYPE(tag)        (((tag) >> 8) & 0xFF)
+#define AB_REC_SLOT(tag)        ((tag) & 0xFF)
+
+#define AB_LOG_PAGE_ADDR(page)  (AB_LOG_BASE + (page) * FMC_FLASH_PAGE_SIZE)
+#define AB_SRAM_SIZE            0x5000          /* 20 KB SRAM */
+
+typedef struct
+{
+    uint32_t u32State;          /* AB_STATE_EMPTY, AB_STATE_PENDING, AB_STATE_CONFIRMED or AB_STATE_REJECTED */
+    uint32_t u32Len;            /* Image length, 0 if it is not known */
+    uint32_t u32Crc;            /* CRC-32 of the image */
+    uint32_t u32Attempts;       /* Boots of the pending image */
+} S_AB_SLOT_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static S_AB_SLOT_T s_asAbSlot[2];
+static uint32_t s_u32AbActive;                  /* Slot of the last confirmed image */
+static uint32_t s_u32LogPage;                   /* Page of the log in use */
+static uint32_t s_u32LogSeq;                    /* Sequence number of the page in use */
+static uint32_t s_u32LogAddr;                   /* Next record, 0 when there is no valid page */
+static uint32_t s_u32UpdSlot;                   /* Slot being written */
+static uint32_t s_u32UpdAddr;                   /* Next address to write */
+static uint32_t s_u32UpdEnd;                    /* End of the image being written, 0 if no update */
+static uint32_t s_u32WdtArmed;                  /* WDT is started for a pending image */
+
+
+/// @cond HIDDEN_SYMBOLS
+static int32_t AB_IsPageValid(uint32_t u32Addr)
+{
+    return ((M32(u32Addr + 8) == AB_LOG_MAGIC) && (M32(u32Addr) == ~M32(u32Addr + 4)));
+}
+
+static int32_t AB_IsRecordValid(uint32_t u32Addr)
+{
+    uint32_t u32Tag = M32(u32Addr);
+
+    if(((u32Tag & 0xFFFF0000ul) != 0xAB000000ul) || (AB_REC_SLOT(u32Tag) > AB_SLOT_B))
+        return 0;
+
+    return (M32(u32Addr + 12) == ~(u32Tag ^ M32(u32Addr + 4) ^ M32(u32Addr + 8)));
+}
+
+static int32_t AB_IsBlank(uint32_t u32Addr, uint32_t u32Size)
+{
+    uint32_t i;
+
+    for(i = 0; i < u32Size; i += 4)
+    {
+        if(M32(u32Addr + i) != 0xFFFFFFFFul)
+            return 0;
+    }
+    return 1;
+}
+
+static void AB_ResetState(void)
+{
+    s_asAbSlot[AB_SLOT_A].u32State = AB_STATE_CONFIRMED;
+    s_asAbSlot[AB_SLOT_A].u32Len = 0;
+    s_asAbSlot[AB_SLOT_A].u32Crc = 0;
+    s_asAbSlot[AB_SLOT_A].u32Attempts = 0;
+    s_asAbSlot[AB_SLOT_B].u32State = AB_STATE_EMPTY;
+    s_asAbSlot[AB_SLOT_B].u32Len = 0;
+    s_asAbSlot[AB_SLOT_B].u32Crc = 0;
+    s_asAbSlot[AB_SLOT_B].u32Attempts = 0;
+    s_u32AbActive = AB_SLOT_A;
+}
+
+static void AB_Apply(uint32_t u32Tag, uint32_t u32Len, uint32_t u32Crc)
+{
+    uint32_t u32Slot = AB_REC_SLOT(u32Tag);
+    S_AB_SLOT_T *psSlot = &s_asAbSlot[u32Slot];
+
+    switch(AB_REC_TYPE(u32Tag))
+    {
+        case AB_REC_ERASE:
+            psSlot->u32State = AB_STATE_EMPTY;
+            psSlot->u32Len = 0;
+            psSlot->u32Crc = 0;
+            psSlot->u32Attempts = 0;
+            break;
+
+        case AB_REC_IMAGE:
+            psSlot->u32State = AB_STATE_PENDING;
+            psSlot->u32Len = u32Len;
+            psSlot->u32Crc = u32Crc;
+            psSlot->u32Attempts = 0;
+            break;
+
+        case AB_REC_ATTEMPT:
+            psSlot->u32Attempts++;
+            break;
+
+        case AB_REC_CONFIRM:
+            psSlot->u32State = AB_STATE_CONFIRMED;
+            s_u32AbActive = u32Slot;
+            break;
+
+        case AB_REC_REJECT:
+            psSlot->u32State = AB_STATE_REJECTED;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static int32_t AB_WriteRecord(uint32_t u32Addr, uint32_t u32Tag, uint32_t u32Len, uint32_t u32Crc)
+{
+    uint32_t au32Rec[4];
+
+    au32Rec[0] = u32Tag;
+    au32Rec[1] = u32Len;
+    au32Rec[2] = u32Crc;
+    au32Rec[3] = ~(u32Tag ^ u32Len ^ u32Crc);
+
+    return FMC_WriteBuffer(u32Addr, au32Rec, AB_REC_SIZE);
+}
+
+/* Write the state to the other log page and switch to it */
+static int32_t AB_Compact(void)
+{
+    uint32_t au32Hdr[3], u32Page, u32Addr, u32Slot, i, j;
+    S_AB_SLOT_T *psSlot;
+
+    u32Page = (s_u32LogAddr == 0) ? 0 : (s_u32LogPage ^ 1);
+    u32Addr = AB_LOG_PAGE_ADDR(u32Page);
+
+    if(FMC_Erase(u32Addr) != 0)
+        return -1;
+    u32Addr += AB_LOG_HDR_SIZE;
+
+    /* The active slot goes last, so its AB_REC_CONFIRM is the last one */
+    for(i = 0; i < 2; i++)
+    {
+        u32Slot = s_u32AbActive ^ 1 ^ i;
+        psSlot = &s_asAbSlot[u32Slot];
+
+        if(psSlot->u32State == AB_STATE_EMPTY)
+        {
+            if(AB_WriteRecord(u32Addr, AB_REC_TAG(AB_REC_ERASE, u32Slot), 0, 0) != 0)
+                return -1;
+            u32Addr += AB_REC_SIZE;
+            continue;
+        }
+
+        if(psSlot->u32Len)
+        {
+            if(AB_WriteRecord(u32Addr, AB_REC_TAG(AB_REC_IMAGE, u32Slot), psSlot->u32Len, psSlot->u32Crc) != 0)
+                return -1;
+            u32Addr += AB_REC_SIZE;
+        }
+
+        if(psSlot->u32State == AB_STATE_PENDING)
+        {
+            for(j = 0; (j < psSlot->u32Attempts) && (j < AB_MAX_ATTEMPTS); j++)
+            {
+                if(AB_WriteRecord(u32Addr, AB_REC_TAG(AB_REC_ATTEMPT, u32Slot), 0, 0) != 0)
+                    return -1;
+                u32Addr += AB_REC_SIZE;
+            }
+        }
+        else
+        {
+            if(AB_WriteRecord(u32Addr, AB_REC_TAG((psSlot->u32State == AB_STATE_CONFIRMED) ?
+                                                  AB_REC_CONFIRM : AB_REC_REJECT, u32Slot), 0, 0) != 0)
+                return -1;
+            u32Addr += AB_REC_SIZE;
+        }
+    }
+
+    /* The header commits the page */
+    au32Hdr[0] = s_u32LogSeq + 1;
+    au32Hdr[1] = ~au32Hdr[0];
+    au32Hdr[2] = AB_LOG_MAGIC;
+    if(FMC_WriteBuffer(AB_LOG_PAGE_ADDR(u32Page), au32Hdr, sizeof(au32Hdr)) != 0)
+        return -1;
+
+    s_u32LogPage = u32Page;
+    s_u32LogSeq = au32Hdr[0];
+    s_u32LogAddr = u32Addr;
+
+    return 0;
+}
+
+static int32_t AB_Append(uint32_t u32Tag, uint32_t u32Len, uint32_t u32Crc)
+{
+    int32_t i32Ret;
+
+    if((s_u32LogAddr == 0) || (s_u32LogAddr + AB_REC_SIZE > AB_LOG_PAGE_ADDR(s_u32LogPage) + FMC_FLASH_PAGE_SIZE))
+    {
+        if(AB_Compact() != 0)
+            return -1;
+    }
+
+    i32Ret = AB_WriteRecord(s_u32LogAddr, u32Tag, u32Len, u32Crc);
+
+    /* A failed record is skipped */
+    s_u32LogAddr += AB_REC_SIZE;
+    if(i32Ret != 0)
+        return -1;
+
+    AB_Apply(u32Tag, u32Len, u32Crc);
+
+    return 0;
+}
+
+static int32_t AB_VerifyImage(uint32_t u32Base, uint32_t u32Len, uint32_t u32Crc)
+{
+    uint32_t u32Sp, u32Entry;
+
+    /* The vector table must give a stack in SRAM and an entry in the slot */
+    u32Sp = M32(u32Base);
+    u32Entry = M32(u32Base + 4);
+    if((u32Sp <= SRAM_BASE) || (u32Sp > SRAM_BASE + AB_SRAM_SIZE) || (u32Sp & 0x3) ||
+            !(u32Entry & 1) || (u32Entry < u32Base) || (u32Entry >= u32Base + AB_SLOT_SIZE))
+        return 0;
+
+    if(u32Len == 0)
+        return 1;
+
+    if(u32Len > AB_SLOT_SIZE)
+        return 0;
+
+    /* CRC-32 as IEEE 802.3, calculated by the CRC controller */
+    CRC_Open(CRC_32, CRC_WDATA_RVS | CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM, 0xFFFFFFFFul, CRC_CPU_WDATA_32);
+
+    return (CRC_Calculate((const uint8_t *)u32Base, u32Len) == u32Crc);
+}
+
+static int32_t AB_IsImageValid(uint32_t u32Slot)
+{
+    return AB_VerifyImage(AB_GetSlotBase(u32Slot), s_asAbSlot[u32Slot].u32Len, s_asAbSlot[u32Slot].u32Crc);
+}
+
+/* Reset the chip by WDT if the image does not call AB_Confirm in about 6.5 seconds */
+static void AB_StartWatchdog(void)
+{
+    CLK_EnableXtalRC(CLK_PWRCTL_LIRCEN_Msk);
+    CLK_WaitClockReady(CLK_STATUS_LIRCSTB_Msk);
+    CLK_EnableModuleClock(WDT_MODULE);
+    CLK_SetModuleClock(WDT_MODULE, CLK_CLKSEL1_WDTSEL_LIRC, 0);
+
+    WDT_Open(WDT_TIMEOUT_2POW16, WDT_RESET_DELAY_1026CLK, TRUE, FALSE);
+    s_u32WdtArmed = 1;
+}
+
+static void AB_Start(uint32_t u32Slot)
+{
+    /* Mask all interrupt before changing VECMAP to avoid wrong interrupt handler fetched */
+    __set_PRIMASK(1);
+
+    FMC_SetVectorPageAddr(AB_GetSlotBase(u32Slot));
+
+    /* System reset keeps VECMAP, the CPU starts with the vector table of the slot */
+    NVIC_SystemReset();
+}
+/// @endcond HIDDEN_SYMBOLS
+
+
+/**
+ * @brief      Load the state of the image slots
+ *
+ * @param      None
+ *
+ * @retval      0 Success
+ * @retval     -1 Failed
+ *
+ * @details    This function enables APROM update and the CRC controller clock, and replays the log.
+ *             When the running image is pending, WDT is started, so the image is rolled back if it
+ *             hangs before AB_Confirm.
+ */
+int32_t AB_Init(void)
+{
+    uint32_t u32Page, u32Addr, u32End;
+    int32_t i32Slot;
+
+    FMC_ENABLE_AP_UPDATE();
+    CLK_EnableModuleClock(CRC_MODULE);
+
+    AB_ResetState();
+    s_u32UpdEnd = 0;
+    s_u32LogAddr = 0;
+    s_u32LogSeq = 0;
+
+    /* Use the valid page with the newer sequence number */
+    for(u32Page = 0; u32Page < 2; u32Page++)
+    {
+        u32Addr = AB_LOG_PAGE_ADDR(u32Page);
+        if(AB_IsPageValid(u32Addr) && ((s_u32LogAddr == 0) || ((int32_t)(M32(u32Addr) - s_u32LogSeq) > 0)))
+        {
+            s_u32LogPage = u32Page;
+            s_u32LogSeq = M32(u32Addr);
+            s_u32LogAddr = u32Addr;
+        }
+    }
+
+    if(s_u32LogAddr)
+    {
+        u32Addr = s_u32LogAddr + AB_LOG_HDR_SIZE;
+        u32End = AB_LOG_PAGE_ADDR(s_u32LogPage) + FMC_FLASH_PAGE_SIZE;
+        for(; u32Addr < u32End; u32Addr += AB_REC_SIZE)
+        {
+            if(AB_IsBlank(u32Addr, AB_REC_SIZE))
+                break;
+            if(AB_IsRecordValid(u32Addr))
+                AB_Apply(M32(u32Addr), M32(u32Addr + 4), M32(u32Addr + 8));
+        }
+        s_u32LogAddr = u32Addr;
+    }
+
+    i32Slot = AB_GetRunningSlot();
+    if((i32Slot >= 0) && (s_asAbSlot[i32Slot].u32State == AB_STATE_PENDING))
+        AB_StartWatchdog();
+
+    return 0;
+}
+
+/**
+ * @brief      Get the base address of an image slot
+ *
+ * @param[in]  u32Slot  AB_SLOT_A or AB_SLOT_B
+ *
+ * @return     Base address of the slot
+ */
+uint32_t AB_GetSlotBase(uint32_t u32Slot)
+{
+    return (u32Slot == AB_SLOT_B) ? AB_SLOT_B_BASE : AB_SLOT_A_BASE;
+}
+
+/**
+ * @brief      Get the state of an image slot
+ *
+ * @param[in]  u32Slot  AB_SLOT_A or AB_SLOT_B
+ *
+ * @return     AB_STATE_EMPTY, AB_STATE_PENDING, AB_STATE_CONFIRMED or AB_STATE_REJECTED
+ */
+uint32_t AB_GetSlotState(uint32_t u32Slot)
+{
+    return s_asAbSlot[u32Slot & 1].u32State;
+}
+
+/**
+ * @brief      Get the slot of the running image
+ *
+ * @param      None
+ *
+ * @return     AB_SLOT_A or AB_SLOT_B, or -1 when VECMAP is not the base of a slot, e.g. in the boot manager
+ */
+int32_t AB_GetRunningSlot(void)
+{
+    uint32_t u32VecMap = FMC_GetVECMAP();
+
+    if(u32VecMap == AB_SLOT_A_BASE)
+        return AB_SLOT_A;
+    if(u32VecMap == AB_SLOT_B_BASE)
+        return AB_SLOT_B;
+    return -1;
+}
+
+/**
+ * @brief      Start to write a new image
+ *
+ * @param[in]  u32Len   Image length in bytes
+ *
+ * @return     The slot to write, or -1 if failed
+ *
+ * @details    The image is written to the slot which is not running. The running image must be confirmed,
+ *             so the last confirmed image is never overwritten. Pages of the slot are erased ahead of
+ *             AB_WriteImage.
+ */
+int32_t AB_BeginUpdate(uint32_t u32Len)
+{
+    int32_t i32Slot;
+
+    if((u32Len == 0) || (u32Len > AB_SLOT_SIZE) || s_u32UpdEnd)
+        return -1;
+
+    i32Slot = AB_GetRunningSlot();
+    if(i32Slot < 0)
+        i32Slot = s_u32AbActive;
+    if(s_asAbSlot[i32Slot].u32State != AB_STATE_CONFIRMED)
+        return -1;
+    i32Slot ^= 1;
+
+    if(AB_Append(AB_REC_TAG(AB_REC_ERASE, i32Slot), 0, 0) != 0)
+        return -1;
+
+    s_u32UpdSlot = i32Slot;
+    s_u32UpdAddr = AB_GetSlotBase(i32Slot);
+    s_u32UpdEnd = s_u32UpdAddr + u32Len;
+    FMC_EnableEraseAhead(s_u32UpdAddr, u32Len);
+
+    return i32Slot;
+}
+
+/**
+ * @brief      Write the next part of the new image
+ *
+ * @param[in]  pu32Data Image data
+ * @param[in]  u32Len   Length of the data in bytes. It must be multiple of 4. The last part is padded to words.
+ *
+ * @retval      0 Success
+ * @retval     -1 Failed, the update is aborted
+ */
+int32_t AB_WriteImage(const uint32_t *pu32Data, uint32_t u32Len)
+{
+    if((s_u32UpdEnd == 0) || (s_u32UpdAddr + u32Len > ((s_u32UpdEnd + 3) & ~3ul)) ||
+            (FMC_WriteBuffer(s_u32UpdAddr, pu32Data, u32Len) != 0))
+    {
+        AB_AbortUpdate();
+        return -1;
+    }
+
+    s_u32UpdAddr += u32Len;
+
+    return 0;
+}
+
+/**
+ * @brief      Finish writing the new image
+ *
+ * @param[in]  u32Crc   CRC-32 (IEEE 802.3, as zlib crc32) of the image
+ *
+ * @retval      0 Success, the image is pending. Call AB_Activate to start it.
+ * @retval     -1 Failed, the image is not complete or the CRC does not match
+ *
+ * @details    The image in flash is checked by the CRC controller.
+ */
+int32_t AB_EndUpdate(uint32_t u32Crc)
+{
+    uint32_t u32Base, u32Len;
+    int32_t i32Ret;
+
+    if(s_u32UpdEnd == 0)
+        return -1;
+
+    u32Base = AB_GetSlotBase(s_u32UpdSlot);
+    u32Len = s_u32UpdEnd - u32Base;
+    s_u32UpdEnd = 0;
+
+    i32Ret = FMC_DisableEraseAhead();
+    if((i32Ret != 0) || (s_u32UpdAddr < u32Base + u32Len) || !AB_VerifyImage(u32Base, u32Len, u32Crc))
+        return -1;
+
+    return AB_Append(AB_REC_TAG(AB_REC_IMAGE, s_u32UpdSlot), u32Len, u32Crc);
+}
+
+/**
+ * @brief      Abort writing the new image
+ *
+ * @param      None
+ *
+ * @return     None
+ *
+ * @details    Call it when the image cannot be completed, e.g. the transfer timed out. It waits for the page
+ *             erase in progress and disables erase ahead. The slot stays empty and AB_BeginUpdate can start
+ *             a new update. It does nothing if no update is in progress.
+ */
+void AB_AbortUpdate(void)
+{
+    s_u32UpdEnd = 0;
+    FMC_DisableEraseAhead();
+}
+
+/**
+ * @brief      Start the image of a slot
+ *
+ * @param[in]  u32Slot  AB_SLOT_A or AB_SLOT_B
+ *
+ * @return     -1 if failed. It does not return on success.
+ *
+ * @details    A pending image is started with WDT enabled and must call AB_Confirm. A confirmed image
+ *             becomes the active image. The image is started by a system reset.
+ */
+int32_t AB_Activate(uint32_t u32Slot)
+{
+    S_AB_SLOT_T *psSlot;
+
+    u32Slot &= 1;
+    psSlot = &s_asAbSlot[u32Slot];
+    if(!AB_IsImageValid(u32Slot))
+        return -1;
+
+    if(psSlot->u32State == AB_STATE_PENDING)
+    {
+        if((psSlot->u32Attempts >= AB_MAX_ATTEMPTS) || (AB_Append(AB_REC_TAG(AB_REC_ATTEMPT, u32Slot), 0, 0) != 0))
+            return -1;
+        AB_StartWatchdog();
+    }
+    else if(psSlot->u32State == AB_STATE_CONFIRMED)
+    {
+        if((u32Slot != s_u32AbActive) && (AB_Append(AB_REC_TAG(AB_REC_CONFIRM, u32Slot), 0, 0) != 0))
+            return -1;
+    }
+    else
+        return -1;
+
+    AB_Start(u32Slot);
+
+    return -1;
+}
+
+/**
+ * @brief      Confirm the running image
+ *
+ * @param      None
+ *
+ * @retval      0 Success, the running image is the active image
+ * @retval     -1 Failed
+ *
+ * @details    A pending image calls this function after its self test. WDT started for the pending image
+ *             is stopped.
+ */
+int32_t AB_Confirm(void)
+{
+    int32_t i32Slot = AB_GetRunningSlot();
+
+    if(i32Slot < 0)
+        return -1;
+
+    if((s_asAbSlot[i32Slot].u32State != AB_STATE_CONFIRMED) || (s_u32AbActive != (uint32_t)i32Slot))
+    {
+        if(AB_Append(AB_REC_TAG(AB_REC_CONFIRM, i32Slot), 0, 0) != 0)
+            return -1;
+    }
+
+    if(s_u32WdtArmed)
+    {
+        WDT_Close();
+        s_u32WdtArmed = 0;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      Select and start an image
+ *
+ * @param      None
+ *
+ * @return     -1 if there is no valid image. It does not return on success.
+ *
+ * @details    The boot manager calls this function after a chip reset.
+ *             A pending image is started until it has been started AB_MAX_ATTEMPTS times, then it is
+ *             rejected. Otherwise the active image is started, or the other confirmed image if the CRC
+ *             of the active image does not match.
+ */
+int32_t AB_Boot(void)
+{
+    uint32_t u32Slot, i;
+
+    u32Slot = s_u32AbActive ^ 1;
+    if(s_asAbSlot[u32Slot].u32State == AB_STATE_PENDING)
+    {
+        if((s_asAbSlot[u32Slot].u32Attempts < AB_MAX_ATTEMPTS) && AB_IsImageValid(u32Slot))
+        {
+            if(AB_Append(AB_REC_TAG(AB_REC_ATTEMPT, u32Slot), 0, 0) == 0)
+            {
+                AB_StartWatchdog();
+                AB_Start(u32Slot);
+            }
+        }
+        else
+        {
+            /* Roll back */
+            AB_Append(AB_REC_TAG(AB_REC_REJECT, u32Slot), 0, 0);
+        }
+    }
+
+    for(i = 0; i < 2; i++)
+    {
+        u32Slot = s_u32AbActive ^ i;
+        if((s_asAbSlot[u32Slot].u32State == AB_STATE_CONFIRMED) && AB_IsImageValid(u32Slot))
+        {
+            if(i)
+                AB_Append(AB_REC_TAG(AB_REC_CONFIRM, u32Slot), 0, 0);
+            AB_Start(u32Slot);
+        }
+    }
+
+    return -1;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,59 @@
+/**************************************************************************//**
+ * @file     abupdate.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 16/10/25 4:29p $
+ * @brief    A/B dual-image update manager header file
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#ifndef __ABUPDATE_H__
+#define __ABUPDATE_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  APROM layout. Each image must be linked to run at the base address of its slot.                        */
+/*---------------------------------------------------------------------------------------------------------*/
+#define AB_BOOT_BASE            0x00000     /* Boot manager, 8 KB */
+#define AB_LOG_BASE             0x02000     /* Boot state log, 2 pages */
+#define AB_SLOT_A_BASE          0x03000     /* Image slot A */
+#define AB_SLOT_B_BASE          0x11000     /* Image slot B */
+#define AB_SLOT_SIZE            0x0E000     /* 56 KB each */
+
+#define AB_MAX_ATTEMPTS         3           /* Boots of a new image without confirmation before roll back */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Slot state constant definitions                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+#define AB_SLOT_A               0
+#define AB_SLOT_B               1
+
+#define AB_STATE_EMPTY          0           /* No image, or being written */
+#define AB_STATE_PENDING        1           /* New image verified, not confirmed yet */
+#define AB_STATE_CONFIRMED      2           /* Image confirmed by itself */
+#define AB_STATE_REJECTED       3           /* Image failed to confirm and was rolled back */
+
+int32_t AB_Init(void);
+uint32_t AB_GetSlotBase(uint32_t u32Slot);
+uint32_t AB_GetSlotState(uint32_t u32Slot);
+int32_t AB_GetRunningSlot(void);
+int32_t AB_BeginUpdate(uint32_t u32Len);
+int32_t AB_WriteImage(const uint32_t *pu32Data, uint32_t u32Len);
+int32_t AB_EndUpdate(uint32_t u32Crc);
+void AB_AbortUpdate(void);
+int32_t AB_Activate(uint32_t u32Slot);
+int32_t AB_Confirm(void);
+int32_t AB_Boot(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* __ABUPDATE_H__ */
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
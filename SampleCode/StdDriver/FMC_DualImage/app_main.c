@@ -0,0 +1,244 @@
+/******************************************************************************
+ * @file     app_main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 16/10/25 4:29p $
+ * @brief    Application image of the A/B dual-image update sample.
+ *           It receives a new image by UART0 into the other slot, starts it and confirms it.
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NUC1261.h"
+#include "abupdate.h"
+
+#define PLLCTL_SETTING      CLK_PLLCTL_72MHz_HXT
+#define PLL_CLOCK           72000000
+
+#define BLOCK_SIZE          256         /* Image bytes acknowledged at a time */
+
+static uint32_t s_au32Block[BLOCK_SIZE / 4];
+
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Enable external XTAL 12MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HXTEN_Msk);
+
+    /* Waiting for external XTAL clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HXTSTB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+
+    /* Select UART module clock source */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HXT, CLK_CLKDIV0_UART(1));
+
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set PA multi-function pins for UART0 RXD and TXD */
+    SYS->GPA_MFPL &= ~(SYS_GPA_MFPL_PA3MFP_Msk | SYS_GPA_MFPL_PA2MFP_Msk);
+    SYS->GPA_MFPL |= (SYS_GPA_MFPL_PA3MFP_UART0_RXD | SYS_GPA_MFPL_PA2MFP_UART0_TXD);
+}
+
+void UART_Init()
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    UART_Open(UART0, 115200);
+}
+
+/* Receive u32Len bytes from UART0, return -1 if no data come in about 1 second */
+static int32_t ReceiveBytes(uint8_t *pu8Buf, uint32_t u32Len)
+{
+    uint32_t u32TimeOut;
+
+    while(u32Len--)
+    {
+        u32TimeOut = SystemCoreClock / 8;
+        while(UART_GET_RX_EMPTY(UART0))
+        {
+            if(--u32TimeOut == 0)
+                return -1;
+        }
+        *pu8Buf++ = UART_READ(UART0);
+    }
+    return 0;
+}
+
+/*
+    The host sends the image length and its CRC-32 as little endian words, then the image in blocks of
+    BLOCK_SIZE bytes. The image must be linked for the slot given in the prompt. Each block is
+    acknowledged by 'K' after it is programmed, then the host sends the next one.
+*/
+static int32_t ReceiveImage(void)
+{
+    uint32_t au32Hdr[2], u32Len, u32Size, i;
+    int32_t i32Slot;
+
+    printf("Send image length, CRC-32 and image (linked for slot %c at 0x%05x) ...\n",
+           'A' + (AB_GetRunningSlot() ^ 1), AB_GetSlotBase(AB_GetRunningSlot() ^ 1));
+    UART_WAIT_TX_EMPTY(UART0);
+
+    while(ReceiveBytes((uint8_t *)au32Hdr, sizeof(au32Hdr)) != 0);
+
+    i32Slot = AB_BeginUpdate(au32Hdr[0]);
+    if(i32Slot < 0)
+        return -1;
+
+    UART_WRITE(UART0, 'K');
+    for(u32Len = au32Hdr[0]; u32Len; u32Len -= u32Size)
+    {
+        u32Size = (u32Len > BLOCK_SIZE) ? BLOCK_SIZE : u32Len;
+        if(ReceiveBytes((uint8_t *)s_au32Block, u32Size) != 0)
+        {
+            AB_AbortUpdate();
+            return -1;
+        }
+
+        /* Pad the last block to words */
+        for(i = u32Size; i & 3; i++)
+            ((uint8_t *)s_au32Block)[i] = 0xFF;
+
+        if(AB_WriteImage(s_au32Block, i) != 0)
+        {
+            AB_AbortUpdate();
+            return -1;
+        }
+        UART_WRITE(UART0, 'K');
+    }
+
+    if(AB_EndUpdate(au32Hdr[1]) != 0)
+    {
+        AB_AbortUpdate();
+        return -1;
+    }
+
+    printf("\nImage of %d bytes written to slot %c.\n", au32Hdr[0], 'A' + i32Slot);
+
+    return i32Slot;
+}
+
+int main()
+{
+    char *acState[] = {"Empty", "Pending", "Confirmed", "Rejected"};
+    uint8_t u8Item;
+    int32_t i32Slot;
+    uint32_t i;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system clock and multi-function I/O */
+    SYS_Init();
+
+    /* Init UART */
+    UART_Init();
+
+    /* Enable FMC ISP function */
+    FMC_Open();
+
+    AB_Init();
+    i32Slot = AB_GetRunningSlot();
+
+    printf("\n\n");
+    printf("+------------------------------------+\n");
+    printf("|   FMC A/B Dual-Image Application   |\n");
+    printf("+------------------------------------+\n");
+    printf("  Built at ............................ [%s %s]\n", __DATE__, __TIME__);
+    if(i32Slot < 0)
+    {
+        printf("  VECMAP 0x%05x is not an image slot, start it by the boot manager.\n", FMC_GetVECMAP());
+        goto lexit;
+    }
+    printf("  Running slot ........................ [%c]\n", 'A' + i32Slot);
+    for(i = AB_SLOT_A; i <= AB_SLOT_B; i++)
+        printf("  Slot %c at 0x%05x ..................... [%s]\n", 'A' + i, AB_GetSlotBase(i), acState[AB_GetSlotState(i)]);
+
+    if(AB_GetSlotState(i32Slot) == AB_STATE_PENDING)
+    {
+        printf("\nThis image is on trial. Confirm it in 6 seconds, or WDT resets the chip and\n");
+        printf("the boot manager rolls back after %d attempts.\n", AB_MAX_ATTEMPTS);
+    }
+
+    do
+    {
+        printf("\n\n");
+        printf("+----------------------------------------+\n");
+        printf("|               Select                   |\n");
+        printf("+----------------------------------------+\n");
+        printf("| [0] Confirm running image              |\n");
+        printf("| [1] Update the other slot by UART0     |\n");
+        printf("| [2] Start the other slot               |\n");
+        printf("| [3] Chip reset to the boot manager     |\n");
+        printf("+----------------------------------------+\n");
+        printf("Please select...");
+        u8Item = getchar();
+        printf("%c\n", u8Item);
+
+        switch(u8Item)
+        {
+            case '0':
+                if(AB_Confirm() != 0)
+                    printf("Failed to confirm!\n");
+                else
+                    printf("Slot %c confirmed.\n", 'A' + i32Slot);
+                break;
+
+            case '1':
+                if(ReceiveImage() < 0)
+                    printf("\nUpdate failed!\n");
+                break;
+
+            case '2':
+                printf("\n\nChange VECMAP and start slot %c...\n", 'A' + (i32Slot ^ 1));
+                UART_WAIT_TX_EMPTY(UART0); /* To make sure all message has been print out */
+
+                AB_Activate(i32Slot ^ 1);
+                printf("No valid image in slot %c!\n", 'A' + (i32Slot ^ 1));
+                break;
+
+            case '3':
+                UART_WAIT_TX_EMPTY(UART0);
+                SYS_ResetChip();
+                break;
+
+            default :
+                break;
+        }
+    }
+    while(1);
+
+lexit:
+
+    /* Disable FMC ISP function */
+    FMC_Close();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    printf("\nFMC Sample Code Completed.\n");
+
+    while(1);
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
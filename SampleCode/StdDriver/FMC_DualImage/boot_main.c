@@ -0,0 +1,134 @@
+/******************************************************************************
+ * @file     boot_main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 16/10/25 4:29p $
+ * @brief    Boot manager of the A/B dual-image update sample.
+ *           It selects an image slot, sets VECMAP to the slot and resets to start the image.
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NUC1261.h"
+#include "abupdate.h"
+
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable Internal RC 22.1184MHz clock */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Waiting for Internal RC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Switch HCLK clock source to Internal RC and HCLK source divide 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Enable UART module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+
+    /* Select UART module clock source as HIRC and UART module clock divider as 1 */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC, CLK_CLKDIV0_UART(1));
+
+    /* Update System Core Clock */
+    SystemCoreClockUpdate();
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set PA multi-function pins for UART0 RXD and TXD */
+    SYS->GPA_MFPL &= ~(SYS_GPA_MFPL_PA3MFP_Msk | SYS_GPA_MFPL_PA2MFP_Msk);
+    SYS->GPA_MFPL |= (SYS_GPA_MFPL_PA3MFP_UART0_RXD | SYS_GPA_MFPL_PA2MFP_UART0_TXD);
+}
+
+void UART_Init()
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    UART_Open(UART0, 115200);
+}
+
+static int SetIAPBoot(void)
+{
+    uint32_t  au32Config[2];
+    uint32_t u32CBS;
+
+    /* Read current boot mode */
+    u32CBS = (FMC->ISPSTS & FMC_ISPSTS_CBS_Msk) >> FMC_ISPSTS_CBS_Pos;
+    if(u32CBS & 1)
+    {
+        /* Modify User Configuration when it is not in IAP mode */
+
+        FMC_ReadConfig(au32Config, 2);
+        if(au32Config[0] & 0x40)
+        {
+            FMC_EnableConfigUpdate();
+            au32Config[0] &= ~0x40;
+            FMC_Erase(FMC_CONFIG_BASE);
+            FMC_WriteConfig(au32Config, 2);
+
+            // Perform chip reset to make new User Config take effect
+            SYS_ResetChip();
+        }
+    }
+    return 0;
+}
+
+int main()
+{
+    char *acState[] = {"Empty", "Pending", "Confirmed", "Rejected"};
+    uint32_t i;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    /* Init system clock and multi-function I/O */
+    SYS_Init();
+
+    /* Init UART */
+    UART_Init();
+
+    printf("\n\n");
+    printf("+------------------------------------+\n");
+    printf("|   FMC A/B Dual-Image Boot Manager  |\n");
+    printf("+------------------------------------+\n");
+
+    /* Enable FMC ISP function */
+    FMC_Open();
+
+    /* VECMAP can be set only in IAP mode */
+    SetIAPBoot();
+
+    if(AB_Init() < 0)
+    {
+        printf("Failed to load slot state!\n");
+        goto lexit;
+    }
+
+    for(i = AB_SLOT_A; i <= AB_SLOT_B; i++)
+        printf("  Slot %c at 0x%05x ..................... [%s]\n", 'A' + i, AB_GetSlotBase(i), acState[AB_GetSlotState(i)]);
+
+    UART_WAIT_TX_EMPTY(UART0); /* To make sure all message has been print out */
+
+    /* It returns only when there is no valid image */
+    AB_Boot();
+
+    printf("No valid image!\n");
+
+lexit:
+
+    /* Disable FMC ISP function */
+    FMC_Close();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    while(1);
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -64,6 +64,56 @@ void SYS_Init(void)
 
 }
 
+uint32_t g_au32PageBuf[FMC_FLASH_PAGE_SIZE / 4];
+
+/* Start SysTick as a 24-bit down counter of HCLK */
+void TickStart(void)
+{
+    SysTick->LOAD = 0xFFFFFF;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+/* Return the bytes programmed per ms since TickStart */
+uint32_t TickBytesPerMs(uint32_t u32Bytes)
+{
+    uint32_t u32Ticks = 0xFFFFFF - SysTick->VAL;
+
+    SysTick->CTRL = 0;
+    return u32Bytes * (SystemCoreClock / 1000) / u32Ticks;
+}
+
+/* Program one page word by word and by FMC_WriteBuffer, then compare the speed */
+void ProgramSpeedTest(uint32_t u32Addr)
+{
+    uint32_t i, u32Word, u32Buf;
+
+    for(i = 0; i < FMC_FLASH_PAGE_SIZE / 4; i++)
+        g_au32PageBuf[i] = i * 0x01010101 + TEST_PATTERN;
+
+    FMC_Erase(u32Addr);
+    TickStart();
+    for(i = 0; i < FMC_FLASH_PAGE_SIZE; i += 4)
+        FMC_Write(u32Addr + i, g_au32PageBuf[i / 4]);
+    u32Word = TickBytesPerMs(FMC_FLASH_PAGE_SIZE);
+
+    FMC_Erase(u32Addr);
+    TickStart();
+    FMC_WriteBuffer(u32Addr, g_au32PageBuf, FMC_FLASH_PAGE_SIZE);
+    u32Buf = TickBytesPerMs(FMC_FLASH_PAGE_SIZE);
+
+    for(i = 0; i < FMC_FLASH_PAGE_SIZE; i += 4)
+    {
+        if(FMC_Read(u32Addr + i) != g_au32PageBuf[i / 4])
+        {
+            printf("[FMC_WriteBuffer verify FAIL at 0x%x]\n", u32Addr + i);
+            while(1);
+        }
+    }
+
+    printf("\nProgram one page: FMC_Write %d bytes/ms, FMC_WriteBuffer %d bytes/ms\n", u32Word, u32Buf);
+}
+
 void UART0_Init()
 {
     /*---------------------------------------------------------------------------------------------------------*/
@@ -125,6 +175,8 @@ int main()
             while(1);
         }
     }
+    ProgramSpeedTest(u32Addr);
+
     /* Disable FMC ISP function */
     FMC->ISPCTL &=  ~FMC_ISPCTL_ISPEN_Msk;
 
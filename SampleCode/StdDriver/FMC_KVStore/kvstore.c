@@ -0,0 +1,452 @@
+/**************************************************************************//**
+ * @file     kvstore.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 16/10/25 4:29p $
+ * @brief    Log-structured key-value store on Data Flash
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <string.h>
+#include "NUC1261.h"
+#include "kvstore.h"
+
+/*
+    The store is a ring of flash pages used as a log. A write appends a record to the newest (head) page,
+    so most writes program a few words and need no erase. When fewer than KV_GC_FREE_PAGES pages are free,
+    each write also checks KV_GC_STEP_RECORDS records of the oldest (tail) page, copies the live ones to the
+    head and erases the tail page when all its records are checked. One page is always kept free for this
+    copy, so the live data must stay below (page count - 2) pages.
+
+    Page   : word 0 sequence number, word 1 inverted sequence number, word 2 KV_PAGE_MAGIC, then records.
+             An interrupted erase sets bits at random, it breaks the inverted copy of the sequence number.
+    Record : word 0 key[15:0], value length[23:16] and header check[31:24],
+             the value padded to words with 0xFF,
+             CRC-32 of the header and the value with bit 31 cleared, so it never reads as erased flash.
+    Words are programmed in ascending address order, so the magic word commits a page and the CRC word
+    commits a record. After power off, a record with wrong CRC is skipped and a wrong header ends the page.
+    Collection clears the magic word of the tail page before erasing it.
+    A record of length 0 deletes the key.
+
+    KV_Init replays the pages from the oldest to the newest into an index holding the address of the
+    latest record of each key, so a read is one table look-up and a copy from flash.
+    ISP must be enabled by FMC_Open before using the store. It is not reentrant.
+*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Macro, type and constant definitions                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define KV_PAGE_MAGIC           0x3153564Bul    /* "KVS1" */
+#define KV_PAGE_HDR_SIZE        12
+#define KV_GC_FREE_PAGES        3               /* Collection runs while fewer pages are free */
+
+#define KV_PAGE_ADDR(page)      (s_u32KvBase + (page) * FMC_FLASH_PAGE_SIZE)
+#define KV_REC_SIZE(len)        (8 + (((len) + 3) & ~3ul))
+#define KV_HDR(key, len)        ((key) | ((len) << 16) | ((((key) ^ ((key) >> 8) ^ (len) ^ 0x5A) & 0xFF) << 24))
+#define KV_FREE_PAGES()         (s_u32KvPageCnt - s_u32UsedCnt)
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static uint32_t s_au32KvAddr[KV_MAX_KEYS];      /* Address of the latest record of each key, 0 if none */
+static uint32_t s_au32RecBuf[KV_REC_SIZE(KV_MAX_VALUE_LEN) / 4];
+static uint32_t s_u32KvBase = 0;
+static uint32_t s_u32KvPageCnt = 0;
+static uint32_t s_u32HeadPage, s_u32TailPage;  /* Newest and oldest page in use */
+static uint32_t s_u32UsedCnt;                   /* Pages from tail to head */
+static uint32_t s_u32Seq;                       /* Sequence number of the head page */
+static uint32_t s_u32WriteAddr;                 /* Next record in the head page */
+static uint32_t s_u32GcAddr;                    /* Next record to check in the tail page */
+static uint32_t s_u32EraseCnt;
+
+
+/// @cond HIDDEN_SYMBOLS
+static uint32_t KV_Crc(const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t u32Crc = 0xFFFFFFFFul, i;
+
+    while(u32Len--)
+    {
+        u32Crc ^= *pu8Data++;
+        for(i = 0; i < 8; i++)
+            u32Crc = (u32Crc >> 1) ^ (0xEDB88320ul & (0 - (u32Crc & 1)));
+    }
+    return (~u32Crc) & 0x7FFFFFFFul;
+}
+
+/* Return the size of the record at u32Addr, or 0 when there is no valid header before u32End */
+static uint32_t KV_RecordSize(uint32_t u32Addr, uint32_t u32End)
+{
+    uint32_t u32Hdr, u32Key, u32Len;
+
+    if(u32Addr + 8 > u32End)
+        return 0;
+
+    u32Hdr = M32(u32Addr);
+    u32Key = u32Hdr & 0xFFFF;
+    u32Len = (u32Hdr >> 16) & 0xFF;
+    if((u32Key >= KV_MAX_KEYS) || (u32Len > KV_MAX_VALUE_LEN) || (u32Hdr != KV_HDR(u32Key, u32Len)) ||
+            (u32Addr + KV_REC_SIZE(u32Len) > u32End))
+        return 0;
+
+    return KV_REC_SIZE(u32Len);
+}
+
+static int32_t KV_IsCommitted(uint32_t u32Addr, uint32_t u32Size)
+{
+    return (M32(u32Addr + u32Size - 4) == KV_Crc((const uint8_t *)u32Addr, u32Size - 4));
+}
+
+static int32_t KV_IsPageValid(uint32_t u32Page)
+{
+    uint32_t u32Addr = KV_PAGE_ADDR(u32Page);
+
+    return ((M32(u32Addr + 8) == KV_PAGE_MAGIC) && (M32(u32Addr) == ~M32(u32Addr + 4)));
+}
+
+static uint32_t KV_HeadRoom(void)
+{
+    if(s_u32UsedCnt == 0)
+        return 0;
+    return KV_PAGE_ADDR(s_u32HeadPage) + FMC_FLASH_PAGE_SIZE - s_u32WriteAddr;
+}
+
+/* Take the next free page as head */
+static int32_t KV_OpenPage(void)
+{
+    uint32_t u32Page, u32Addr, i, au32Hdr[3];
+
+    if(s_u32UsedCnt >= s_u32KvPageCnt)
+        return -1;
+
+    u32Page = (s_u32UsedCnt == 0) ? s_u32TailPage : ((s_u32HeadPage + 1) % s_u32KvPageCnt);
+    u32Addr = KV_PAGE_ADDR(u32Page);
+
+    /* Free pages are normally blank. An erase interrupted by power off is done again. */
+    for(i = 0; i < FMC_FLASH_PAGE_SIZE; i += 4)
+    {
+        if(M32(u32Addr + i) != 0xFFFFFFFFul)
+            break;
+    }
+    if(i < FMC_FLASH_PAGE_SIZE)
+    {
+        s_u32EraseCnt++;
+        if(FMC_Erase(u32Addr) != 0)
+            return -1;
+    }
+
+    /* The page is in use even if its header fails. It has no magic and is erased by collection. */
+    s_u32HeadPage = u32Page;
+    if(s_u32UsedCnt++ == 0)
+    {
+        s_u32TailPage = u32Page;
+        s_u32GcAddr = u32Addr + KV_PAGE_HDR_SIZE;
+    }
+    s_u32WriteAddr = u32Addr + FMC_FLASH_PAGE_SIZE;
+
+    au32Hdr[0] = ++s_u32Seq;
+    au32Hdr[1] = ~s_u32Seq;
+    au32Hdr[2] = KV_PAGE_MAGIC;
+    if(FMC_WriteBuffer(u32Addr, au32Hdr, sizeof(au32Hdr)) != 0)
+        return -1;
+
+    s_u32WriteAddr = u32Addr + KV_PAGE_HDR_SIZE;
+    return 0;
+}
+
+/* Append a record to the head page */
+static int32_t KV_Program(uint32_t u32Key, const void *pvData, uint32_t u32Len)
+{
+    uint32_t u32Size = KV_REC_SIZE(u32Len), u32Addr;
+
+    if(KV_HeadRoom() < u32Size)
+    {
+        if(KV_OpenPage() != 0)
+            return -1;
+    }
+
+    s_au32RecBuf[u32Size / 4 - 2] = 0xFFFFFFFFul;
+    if(u32Len)
+        memcpy(&s_au32RecBuf[1], pvData, u32Len);
+    s_au32RecBuf[0] = KV_HDR(u32Key, u32Len);
+    s_au32RecBuf[u32Size / 4 - 1] = KV_Crc((const uint8_t *)s_au32RecBuf, u32Size - 4);
+
+    u32Addr = s_u32WriteAddr;
+    if(FMC_WriteBuffer(u32Addr, s_au32RecBuf, u32Size) != 0)
+    {
+        /* The header may be broken, records after it could not be found. Close the page. */
+        s_u32WriteAddr = KV_PAGE_ADDR(s_u32HeadPage) + FMC_FLASH_PAGE_SIZE;
+        return -1;
+    }
+    s_u32WriteAddr += u32Size;
+    s_au32KvAddr[u32Key] = u32Len ? u32Addr : 0;
+
+    return 0;
+}
+
+/*
+    Check up to u32Records records of the tail page and copy the live ones to the head.
+    The tail page is erased when all its records are checked. Only a forced step may take the last free
+    page for the copy, the live records of one page always fit in it.
+*/
+static int32_t KV_CollectStep(uint32_t u32Records, int32_t i32Force)
+{
+    uint32_t u32Tail, u32Size, u32Hdr, u32Zero = 0;
+
+    while(u32Records-- && (s_u32UsedCnt > 1))
+    {
+        u32Tail = KV_PAGE_ADDR(s_u32TailPage);
+        u32Size = 0;
+        if(KV_IsPageValid(s_u32TailPage))
+            u32Size = KV_RecordSize(s_u32GcAddr, u32Tail + FMC_FLASH_PAGE_SIZE);
+
+        if(u32Size == 0)
+        {
+            /*
+                An erase interrupted by power off may leave the page header and some old records readable,
+                while a later delete record is broken. Clear the magic first, so the page is never replayed.
+            */
+            if(FMC_WriteBuffer(u32Tail + 8, &u32Zero, 4) != 0)
+                return -1;
+            s_u32EraseCnt++;
+            if(FMC_Erase(u32Tail) != 0)
+                return -1;
+            s_u32TailPage = (s_u32TailPage + 1) % s_u32KvPageCnt;
+            s_u32UsedCnt--;
+            s_u32GcAddr = KV_PAGE_ADDR(s_u32TailPage) + KV_PAGE_HDR_SIZE;
+            break;
+        }
+
+        /* Only committed records are in the index, deleted keys are not copied */
+        u32Hdr = M32(s_u32GcAddr);
+        if(s_au32KvAddr[u32Hdr & 0xFFFF] == s_u32GcAddr)
+        {
+            if(!i32Force && (KV_HeadRoom() < u32Size) && (KV_FREE_PAGES() < 2))
+                break;
+            if(KV_Program(u32Hdr & 0xFFFF, (const void *)(s_u32GcAddr + 4), (u32Hdr >> 16) & 0xFF) != 0)
+                return -1;
+        }
+        s_u32GcAddr += u32Size;
+    }
+
+    return 0;
+}
+
+static int32_t KV_Update(uint32_t u32Key, const void *pvData, uint32_t u32Len)
+{
+    uint32_t u32Size = KV_REC_SIZE(u32Len), u32Tail, i;
+
+    /*
+        A new page may not take the last free page. Collect the tail pages until the record fits.
+        No page is free only if power was off while the last free page took the copy, finish that first.
+    */
+    for(i = 0; (KV_FREE_PAGES() == 0) || ((KV_HeadRoom() < u32Size) && (KV_FREE_PAGES() < 2)); i++)
+    {
+        /* Every page is collected and no space is freed */
+        if(i >= s_u32KvPageCnt)
+            return -1;
+
+        u32Tail = s_u32TailPage;
+        do
+        {
+            if(KV_CollectStep(KV_GC_STEP_RECORDS, 1) != 0)
+                return -1;
+        }
+        while((s_u32TailPage == u32Tail) && (s_u32UsedCnt > 1));
+    }
+
+    if(KV_Program(u32Key, pvData, u32Len) != 0)
+        return -1;
+
+    return KV_Collect();
+}
+/// @endcond HIDDEN_SYMBOLS
+
+
+/**
+ * @brief      Open the key-value store
+ *
+ * @param[in]  u32Base     Start address of the store, usually FMC_ReadDataFlashBaseAddr(). It must be page aligned.
+ * @param[in]  u32PageCnt  Number of flash pages of the store. It must be 3 or more.
+ *
+ * @retval      0 Success
+ * @retval     -1 Wrong parameter
+ *
+ * @details    Pages are scanned from the oldest to the newest to build the index. Records not completed
+ *             before power off are ignored. Blank or foreign pages give an empty store, no erase is done here.
+ */
+int32_t KV_Init(uint32_t u32Base, uint32_t u32PageCnt)
+{
+    uint32_t i, u32Page, u32Addr, u32End, u32Size, u32Seq, u32Min = 0, u32Max = 0, u32Found = 0;
+
+    if((u32Base & (FMC_FLASH_PAGE_SIZE - 1)) || (u32PageCnt < 3))
+        return -1;
+
+    s_u32KvBase = u32Base;
+    s_u32KvPageCnt = u32PageCnt;
+    s_u32HeadPage = s_u32TailPage = 0;
+    s_u32UsedCnt = 0;
+    s_u32Seq = 0;
+    s_u32EraseCnt = 0;
+    memset(s_au32KvAddr, 0, sizeof(s_au32KvAddr));
+
+    /* The newest page is head and the oldest page is tail */
+    for(i = 0; i < u32PageCnt; i++)
+    {
+        if(!KV_IsPageValid(i))
+            continue;
+        u32Seq = M32(KV_PAGE_ADDR(i));
+        if(!u32Found || (u32Seq > u32Max))
+        {
+            u32Max = u32Seq;
+            s_u32HeadPage = i;
+        }
+        if(!u32Found || (u32Seq < u32Min))
+        {
+            u32Min = u32Seq;
+            s_u32TailPage = i;
+        }
+        u32Found = 1;
+    }
+
+    s_u32GcAddr = KV_PAGE_ADDR(s_u32TailPage) + KV_PAGE_HDR_SIZE;
+    if(!u32Found)
+        return 0;
+
+    s_u32Seq = u32Max;
+    s_u32UsedCnt = (s_u32HeadPage + u32PageCnt - s_u32TailPage) % u32PageCnt + 1;
+
+    /* Replay the records, later records replace earlier ones */
+    u32Addr = u32End = 0;
+    for(i = 0, u32Page = s_u32TailPage; i < s_u32UsedCnt; i++, u32Page = (u32Page + 1) % u32PageCnt)
+    {
+        u32Addr = KV_PAGE_ADDR(u32Page) + KV_PAGE_HDR_SIZE;
+        u32End = KV_PAGE_ADDR(u32Page) + FMC_FLASH_PAGE_SIZE;
+        if(!KV_IsPageValid(u32Page))
+            continue;
+
+        while((u32Size = KV_RecordSize(u32Addr, u32End)) != 0)
+        {
+            if(KV_IsCommitted(u32Addr, u32Size))
+                s_au32KvAddr[M32(u32Addr) & 0xFFFF] = (M32(u32Addr) & 0xFF0000) ? u32Addr : 0;
+            u32Addr += u32Size;
+        }
+    }
+
+    /* Append after the last record of the head page only if the rest of the page is blank */
+    s_u32WriteAddr = u32Addr;
+    for(; u32Addr < u32End; u32Addr += 4)
+    {
+        if(M32(u32Addr) != 0xFFFFFFFFul)
+        {
+            s_u32WriteAddr = u32End;
+            break;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      Read the value of a key
+ *
+ * @param[in]  u32Key  The key, 0 to KV_MAX_KEYS - 1
+ * @param[out] pvBuf   Buffer for the value
+ * @param[in]  u32Len  Size of pvBuf in bytes. A longer value is truncated.
+ *
+ * @retval     >=0 Length of the value
+ * @retval     -1  The key is not found
+ */
+int32_t KV_Read(uint32_t u32Key, void *pvBuf, uint32_t u32Len)
+{
+    uint32_t u32Addr, u32Size;
+
+    if(u32Key >= KV_MAX_KEYS)
+        return -1;
+
+    u32Addr = s_au32KvAddr[u32Key];
+    if(u32Addr == 0)
+        return -1;
+
+    u32Size = (M32(u32Addr) >> 16) & 0xFF;
+    memcpy(pvBuf, (const void *)(u32Addr + 4), (u32Len < u32Size) ? u32Len : u32Size);
+
+    return (int32_t)u32Size;
+}
+
+/**
+ * @brief      Write the value of a key
+ *
+ * @param[in]  u32Key  The key, 0 to KV_MAX_KEYS - 1
+ * @param[in]  pvData  The value
+ * @param[in]  u32Len  Length of the value in bytes, 1 to KV_MAX_VALUE_LEN
+ *
+ * @retval      0 Success
+ * @retval     -1 Wrong parameter, the store is full or flash program/erase failed
+ *
+ * @details    Nothing is programmed if the value is not changed. The old value stays valid until the new
+ *             record is completed, so a power off during the write gives either the old or the new value.
+ */
+int32_t KV_Write(uint32_t u32Key, const void *pvData, uint32_t u32Len)
+{
+    uint32_t u32Addr;
+
+    if((s_u32KvPageCnt == 0) || (u32Key >= KV_MAX_KEYS) || (pvData == NULL) || (u32Len == 0) ||
+            (u32Len > KV_MAX_VALUE_LEN))
+        return -1;
+
+    u32Addr = s_au32KvAddr[u32Key];
+    if(u32Addr && (((M32(u32Addr) >> 16) & 0xFF) == u32Len) && (memcmp((const void *)(u32Addr + 4), pvData, u32Len) == 0))
+        return 0;
+
+    return KV_Update(u32Key, pvData, u32Len);
+}
+
+/**
+ * @brief      Delete a key
+ *
+ * @param[in]  u32Key  The key, 0 to KV_MAX_KEYS - 1
+ *
+ * @retval      0 Success
+ * @retval     -1 Wrong parameter, the store is full or flash program/erase failed
+ */
+int32_t KV_Delete(uint32_t u32Key)
+{
+    if((s_u32KvPageCnt == 0) || (u32Key >= KV_MAX_KEYS))
+        return -1;
+
+    if(s_au32KvAddr[u32Key] == 0)
+        return 0;
+
+    return KV_Update(u32Key, NULL, 0);
+}
+
+/**
+ * @brief      Run one step of garbage collection
+ *
+ * @retval      0 Success
+ * @retval     -1 Flash program/erase failed
+ *
+ * @details    KV_Write runs a step after each write while fewer than 3 pages are free. Calling this function
+ *             when the application is idle moves that work, and the page erases, out of KV_Write.
+ */
+int32_t KV_Collect(void)
+{
+    if((s_u32UsedCnt < 2) || (KV_FREE_PAGES() >= KV_GC_FREE_PAGES))
+        return 0;
+
+    return KV_CollectStep(KV_GC_STEP_RECORDS, 0);
+}
+
+/**
+ * @brief      Get the number of page erases done since KV_Init
+ *
+ * @return     Number of page erases
+ */
+uint32_t KV_GetEraseCount(void)
+{
+    return s_u32EraseCnt;
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
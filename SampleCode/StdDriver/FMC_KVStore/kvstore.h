@@ -0,0 +1,36 @@
+/**************************************************************************//**
+ * @file     kvstore.h
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 16/10/25 4:29p $
+ * @brief    Log-structured key-value store on Data Flash header file
+ *
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#ifndef __KVSTORE_H__
+#define __KVSTORE_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define KV_MAX_KEYS             64      /* Keys are 0 to KV_MAX_KEYS - 1. The index takes 4 bytes of SRAM per key. */
+#define KV_MAX_VALUE_LEN        64      /* Maximum value length in bytes, up to 255 */
+#define KV_GC_STEP_RECORDS      4       /* Records of the oldest page checked after each write during collection */
+
+int32_t KV_Init(uint32_t u32Base, uint32_t u32PageCnt);
+int32_t KV_Read(uint32_t u32Key, void *pvBuf, uint32_t u32Len);
+int32_t KV_Write(uint32_t u32Key, const void *pvData, uint32_t u32Len);
+int32_t KV_Delete(uint32_t u32Key);
+int32_t KV_Collect(void);
+uint32_t KV_GetEraseCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* __KVSTORE_H__ */
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,210 @@
+/******************************************************************************
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 16/10/25 4:29p $
+ * @brief    Show how to keep frequently updated settings in Data Flash by a log-structured key-value store.
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NUC1261.h"
+#include "kvstore.h"
+
+#define PLLCTL_SETTING      CLK_PLLCTL_72MHz_HXT
+#define PLL_CLOCK           72000000
+
+#define DATA_FLASH_BASE     0x1E000     /* The last 4 pages of 128 KB APROM */
+#define KV_PAGE_CNT         4
+
+#define KEY_BOOT_COUNT      0
+#define KEY_COUNTER         1
+#define KEY_SETTING         2
+
+#define TEST_UPDATES        20000
+
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable HIRC clock (Internal RC 22.1184MHz) */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Wait for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Select HCLK clock source as HIRC and and HCLK source divider as 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Set PLL to Power-down mode and PLLSTB bit in CLK_STATUS register will be cleared by hardware.*/
+    CLK_DisablePLL();
+
+    /* Enable HXT clock (external XTAL 12MHz) */
+    CLK_EnableXtalRC(CLK_PWRCTL_HXTEN_Msk);
+
+    /* Wait for HXT clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HXTSTB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+
+    /* Select UART module clock source as HXT and UART module clock divider as 1 */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HXT, CLK_CLKDIV0_UART(1));
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set PA multi-function pins for UART0 RXD and TXD */
+    SYS->GPA_MFPL &= ~(SYS_GPA_MFPL_PA3MFP_Msk | SYS_GPA_MFPL_PA2MFP_Msk);
+    SYS->GPA_MFPL |= (SYS_GPA_MFPL_PA3MFP_UART0_RXD | SYS_GPA_MFPL_PA2MFP_UART0_TXD);
+}
+
+void UART_Init()
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    UART_Open(UART0, 115200);
+}
+
+static int  SetDataFlashBase(uint32_t u32DFBA)
+{
+    uint32_t au32Config[2];
+
+    /* Read current User Configuration */
+    FMC_ReadConfig(au32Config, 2);
+
+    /* Just return when Data Flash has been enabled at u32DFBA */
+    if(!(au32Config[0] & 0x1) && (au32Config[1] == u32DFBA))
+        return 0;
+
+    /* Enable User Configuration Update */
+    FMC_EnableConfigUpdate();
+
+    /* Erase User Configuration */
+    FMC_Erase(FMC_CONFIG_BASE);
+
+    /* Write User Configuration to Enable Data Flash */
+    au32Config[0] &= ~0x1;
+    au32Config[1] = u32DFBA;
+
+    if(FMC_WriteConfig(au32Config, 2))
+        return -1;
+
+    printf("\nSet Data Flash base as 0x%x.\n", FMC_ReadDataFlashBaseAddr());
+
+    /* Perform chip reset to make new User Config take effect */
+    SYS->IPRST0 |= SYS_IPRST0_CHIPRST_Msk;
+
+    return 0;
+}
+
+int main()
+{
+    uint32_t i, u32Boot, u32Counter, u32Erase, au32Setting[4];
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    SYS_Init();
+    UART_Init();
+
+    /*
+        This sample keeps a boot counter, a frequently updated counter and a setting block in Data Flash.
+        Each update appends a small record, a page is erased only after it is filled with old records.
+    */
+
+    printf("\n\n");
+    printf("+----------------------------------------+\n");
+    printf("|        FMC Key-Value Store Sample      |\n");
+    printf("+----------------------------------------+\n");
+
+    /* Enable FMC ISP function */
+    FMC_Open();
+
+    if(SetDataFlashBase(DATA_FLASH_BASE) < 0)
+    {
+        printf("Failed to set Data Flash base address!\n");
+        goto lexit;
+    }
+
+    if(KV_Init(FMC_ReadDataFlashBaseAddr(), KV_PAGE_CNT) < 0)
+    {
+        printf("Failed to open key-value store!\n");
+        goto lexit;
+    }
+
+    /* The boot count is kept over reset and power off */
+    if(KV_Read(KEY_BOOT_COUNT, &u32Boot, sizeof(u32Boot)) != sizeof(u32Boot))
+        u32Boot = 0;
+    u32Boot++;
+    if(KV_Write(KEY_BOOT_COUNT, &u32Boot, sizeof(u32Boot)) < 0)
+    {
+        printf("Failed to write boot count!\n");
+        goto lexit;
+    }
+    printf("  Boot count ............................ [%d]\n", u32Boot);
+
+    if(KV_Read(KEY_COUNTER, &u32Counter, sizeof(u32Counter)) != sizeof(u32Counter))
+        u32Counter = 0;
+    printf("  Counter ............................... [%d]\n", u32Counter);
+
+    /* Update the counter every time and the setting block every 16 times */
+    printf("\n  Update counter %d times ...\n", TEST_UPDATES);
+    u32Erase = KV_GetEraseCount();
+    for(i = 0; i < TEST_UPDATES; i++)
+    {
+        u32Counter++;
+        if(KV_Write(KEY_COUNTER, &u32Counter, sizeof(u32Counter)) < 0)
+        {
+            printf("Failed to write counter!\n");
+            goto lexit;
+        }
+
+        if((i & 0xF) == 0)
+        {
+            au32Setting[0] = i;
+            au32Setting[1] = ~i;
+            au32Setting[2] = u32Counter;
+            au32Setting[3] = u32Boot;
+            if(KV_Write(KEY_SETTING, au32Setting, sizeof(au32Setting)) < 0)
+            {
+                printf("Failed to write setting!\n");
+                goto lexit;
+            }
+        }
+    }
+    u32Erase = KV_GetEraseCount() - u32Erase;
+
+    if((KV_Read(KEY_COUNTER, &i, sizeof(i)) != sizeof(i)) || (i != u32Counter))
+    {
+        printf("Counter verify failed!\n");
+        goto lexit;
+    }
+
+    printf("  Counter ............................... [%d]\n", u32Counter);
+    printf("  Page erases ........................... [%d]\n", u32Erase);
+    printf("  Page erases per 1000000 updates ....... [%d]\n", u32Erase * (1000000 / TEST_UPDATES));
+    printf("  Erases of each page per 1000000 updates [%d]\n", u32Erase * (1000000 / TEST_UPDATES) / KV_PAGE_CNT);
+    printf("  (A word rewritten in place needs one page erase per update)\n");
+
+lexit:
+
+    /* Disable FMC ISP function */
+    FMC_Close();
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    printf("\nFMC Sample Code Completed.\n");
+
+    while(1);
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
@@ -0,0 +1,220 @@
+/******************************************************************************
+ * @file     main.c
+ * @version  V3.00
+ * $Revision: 1 $
+ * $Date: 16/10/25 4:29p $
+ * @brief    Show how to run functions from SRAM by RAMFUNC and report the flash wait states saved.
+ * @note
+ * Copyright (C) 2016 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NUC1261.h"
+
+#define PLLCTL_SETTING      CLK_PLLCTL_72MHz_HXT
+#define PLL_CLOCK           72000000
+
+#define TEST_LEN            256
+
+/* RAMFUNC region given by the linker */
+#if defined (__CC_ARM)
+extern uint32_t Image$$RW_RAMFUNC$$Base[], Image$$RW_RAMFUNC$$Length[];
+#define RAMFUNC_BASE        ((uint32_t)Image$$RW_RAMFUNC$$Base)
+#define RAMFUNC_SIZE        ((uint32_t)Image$$RW_RAMFUNC$$Length)
+#elif defined (__ICCARM__)
+#pragma section = ".textrw"
+#define RAMFUNC_BASE        ((uint32_t)__section_begin(".textrw"))
+#define RAMFUNC_SIZE        ((uint32_t)__section_size(".textrw"))
+#else
+extern uint32_t __ramfunc_start__[], __ramfunc_end__[];
+#define RAMFUNC_BASE        ((uint32_t)__ramfunc_start__)
+#define RAMFUNC_SIZE        ((uint32_t)__ramfunc_end__ - (uint32_t)__ramfunc_start__)
+#endif
+
+typedef uint32_t (*PFN_KERNEL)(void);
+
+typedef struct
+{
+    const char *pcName;
+    PFN_KERNEL pfnFlash;
+    PFN_KERNEL pfnSram;
+} S_KERNEL_T;
+
+int16_t g_ai16A[TEST_LEN], g_ai16B[TEST_LEN];
+uint8_t g_au8Data[TEST_LEN];
+
+/* Each kernel is built twice from the same source, once in flash and once in SRAM */
+#define DOT_PRODUCT(FuncName)                                               \
+uint32_t FuncName(void)                                                     \
+{                                                                           \
+    int32_t i32Sum = 0;                                                     \
+    uint32_t i;                                                             \
+                                                                            \
+    for(i = 0; i < TEST_LEN; i++)                                           \
+        i32Sum += (int32_t)g_ai16A[i] * g_ai16B[i];                         \
+    return (uint32_t)i32Sum;                                                \
+}
+
+#define CRC16(FuncName)                                                     \
+uint32_t FuncName(void)                                                     \
+{                                                                           \
+    uint32_t u32Crc = 0xFFFF, i, j;                                         \
+                                                                            \
+    for(i = 0; i < TEST_LEN; i++)                                           \
+    {                                                                       \
+        u32Crc ^= (uint32_t)g_au8Data[i] << 8;                              \
+        for(j = 0; j < 8; j++)                                              \
+        {                                                                   \
+            if(u32Crc & 0x8000)                                             \
+                u32Crc = ((u32Crc << 1) ^ 0x1021) & 0xFFFF;                 \
+            else                                                            \
+                u32Crc = (u32Crc << 1) & 0xFFFF;                            \
+        }                                                                   \
+    }                                                                       \
+    return u32Crc;                                                          \
+}
+
+DOT_PRODUCT(DotProduct_Flash)
+RAMFUNC DOT_PRODUCT(DotProduct_Sram)
+CRC16(Crc16_Flash)
+RAMFUNC CRC16(Crc16_Sram)
+
+static const S_KERNEL_T s_asKernel[] =
+{
+    {"DotProduct", DotProduct_Flash, DotProduct_Sram},
+    {"Crc16     ", Crc16_Flash, Crc16_Sram},
+};
+
+
+void SYS_Init(void)
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init System Clock                                                                                       */
+    /*---------------------------------------------------------------------------------------------------------*/
+
+    /* Enable HIRC clock (Internal RC 22.1184MHz) */
+    CLK_EnableXtalRC(CLK_PWRCTL_HIRCEN_Msk);
+
+    /* Wait for HIRC clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HIRCSTB_Msk);
+
+    /* Select HCLK clock source as HIRC and and HCLK source divider as 1 */
+    CLK_SetHCLK(CLK_CLKSEL0_HCLKSEL_HIRC, CLK_CLKDIV0_HCLK(1));
+
+    /* Set PLL to Power-down mode and PLLSTB bit in CLK_STATUS register will be cleared by hardware.*/
+    CLK_DisablePLL();
+
+    /* Enable HXT clock (external XTAL 12MHz) */
+    CLK_EnableXtalRC(CLK_PWRCTL_HXTEN_Msk);
+
+    /* Wait for HXT clock ready */
+    CLK_WaitClockReady(CLK_STATUS_HXTSTB_Msk);
+
+    /* Set core clock as PLL_CLOCK from PLL */
+    CLK_SetCoreClock(PLL_CLOCK);
+
+    /* Enable UART module clock */
+    CLK_EnableModuleClock(UART0_MODULE);
+
+    /* Select UART module clock source as HXT and UART module clock divider as 1 */
+    CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HXT, CLK_CLKDIV0_UART(1));
+
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init I/O Multi-function                                                                                 */
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Set PA multi-function pins for UART0 RXD and TXD */
+    SYS->GPA_MFPL &= ~(SYS_GPA_MFPL_PA3MFP_Msk | SYS_GPA_MFPL_PA2MFP_Msk);
+    SYS->GPA_MFPL |= (SYS_GPA_MFPL_PA3MFP_UART0_RXD | SYS_GPA_MFPL_PA2MFP_UART0_TXD);
+}
+
+void UART_Init()
+{
+    /*---------------------------------------------------------------------------------------------------------*/
+    /* Init UART                                                                                               */
+    /*---------------------------------------------------------------------------------------------------------*/
+    UART_Open(UART0, 115200);
+}
+
+/* Return the HCLK cycles taken by pfnKernel */
+static uint32_t MeasureCycles(PFN_KERNEL pfnKernel)
+{
+    uint32_t u32Start;
+
+    SysTick->LOAD = 0xFFFFFF;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    u32Start = SysTick->VAL;
+    pfnKernel();
+
+    return (u32Start - SysTick->VAL) & 0xFFFFFF;
+}
+
+static void ReportCycles(void)
+{
+    uint32_t i, u32Flash, u32Sram;
+
+    for(i = 0; i < sizeof(s_asKernel) / sizeof(s_asKernel[0]); i++)
+    {
+        /* The first run fills the flash cache */
+        MeasureCycles(s_asKernel[i].pfnFlash);
+        u32Flash = MeasureCycles(s_asKernel[i].pfnFlash);
+        u32Sram = MeasureCycles(s_asKernel[i].pfnSram);
+
+        printf("  %s   %8d     %8d     %8d (%d%%)\n", s_asKernel[i].pcName, u32Flash, u32Sram,
+               (int32_t)(u32Flash - u32Sram), (int32_t)(u32Flash - u32Sram) * 100 / (int32_t)u32Flash);
+    }
+}
+
+int main()
+{
+    uint32_t i, u32Addr;
+
+    /* Unlock protected registers */
+    SYS_UnlockReg();
+
+    SYS_Init();
+    UART_Init();
+
+    printf("\n\n");
+    printf("+----------------------------------------+\n");
+    printf("|        FMC RAMFUNC Sample Code         |\n");
+    printf("+----------------------------------------+\n");
+
+    for(i = 0; i < TEST_LEN; i++)
+    {
+        g_ai16A[i] = (int16_t)(i * 37 - 4000);
+        g_ai16B[i] = (int16_t)(1000 - i * 13);
+        g_au8Data[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    /* Functions with RAMFUNC are copied to SRAM before main() */
+    printf("\n  RAMFUNC region 0x%08x, %d bytes\n\n", RAMFUNC_BASE, RAMFUNC_SIZE);
+    for(i = 0; i < sizeof(s_asKernel) / sizeof(s_asKernel[0]); i++)
+    {
+        u32Addr = (uint32_t)s_asKernel[i].pfnSram & ~1ul;
+        printf("  %s_Sram at 0x%08x %s\n", s_asKernel[i].pcName, u32Addr,
+               ((u32Addr & 0xF0000000) == SRAM_BASE) ? "[SRAM]" : "[Flash, check linker script]");
+        if(s_asKernel[i].pfnFlash() != s_asKernel[i].pfnSram())
+            printf("  Result mismatch!\n");
+    }
+
+    /* Flash wait states are mostly hidden by the flash cache in small loops, show both cases */
+    printf("\n  HCLK %d Hz, cycles per %d elements\n", SystemCoreClock, TEST_LEN);
+    printf("  Kernel       Flash        SRAM         Saved\n");
+    printf("  Flash cache enabled:\n");
+    ReportCycles();
+
+    FMC->FTCTL |= FMC_FTCTL_CACHEOFF_Msk;
+    printf("  Flash cache disabled:\n");
+    ReportCycles();
+    FMC->FTCTL &= ~FMC_FTCTL_CACHEOFF_Msk;
+
+    /* Lock protected registers */
+    SYS_LockReg();
+
+    printf("\nFMC Sample Code Completed.\n");
+
+    while(1);
+}
+
+/*** (C) COPYRIGHT 2016 Nuvoton Technology Corp. ***/
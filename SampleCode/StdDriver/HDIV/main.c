@@ -70,6 +70,89 @@ void HDIV_Init(void)
     CLK->AHBCLK |= CLK_AHBCLK_HDIVCKEN_Msk;
 }
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Division benchmark                                                                                     */
+/*  The '/' operator calls the run-time division of hdiv.c, which uses HDIV while HDIV clock is enabled    */
+/*  and its bit-serial shift-subtract fallback while it is disabled. The fallback is not the toolchain     */
+/*  helper; remove hdiv.c from the project to measure that one.                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+#define BENCH_LOOPS     1000
+
+typedef struct
+{
+    char *pcName;
+    int32_t i32Signed;
+    uint32_t u32Dividend;
+    uint32_t u32Divisor;
+} S_DIV_CASE_T;
+
+static const S_DIV_CASE_T s_asDivCase[] =
+{
+    /* TIMER_Delay */
+    {"TIMER_Delay  SystemCoreClock / u32Clk", 0, 72000000, 12000000},
+    {"TIMER_Delay  1000000000 / u32Clk     ", 0, 1000000000, 12000000},
+    {"TIMER_Delay  (u32Usec * 1000) / nsec ", 0, 1000 * 1000, 83},
+    /* UART_Open */
+    {"UART_Open    MODE2_DIVIDER(115200)   ", 0, 12000000 + 57600, 115200},
+    {"UART_Open    clock / (divider + 1)   ", 0, 72000000, 2},
+    /* DSP */
+    {"DSP mean     q31 sum / blockSize     ", 1, (uint32_t)(-12345678), 64},
+    {"DSP          q15 x / y               ", 1, 0x12340000, 0x2345},
+};
+
+volatile uint32_t g_u32Dividend, g_u32Divisor;
+volatile uint32_t g_u32Result;
+
+uint32_t DivBench(const S_DIV_CASE_T *psCase)
+{
+    uint32_t i, u32Ticks;
+
+    g_u32Dividend = psCase->u32Dividend;
+    g_u32Divisor = psCase->u32Divisor;
+
+    SysTick->LOAD = 0xFFFFFF;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    if(psCase->i32Signed)
+    {
+        for(i = 0; i < BENCH_LOOPS; i++)
+            g_u32Result = (uint32_t)((int32_t)g_u32Dividend / (int32_t)g_u32Divisor);
+    }
+    else
+    {
+        for(i = 0; i < BENCH_LOOPS; i++)
+            g_u32Result = g_u32Dividend / g_u32Divisor;
+    }
+
+    u32Ticks = 0xFFFFFF - SysTick->VAL;
+    SysTick->CTRL = 0;
+
+    return u32Ticks;
+}
+
+void DivBenchAll(void)
+{
+    uint32_t i, u32Hw, u32Sw, u32ClkEn;
+
+    u32ClkEn = CLK->AHBCLK & CLK_AHBCLK_HDIVCKEN_Msk;
+
+    printf("Cycles per division (loop overhead included):\n");
+    printf("                                         HDIV  Bit-serial\n");
+    for(i = 0; i < sizeof(s_asDivCase) / sizeof(s_asDivCase[0]); i++)
+    {
+        CLK->AHBCLK |= CLK_AHBCLK_HDIVCKEN_Msk;
+        u32Hw = DivBench(&s_asDivCase[i]);
+        CLK->AHBCLK &= ~CLK_AHBCLK_HDIVCKEN_Msk;
+        u32Sw = DivBench(&s_asDivCase[i]);
+        printf("%s %6d %11d\n", s_asDivCase[i].pcName, u32Hw / BENCH_LOOPS, u32Sw / BENCH_LOOPS);
+    }
+    printf("Bit-serial is the shift-subtract fallback of hdiv.c, used while HDIV clock is disabled.\n");
+    printf("Divisors above 32767 (or unsigned dividends above 0x7FFFFFFF) use it in both columns.\n\n");
+
+    CLK->AHBCLK = (CLK->AHBCLK & ~CLK_AHBCLK_HDIVCKEN_Msk) | u32ClkEn;
+}
+
 /*---------------------------------------------------------------------------------------------------------*/
 /*  MAIN function                                                                                          */
 /*---------------------------------------------------------------------------------------------------------*/
@@ -94,6 +177,9 @@ int main(void)
 
     printf("12341 / 123 = %d\n", HDIV_Div(12341, 123));
     printf("12341 %% 123 = %d\n", HDIV_Mod(12341, 123));
+    printf("\n");
+
+    DivBenchAll();
 
     /* Lock protected registers */
     SYS_LockReg();
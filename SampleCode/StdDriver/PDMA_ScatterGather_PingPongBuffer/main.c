@@ -23,18 +23,34 @@ uint32_t g_au32SrcArray1[1] = {0xAAAAAAAA};
 uint32_t g_au32DestArray[1];
 uint32_t volatile g_u32IsTestOver = 0;
 uint32_t volatile g_u32TransferredCount = 0;
-uint32_t g_u32DMAConfig = 0;
-static uint32_t s_u32TableIndex = 0;
+S_PDMA_JOB_T g_sPingPongJob;
 
-typedef struct dma_desc_t
+/**
+ * @brief       Ping-pong job callback
+ *
+ * @param[in]   psJob       The pointer of PDMA job
+ * @param[in]   u32Status   PDMA_JOB_BUSY when a descriptor table is finished
+ *
+ * @return      None
+ *
+ * @details     Job scheduler has reloaded the finished descriptor table before the callback is called.
+ */
+void PingPongCallback(S_PDMA_JOB_T *psJob, uint32_t u32Status)
 {
-    uint32_t ctl;
-    uint32_t src;
-    uint32_t dest;
-    uint32_t offset;
-} DMA_DESC_T;
+    if(u32Status != PDMA_JOB_BUSY)
+        return;
 
-DMA_DESC_T DMA_DESC[2]; /* Descriptor table */
+    /* When finished a descriptor table then g_u32TransferredCount increases 1 */
+    g_u32TransferredCount++;
+
+    /* Check if PDMA has finished PDMA_TEST_COUNT tasks */
+    if(g_u32TransferredCount >= PDMA_TEST_COUNT)
+    {
+        /* Stop the ring and return its descriptor tables to job scheduler */
+        PDMA_JobCancel(psJob);
+        g_u32IsTestOver = 1;
+    }
+}
 
 /**
  * @brief       DMA IRQ
@@ -47,29 +63,7 @@ DMA_DESC_T DMA_DESC[2]; /* Descriptor table */
  */
 void PDMA_IRQHandler(void)
 {
-    /* Check channel transfer done status */
-    //if (PDMA_GET_TD_STS() == PDMA_TDSTS_TDIF4_Msk)
-    {
-        /* Reload PDMA Descriptor table configuration after transmission finished */
-        DMA_DESC[s_u32TableIndex].ctl = g_u32DMAConfig;
-        s_u32TableIndex ^= 1;
-        /* When finished a descriptor table then g_u32TransferredCount increases 1 */
-        g_u32TransferredCount++;
-
-        /* Check if PDMA has finished PDMA_TEST_COUNT tasks */
-        if(g_u32TransferredCount >= PDMA_TEST_COUNT)
-        {
-            /* Set PDMA into idle state by Descriptor table */
-            DMA_DESC[0].ctl &= ~PDMA_DSCT_CTL_OPMODE_Msk;
-            DMA_DESC[1].ctl &= ~PDMA_DSCT_CTL_OPMODE_Msk;
-            g_u32IsTestOver = 1;
-
-            /* Clear table empty flag of channel 4 */
-            PDMA_CLR_EMPTY_FLAG(PDMA_SCATSTS_TEMPTYF4_Msk);
-        }
-        /* Clear transfer done flag of channel 4 */
-        PDMA_CLR_TD_FLAG(PDMA_TDSTS_TDIF4_Msk);
-    }
+    PDMA_JobIRQHandler();
 }
 
 void SYS_Init(void)
@@ -157,14 +151,14 @@ int main(void)
     printf("+-----------------------------------------------------------------------+ \n");
 
     /* This sample will transfer data by looped around two descriptor tables from two different source to the same destination buffer in sequence.
-       And operation sequence will be table 1 -> table 2-> table 1 -> table 2 -> table 1 -> ... -> until PDMA configuration doesn't be reloaded. */
+       And operation sequence will be table 1 -> table 2-> table 1 -> table 2 -> table 1 -> ... -> until the job is cancelled. */
 
     /*--------------------------------------------------------------------------------------------------
       PDMA transfer configuration:
 
         Channel = 4
         Operation mode = scatter-gather mode
-        First scatter-gather descriptor table = DMA_DESC[0]
+        First scatter-gather descriptor table = table 1 of g_sPingPongJob
         Request source = PDMA_MEM(memory to memory)
 
         Transmission flow:
@@ -173,110 +167,55 @@ int main(void)
                                       PDMA_TEST_COUNT/2 times
            ------------------------                             -----------------------
           |                        | ------------------------> |                       |
-          |  DMA_DESC[0]           |                           |  DMA_DESC[1]          |
+          |  Job descriptor 1      |                           |  Job descriptor 2     |
           |  (Descriptor table 1)  |                           |  (Descriptor table 2) |
           |                        | <-----------------------  |                       |
            ------------------------                             -----------------------
 
         Note: The configuration of each table in SRAM need to be reloaded after transmission finished.
+              Job scheduler reloads it before PingPongCallback() is called.
     --------------------------------------------------------------------------------------------------*/
 
-    /* Open Channel 4 */
-    PDMA_Open(1 << 4);
+    /* Hand channel 4 to job scheduler. It enables transfer done interrupt and PDMA IRQ. */
+    PDMA_JobOpen(1 << 4);
 
-    /* Enable Scatter Gather mode, assign the first scatter-gather descriptor table is table 1,
-       and set transfer mode as memory to memory */
-    PDMA_SetTransferMode(4, PDMA_MEM, TRUE, (uint32_t)&DMA_DESC[0]);
+    /* Request source is PDMA_MEM(memory to memory) */
+    PDMA_JobInit(&g_sPingPongJob, PDMA_MEM, PingPongCallback, NULL);
 
-
-    /* Scatter-Gather descriptor table configuration in SRAM */
-    g_u32DMAConfig = \
-                     (0 << PDMA_DSCT_CTL_TXCNT_Pos) | /* Transfer count is 1 */ \
-                     PDMA_WIDTH_32 |  /* Transfer width is 32 bits(one word) */ \
-                     PDMA_SAR_FIX |   /* Source increment size is fixed(no increment) */ \
-                     PDMA_DAR_FIX |   /* Destination increment size is fixed(no increment) */ \
-                     PDMA_REQ_BURST | /* Transfer type is burst transfer type */ \
-                     PDMA_BURST_1 |   /* Burst size is 128. No effect in single transfer type */ \
-                     PDMA_OP_SCATTER; /* Operation mode is scatter-gather mode */
-    /*-----------------------------------------------------------------------------------------------------------------------------------------------------------
+    /* Transfer type is burst transfer type and burst size is 1.
        Note: PDMA_REQ_BURST is only supported in memory-to-memory transfer mode.
-             PDMA transfer type should be set as PDMA_REQ_SINGLE in memory-to-peripheral and peripheral-to-memory transfer mode,
-             then above code will be modified as follows:
-             g_u32DMAConfig = (0 << PDMA_DSCT_CTL_TXCNT_Pos) | PDMA_WIDTH_32 | PDMA_SAR_FIX | PDMA_DAR_FIX | PDMA_BURST_1 | PDMA_REQ_SINGLE | PDMA_OP_SCATTER;
-    -----------------------------------------------------------------------------------------------------------------------------------------------------------*/
+             Job scheduler uses PDMA_REQ_SINGLE for memory-to-peripheral and peripheral-to-memory jobs. */
+    g_sPingPongJob.u32Burst = PDMA_REQ_BURST | PDMA_BURST_1;
 
     /*------------------------------------------------------------------------------------------------------
-      Descriptor table 1 configuration:
+      Descriptor table 1 and 2 configuration:
 
-             g_au32SrcArray0               transfer 1 times    g_au32DestArray
+             g_au32SrcArray0 / 1           transfer 1 times    g_au32DestArray
              ---------------------------   ----------------->  ---------------------------
             |            [0]            |                     |            [0]            |
              ---------------------------                       ---------------------------
              \                         /                       \                         /
                    32bits(one word)                                  32bits(one word)
 
-        Operation mode = scatter-gather mode
-        Next descriptor table = DMA_DESC[1](Descriptor table 2)
-        transfer done and table empty interrupt = enable
-
         Transfer count = 1
         Transfer width = 32 bits(one word)
-        Source address = g_au32SrcArray0
         Source address increment size = fixed address(no increment)
-        Destination address = au8DestArray0
         Destination address increment size = fixed address(no increment)
-        Transfer type = burst transfer
 
         Total transfer length = 1 * 32 bits
     ------------------------------------------------------------------------------------------------------*/
-    DMA_DESC[0].ctl = g_u32DMAConfig;
-    /* Configure source address */
-    DMA_DESC[0].src = (uint32_t)g_au32SrcArray0; /* Ping-Pong buffer 1 */
-    /* Configure destination address */
-    DMA_DESC[0].dest = (uint32_t)&g_au32DestArray[0];
-    /* Configure next descriptor table address */
-    DMA_DESC[0].offset = (uint32_t)&DMA_DESC[1] - (PDMA->SCATBA); /* next operation table is table 2 */
+    PDMA_JobAddDesc(&g_sPingPongJob, PDMA_WIDTH_32, (uint32_t)g_au32SrcArray0, PDMA_SAR_FIX,
+                    (uint32_t)&g_au32DestArray[0], PDMA_DAR_FIX, 1);    /* Ping-Pong buffer 1 */
+    PDMA_JobAddDesc(&g_sPingPongJob, PDMA_WIDTH_32, (uint32_t)g_au32SrcArray1, PDMA_SAR_FIX,
+                    (uint32_t)&g_au32DestArray[0], PDMA_DAR_FIX, 1);    /* Ping-Pong buffer 2 */
 
-    /*------------------------------------------------------------------------------------------------------
-      Descriptor table 2 configuration:
+    /* Link table 2 back to table 1. Every table raises transfer done interrupt and is reloaded by job scheduler. */
+    PDMA_JobSetCyclic(&g_sPingPongJob);
 
-             g_au32SrcArray1               transfer 1 times    g_au32DestArray
-             ---------------------------   ----------------->  ---------------------------
-            |            [0]            |                     |            [0]            |
-             ---------------------------                       ---------------------------
-             \                         /                       \                         /
-                   32bits(one word)                                  32bits(one word)
-
-        Operation mode = scatter-gather mode
-        Next descriptor table = DMA_DESC[0](Descriptor table 1)
-        transfer done and table empty interrupt = enable
-
-        Transfer count = 1
-        Transfer width = 32 bits(one word)
-        Source address = g_au32SrcArray1
-        Source address increment size = fixed address(no increment)
-        Destination address = au8DestArray0
-        Destination address increment size = fixed address(no increment)
-        Transfer type = burst transfer
-
-        Total transfer length = 1 * 32 bits
-    ------------------------------------------------------------------------------------------------------*/
-    DMA_DESC[1].ctl = g_u32DMAConfig;
-    /* Configure source address */
-    DMA_DESC[1].src = (uint32_t)g_au32SrcArray1; /* Ping-Pong buffer 2 */
-    /* Configure destination address */
-    DMA_DESC[1].dest = (uint32_t)&g_au32DestArray[0];
-    /* Configure next descriptor table address */
-    DMA_DESC[1].offset = (uint32_t)&DMA_DESC[0] - (PDMA->SCATBA); /* next operation table is table 1 */
-
-
-    /* Enable transfer done interrupt */
-    PDMA_EnableInt(4, PDMA_INT_TRANS_DONE);
-    NVIC_EnableIRQ(PDMA_IRQn);
     g_u32IsTestOver = 0;
 
-    /* Start PDMA operatin */
-    PDMA_Trigger(4);
+    /* Start PDMA operation on channel 4 */
+    PDMA_JobSubmit(&g_sPingPongJob);
 
     while(1)
     {
@@ -40,7 +40,11 @@ uint8_t gu8ConfigDescriptor[] =
 {
     LEN_CONFIG,     /* bLength */
     DESC_CONFIG,    /* bDescriptorType */
+#if (UAC_SYNC_MODE == UAC_SYNC_FEEDBACK)
+    0xCB, 0x00,     /* wTotalLength */
+#else
     0xC2, 0x00,     /* wTotalLength */
+#endif
     0x03,           /* bNumInterfaces */
     0x01,           /* bConfigurationValue */
     0x00,           /* iConfiguration */
@@ -213,7 +217,11 @@ uint8_t gu8ConfigDescriptor[] =
     0x04,           /* bDescriptorType */
     0x02,           /* bInterfaceNumber */
     0x01,           /* bAlternateSetting */
+#if (UAC_SYNC_MODE == UAC_SYNC_FEEDBACK)
+    0x02,           /* bNumEndpoints */
+#else
     0x01,           /* bNumEndpoints */
+#endif
     0x01,           /* bInterfaceClass:AUDIO */
     0x02,           /* bInterfaceSubClass:AUDIOSTREAMING */
     0x00,           /* bInterfaceProtocol */
@@ -244,11 +252,19 @@ uint8_t gu8ConfigDescriptor[] =
     0x09,                       /* bLength */
     0x05,                       /* bDescriptorType */
     ISO_OUT_EP_NUM | EP_OUTPUT, /* bEndpointAddress */
+#if (UAC_SYNC_MODE == UAC_SYNC_FEEDBACK)
+    0x05,                       /* bmAttributes: Isochronous, asynchronous */
+#else
     0x0d,                       /* bmAttributes */
+#endif
     EP3_MAX_PKT_SIZE, 0x00,     /* wMaxPacketSize */
     0x01,                       /* bInterval */
     0x00,                       /* bRefresh */
+#if (UAC_SYNC_MODE == UAC_SYNC_FEEDBACK)
+    ISO_FB_EP_NUM | EP_INPUT,   /* bSynchAddress */
+#else
     0x00,                       /* bSynchAddress */
+#endif
 
     /* Class-spec AS ISO Audio Data endpoint Descriptor */
     0x07,           /* bLength */
@@ -257,6 +273,18 @@ uint8_t gu8ConfigDescriptor[] =
     0x80,           /* bmAttributes */
     0x00,           /* bLockDelayUnits */
     0x00, 0x00,     /* wLockDelay */
+
+#if (UAC_SYNC_MODE == UAC_SYNC_FEEDBACK)
+    /* Standard AS ISO Synch Endpoint, input, address 3, 10.14 feedback */
+    0x09,                       /* bLength */
+    0x05,                       /* bDescriptorType */
+    ISO_FB_EP_NUM | EP_INPUT,   /* bEndpointAddress */
+    0x11,                       /* bmAttributes: Isochronous, feedback */
+    EP4_MAX_PKT_SIZE, 0x00,     /* wMaxPacketSize */
+    0x01,                       /* bInterval */
+    FB_REFRESH,                 /* bRefresh */
+    0x00,                       /* bSynchAddress */
+#endif
 };
 
 /*!<USB Language String Descriptor */
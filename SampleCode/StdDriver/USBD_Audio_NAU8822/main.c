@@ -83,6 +83,7 @@ void SYS_Init(void)
     CLK_EnableModuleClock(TMR0_MODULE);
     CLK_EnableModuleClock(I2C0_MODULE);
     CLK_EnableModuleClock(SPI0_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
 
     /* Select module clock source */
     CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UARTSEL_HIRC, CLK_CLKDIV0_UART(1));
@@ -154,12 +155,16 @@ void I2C0_Init(void)
 
 
 
+void PDMA_IRQHandler(void)
+{
+    PDMA_JobIRQHandler();
+}
+
 /*---------------------------------------------------------------------------------------------------------*/
 /*  Main Function                                                                                          */
 /*---------------------------------------------------------------------------------------------------------*/
 int32_t main(void)
 {
-    int32_t i;
     uint32_t u32TrimInit;
 
     /*
@@ -249,14 +254,13 @@ int32_t main(void)
     }
 
 
-    /* Fill dummy data to I2S Tx for start I2S iteration */
-    for(i = 0; i < 4; i++)
-        SPII2S_WRITE_TX_FIFO(SPI0, 0);
-
-    /* Start I2S play iteration */
-    SPII2S_EnableInt(SPI0, SPII2S_FIFO_TXTH_INT_MASK | SPII2S_FIFO_RXTH_INT_MASK);
+    /* Start I2S play and record iteration by PDMA */
+    PDMA_JobOpen(I2S_PDMA_CH_MASK);
+    UAC_I2SPdmaStart();
 
     USBD_Open(&gsInfo, UAC_ClassRequest, (SET_INTERFACE_REQ)UAC_SetInterface);
+    /* SOF interrupt is used for USB trim and feedback */
+    USBD_ENABLE_INT(USBD_INT_SOF);
     /* Endpoint configuration */
     UAC_Init();
     USBD_Start();
@@ -268,9 +272,7 @@ int32_t main(void)
     u32TrimInit = M32(TRIM_INIT);
 
     /* Clear SOF */
-    USBD->INTSTS = USBD_INTSTS_SOFIF_Msk;
-
-    NVIC_EnableIRQ(SPI0_IRQn);
+    g_u8UsbSof = 0;
 
     while(1)
     {
@@ -282,10 +284,10 @@ int32_t main(void)
         if((SYS->IRCTCTL1 & SYS_IRCTCTL1_FREQSEL_Msk) != 2)
         {
             /* Start USB trim only when SOF */
-            if(USBD->INTSTS & USBD_INTSTS_SOFIF_Msk)
+            if(g_u8UsbSof)
             {
                 /* Clear SOF */
-                USBD->INTSTS = USBD_INTSTS_SOFIF_Msk;
+                g_u8UsbSof = 0;
 
                 /* Re-enable crystal-less */
                 SYS->IRCTCTL1 = HIRC48_AUTO_TRIM;
@@ -305,7 +307,7 @@ int32_t main(void)
             SYS->IRCTISTS = SYS_IRCTISTS_CLKERRIF1_Msk | SYS_IRCTISTS_TFAILIF1_Msk;
 
             /* Clear SOF */
-            USBD->INTSTS = USBD_INTSTS_SOFIF_Msk;
+            g_u8UsbSof = 0;
         }
 
 
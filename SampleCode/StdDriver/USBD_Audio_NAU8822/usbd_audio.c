@@ -48,16 +48,34 @@ typedef enum
 } RESAMPLE_STATE_T;
 
 /* Temp buffer for play and record */
-uint32_t g_au32UsbTmpBuf[((PLAY_RATE > REC_RATE) ? PLAY_RATE : REC_RATE) / 2000 * ((PLAY_CHANNELS > REC_CHANNELS) ? PLAY_CHANNELS : REC_CHANNELS)] = {0};
+uint32_t g_au32UsbTmpBuf[EP3_MAX_PKT_SIZE / 4] = {0};
 
-/* Recoder Buffer and its pointer */
-uint32_t g_au32PcmRecBuf[96] = {0};
-volatile uint32_t g_u32RecPos = 0;
+/* Recoder ring buffer and its pointer. PDMA writes whole segments at g_u32RecPos_In */
+uint32_t g_au32PcmRecBuf[REC_BUF_LEN] = {0};
+volatile uint32_t g_u32RecPos_In = 0;
+volatile uint32_t g_u32RecPos_Out = 0;
 
-/* Player Buffer and its pointer */
+/* Player Buffer and its pointer. PDMA reads whole segments after g_u32PlayPos_Out */
 uint32_t g_au32PcmPlayBuf[BUF_LEN] = {0};
-volatile uint32_t g_u32PlayPos_Out = 0;
-volatile uint32_t g_u32PlayPos_In = 0;
+volatile uint32_t g_u32PlayPos_Out = BUF_LEN - 1;
+volatile uint32_t g_u32PlayPos_In = BUF_LEN - 1;
+
+/* Cyclic PDMA jobs between I2S and play/record ring buffers. One descriptor for each segment. */
+static S_PDMA_JOB_T s_sPlayJob;
+static S_PDMA_JOB_T s_sRecJob;
+static uint32_t s_u32PlaySeg = 0;       /* Play segment in PDMA transfer */
+static uint32_t s_u32RecSeg = 0;        /* Record segment in PDMA transfer */
+static volatile uint32_t s_u32PlayFrames = 0;   /* Free running count of frames in finished play segments */
+
+volatile uint8_t g_u8UsbSof = 0;        /* Set by SOF interrupt */
+
+#if (UAC_SYNC_MODE == UAC_SYNC_FEEDBACK)
+static S_USBD_FB_T s_sPlayFb;           /* Feedback value control of play */
+#endif
+
+#if (PDMA_JOB_DESC_NUM < PLAY_SEG_NUM + REC_SEG_NUM)
+#error Define PDMA_JOB_DESC_NUM for the descriptors of play and record jobs in project setting
+#endif
 
 
 
@@ -73,6 +91,255 @@ uint32_t GetSamplesInBuf(void)
     return (uint32_t)i32Tmp;
 }
 
+#if (UAC_SYNC_MODE == UAC_SYNC_FEEDBACK)
+/* Free running count of frames sent to I2S, including the part of play segment in PDMA transfer */
+static uint32_t UAC_GetPlayedFrames(void)
+{
+    uint32_t u32Ch = (uint32_t)s_sPlayJob.i32Ch, u32Done, u32Remain;
+
+    /* Read again if the segment is finished while reading */
+    do
+    {
+        u32Done = PDMA_GET_TD_STS() & (1 << u32Ch);
+        u32Remain = (PDMA->DSCT[u32Ch].CTL & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos;
+    }
+    while(u32Done != (PDMA_GET_TD_STS() & (1 << u32Ch)));
+
+    /* A finished segment is not counted until PDMA interrupt is served */
+    return s_u32PlayFrames + (u32Done ? PLAY_SEG_LEN : 0) + (PLAY_SEG_LEN - 1 - u32Remain);
+}
+#endif
+
+static void UAC_PutPlayData(uint32_t u32Data)
+{
+    uint32_t u32Idx;
+
+    /* Check ring buffer turn around */
+    u32Idx = g_u32PlayPos_In + 1;
+    if(u32Idx >= BUF_LEN)
+        u32Idx = 0;
+
+    /* Check if buffer full */
+    if(u32Idx != g_u32PlayPos_Out)
+    {
+        /* Update play ring buffer only when it is not full */
+        g_au32PcmPlayBuf[u32Idx] = u32Data;
+
+        /* Update IN index */
+        g_u32PlayPos_In = u32Idx;
+    }
+}
+
+#if (UAC_SYNC_MODE == UAC_SYNC_RESAMPLE)
+/*
+    4-tap polyphase interpolation filter (Catmull-Rom cubic) in Q15.
+    Row n is for output between x[1] and x[2] at fraction n / RESAMPLE_PHASE_NUM.
+*/
+static const int16_t s_ai16ResampleCoef[RESAMPLE_PHASE_NUM][4] =
+{
+    {     0,  32767,      0,      0},
+    {  -126,  32763,    132,     -1},
+    {  -248,  32748,    272,     -4},
+    {  -366,  32724,    419,     -9},
+    {  -480,  32690,    574,    -16},
+    {  -591,  32646,    737,    -24},
+    {  -698,  32593,    907,    -34},
+    {  -801,  32531,   1084,    -46},
+    {  -900,  32460,   1268,    -60},
+    {  -996,  32380,   1459,    -75},
+    { -1088,  32291,   1657,    -92},
+    { -1176,  32194,   1861,   -111},
+    { -1262,  32088,   2072,   -130},
+    { -1343,  31974,   2289,   -152},
+    { -1421,  31852,   2512,   -175},
+    { -1496,  31722,   2741,   -199},
+    { -1568,  31584,   2976,   -224},
+    { -1636,  31438,   3217,   -251},
+    { -1702,  31285,   3463,   -278},
+    { -1764,  31124,   3715,   -307},
+    { -1822,  30956,   3972,   -338},
+    { -1878,  30780,   4235,   -369},
+    { -1931,  30598,   4502,   -401},
+    { -1981,  30408,   4775,   -434},
+    { -2028,  30212,   5052,   -468},
+    { -2072,  30009,   5334,   -503},
+    { -2113,  29800,   5620,   -539},
+    { -2152,  29584,   5911,   -575},
+    { -2188,  29362,   6206,   -612},
+    { -2221,  29135,   6504,   -650},
+    { -2251,  28901,   6807,   -689},
+    { -2279,  28661,   7114,   -728},
+    { -2304,  28416,   7424,   -768},
+    { -2327,  28165,   7738,   -808},
+    { -2347,  27909,   8055,   -849},
+    { -2365,  27648,   8375,   -890},
+    { -2380,  27382,   8698,   -932},
+    { -2394,  27110,   9025,   -973},
+    { -2405,  26834,   9354,  -1015},
+    { -2413,  26553,   9686,  -1058},
+    { -2420,  26268,  10020,  -1100},
+    { -2424,  25978,  10357,  -1143},
+    { -2427,  25684,  10696,  -1185},
+    { -2427,  25386,  11037,  -1228},
+    { -2426,  25084,  11380,  -1270},
+    { -2422,  24779,  11724,  -1313},
+    { -2416,  24469,  12071,  -1356},
+    { -2409,  24156,  12419,  -1398},
+    { -2400,  23840,  12768,  -1440},
+    { -2389,  23520,  13119,  -1482},
+    { -2377,  23198,  13470,  -1523},
+    { -2362,  22872,  13823,  -1565},
+    { -2346,  22544,  14176,  -1606},
+    { -2329,  22212,  14531,  -1646},
+    { -2310,  21879,  14885,  -1686},
+    { -2290,  21542,  15241,  -1725},
+    { -2268,  21204,  15596,  -1764},
+    { -2245,  20863,  15952,  -1802},
+    { -2220,  20521,  16307,  -1840},
+    { -2195,  20177,  16662,  -1876},
+    { -2168,  19830,  17018,  -1912},
+    { -2139,  19483,  17372,  -1948},
+    { -2110,  19134,  17726,  -1982},
+    { -2079,  18783,  18080,  -2016},
+    { -2048,  18432,  18432,  -2048},
+    { -2016,  18080,  18783,  -2079},
+    { -1982,  17726,  19134,  -2110},
+    { -1948,  17372,  19483,  -2139},
+    { -1912,  17018,  19830,  -2168},
+    { -1876,  16662,  20177,  -2195},
+    { -1840,  16307,  20521,  -2220},
+    { -1802,  15952,  20863,  -2245},
+    { -1764,  15596,  21204,  -2268},
+    { -1725,  15241,  21542,  -2290},
+    { -1686,  14885,  21879,  -2310},
+    { -1646,  14531,  22212,  -2329},
+    { -1606,  14176,  22544,  -2346},
+    { -1565,  13823,  22872,  -2362},
+    { -1523,  13470,  23198,  -2377},
+    { -1482,  13119,  23520,  -2389},
+    { -1440,  12768,  23840,  -2400},
+    { -1398,  12419,  24156,  -2409},
+    { -1356,  12071,  24469,  -2416},
+    { -1313,  11724,  24779,  -2422},
+    { -1270,  11380,  25084,  -2426},
+    { -1228,  11037,  25386,  -2427},
+    { -1185,  10696,  25684,  -2427},
+    { -1143,  10357,  25978,  -2424},
+    { -1100,  10020,  26268,  -2420},
+    { -1058,   9686,  26553,  -2413},
+    { -1015,   9354,  26834,  -2405},
+    {  -973,   9025,  27110,  -2394},
+    {  -932,   8698,  27382,  -2380},
+    {  -890,   8375,  27648,  -2365},
+    {  -849,   8055,  27909,  -2347},
+    {  -808,   7738,  28165,  -2327},
+    {  -768,   7424,  28416,  -2304},
+    {  -728,   7114,  28661,  -2279},
+    {  -689,   6807,  28901,  -2251},
+    {  -650,   6504,  29135,  -2221},
+    {  -612,   6206,  29362,  -2188},
+    {  -575,   5911,  29584,  -2152},
+    {  -539,   5620,  29800,  -2113},
+    {  -503,   5334,  30009,  -2072},
+    {  -468,   5052,  30212,  -2028},
+    {  -434,   4775,  30408,  -1981},
+    {  -401,   4502,  30598,  -1931},
+    {  -369,   4235,  30780,  -1878},
+    {  -338,   3972,  30956,  -1822},
+    {  -307,   3715,  31124,  -1764},
+    {  -278,   3463,  31285,  -1702},
+    {  -251,   3217,  31438,  -1636},
+    {  -224,   2976,  31584,  -1568},
+    {  -199,   2741,  31722,  -1496},
+    {  -175,   2512,  31852,  -1421},
+    {  -152,   2289,  31974,  -1343},
+    {  -130,   2072,  32088,  -1262},
+    {  -111,   1861,  32194,  -1176},
+    {   -92,   1657,  32291,  -1088},
+    {   -75,   1459,  32380,   -996},
+    {   -60,   1268,  32460,   -900},
+    {   -46,   1084,  32531,   -801},
+    {   -34,    907,  32593,   -698},
+    {   -24,    737,  32646,   -591},
+    {   -16,    574,  32690,   -480},
+    {    -9,    419,  32724,   -366},
+    {    -4,    272,  32748,   -248},
+    {    -1,    132,  32763,   -126}
+};
+
+static uint32_t s_au32ResampleHist[4] = {0};    /* Last 4 input frames. [3] is the newest one */
+static uint32_t s_u32ResamplePhase = 0;         /* Position of next output frame after s_au32ResampleHist[1]. Q16 */
+static int32_t s_i32FillAvg = (BUF_LEN / 2) << 8;   /* Average samples in play buffer. Q8 */
+
+static int16_t UAC_Interp(int32_t i32Shift, const int16_t *pi16Coef)
+{
+    int32_t i32Acc;
+
+    i32Acc  = (int16_t)(s_au32ResampleHist[0] >> i32Shift) * pi16Coef[0];
+    i32Acc += (int16_t)(s_au32ResampleHist[1] >> i32Shift) * pi16Coef[1];
+    i32Acc += (int16_t)(s_au32ResampleHist[2] >> i32Shift) * pi16Coef[2];
+    i32Acc += (int16_t)(s_au32ResampleHist[3] >> i32Shift) * pi16Coef[3];
+    i32Acc = (i32Acc + 0x4000) >> 15;
+
+    if(i32Acc > 32767)
+        i32Acc = 32767;
+    else if(i32Acc < -32768)
+        i32Acc = -32768;
+
+    return (int16_t)i32Acc;
+}
+
+/**
+ * @brief       Resample play data into play buffer
+ *
+ * @param[in]   pu32Src     Stereo 16-bit frames from USB
+ * @param[in]   u32Frames   Number of frames
+ *
+ * @return      None
+ *
+ * @details     The resample ratio is steered by samples in play buffer. When the buffer is more than
+ *              half full, input is consumed a little faster than output is produced and vice versa.
+ *              The correction is limited to +-RESAMPLE_MAX_PPM.
+ */
+static void UAC_Resample(uint32_t *pu32Src, uint32_t u32Frames)
+{
+    const int16_t *pi16Coef;
+    int32_t i32Err;
+    uint32_t u32Step, u32Phase;
+
+    /* Low pass the fill level. It steps by PLAY_SEG_LEN when PDMA finishes a segment, the step jitter would
+       modulate the played tone. The time constant (256 packets) is still far below the loop one (seconds). */
+    s_i32FillAvg += (((int32_t)GetSamplesInBuf() << 8) - s_i32FillAvg) >> 8;
+
+    /* Step of input position for each output frame. Q16. Full correction at 1/4 buffer error */
+    i32Err = (s_i32FillAvg >> 8) - BUF_LEN / 2;
+    if(i32Err > BUF_LEN / 4)
+        i32Err = BUF_LEN / 4;
+    else if(i32Err < -(BUF_LEN / 4))
+        i32Err = -(BUF_LEN / 4);
+    u32Step = 65536 + i32Err * (65536 * RESAMPLE_MAX_PPM / 1000) / (BUF_LEN / 4 * 1000);
+
+    u32Phase = s_u32ResamplePhase;
+    while(u32Frames--)
+    {
+        s_au32ResampleHist[0] = s_au32ResampleHist[1];
+        s_au32ResampleHist[1] = s_au32ResampleHist[2];
+        s_au32ResampleHist[2] = s_au32ResampleHist[3];
+        s_au32ResampleHist[3] = *pu32Src++;
+
+        /* Output all frames located between s_au32ResampleHist[1] and s_au32ResampleHist[2] */
+        while(u32Phase < 65536)
+        {
+            pi16Coef = s_ai16ResampleCoef[(u32Phase * RESAMPLE_PHASE_NUM) >> 16];
+            UAC_PutPlayData((uint16_t)UAC_Interp(0, pi16Coef) | ((uint32_t)(uint16_t)UAC_Interp(16, pi16Coef) << 16));
+            u32Phase += u32Step;
+        }
+        u32Phase -= 65536;
+    }
+    s_u32ResamplePhase = u32Phase;
+}
+#endif
+
 /*--------------------------------------------------------------------------*/
 
 
@@ -139,6 +406,20 @@ void USBD_IRQHandler(void)
         }
     }
 
+//------------------------------------------------------------------
+    if(u32IntSts & USBD_INTSTS_SOF)
+    {
+        /* Clear event flag */
+        USBD_CLR_INT_FLAG(USBD_INTSTS_SOF);
+
+        g_u8UsbSof = 1;
+
+#if (UAC_SYNC_MODE == UAC_SYNC_FEEDBACK)
+        if(g_u8PlayEn)
+            USBD_FbSOF(&s_sPlayFb, UAC_GetPlayedFrames(), (int32_t)GetSamplesInBuf() - BUF_LEN / 2);
+#endif
+    }
+
 //------------------------------------------------------------------
     if(u32IntSts & USBD_INTSTS_USB)
     {
@@ -197,6 +478,9 @@ void USBD_IRQHandler(void)
         {
             /* Clear event flag */
             USBD_CLR_INT_FLAG(USBD_INTSTS_EP4);
+
+            // Isochronous IN feedback
+            EP4_Handler();
         }
 
         if(u32IntSts & USBD_INTSTS_EP5)
@@ -265,20 +549,21 @@ void EP3_Handler(void)
     int32_t i;
     uint8_t *pu8Buf;
     uint8_t *pu8Src;
-    uint32_t u32Idx;
 
     /* Get the address in USB buffer */
     pu8Src = (uint8_t *)((uint32_t)USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(EP3));
 
+    /* Get byte size of play data. It varies with feedback in asynchronous mode */
+    u32Len = USBD_GET_PAYLOAD_LEN(EP3) & ~3;
+    if(u32Len > EP3_MAX_PKT_SIZE)
+        u32Len = EP3_MAX_PKT_SIZE;
+
     /* Prepare for nex OUT packet */
     USBD_SET_PAYLOAD_LEN(EP3, EP3_MAX_PKT_SIZE);
 
     /* Get the temp buffer */
     pu8Buf = (uint8_t *)g_au32UsbTmpBuf;
 
-    /* Calculate byte size of play data */
-    u32Len = PLAY_RATE / 1000 * PLAY_CHANNELS * 2;
-
     /* Copy all data from USB buffer to SRAM buffer */
     /* We assume the source data are 4 bytes alignment. */
     for(i = 0; i < u32Len; i += 4)
@@ -291,32 +576,28 @@ void EP3_Handler(void)
 
     /* Calculate word length */
     u32Len = u32Len >> 2;
+#if (UAC_SYNC_MODE == UAC_SYNC_RESAMPLE)
+    UAC_Resample(g_au32UsbTmpBuf, u32Len);
+#else
     for(i = 0; i < u32Len; i++)
-    {
-        /* Check ring buffer turn around */
-        u32Idx = g_u32PlayPos_In + 1;
-        if(u32Idx >= BUF_LEN)
-            u32Idx = 0;
-
-        /* Check if buffer full */
-        if(u32Idx != g_u32PlayPos_Out)
-        {
-            /* Update play ring buffer only when it is not full */
-            g_au32PcmPlayBuf[u32Idx] = g_au32UsbTmpBuf[i];
-
-            /* Update IN index */
-            g_u32PlayPos_In = u32Idx;
-        }
-    }
-
-    if(g_u8PlayEn == 0)
-    {
-        /* Start play data output through I2S only when we have enough data in buffer */
-        if(GetSamplesInBuf() > BUF_LEN / 2)
-            g_u8PlayEn = 1;
-    }
-
+        UAC_PutPlayData(g_au32UsbTmpBuf[i]);
+#endif
+}
 
+/**
+ * @brief       EP4 Handler (ISO IN feedback interrupt handler)
+ *
+ * @param[in]   None
+ *
+ * @return      None
+ *
+ * @details     This function is used to prepare next feedback value after host read the last one.
+ */
+void EP4_Handler(void)
+{
+#if (UAC_SYNC_MODE == UAC_SYNC_FEEDBACK)
+    USBD_FbInHandler(&s_sPlayFb);
+#endif
 }
 
 
@@ -361,6 +642,14 @@ void UAC_Init(void)
     USBD_SET_EP_BUF_ADDR(EP3, EP3_BUF_BASE);
     /* trigger receive OUT data */
     USBD_SET_PAYLOAD_LEN(EP3, EP3_MAX_PKT_SIZE);
+
+#if (UAC_SYNC_MODE == UAC_SYNC_FEEDBACK)
+    /*****************************************************/
+    /* EP4 ==> Isochronous IN feedback endpoint, address 3 */
+    USBD_CONFIG_EP(EP4, USBD_CFG_EPMODE_IN | ISO_FB_EP_NUM | USBD_CFG_TYPE_ISO);
+    /* Buffer offset for EP4 */
+    USBD_SET_EP_BUF_ADDR(EP4, EP4_BUF_BASE);
+#endif
 }
 
 
@@ -662,6 +951,11 @@ void UAC_SetInterface(void)
         if(u32AltInterface == 1)
         {
             USBD_SET_PAYLOAD_LEN(EP3, EP3_MAX_PKT_SIZE);
+#if (UAC_SYNC_MODE == UAC_SYNC_FEEDBACK)
+            /* Start feedback from nominal rate */
+            USBD_FbOpen(&s_sPlayFb, EP4, PLAY_RATE, FB_REFRESH);
+            USBD_FbInHandler(&s_sPlayFb);
+#endif
             UAC_DeviceEnable(UAC_SPEAKER);
         }
         else
@@ -821,67 +1115,103 @@ void WAU8822_Setup(void)
 
 
 
-void SPI0_IRQHandler(void)
+/* Called from PDMA_JobIRQHandler after each play segment, when the job scheduler has re-armed its descriptor */
+static void UAC_PlaySegDone(S_PDMA_JOB_T *psJob, uint32_t u32Status)
 {
-    uint32_t u32I2SIntFlag;
-    uint32_t i, u32Idx;
+    uint32_t u32Out, i;
+    uint32_t *pu32Buf;
 
-    u32I2SIntFlag = SPI0->STATUS;//  I2S_GET_INT_FLAG(I2S, I2S_STATUS_I2STXINT_Msk | I2S_STATUS_I2SRXINT_Msk);
+    (void)psJob;
 
-    if(u32I2SIntFlag & SPI_STATUS_TXTHIF_Msk)
+    if(u32Status == PDMA_JOB_BUSY)
     {
+        /* Finished segment is free space now. Fill 0 in case it is played again before refilled */
+        pu32Buf = &g_au32PcmPlayBuf[s_u32PlaySeg * PLAY_SEG_LEN];
+        for(i = 0; i < PLAY_SEG_LEN; i++)
+            pu32Buf[i] = 0;
 
-        /* Fill 2 word data when it is Tx threshold interrupt */
-        for(i = 0; i < 2; i++)
-        {
-            /* Check buffer empty */
-            if((g_u32PlayPos_Out != g_u32PlayPos_In) && g_u8PlayEn)
-            {
+        /* Last word of finished segment */
+        u32Out = s_u32PlaySeg * PLAY_SEG_LEN + PLAY_SEG_LEN - 1;
 
-                /* Check ring buffer trun around */
-                u32Idx = g_u32PlayPos_Out + 1;
-                if(u32Idx >= BUF_LEN)
-                    u32Idx = 0;
-
-                /* Play to I2S */
-                SPII2S_WRITE_TX_FIFO(SPI0, g_au32PcmPlayBuf[u32Idx]);
-
-                /* Update OUT index */
-                g_u32PlayPos_Out = u32Idx;
-            }
-            else
-            {
-                /* Fill 0x0 when buffer is empty */
-                SPII2S_WRITE_TX_FIFO(SPI0, 0x00);
-                /* Buffer underrun. Disable play */
-                g_u8PlayEn = 0;
-            }
+        if(g_u8PlayEn == 0)
+        {
+            /* Keep buffer empty when play is stopped */
+            g_u32PlayPos_In = u32Out;
+        }
+        else if(GetSamplesInBuf() < PLAY_SEG_LEN)
+        {
+            /* Buffer underrun. Restart with half buffer (silence and remained data) ahead */
+            g_u32PlayPos_In = (u32Out + BUF_LEN / 2) % BUF_LEN;
         }
 
+        /* Update OUT index */
+        g_u32PlayPos_Out = u32Out;
+        s_u32PlayFrames += PLAY_SEG_LEN;
+
+        if(++s_u32PlaySeg >= PLAY_SEG_NUM)
+            s_u32PlaySeg = 0;
     }
+}
 
-    if(u32I2SIntFlag & SPI_STATUS_RXTHIF_Msk)
+/* Called from PDMA_JobIRQHandler after each record segment */
+static void UAC_RecSegDone(S_PDMA_JOB_T *psJob, uint32_t u32Status)
+{
+    (void)psJob;
+
+    if(u32Status == PDMA_JOB_BUSY)
     {
-        static int16_t i16Cnt = 0;
-        if((g_u32RecPos < 96) && g_u8RecEn)
-        {
+        if(++s_u32RecSeg >= REC_SEG_NUM)
+            s_u32RecSeg = 0;
+
+        /* Update IN index to first word of segment in transfer */
+        g_u32RecPos_In = s_u32RecSeg * REC_SEG_LEN;
 
-            g_au32PcmRecBuf[g_u32RecPos  ] = SPII2S_READ_RX_FIFO(SPI0);
-            g_au32PcmRecBuf[g_u32RecPos + 1] = SPII2S_READ_RX_FIFO(SPI0);
-            g_au32PcmRecBuf[g_u32RecPos + 2] = SPII2S_READ_RX_FIFO(SPI0);
-            g_au32PcmRecBuf[g_u32RecPos + 3] = SPII2S_READ_RX_FIFO(SPI0);
-            g_u32RecPos += 4;
-            if(i16Cnt > 512) i16Cnt = -512;
+        if(g_u8RecEn == 0)
+        {
+            /* Drop record data when record is stopped */
+            g_u32RecPos_Out = g_u32RecPos_In;
         }
-        else
+        else if(((g_u32RecPos_In - g_u32RecPos_Out + REC_BUF_LEN) % REC_BUF_LEN) > (REC_BUF_LEN - 2 * REC_SEG_LEN))
         {
-            SPII2S_READ_RX_FIFO(SPI0);
-            SPII2S_READ_RX_FIFO(SPI0);
-            SPII2S_READ_RX_FIFO(SPI0);
-            SPII2S_READ_RX_FIFO(SPI0);
+            /* Buffer overrun. Keep segment in transfer and next one free. Drop the oldest data */
+            g_u32RecPos_Out = (g_u32RecPos_In + 2 * REC_SEG_LEN) % REC_BUF_LEN;
         }
     }
+}
 
+/**
+  * @brief  UAC_I2SPdmaStart, start cyclic PDMA jobs between I2S and play/record buffers.
+  * @param  None.
+  * @retval None.
+  * @details Each job descriptor moves one segment of ring buffer and the job runs them as a ring, so I2S is
+  *          fed continuously and CPU only updates ring pointers per segment. The job scheduler must be opened
+  *          by PDMA_JobOpen() with two free channels, and PDMA_IRQHandler() must call PDMA_JobIRQHandler().
+  */
+void UAC_I2SPdmaStart(void)
+{
+    uint32_t i;
+
+    s_u32PlaySeg = 0;
+    s_u32RecSeg = 0;
+
+    PDMA_JobInit(&s_sPlayJob, PDMA_SPI0_TX, UAC_PlaySegDone, NULL);
+    for(i = 0; i < PLAY_SEG_NUM; i++)
+        PDMA_JobAddDesc(&s_sPlayJob, PDMA_WIDTH_32, (uint32_t)&g_au32PcmPlayBuf[i * PLAY_SEG_LEN], PDMA_SAR_INC,
+                        (uint32_t)&SPI0->TX, PDMA_DAR_FIX, PLAY_SEG_LEN);
+    PDMA_JobSetCyclic(&s_sPlayJob);
+
+    PDMA_JobInit(&s_sRecJob, PDMA_SPI0_RX, UAC_RecSegDone, NULL);
+    for(i = 0; i < REC_SEG_NUM; i++)
+        PDMA_JobAddDesc(&s_sRecJob, PDMA_WIDTH_32, (uint32_t)&SPI0->RX, PDMA_SAR_FIX,
+                        (uint32_t)&g_au32PcmRecBuf[i * REC_SEG_LEN], PDMA_DAR_INC, REC_SEG_LEN);
+    PDMA_JobSetCyclic(&s_sRecJob);
+
+    SPII2S_CLR_TX_FIFO(SPI0);
+    SPII2S_CLR_RX_FIFO(SPI0);
+    PDMA_JobSubmit(&s_sPlayJob);
+    PDMA_JobSubmit(&s_sRecJob);
+    SPII2S_ENABLE_TXDMA(SPI0);
+    SPII2S_ENABLE_RXDMA(SPI0);
 }
 
 
@@ -894,28 +1224,30 @@ void SPI0_IRQHandler(void)
 void UAC_SendRecData(void)
 {
     uint8_t *pu8Buf;
-    uint32_t u32Size;
-    int32_t i;
+    uint32_t u32Size, u32Out, u32Len;
 
     /* Get the address in USB buffer */
     pu8Buf = (uint8_t *)((uint32_t)USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(EP2));
 
-    /* Prepare the data to USB IN buffer */
-    u32Size = g_u32RecPos * 4;
-    if(u32Size > EP2_MAX_PKT_SIZE) u32Size = EP2_MAX_PKT_SIZE;
-    USBD_MemCopy(pu8Buf, (uint8_t *)g_au32PcmRecBuf, u32Size);
+    /* Get word size of record data in ring buffer */
+    u32Out = g_u32RecPos_Out;
+    u32Size = (g_u32RecPos_In - u32Out + REC_BUF_LEN) % REC_BUF_LEN;
+    if(u32Size > EP2_MAX_PKT_SIZE / 4) u32Size = EP2_MAX_PKT_SIZE / 4;
+
+    /* Prepare the data to USB IN buffer. It could be wrapped around in ring buffer */
+    u32Len = REC_BUF_LEN - u32Out;
+    if(u32Len > u32Size) u32Len = u32Size;
+    USBD_MemCopy(pu8Buf, (uint8_t *)&g_au32PcmRecBuf[u32Out], u32Len * 4);
+    if(u32Size > u32Len)
+        USBD_MemCopy(pu8Buf + u32Len * 4, (uint8_t *)g_au32PcmRecBuf, (u32Size - u32Len) * 4);
 
     /* Trigger ISO IN */
-    USBD_SET_PAYLOAD_LEN(EP2, u32Size);
+    USBD_SET_PAYLOAD_LEN(EP2, u32Size * 4);
 
+    /* Update OUT index only when it is not moved by overrun handling */
     __set_PRIMASK(1);
-    /*g_au32PcmRecBuf is not ring buffer. We need to copy remained data to buffer front */
-    g_u32RecPos -= (u32Size / 4);
-    if(g_u32RecPos)
-    {
-        for(i = 0; i < g_u32RecPos; i++)
-            g_au32PcmRecBuf[i] = g_au32PcmRecBuf[i + u32Size / 4];
-    }
+    if(g_u32RecPos_Out == u32Out)
+        g_u32RecPos_Out = (u32Out + u32Size) % REC_BUF_LEN;
     __set_PRIMASK(0);
 
 }
@@ -930,37 +1262,24 @@ void UAC_DeviceEnable(uint8_t u8Object)
 {
     if(u8Object == UAC_MICROPHONE)
     {
-        if(g_u8RecEn == 0)
-        {
-            /* Reset record buffer */
-            memset(g_au32PcmRecBuf, 0, sizeof(g_au32PcmRecBuf));
-            g_u32RecPos = 0;
-        }
-
-        /* Enable record hardware */
+        /* Reset record buffer. Record data is sent from next segment */
+        __set_PRIMASK(1);
+        g_u32RecPos_Out = g_u32RecPos_In;
         g_u8RecEn = 1;
-
-        SPII2S_CLR_RX_FIFO(SPI0);
-        SPII2S_EnableInt(SPI0, SPII2S_FIFO_RXTH_INT_MASK);
-        SPII2S_ENABLE_RX(SPI0);
+        __set_PRIMASK(0);
     }
     else
     {
         /* Reset Play buffer */
         if(g_u8PlayEn == 0)
         {
-            /* Fill 0x0 to buffer before playing for buffer operation smooth */
-            memset(g_au32PcmPlayBuf, 0, sizeof(g_au32PcmPlayBuf));
-            g_u32PlayPos_In = BUF_LEN / 2;
-            g_u32PlayPos_Out = 0;
+            /* Buffer is filled with 0x0. Start with half buffer ahead for buffer operation smooth */
+            __set_PRIMASK(1);
+            g_u32PlayPos_In = (g_u32PlayPos_Out + BUF_LEN / 2) % BUF_LEN;
+            __set_PRIMASK(0);
         }
 
-        /* Eanble play hardware */
         g_u8PlayEn = 1;
-
-        SPII2S_CLR_TX_FIFO(SPI0);
-        SPII2S_EnableInt(SPI0, SPII2S_FIFO_TXTH_INT_MASK);
-        SPII2S_ENABLE_TX(SPI0);
     }
 }
 
@@ -974,21 +1293,18 @@ void UAC_DeviceDisable(uint8_t u8Object)
 {
     if(u8Object ==  UAC_MICROPHONE)
     {
-        /* Disable record hardware/stop record */
+        /* Stop record. PDMA keeps running and data is dropped */
         g_u8RecEn = 0;
-
-        SPII2S_DisableInt(SPI0, SPII2S_FIFO_RXTH_INT_MASK);
-        SPII2S_DISABLE_RX(SPI0);
-        SPII2S_CLR_RX_FIFO(SPI0);
     }
     else
     {
-        /* Disable play hardware/stop play */
+        /* Stop play. PDMA keeps running and plays 0x0 */
         g_u8PlayEn = 0;
 
-        SPII2S_DisableInt(SPI0, SPII2S_FIFO_TXTH_INT_MASK);
-        SPII2S_DISABLE_TX(SPI0);
-        SPII2S_CLR_TX_FIFO(SPI0);
+        __set_PRIMASK(1);
+        memset(g_au32PcmPlayBuf, 0, sizeof(g_au32PcmPlayBuf));
+        g_u32PlayPos_In = g_u32PlayPos_Out;
+        __set_PRIMASK(0);
     }
 }
 
@@ -1040,7 +1356,7 @@ void AdjFreq(void)
     /* Get sample size in play buffer */
     u32Size = GetSamplesInBuf();
 
-
+#if (UAC_SYNC_MODE == UAC_SYNC_PLL)
     if(g_i32AdjFlag == 0)
     {
         /* Check if we need to adjust the frequency when we didn't in adjusting state */
@@ -1072,6 +1388,7 @@ void AdjFreq(void)
             g_i32AdjFlag = 0;
         }
     }
+#endif
 
     /* Show adjustment, buffer, volume status */
     if((i32PreFlag != g_i32AdjFlag) || (i32Cnt++ > 40000))
@@ -33,6 +33,26 @@
 #define BUF_LEN     48*64
 #define REC_LEN     REC_RATE / 1000
 
+/* I2S data is moved by cyclic PDMA jobs. One descriptor for each segment of ring buffer */
+#define I2S_PDMA_CH_MASK    ((1 << 1) | (1 << 2))           /* Job scheduler channels for play and record */
+#define PLAY_SEG_NUM    16                                  /* Number of segments in play buffer */
+#define PLAY_SEG_LEN    (BUF_LEN / PLAY_SEG_NUM)            /* Words of one play segment (4ms) */
+#define REC_SEG_NUM     4                                   /* Number of segments in record buffer */
+#define REC_SEG_LEN     (REC_RATE / 1000 * REC_CHANNELS / 2)/* Words of one record segment (1ms) */
+#define REC_BUF_LEN     (REC_SEG_LEN * REC_SEG_NUM)
+
+/* Method to track clock drift between USB host and I2S for play */
+#define UAC_SYNC_PLL        0       /* Adaptive. Tune codec clock by play buffer level */
+#define UAC_SYNC_RESAMPLE   1       /* Adaptive. Resample play data by play buffer level */
+#define UAC_SYNC_FEEDBACK   2       /* Asynchronous. Host paces play data by feedback endpoint */
+#ifndef UAC_SYNC_MODE
+#define UAC_SYNC_MODE       UAC_SYNC_FEEDBACK
+#endif
+
+#define FB_REFRESH          5       /* Feedback is refreshed every 2^FB_REFRESH ms */
+#define RESAMPLE_PHASE_NUM  128     /* Number of phases of polyphase interpolation filter. Don't Change */
+#define RESAMPLE_MAX_PPM    1500    /* Maximum rate correction in ppm. Above the 1000 ppm clock drift to be tracked. */
+
 /* Define Descriptor information */
 #if(PLAY_CHANNELS == 1)
 #define PLAY_CH_CFG     1
@@ -90,7 +110,8 @@
 #define EP0_MAX_PKT_SIZE    8
 #define EP1_MAX_PKT_SIZE    EP0_MAX_PKT_SIZE
 #define EP2_MAX_PKT_SIZE    256
-#define EP3_MAX_PKT_SIZE    PLAY_RATE*PLAY_CHANNELS*2/1000
+#define EP3_MAX_PKT_SIZE    ((PLAY_RATE / 1000 + 1) * PLAY_CHANNELS * 2)
+#define EP4_MAX_PKT_SIZE    3
 
 #define SETUP_BUF_BASE      0
 #define SETUP_BUF_LEN       8
@@ -98,22 +119,33 @@
 #define EP0_BUF_LEN         EP0_MAX_PKT_SIZE
 #define EP1_BUF_BASE        (SETUP_BUF_BASE + SETUP_BUF_LEN)
 #define EP1_BUF_LEN         EP1_MAX_PKT_SIZE
-#define EP2_BUF_BASE        (EP1_BUF_BASE + EP1_BUF_LEN)
+/* BUFSEG is in 8 bytes units, round up the buffer after one of other size */
+#define EP2_BUF_BASE        ((EP1_BUF_BASE + EP1_BUF_LEN + 7) & ~7)
 #define EP2_BUF_LEN         EP2_MAX_PKT_SIZE
-#define EP3_BUF_BASE        (EP2_BUF_BASE + EP2_BUF_LEN)
+#define EP3_BUF_BASE        ((EP2_BUF_BASE + EP2_BUF_LEN + 7) & ~7)
 #define EP3_BUF_LEN         EP3_MAX_PKT_SIZE
+#define EP4_BUF_BASE        ((EP3_BUF_BASE + EP3_BUF_LEN + 7) & ~7)
+#define EP4_BUF_LEN         EP4_MAX_PKT_SIZE
+
+/* USB SRAM is 512 bytes */
+#if ((EP4_BUF_BASE + EP4_BUF_LEN) > 512)
+#error Endpoint buffers exceed USB SRAM
+#endif
 
 /* Define the interrupt In EP number */
 #define ISO_IN_EP_NUM    0x01
 #define ISO_OUT_EP_NUM   0x02
+#define ISO_FB_EP_NUM    0x03
 
 /*-------------------------------------------------------------*/
 extern volatile uint32_t g_usbd_UsbAudioState;
+extern volatile uint8_t g_u8UsbSof;
 
 void UAC_DeviceEnable(uint8_t u8Object);
 void UAC_DeviceDisable(uint8_t u8Object);
 void UAC_SendRecData(void);
 void UAC_GetPlayData(int16_t *pi16src, int16_t i16Samples);
+void UAC_I2SPdmaStart(void);
 
 
 /*-------------------------------------------------------------*/
@@ -123,6 +155,7 @@ void UAC_SetInterface(void);
 
 void EP2_Handler(void);
 void EP3_Handler(void);
+void EP4_Handler(void);
 
 void WAU8822_Setup(void);
 void timer_init(void);
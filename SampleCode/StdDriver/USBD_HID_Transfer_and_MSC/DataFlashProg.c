@@ -79,29 +79,14 @@ void DataFlashRead(uint32_t addr, uint32_t size, uint32_t buffer)
 
 void FlashCacheFlush(void)
 {
-    int32_t i;
-
     if(g_u32Tag == (uint32_t) - 1)
         return;
 
     dbg("Flush %08x\n", g_u32Tag);
 
     /* We need to flush out cache before update it */
-    FMC->ISPADDR = g_u32Tag;
-    FMC->ISPCMD = 0x22;
-    FMC->ISPTRG = 1;
-    while(FMC->ISPTRG);
-    i = 0;
-    FMC->ISPCMD = 0x21;
-    FMC->ISPDAT = g_sectorBuf[i++];
-    do
-    {
-        FMC->ISPTRG = 1;
-        while(FMC->ISPTRG);
-        FMC->ISPADDR += 4;
-        FMC->ISPDAT = g_sectorBuf[i++];
-    }
-    while(i <= FLASH_PAGE_SIZE / 4);
+    FMC_ErasePages(g_u32Tag, FLASH_PAGE_SIZE);
+    FMC_WriteBuffer(g_u32Tag, g_sectorBuf, FLASH_PAGE_SIZE);
 
     g_u32Tag = (uint32_t) - 1;
 }
@@ -137,21 +122,8 @@ void DataFlashWrite(uint32_t addr, uint32_t size, uint32_t buffer)
                 dbg("Flush: TAG %08x\n", g_u32Tag);
 
                 /* We need to flush out cache before update it */
-                FMC->ISPADDR = g_u32Tag;
-                FMC->ISPCMD = 0x22;
-                FMC->ISPTRG = 1;
-                while(FMC->ISPTRG);
-                i = 0;
-                FMC->ISPCMD = 0x21;
-                FMC->ISPDAT = g_sectorBuf[i++];
-                do
-                {
-                    FMC->ISPTRG = 1;
-                    while(FMC->ISPTRG);
-                    FMC->ISPADDR += 4;
-                    FMC->ISPDAT = g_sectorBuf[i++];
-                }
-                while(i <= FLASH_PAGE_SIZE / 4);
+                FMC_ErasePages(g_u32Tag, FLASH_PAGE_SIZE);
+                FMC_WriteBuffer(g_u32Tag, g_sectorBuf, FLASH_PAGE_SIZE);
 
             }
 
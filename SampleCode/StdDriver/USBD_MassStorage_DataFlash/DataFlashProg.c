@@ -26,168 +26,240 @@
 /* Macro, type and constant definitions                                                                    */
 /*---------------------------------------------------------------------------------------------------------*/
 
-uint32_t g_u32Tag = (uint32_t) - 1;
-uint32_t g_sectorBuf[FLASH_PAGE_SIZE / 4];
-
 #define WRITE_THROUGH       0   //0: write through off. Better performance. 1: write through on. Slower.
 
+#define CACHE_TAG_INVALID   ((uint32_t) - 1)
 
-/* This is low level read function of USB Mass Storage */
-void DataFlashRead(uint32_t addr, uint32_t size, uint32_t buffer)
+/*---------------------------------------------------------------------------------------------------------*/
+/* Global variables                                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+
+/* Page cache. Each entry holds one flash page. g_au32Tag is the page base address or CACHE_TAG_INVALID. */
+uint32_t g_au32Tag[FLASH_CACHE_PAGE_NUM];
+uint32_t g_au32Age[FLASH_CACHE_PAGE_NUM];
+uint8_t g_au8Dirty[FLASH_CACHE_PAGE_NUM];
+uint32_t g_au32SectorBuf[FLASH_CACHE_PAGE_NUM][FLASH_PAGE_SIZE / 4];
+
+static uint32_t s_u32CacheClock = 0;    /* LRU time stamp */
+static uint32_t s_u32IdleCnt = 0;       /* Loops since last write */
+static uint32_t s_u32DirtyCnt = 0;      /* Number of dirty cache pages */
+static volatile uint32_t s_u32FlushReq = 0;     /* Flush requested by USB interrupt */
+
+
+static void FlashCacheInit(void)
 {
-    uint32_t alignAddr, offset, *pu32;
+    static uint8_t u8Init = 0;
     int32_t i;
 
+    if(u8Init)
+        return;
 
-    /* Modify the address to MASS_STORAGE_OFFSET */
-    addr += MASS_STORAGE_OFFSET;
+    for(i = 0; i < FLASH_CACHE_PAGE_NUM; i++)
+    {
+        g_au32Tag[i] = CACHE_TAG_INVALID;
+        g_au32Age[i] = 0;
+        g_au8Dirty[i] = 0;
+    }
+    u8Init = 1;
+}
+
+/* Return the cache entry holding the page at alignAddr, or -1 when it is not cached */
+static int32_t FlashCacheLookup(uint32_t alignAddr)
+{
+    int32_t i;
 
-    /* Get address base on page size alignment */
-    alignAddr = addr & (~(FLASH_PAGE_SIZE - 1));
+    for(i = 0; i < FLASH_CACHE_PAGE_NUM; i++)
+    {
+        if(g_au32Tag[i] == alignAddr)
+            return i;
+    }
+    return -1;
+}
 
-    /* Get the sector offset*/
-    offset = (addr & (FLASH_PAGE_SIZE - 1));
+/* Erase the page and program the cache entry back to flash */
+static void FlashCacheWriteBack(int32_t idx)
+{
+    uint32_t *pu32 = g_au32SectorBuf[idx];
+    int32_t i, j;
 
-    dbg("R[%08x] %x ALIGN[%08x] O %x\n", addr, size, alignAddr, offset);
+    dbg("Flush %08x\n", g_au32Tag[idx]);
 
-    pu32 = (uint32_t *)buffer;
+    FMC_ErasePages(g_au32Tag[idx], FLASH_PAGE_SIZE);
 
-#if WRITE_THROUGH
-    for(i = 0; i < size / 4; i++)
+    for(i = 0; i < FLASH_PAGE_SIZE / 4; i += FMC_MULTI_WORD_PROG_LEN / 4)
     {
-        /* Read from flash */
-        pu32[i] = M32(addr + i * 4);
+        /* Erased flash is already 0xFFFFFFFF. No need to program a block of it. */
+        for(j = 0; j < FMC_MULTI_WORD_PROG_LEN / 4; j++)
+        {
+            if(pu32[i + j] != 0xFFFFFFFF)
+                break;
+        }
+        if(j < FMC_MULTI_WORD_PROG_LEN / 4)
+            FMC_WriteBuffer(g_au32Tag[idx] + i * 4, &pu32[i], FMC_MULTI_WORD_PROG_LEN);
     }
-#else
-    for(i = 0; i < size / 4; i++)
+
+    g_au8Dirty[idx] = 0;
+    s_u32DirtyCnt--;
+}
+
+/* Get a cache entry for the page at alignAddr. The least recently used entry is evicted on miss.
+   If bLoad is 0, the caller overwrites the whole page and the flash contents are not loaded. */
+static int32_t FlashCacheGet(uint32_t alignAddr, int32_t bLoad)
+{
+    int32_t i, idx;
+
+    idx = FlashCacheLookup(alignAddr);
+    if(idx < 0)
     {
-        /* Read from cache */
-        if(((alignAddr + i * 4) >= g_u32Tag) && ((alignAddr + i * 4) < g_u32Tag + FLASH_PAGE_SIZE))
+        /* Pick a free entry first, otherwise the least recently used one */
+        idx = 0;
+        for(i = 0; i < FLASH_CACHE_PAGE_NUM; i++)
         {
-            offset = (addr + i * 4 - g_u32Tag) / 4;
-            pu32[i] = g_sectorBuf[offset];
+            if(g_au32Tag[i] == CACHE_TAG_INVALID)
+            {
+                idx = i;
+                break;
+            }
+            if(g_au32Age[i] < g_au32Age[idx])
+                idx = i;
         }
+
+        if(g_au8Dirty[idx])
+            FlashCacheWriteBack(idx);
+
+        if(bLoad)
+            memcpy(g_au32SectorBuf[idx], (void *)alignAddr, FLASH_PAGE_SIZE);
+
+        g_au32Tag[idx] = alignAddr;
+    }
+
+    g_au32Age[idx] = ++s_u32CacheClock;
+    return idx;
+}
+
+
+/* This is low level read function of USB Mass Storage */
+void DataFlashRead(uint32_t addr, uint32_t size, uint32_t buffer)
+{
+    uint32_t alignAddr, offset, len;
+    int32_t idx;
+
+    FlashCacheInit();
+
+    /* Modify the address to MASS_STORAGE_OFFSET */
+    addr += MASS_STORAGE_OFFSET;
+
+    dbg("R[%08x] %x\n", addr, size);
+
+    while(size > 0)
+    {
+        /* Get address base on page size alignment */
+        alignAddr = addr & (~(FLASH_PAGE_SIZE - 1));
+
+        /* Get the sector offset*/
+        offset = (addr & (FLASH_PAGE_SIZE - 1));
+
+        len = FLASH_PAGE_SIZE - offset;
+        if(size < len)
+            len = size;
+
+        /* Read whole run from cache if the page is cached, otherwise from flash directly */
+        idx = FlashCacheLookup(alignAddr);
+        if(idx >= 0)
+            memcpy((void *)buffer, (uint8_t *)g_au32SectorBuf[idx] + offset, len);
         else
-        {
-            /* Read from flash */
-            pu32[i] = M32(addr + i * 4);
-        }
+            memcpy((void *)buffer, (void *)addr, len);
+
+        size -= len;
+        addr += len;
+        buffer += len;
     }
-#endif
 }
 
 
+/* Write all dirty cache pages back to flash. Pages remain cached for reading. */
 void FlashCacheFlush(void)
 {
     int32_t i;
 
-    if(g_u32Tag == (uint32_t) - 1)
-        return;
+    FlashCacheInit();
+
+    for(i = 0; i < FLASH_CACHE_PAGE_NUM; i++)
+    {
+        if(g_au8Dirty[i])
+            FlashCacheWriteBack(i);
+    }
+    s_u32IdleCnt = 0;
+}
+
+/* Ask main loop to write back dirty pages at once. It is safe to call from interrupt, the flush itself
+   must not run there because main loop may be in the middle of DataFlashWrite. */
+void FlashCacheRequestFlush(void)
+{
+    s_u32FlushReq = 1;
+}
 
-    dbg("Flush %08x\n", g_u32Tag);
-
-    /* We need to flush out cache before update it */
-    FMC->ISPADDR = g_u32Tag;
-    FMC->ISPCMD = 0x22;
-    FMC->ISPTRG = 1;
-    while(FMC->ISPTRG);
-    i = 0;
-    FMC->ISPCMD = 0x21;
-    FMC->ISPDAT = g_sectorBuf[i++];
-    do
+/* Flush-on-idle hook. Call it from main loop. Dirty pages are written back after
+   FLASH_CACHE_IDLE_LOOPS calls without any write, or at once after FlashCacheRequestFlush(). */
+void FlashCacheIdle(void)
+{
+    if(s_u32FlushReq)
     {
-        FMC->ISPTRG = 1;
-        while(FMC->ISPTRG);
-        FMC->ISPADDR += 4;
-        FMC->ISPDAT = g_sectorBuf[i++];
+        s_u32FlushReq = 0;
+        FlashCacheFlush();
+        return;
     }
-    while(i <= FLASH_PAGE_SIZE / 4);
 
-    g_u32Tag = (uint32_t) - 1;
+    if(s_u32DirtyCnt == 0)
+        return;
+
+    if(++s_u32IdleCnt >= FLASH_CACHE_IDLE_LOOPS)
+        FlashCacheFlush();
 }
 
 void DataFlashWrite(uint32_t addr, uint32_t size, uint32_t buffer)
 {
     /* This is low level write function of USB Mass Storage */
-    int32_t len, i, offset;
-    uint32_t *pu32;
-    uint32_t alignAddr;
+    uint32_t alignAddr, offset, len;
+    int32_t idx;
+
+    FlashCacheInit();
 
     /* Modify the address to MASS_STORAGE_OFFSET */
     addr += MASS_STORAGE_OFFSET;
 
-    len = (int32_t)size;
-
-    do
+    while(size > 0)
     {
-
         /* Get address base on page size alignment */
         alignAddr = addr & (~(FLASH_PAGE_SIZE - 1));
 
         /* Get the sector offset*/
         offset = (addr & (FLASH_PAGE_SIZE - 1));
 
-        dbg("W[%08x] %x ALIGN[%08x] O %x\n", addr, size, alignAddr, offset);
-
-        /* check cache buffer */
-        if(g_u32Tag != alignAddr)
-        {
-            if(g_u32Tag != (uint32_t) - 1)
-            {
-                dbg("Flush: TAG %08x\n", g_u32Tag);
-
-                /* We need to flush out cache before update it */
-                FMC->ISPADDR = g_u32Tag;
-                FMC->ISPCMD = 0x22;
-                FMC->ISPTRG = 1;
-                while(FMC->ISPTRG);
-                i = 0;
-                FMC->ISPCMD = 0x21;
-                FMC->ISPDAT = g_sectorBuf[i++];
-                do
-                {
-                    FMC->ISPTRG = 1;
-                    while(FMC->ISPTRG);
-                    FMC->ISPADDR += 4;
-                    FMC->ISPDAT = g_sectorBuf[i++];
-                }
-                while(i <= FLASH_PAGE_SIZE / 4);
-
-            }
-
-
-            /* load data to cache buffer */
-            i = 0;
-            FMC->ISPADDR = alignAddr;
-            FMC->ISPCMD = 0;
-            do
-            {
-                FMC->ISPTRG = 1;
-                while(FMC->ISPTRG);
-                g_sectorBuf[i++] = FMC->ISPDAT;
-                FMC->ISPADDR += 4;
-            }
-            while(i <= FLASH_PAGE_SIZE / 4);
-            g_u32Tag = alignAddr;
-        }
-
-        /* Update the data */
-        pu32 = (uint32_t *)buffer;
         len = FLASH_PAGE_SIZE - offset;
         if(size < len)
             len = size;
 
-        for(i = 0; i < len / 4; i++)
+        dbg("W[%08x] %x ALIGN[%08x] O %x\n", addr, len, alignAddr, offset);
+
+        /* Sequential sectors of the same page are coalesced in the cache.
+           No need to load the page from flash if it is overwritten completely. */
+        idx = FlashCacheGet(alignAddr, (len != FLASH_PAGE_SIZE));
+
+        /* Update the data */
+        memcpy((uint8_t *)g_au32SectorBuf[idx] + offset, (void *)buffer, len);
+        if(g_au8Dirty[idx] == 0)
         {
-            g_sectorBuf[offset / 4 + i] = pu32[i];
+            g_au8Dirty[idx] = 1;
+            s_u32DirtyCnt++;
         }
 
         size -= len;
         addr += len;
         buffer += len;
-
     }
-    while(size > 0);
+
+    s_u32IdleCnt = 0;
 
 #if WRITE_THROUGH
     FlashCacheFlush();
@@ -13,6 +13,17 @@
 #define FLASH_PAGE_SIZE           2048
 #define BUFFER_PAGE_SIZE          2048
 
+#ifndef FLASH_CACHE_PAGE_NUM
+#define FLASH_CACHE_PAGE_NUM      2           /* Number of flash pages cached in SRAM. Each page takes FLASH_PAGE_SIZE bytes. */
+#endif
+#ifndef FLASH_CACHE_IDLE_LOOPS
+#define FLASH_CACHE_IDLE_LOOPS    0x100000    /* Write back dirty pages after main loop is idle for this many loops */
+#endif
+
+void FlashCacheFlush(void);
+void FlashCacheRequestFlush(void);
+void FlashCacheIdle(void);
+
 
 #endif  /* __DATA_FLASH_PROG_H__ */
 
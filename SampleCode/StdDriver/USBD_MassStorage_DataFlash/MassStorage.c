@@ -139,12 +139,11 @@ void USBD_IRQHandler(void)
         }
         if(u32State & USBD_STATE_SUSPEND)
         {
-            extern void FlashCacheFlush();
-
             /* Enable USB but disable PHY */
             USBD_DISABLE_PHY();
 
-            FlashCacheFlush();
+            /* Main loop writes back the cached pages */
+            FlashCacheRequestFlush();
 
             DBG_PRINTF("Suspend\n");
         }
@@ -217,6 +217,9 @@ int32_t main(void)
 #endif
 
         MSC_ProcessCmd();
+
+        /* Write back cached flash pages when host stops writing */
+        FlashCacheIdle();
     }
 }
 
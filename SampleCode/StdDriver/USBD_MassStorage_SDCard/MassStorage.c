@@ -138,12 +138,15 @@ void USBD_IRQHandler(void)
             USBD_ENABLE_USB();
             USBD_SwReset();
             g_u32OutToggle = g_u32OutSkip = 0;
+            /* Main loop ends the SD card stream of an aborted command */
+            SDCARD_RequestSync();
             DBG_PRINTF("Bus reset\n");
         }
         if(u32State & USBD_STATE_SUSPEND)
         {
             /* Enable USB but disable PHY */
             USBD_DISABLE_PHY();
+            SDCARD_RequestSync();
             DBG_PRINTF("Suspend\n");
         }
         if(u32State & USBD_STATE_RESUME)
@@ -759,6 +762,15 @@ void MSC_Write(void)
                     //DataFlashWrite(g_u32DataFlashStartAddr , len, (uint32_t)STORAGE_DATA_BUF);
                     MSC_WriteMedia(g_u32DataFlashStartAddr, len, (uint8_t *)STORAGE_DATA_BUF);
                 }
+
+                /* Finish multi-block write before reporting status */
+                if(SDCARD_Sync() == FALSE)
+                {
+                    /* MEDIUM ERROR, WRITE ERROR */
+                    g_au8SenseKey[0] = 0x03;
+                    g_au8SenseKey[1] = 0x0C;
+                    g_au8SenseKey[2] = 0x00;
+                }
             }
 
             g_u8BulkState = BULK_IN;
@@ -1204,6 +1216,9 @@ void MSC_AckCmd(void)
                     MSC_ReadTrig();
                     return;
                 }
+
+                /* All data is read. End CMD18, so the card does not read ahead past the command. */
+                SDCARD_Sync();
                 break;
             }
             case UFI_REQUEST_SENSE:
@@ -1241,6 +1256,10 @@ void MSC_AckCmd(void)
 
                 g_sCSW.dCSWDataResidue = tmp;
                 g_sCSW.bCSWStatus = 0;
+
+                /* Card rejected the written data */
+                if(((g_sCBW.u8OPCode == UFI_WRITE_10) || (g_sCBW.u8OPCode == UFI_WRITE_12)) && (g_au8SenseKey[0] == 0x03))
+                    g_sCSW.bCSWStatus = 1;
                 break;
             }
             case UFI_TEST_UNIT_READY:
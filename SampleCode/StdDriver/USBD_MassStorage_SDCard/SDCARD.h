@@ -37,6 +37,10 @@ extern "C"
 
 #define PHYSICAL_BLOCK_SIZE 512    /*!< 512 Erase group size = 16 MMC FLASH sectors */
 
+#define SD_PDMA_CH_MASK ((1 << 0) | (1 << 1)) /*!< PDMA channels of job scheduler. TX and RX jobs of a data block run together. */
+#define SD_PDMA_TX_REQ  PDMA_SPI1_TX    /*!< PDMA request source of SPI TX */
+#define SD_PDMA_RX_REQ  PDMA_SPI1_RX    /*!< PDMA request source of SPI RX */
+
 // Command table value definitions
 // Used in the MMC_Command_Exec function to
 // decode and execute MMC command requests
@@ -148,6 +152,9 @@ typedef struct
 */
 uint32_t SDCARD_Open(void);
 void SDCARD_Close(void);
+uint32_t SDCARD_Sync(void);
+void SDCARD_RequestSync(void);
+void SDCARD_Idle(void);
 uint32_t SDCARD_GetVersion(void);
 uint32_t MMC_Command_Exec(uint8_t cmd_loc, uint32_t argument, uint8_t *pchar, uint32_t* response);
 uint32_t GetLogicSector(void);
@@ -23,6 +23,56 @@
 
 static SPI_T    *g_pSPI = SPI1;
 
+/// @cond HIDDEN_SYMBOLS
+#define SD_STREAM_NONE      0   /* No multi-block transfer in progress */
+#define SD_STREAM_READ      1   /* CMD18 READ_MULTIPLE_BLOCK in progress */
+#define SD_STREAM_WRITE     2   /* CMD25 WRITE_MULTIPLE_BLOCK in progress */
+
+static uint8_t  s_u8StreamMode = SD_STREAM_NONE;
+static uint32_t s_u32StreamNext = 0;    /* Card address of next block in current stream */
+static uint8_t  s_u8TxDummy = 0xFF;     /* PDMA source for clocking out read data */
+static uint8_t  s_u8RxDummy;            /* PDMA destination for discarding write echo */
+static volatile uint8_t s_u8SyncReq = 0;    /* Stream end requested by USB interrupt */
+static S_PDMA_JOB_T s_sTxJob, s_sRxJob;     /* PDMA jobs of one data run */
+
+/* CRC16-CCITT (x^16 + x^12 + x^5 + 1) table for data tokens */
+static const uint16_t s_au16Crc16Table[256] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
+/// @endcond HIDDEN_SYMBOLS
+
 
 
 
@@ -44,10 +94,10 @@ COMMAND __I command_list[] =
     {13, NO , 0xFF, CMD, R2 , NO }, // CMD13; SEND_STATUS: read card status;
     {16, YES, 0xFF, CMD, R1 , NO }, // CMD16; SET_BLOCKLEN: set block size;
     {17, YES, 0xFF, RDB , R1 , NO }, // CMD17; READ_SINGLE_BLOCK: read 1 block;
-    {18, YES, 0xFF, RD , R1 , YES}, // CMD18; READ_MULTIPLE_BLOCK: read > 1;
+    {18, YES, 0xFF, CMD, R1 , YES}, // CMD18; READ_MULTIPLE_BLOCK: read > 1;
     {23, NO , 0xFF, CMD, R1 , NO }, // CMD23; SET_BLOCK_COUNT
     {24, YES, 0xFF, WR , R1 , NO }, // CMD24; WRITE_BLOCK: write 1 block;
-    {25, YES, 0xFF, WR , R1 , YES}, // CMD25; WRITE_MULTIPLE_BLOCK: write > 1;
+    {25, YES, 0xFF, CMD, R1 , YES}, // CMD25; WRITE_MULTIPLE_BLOCK: write > 1;
     {27, NO , 0xFF, CMD, R1 , NO }, // CMD27; PROGRAM_CSD: program CSD;
     {28, YES, 0xFF, CMD, R1b, NO }, // CMD28; SET_WRITE_PROT: set wp for group;
     {29, YES, 0xFF, CMD, R1b, NO }, // CMD29; CLR_WRITE_PROT: clear group wp;
@@ -120,6 +170,22 @@ static uint32_t GenerateCRC(uint32_t u32Data, uint32_t u32GenPoly, uint32_t u32A
     return u32Accum;
 }
 
+/**
+  * @brief This function is used to generate CRC16 of a data block by table lookup
+  * @param[in] pu8Buf Data buffer
+  * @param[in] u32Len Data length (byte)
+  * @return CRC16 value
+  */
+static uint16_t SD_Crc16(const uint8_t *pu8Buf, uint32_t u32Len)
+{
+    uint16_t u16Crc = 0;
+
+    while(u32Len--)
+        u16Crc = (u16Crc << 8) ^ s_au16Crc16Table[(u16Crc >> 8) ^ *pu8Buf++];
+
+    return u16Crc;
+}
+
 /**
   * @brief This function is used to send data though SPI to general clock for SDCARD operation
   * @param[in] u32Data Data to send
@@ -225,6 +291,12 @@ uint32_t MMC_Command_Exec(uint8_t nCmd, uint32_t nArg, uint8_t *pchar, uint32_t
     // what type of response to expect for
     // a given command;  The following
     // conditional handles the MMC response;
+    // CMD12 is followed by a stuff byte before its response;
+    if(current_command.command_byte == 12)
+    {
+        SingleWrite(0xFF);
+    }
+
     if(current_command.response == R1)
     {
         // Read the R1 response from the card;
@@ -254,7 +326,12 @@ uint32_t MMC_Command_Exec(uint8_t nCmd, uint32_t nArg, uint8_t *pchar, uint32_t
             if(!++loopguard) break;
         }
         while((card_response.b[0] & BUSY_BIT));
+        if(!loopguard)
+        {
+            BACK_FROM_ERROR;
+        }
         while((SingleWrite(0xFF) & 0xFF) == 0x00);
+        *response = card_response.b[0];
     }
     else if(current_command.response == R2)
     {
@@ -402,10 +479,10 @@ uint32_t MMC_Command_Exec(uint8_t nCmd, uint32_t nArg, uint8_t *pchar, uint32_t
             SingleWrite(0xFF);
             SingleWrite(START_SBW);
 
+            dummy_CRC.i = SD_Crc16(pchar, current_blklen);
             for(counter = 0; counter < current_blklen; counter++)
             {
                 SPI_WRITE_TX(g_pSPI, *(pchar + counter));
-                dummy_CRC.i = GenerateCRC(*(pchar + counter), 0x1021, dummy_CRC.i);
                 while(SPI_IS_BUSY(g_pSPI));
             }
             SingleWrite(dummy_CRC.b[1]);
@@ -433,7 +510,9 @@ uint32_t MMC_Command_Exec(uint8_t nCmd, uint32_t nArg, uint8_t *pchar, uint32_t
             break;
     }
 
-    PC4 = 1;//SPI_SET_SS_HIGH(g_pSPI);// CS = 1
+    /* Multi-block commands keep CS low. Data blocks follow in the stream. */
+    if(current_command.var_length == NO)
+        PC4 = 1;//SPI_SET_SS_HIGH(g_pSPI);// CS = 1
 
     if((current_command.command_byte == 9) || (current_command.command_byte == 10))
     {
@@ -598,6 +677,8 @@ uint32_t SDCARD_Open(void)
     DBG_PRINTF("SPI is running at %d Hz\n", SPI_GetBusClock(g_pSPI));
     SPI_DisableAutoSS(g_pSPI);
     PC4 = 1;//SPI_SET_SS_LOW(g_pSPI);
+    s_u8StreamMode = SD_STREAM_NONE;
+
     SingleWrite(0xFFFFFFFF);
 
     MMC_FLASH_Init();
@@ -622,6 +703,7 @@ uint32_t SDCARD_Open(void)
   */
 void SDCARD_Close(void)
 {
+    SDCARD_Sync();
     SPI_Close(g_pSPI);
 }
 
@@ -650,38 +732,274 @@ uint32_t GetLogicSector(void)
     return LogicSector;
 }
 
+/// @cond HIDDEN_SYMBOLS
+/**
+  * @brief Start PDMA transfer of one data run between SPI FIFO and memory
+  * @param[in] pu8Tx Data to send. NULL to send 0xFF.
+  * @param[out] pu8Rx Buffer for received data. NULL to discard.
+  * @param[in] u32Len Data length (byte)
+  * @return none
+  * @details The TX and RX jobs must run at the same time, so the PDMA job scheduler is opened with
+  *          the two channels of SD_PDMA_CH_MASK and no other job is submitted while a data run is active.
+  */
+static void SD_PdmaStart(const uint8_t *pu8Tx, uint8_t *pu8Rx, uint32_t u32Len)
+{
+    PDMA_JobInit(&s_sRxJob, SD_PDMA_RX_REQ, NULL, NULL);
+    if(pu8Rx)
+        PDMA_JobAddDesc(&s_sRxJob, PDMA_WIDTH_8, (uint32_t)&g_pSPI->RX, PDMA_SAR_FIX, (uint32_t)pu8Rx, PDMA_DAR_INC, u32Len);
+    else
+        PDMA_JobAddDesc(&s_sRxJob, PDMA_WIDTH_8, (uint32_t)&g_pSPI->RX, PDMA_SAR_FIX, (uint32_t)&s_u8RxDummy, PDMA_DAR_FIX, u32Len);
+
+    PDMA_JobInit(&s_sTxJob, SD_PDMA_TX_REQ, NULL, NULL);
+    if(pu8Tx)
+        PDMA_JobAddDesc(&s_sTxJob, PDMA_WIDTH_8, (uint32_t)pu8Tx, PDMA_SAR_INC, (uint32_t)&g_pSPI->TX, PDMA_DAR_FIX, u32Len);
+    else
+        PDMA_JobAddDesc(&s_sTxJob, PDMA_WIDTH_8, (uint32_t)&s_u8TxDummy, PDMA_SAR_FIX, (uint32_t)&g_pSPI->TX, PDMA_DAR_FIX, u32Len);
+
+    PDMA_JobSubmit(&s_sRxJob);
+    PDMA_JobSubmit(&s_sTxJob);
+
+    /* Enable RX first to not lose any received byte */
+    SPI_TRIGGER_RX_PDMA(g_pSPI);
+    SPI_TRIGGER_TX_PDMA(g_pSPI);
+}
+
+/**
+  * @brief Wait PDMA transfer started by SD_PdmaStart done
+  * @return none
+  * @details It polls the job scheduler, so it also works in USB interrupt.
+  */
+static void SD_PdmaWait(void)
+{
+    PDMA_JobWait(&s_sRxJob);
+    PDMA_JobWait(&s_sTxJob);
+    while(SPI_IS_BUSY(g_pSPI));
+
+    SPI_DISABLE_TX_PDMA(g_pSPI);
+    SPI_DISABLE_RX_PDMA(g_pSPI);
+}
+
+/**
+  * @brief Wait until card releases busy (DO high)
+  * @retval TRUE Card is ready
+  * @retval FALSE Timeout
+  */
+static uint32_t SD_WaitReady(void)
+{
+    uint32_t u32TimeOut = 0x100000;
+
+    while((SingleWrite(0xFF) & 0xFF) != 0xFF)
+    {
+        if(--u32TimeOut == 0)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+  * @brief Terminate current multi-block stream
+  * @retval TRUE Stream is finished without error
+  * @retval FALSE Card reports an error or timeout
+  */
+static uint32_t SD_StopStream(void)
+{
+    uint32_t response = 0;
+    uint32_t u32Ret = TRUE;
+    uint32_t u32End;
+
+    if(s_u8StreamMode == SD_STREAM_READ)
+    {
+        /* CMD12 raises CS when done. A stream that has read the last block of the card may report
+           the block after it as out of range. It is not an error of the blocks read. */
+        u32End = (SDtype & SDBlock) ? LogicSector : LogicSector * PHYSICAL_BLOCK_SIZE;
+        if(MMC_Command_Exec(STOP_TRANSMISSION, EMPTY, EMPTY, &response) == FALSE)
+            u32Ret = FALSE;
+        else if((response != 0) && (s_u32StreamNext != u32End))
+            u32Ret = FALSE;
+    }
+    else if(s_u8StreamMode == SD_STREAM_WRITE)
+    {
+        /* Wait last block programmed and send stop token */
+        SD_WaitReady();
+        SingleWrite(STOP_MBW);
+        SingleWrite(0xFF);
+        if(SD_WaitReady() == FALSE)
+            u32Ret = FALSE;
+        PC4 = 1;//SPI_SET_SS_HIGH(g_pSPI);// CS = 1
+        SingleWrite(0xFF);
+
+        /* Write errors of the stream are reported by card status */
+        if((MMC_Command_Exec(SEND_STATUS, EMPTY, EMPTY, &response) == FALSE) || (response != 0))
+            u32Ret = FALSE;
+    }
+    s_u8StreamMode = SD_STREAM_NONE;
+
+    if(u32Ret == FALSE)
+        DBG_PRINTF("Stream stop error:0x%x\n", response);
+
+    return u32Ret;
+}
+
+/**
+  * @brief Make sure a multi-block stream starting from card address is opened
+  * @param[in] u8Mode SD_STREAM_READ or SD_STREAM_WRITE
+  * @param[in] addr Card address of first block
+  * @retval TRUE Stream is opened
+  * @retval FALSE Card rejects the command
+  */
+static uint32_t SD_OpenStream(uint8_t u8Mode, uint32_t addr)
+{
+    uint32_t response;
+
+    /* Sequential access continues current stream without a new command */
+    if((s_u8StreamMode == u8Mode) && (s_u32StreamNext == addr))
+        return TRUE;
+
+    SD_StopStream();
+
+    if(MMC_Command_Exec((u8Mode == SD_STREAM_READ) ? READ_MULTIPLE_BLOCK : WRITE_MULTIPLE_BLOCK, addr, EMPTY, &response) == FALSE)
+        return FALSE;
+
+    if(response != 0)
+    {
+        PC4 = 1;//SPI_SET_SS_HIGH(g_pSPI);// CS = 1
+        return FALSE;
+    }
+
+    s_u8StreamMode = u8Mode;
+    s_u32StreamNext = addr;
+    return TRUE;
+}
+
+/**
+  * @brief Read next data block of CMD18 stream
+  * @param[out] buffer Buffer of PHYSICAL_BLOCK_SIZE bytes
+  * @retval TRUE Success
+  * @retval FALSE Timeout
+  */
+static uint32_t SD_ReadStreamBlock(uint8_t *buffer)
+{
+    uint32_t u32TimeOut = 0x100000;
+
+    while((SingleWrite(0xFF) & 0xFF) != START_MBR)
+    {
+        if(--u32TimeOut == 0)
+            return FALSE;
+    }
+
+    SD_PdmaStart(NULL, buffer, PHYSICAL_BLOCK_SIZE);
+    SD_PdmaWait();
+
+    /* CRC is not checked in SPI mode but must be clocked out */
+    SingleWrite(0xFF);
+    SingleWrite(0xFF);
+    return TRUE;
+}
+
+/**
+  * @brief Write next data block of CMD25 stream.
+  *        Card programs the block in background. Busy is checked before next block.
+  * @param[in] buffer Buffer of PHYSICAL_BLOCK_SIZE bytes
+  * @retval TRUE Success
+  * @retval FALSE Card rejects the data
+  */
+static uint32_t SD_WriteStreamBlock(uint8_t *buffer)
+{
+    uint16_t u16Crc;
+    uint8_t data_resp;
+    uint8_t loopguard;
+
+    if(SD_WaitReady() == FALSE)
+        return FALSE;
+
+    SingleWrite(START_MBW);
+
+    /* Calculate CRC while PDMA feeds SPI */
+    SD_PdmaStart(buffer, NULL, PHYSICAL_BLOCK_SIZE);
+    u16Crc = SD_Crc16(buffer, PHYSICAL_BLOCK_SIZE);
+    SD_PdmaWait();
+
+    SingleWrite(u16Crc >> 8);
+    SingleWrite(u16Crc & 0xFF);
+
+    loopguard = 0;
+    do
+    {
+        data_resp = SingleWrite(0xFF);
+        if(!++loopguard)
+            return FALSE;
+    }
+    while((data_resp & DATA_RESP_MASK) != 0x01);
+
+    /* Data accepted */
+    return ((data_resp & 0x1F) == 0x05) ? TRUE : FALSE;
+}
+/// @endcond HIDDEN_SYMBOLS
+
+/**
+  * @brief This function is used to finish pending multi-block transfer.
+  *        Written data is programmed into card when it returns.
+  * @retval TRUE Success
+  * @retval FALSE Card reports an error of the transfer
+  */
+uint32_t SDCARD_Sync(void)
+{
+    return SD_StopStream();
+}
+
+/**
+  * @brief This function is used to ask main loop to finish pending multi-block transfer.
+  *        It can be called from interrupt, such as USB suspend or bus reset.
+  * @return none
+  */
+void SDCARD_RequestSync(void)
+{
+    s_u8SyncReq = 1;
+}
+
+/**
+  * @brief This function is called by main loop. It finishes the transfer requested by SDCARD_RequestSync.
+  * @return none
+  */
+void SDCARD_Idle(void)
+{
+    if(s_u8SyncReq)
+    {
+        s_u8SyncReq = 0;
+        SD_StopStream();
+    }
+}
+
 /**
   * @brief This function is used to Get data from SD card
   * @param[in] addr Set start address for LBA
   * @param[in] size Set data size (byte)
   * @param[in] buffer Set buffer pointer
   * @return none
+  * @details Blocks are read by CMD18. The stream is left open, so a following
+  *          sequential read of the same command continues without a new command
+  *          while the card prepares next block. Call SDCARD_Sync when the command
+  *          has read all its data.
   */
 void SpiRead(uint32_t addr, uint32_t size, uint8_t* buffer)
 {
     /* This is low level read function of USB Mass Storage */
-    uint32_t response;
-    if(SDtype & SDBlock)
-    {
-        while(size >= PHYSICAL_BLOCK_SIZE)
-        {
-            MMC_Command_Exec(READ_SINGLE_BLOCK, addr, buffer, &response);
-            addr   ++;
-            buffer += PHYSICAL_BLOCK_SIZE;
-            size  -= PHYSICAL_BLOCK_SIZE;
-        }
+    uint32_t u32Step = (SDtype & SDBlock) ? 1 : PHYSICAL_BLOCK_SIZE;
 
-    }
-    else
+    addr *= u32Step;
+    if(SD_OpenStream(SD_STREAM_READ, addr) == FALSE)
+        return;
+
+    while(size >= PHYSICAL_BLOCK_SIZE)
     {
-        addr *= PHYSICAL_BLOCK_SIZE;
-        while(size >= PHYSICAL_BLOCK_SIZE)
+        if(SD_ReadStreamBlock(buffer) == FALSE)
         {
-            MMC_Command_Exec(READ_SINGLE_BLOCK, addr, buffer, &response);
-            addr   += PHYSICAL_BLOCK_SIZE;
-            buffer += PHYSICAL_BLOCK_SIZE;
-            size  -= PHYSICAL_BLOCK_SIZE;
+            SD_StopStream();
+            return;
         }
+        s_u32StreamNext += u32Step;
+        buffer += PHYSICAL_BLOCK_SIZE;
+        size  -= PHYSICAL_BLOCK_SIZE;
     }
 }
 
@@ -691,30 +1009,28 @@ void SpiRead(uint32_t addr, uint32_t size, uint8_t* buffer)
   * @param[in] size Set data size (byte)
   * @param[in] buffer Set buffer pointer
   * @return none
+  * @details Blocks are written by CMD25. The stream is left open, so a following
+  *          sequential write continues while the card programs previous block.
+  *          Call SDCARD_Sync to finish the stream.
   */
 void SpiWrite(uint32_t addr, uint32_t size, uint8_t* buffer)
 {
-    uint32_t response;
-    if(SDtype & SDBlock)
-    {
-        while(size >= PHYSICAL_BLOCK_SIZE)
-        {
-            MMC_Command_Exec(WRITE_BLOCK, addr, buffer, &response);
-            addr   ++;
-            buffer += PHYSICAL_BLOCK_SIZE;
-            size  -= PHYSICAL_BLOCK_SIZE;
-        }
-    }
-    else
+    uint32_t u32Step = (SDtype & SDBlock) ? 1 : PHYSICAL_BLOCK_SIZE;
+
+    addr *= u32Step;
+    if(SD_OpenStream(SD_STREAM_WRITE, addr) == FALSE)
+        return;
+
+    while(size >= PHYSICAL_BLOCK_SIZE)
     {
-        addr *= PHYSICAL_BLOCK_SIZE;
-        while(size >= PHYSICAL_BLOCK_SIZE)
+        if(SD_WriteStreamBlock(buffer) == FALSE)
         {
-            MMC_Command_Exec(WRITE_BLOCK, addr, buffer, &response);
-            addr   += (PHYSICAL_BLOCK_SIZE);
-            buffer += PHYSICAL_BLOCK_SIZE;
-            size  -= PHYSICAL_BLOCK_SIZE;
+            SD_StopStream();
+            return;
         }
+        s_u32StreamNext += u32Step;
+        buffer += PHYSICAL_BLOCK_SIZE;
+        size  -= PHYSICAL_BLOCK_SIZE;
     }
 }
 /*@}*/ /* end of group NUC1261_SDCARD_EXPORTED_FUNCTIONS */
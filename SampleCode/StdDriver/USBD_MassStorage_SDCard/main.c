@@ -19,6 +19,14 @@
 
 /*--------------------------------------------------------------------------*/
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*  PDMA Interrupt Handler                                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+void PDMA_IRQHandler(void)
+{
+    PDMA_JobIRQHandler();
+}
+
 void SYS_Init(void)
 {
 
@@ -78,6 +86,7 @@ void SYS_Init(void)
     CLK_EnableModuleClock(UART0_MODULE);
     CLK_EnableModuleClock(USBD_MODULE);
     CLK_EnableModuleClock(SPI1_MODULE);
+    CLK_EnableModuleClock(PDMA_MODULE);
 
     /* Select module clock source */
     CLK_SetModuleClock(SPI1_MODULE, CLK_CLKSEL2_SPI1SEL_PCLK0, MODULE_NoMsk);
@@ -117,6 +126,8 @@ int32_t main(void)
     printf("|          NuMicro USB MassStorage Sample Code          |\n");
     printf("+-------------------------------------------------------+\n");
 
+    /* SD card data blocks are moved by PDMA jobs */
+    PDMA_JobOpen(SD_PDMA_CH_MASK);
     SDCARD_Open();
 
     USBD_Open(&gsInfo, MSC_ClassRequest, NULL);
@@ -171,6 +182,7 @@ int32_t main(void)
 #endif
 
         MSC_ProcessCmd();
+        SDCARD_Idle();
     }
 }
 
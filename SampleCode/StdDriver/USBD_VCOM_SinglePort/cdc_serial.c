@@ -13,6 +13,11 @@
 
 uint32_t volatile g_u32OutToggle = 0;
 
+/* Bulk OUT double buffer. Endpoint is re-armed in ISR while a buffer is free. */
+S_USBD_DBUF_T g_sBulkOutBuf;
+static uint32_t s_au32BulkOutBuf0[EP3_MAX_PKT_SIZE / 4];
+static uint32_t s_au32BulkOutBuf1[EP3_MAX_PKT_SIZE / 4];
+
 /*--------------------------------------------------------------------------*/
 void USBD_IRQHandler(void)
 {
@@ -173,12 +178,10 @@ void EP3_Handler(void)
     }
     else
     {
-        gu32RxSize = USBD_GET_PAYLOAD_LEN(EP3);
-        gpu8RxBuf = (uint8_t *)(USBD_BUF_BASE + USBD_GET_EP_BUF_ADDR(EP3));
+        /* Move data to SRAM buffer and get ready for next packet */
+        USBD_DBufOutHandler(&g_sBulkOutBuf);
 
         g_u32OutToggle = USBD->EPSTS & USBD_EPSTS_EPSTS3_Msk;
-        /* Set a flag to indicate bulk out ready */
-        gi8BulkOutReady = 1;
     }
 }
 
@@ -216,7 +219,7 @@ void VCOM_Init(void)
     /* Buffer offset for EP3 */
     USBD_SET_EP_BUF_ADDR(EP3, EP3_BUF_BASE);
     /* trigger receive OUT data */
-    USBD_SET_PAYLOAD_LEN(EP3, EP3_MAX_PKT_SIZE);
+    USBD_DBufOpen(&g_sBulkOutBuf, EP3, (uint8_t *)s_au32BulkOutBuf0, (uint8_t *)s_au32BulkOutBuf1, EP3_MAX_PKT_SIZE);
 
     /* EP4 ==> Interrupt IN endpoint, address 3 */
     USBD_CONFIG_EP(EP4, USBD_CFG_EPMODE_IN | INT_IN_EP_NUM);
@@ -66,7 +66,6 @@ typedef struct
 } STR_VCOM_LINE_CODING;
 
 /*-------------------------------------------------------------*/
-extern volatile int8_t gi8BulkOutReady;
 extern STR_VCOM_LINE_CODING gLineCoding;
 extern uint16_t gCtrlSignal;
 extern volatile uint16_t comRbytes;
@@ -75,8 +74,7 @@ extern volatile uint16_t comRtail;
 extern volatile uint16_t comTbytes;
 extern volatile uint16_t comThead;
 extern volatile uint16_t comTtail;
-extern volatile uint8_t *gpu8RxBuf;
-extern volatile uint32_t gu32RxSize;
+extern S_USBD_DBUF_T g_sBulkOutBuf;
 extern volatile uint32_t gu32TxSize;
 
 /*-------------------------------------------------------------*/
@@ -48,11 +48,8 @@ volatile uint16_t comThead = 0;
 volatile uint16_t comTtail = 0;
 
 uint8_t gRxBuf[64] = {0};
-volatile uint8_t *gpu8RxBuf = 0;
-volatile uint32_t gu32RxSize = 0;
 volatile uint32_t gu32TxSize = 0;
 
-volatile int8_t gi8BulkOutReady = 0;
 
 
 
@@ -209,6 +206,8 @@ void UART02_IRQHandler(void)
 void VCOM_TransferData(void)
 {
     int32_t i, i32Len;
+    uint8_t *pu8Buf;
+    uint32_t u32Len;
 
     /* Check wether USB is ready for next packet or not*/
     if(gu32TxSize == 0)
@@ -246,24 +245,22 @@ void VCOM_TransferData(void)
     }
 
     /* Process the Bulk out data when bulk out data is ready. */
-    if(gi8BulkOutReady && (gu32RxSize <= TXBUFSIZE - comTbytes))
+    pu8Buf = USBD_DBufGet(&g_sBulkOutBuf, &u32Len);
+    if(pu8Buf && (u32Len <= TXBUFSIZE - comTbytes))
     {
-        for(i = 0; i < gu32RxSize; i++)
+        for(i = 0; i < u32Len; i++)
         {
-            comTbuf[comTtail++] = gpu8RxBuf[i];
+            comTbuf[comTtail++] = pu8Buf[i];
             if(comTtail >= TXBUFSIZE)
                 comTtail = 0;
         }
 
         __set_PRIMASK(1);
-        comTbytes += gu32RxSize;
+        comTbytes += u32Len;
         __set_PRIMASK(0);
 
-        gu32RxSize = 0;
-        gi8BulkOutReady = 0; /* Clear bulk out ready flag */
-
-        /* Ready to get next BULK out */
-        USBD_SET_PAYLOAD_LEN(EP3, EP3_MAX_PKT_SIZE);
+        /* Free the buffer. Endpoint is re-armed if it was waiting for it. */
+        USBD_DBufRelease(&g_sBulkOutBuf);
     }
 
     /* Process the software TX FIFO */